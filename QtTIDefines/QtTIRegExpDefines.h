@@ -26,13 +26,10 @@
 
 #define RX_NULL_COALESCING              "^\\s{0,}([\\w\\.\\,\\+\\-\\/\\%\\*\\(\\)\\ \\'\\\"\\{\\}\\[\\]\\:\\<\\>\\=\\!\\&\\|]+)\\s{1,}\\?\\?\\s{1,}([\\w\\.\\,\\+\\-\\/\\%\\*\\(\\)\\ \\'\\\"\\{\\}\\[\\]\\:\\<\\>\\=\\!\\&\\|]+)\\s{0,}$"
 
-#define RX_MATH_OP                      "^\\s{0,}([\\w\\.\\,\\+\\-\\(\\) \\'\\\"\\:]+)(\\s{0,}(\\+|-|/|//|%|\\*|\\*\\*)\\s{0,}([\\w\\.\\,\\+\\-\\(\\) \\'\\\"\\:]+)\\s{0,})+$"
-#define RX_MATH_OP_SEARCH               "\\s{0,}([\\w\\.\\,\\+\\-\\(\\) \\'\\\"\\:]+)\\s{0,}(\\+|-|/|//|%|\\*|\\*\\*)\\s{0,}(.*)\\s{0,}"
+#define RX_MATH_OP                      "^\\s{0,}([\\w\\.\\,\\+\\-\\(\\) \\'\\\"\\:]+)(\\s{0,}(\\*\\*|//|\\+|-|/|%|\\*)\\s{0,}([\\w\\.\\,\\+\\-\\(\\) \\'\\\"\\:]+)\\s{0,})+$"
 
 #define RX_LOGIC_v1                     "^(?!'|\")\\s{0,}([\\w\\.\\,\\+\\-\\/\\%\\*\\(\\)\\ \\'\\\"\\:\\<\\>\\=\\!]+)(\\s{1,}(and|or|&&|\\|\\||not)\\s{1,}([\\w\\.\\,\\+\\-\\/\\%\\*\\(\\)\\ \\'\\\"\\:\\<\\>\\=\\!]+)\\s{0,})+(?!'|\")$"
 #define RX_LOGIC_v2                     "^(?!'|\")\\s{0,}([\\w\\.\\,\\+\\-\\/\\%\\*\\(\\)\\ \\'\\\"\\:]+)(\\s{1,}([\\<\\>\\=\\!]+)\\s{1,}([\\w\\.\\,\\+\\-\\/\\%\\*\\(\\)\\ \\'\\\"\\:]+)\\s{0,})+(?!'|\")$"
-#define RX_LOGIC_LEFT_RIGHT             "((not\\s+)?([\\w\\ \\+\\-\\,\\.\\'\\\"\\:\\/\\(\\)]*)\\s+([\\<\\>\\=\\!]+)\\s+([\\w\\ \\+\\-\\,\\.\\'\\\"\\:\\/\\(\\)]*))"
-#define RX_LOGIC_ONE                    "((not\\s+)?([\\w\\ \\+\\-\\,\\.\\'\\\"\\:\\/\\(\\)]*))"
 
 #define RX_CONTROL_BLOCK_FOR_START      "^(for\\s+([\\w\\ \\,]+)\\s+in\\s+([\\w\\ \\+\\-\\,\\.\\'\\\"\\{\\}\\[\\]\\:\\/\\(\\)]+))"
 #define RX_CONTROL_BLOCK_FOR_END        "^(endfor)$"
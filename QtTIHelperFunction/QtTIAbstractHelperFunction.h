@@ -4,6 +4,7 @@
 #include <QString>
 #include <QStringList>
 #include <QVariantList>
+#include <QVector>
 
 //!
 //! \brief The QtTIAbstractHelperFunction class
@@ -25,6 +26,32 @@ public:
         return _name;
     }
 
+    //!
+    //! \brief Check function is pure (the result depends only on the arguments, no side effects)
+    //! \return
+    //!
+    //! NOTE: The result of the pure function with constant arguments is evaluated once
+    //!       (see QtTIFunctionCache::constantResult). The default help functions are pure.
+    //!
+    bool isPure() const {
+        return _isPure;
+    }
+
+    //!
+    //! \brief Set function is pure
+    //! \param isPure
+    //!
+    //! === Example:
+    //!     QtTIHelperFunction<QString> *f = new QtTIHelperFunction<QString>("to_title", [](const QString &d) {
+    //!         return d.left(1).toUpper() + d.mid(1);
+    //!     });
+    //!     f->setPure(true);
+    //!     QtTIParserFunc.appendHelpFunction(f);
+    //!
+    void setPure(const bool isPure) {
+        _isPure = isPure;
+    }
+
     //!
     //! \brief Get function full name (with input args)
     //! \return
@@ -37,6 +64,12 @@ public:
     //!
     virtual QStringList neededArgsTypes() const = 0;
 
+    //!
+    //! \brief Needed arguments type ids for function
+    //! \return
+    //!
+    virtual const QVector<int> &neededArgsTypeIds() const = 0;
+
     //!
     //! \brief Check is can convert args types
     //! \param args Input arguments
@@ -51,6 +84,15 @@ public:
     //!
     virtual std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> evalFunction(const QVariantList &args) const = 0;
 
+    //!
+    //! \brief Execute function without checking the arguments types
+    //! \param args Input arguments (the types are equal to the needed ones or can be converted)
+    //! \return
+    //!
+    //! NOTE: Used when the function is selected by the arguments types (see QtTIParserFunc::findHelpFunction).
+    //!
+    virtual std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> callFunction(const QVariantList &args) const = 0;
+
     //!
     //! \brief QVarianList to arguments types list
     //! \param args Input arguments
@@ -67,6 +109,25 @@ public:
         return lst;
     }
 
+    //!
+    //! \brief QVarianList to arguments type ids list
+    //! \param args Input arguments
+    //! \return
+    //!
+    //! NOTE: Null argument (except QString) has type id -1 (type name "Null", see vListArgsTypes).
+    //!
+    static QVector<int> vListArgsTypeIds(const QVariantList &args) {
+        QVector<int> lst;
+        lst.reserve(args.size());
+        for (const QVariant &a : args) {
+            if (a.isNull() && a.type() != QVariant::Type::String)
+                lst << -1;
+            else
+                lst << a.userType();
+        }
+        return lst;
+    }
+
     //!
     //! \brief Arguments types list to string
     //! \param types Arguments types list
@@ -77,7 +138,8 @@ public:
     }
 
 private:
-    QString _name;  //!< function name
+    QString _name;          //!< function name
+    bool _isPure {false};   //!< function is pure
 };
 
 #endif // QTTIABSTRACTHELPERFUNCTION_H
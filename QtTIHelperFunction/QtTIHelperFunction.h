@@ -29,6 +29,8 @@ public:
     QtTIHelperFunction(const QString &name,
                        std::function<QVariant/*res*/(const T&... args)> callback)
         : QtTIAbstractHelperFunction(name)
+        , _argsTypes(argsTypesHelper(std::index_sequence_for<T...>{}))
+        , _argsTypeIds{qMetaTypeId<T>()...}
         , _callback(callback) {
         Q_ASSERT_WITH_MSG (_callback != nullptr,
                            QString("[QtTIHelperFunction - %1] Invalid callback function!")
@@ -51,6 +53,8 @@ public:
     QtTIHelperFunction(const QString &name,
                        std::function<std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/>(const T&... args)> callback)
         : QtTIAbstractHelperFunction(name)
+        , _argsTypes(argsTypesHelper(std::index_sequence_for<T...>{}))
+        , _argsTypeIds{qMetaTypeId<T>()...}
         , _callback_tuple(callback) {
         Q_ASSERT_WITH_MSG (_callback_tuple != nullptr,
                            QString("[QtTIHelperFunction - %1] Invalid callback function!")
@@ -72,7 +76,15 @@ public:
     //! \return
     //!
     QStringList neededArgsTypes() const final {
-        return argsTypesHelper(std::index_sequence_for<T...>{});
+        return _argsTypes;
+    }
+
+    //!
+    //! \brief Needed arguments type ids for function
+    //! \return
+    //!
+    const QVector<int> &neededArgsTypeIds() const final {
+        return _argsTypeIds;
     }
 
     //!
@@ -81,10 +93,9 @@ public:
     //! \return
     //!
     bool canConvertArgsTypes(const QVariantList &args) const final {
-        if (neededArgsTypes().size() != args.size())
+        if (_argsTypeIds.size() != args.size())
             return false;
-        const QList<bool> tmpList = canConvertArgsTypesHelper(args, std::index_sequence_for<T...>{});
-        return !tmpList.contains(false);
+        return canConvertArgsTypesHelper(args, std::index_sequence_for<T...>{});
     }
 
     //!
@@ -93,18 +104,25 @@ public:
     //! \return
     //!
     std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> evalFunction(const QVariantList &args) const final {
-        const QStringList neededTypes = neededArgsTypes();
-        const QStringList inputTypes = vListArgsTypes(args);
-        if (neededTypes != inputTypes && !canConvertArgsTypes(args)) {
+        if (_argsTypeIds != vListArgsTypeIds(args) && !canConvertArgsTypes(args)) {
             QString err = QString("Invalid function args!"
                                   "\r\n  - needed: %1"
                                   "\r\n  -  input: %2 (%3)")
                           .arg(fullName())
                           .arg(name())
-                          .arg(inputTypes.join(", "));
+                          .arg(vListArgsTypes(args).join(", "));
 
             return std::make_tuple(false, QVariant(), err);
         }
+        return callFunction(args);
+    }
+
+    //!
+    //! \brief Execute function without checking the arguments types
+    //! \param args Input arguments (the types are equal to the needed ones or can be converted)
+    //! \return
+    //!
+    std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> callFunction(const QVariantList &args) const final {
         if (_callback)
             return std::make_tuple(true,
                                    this->evalFunctionHelper(args, std::index_sequence_for<T...>{}),
@@ -140,20 +158,29 @@ private:
     //!
     template<std::size_t... I>
     QStringList argsTypesHelper(std::index_sequence<I...>) const {
-        return QStringList({QtTIHelperFunctionArg<T>().typeName()...});
+        return QStringList({QtTIHelperFunctionArg<T>::typeName()...});
     }
 
     //!
-    //! \brief Helper method for generating a list of can convert args types results
+    //! \brief Helper method to check all arguments can be converted
     //! \param args
     //! \return
     //!
+    //! NOTE: The check of QVariant argument is always true (see QtTIHelperFunctionArg<QVariant>).
+    //!
     template<std::size_t... I>
-    QList<bool> canConvertArgsTypesHelper(const QVariantList &args, std::index_sequence<I...>) const {
-        return QList<bool>({QtTIHelperFunctionArg<T>().canConvert(args.at(I))...});
+    bool canConvertArgsTypesHelper(const QVariantList &args, std::index_sequence<I...>) const {
+        const bool results[] = {true, QtTIHelperFunctionArg<T>::canConvert(args.at(I))...};
+        for (const bool r : results) {
+            if (!r)
+                return false;
+        }
+        return true;
     }
 
 private:
+    QStringList _argsTypes;     //!< needed arguments types
+    QVector<int> _argsTypeIds;  //!< needed arguments type ids
     std::function<QVariant/*res*/(const T&... args)> _callback {nullptr};                                               //!< callback for function returning QVariant
     std::function<std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/>(const T&... args)> _callback_tuple {nullptr}; //!< callback for function returning std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/>
 };
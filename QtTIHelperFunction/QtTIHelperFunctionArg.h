@@ -12,74 +12,103 @@
 //!
 //! \brief The QtTIHelperFunctionArg class
 //!
+//! Argument of the help function (see QtTIHelperFunction). If the type of the value stored in
+//! QVariant is T, the argument refers to the QVariant storage (no copy), otherwise the value
+//! is converted to T and stored in the argument.
+//!
+//! NOTE: The argument refers to the QVariant, the QVariant must live longer than the argument.
+//!
 template<typename T>
 class QtTIHelperFunctionArg
 {
 public:
-    QtTIHelperFunctionArg()
-        : _typeId(qMetaTypeId<T>())
-    #if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
-        , _typeName(QMetaType::typeName(qMetaTypeId<T>()))
-    #else
-        , _typeName(QMetaType(qMetaTypeId<T>()).name())
-    #endif
-    {}
-
-    QtTIHelperFunctionArg(const QVariant &data)
-        : _data(toT(data))
-        , _typeId(qMetaTypeId<T>())
-    #if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
-        , _typeName(QMetaType::typeName(qMetaTypeId<T>()))
-    #else
-        , _typeName(QMetaType(qMetaTypeId<T>()).name())
-    #endif
-    {}
-
-    ~QtTIHelperFunctionArg()
-    {}
+    explicit QtTIHelperFunctionArg(const QVariant &data)
+    {
+        if (data.userType() == qMetaTypeId<T>()) {
+            _data = static_cast<const T*>(data.constData());
+        } else {
+            _converted = data.value<T>();
+            _data = &_converted;
+        }
+    }
+    QtTIHelperFunctionArg(const QtTIHelperFunctionArg &) = delete;
+    QtTIHelperFunctionArg &operator=(const QtTIHelperFunctionArg &) = delete;
+    ~QtTIHelperFunctionArg() = default;
 
     //!
     //! \brief Get argument data
     //! \return
     //!
-    T data() const { return _data; }
+    const T &data() const { return *_data; }
 
     //!
     //! \brief Get argument type id
     //! \return
     //!
-    int typeId() const { return _typeId; }
+    static int typeId() { return qMetaTypeId<T>(); }
 
     //!
     //! \brief Get argument string type name
     //! \return
     //!
-    QString typeName() const { return _typeName; }
+    static QString typeName() {
+    #if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
+        return QString(QMetaType::typeName(qMetaTypeId<T>()));
+    #else
+        return QString(QMetaType(qMetaTypeId<T>()).name());
+    #endif
+    }
 
     //!
     //! \brief Check can convert data value to type T
     //! \param data
     //! \return
     //!
-    bool canConvert(const QVariant &data) const {
-        if (std::is_same<T, QVariant>::value)
-            return true;
-        return data.canConvert<T>();
+    static bool canConvert(const QVariant &data) {
+        return (data.userType() == qMetaTypeId<T>()
+                || data.canConvert<T>());
     }
 
 private:
-    T _data;                            //!< argument data
-    int _typeId;                        //!< argument type id
-    QString _typeName;                  //!< argument string type name
+    const T *_data {nullptr};   //!< argument data (QVariant storage or converted value)
+    T _converted {};            //!< converted argument data
+};
 
-    //!
-    //! \brief Convert QVariant to data type T
-    //! \param data Data in QVariant
-    //! \return
-    //!
-    T toT(const QVariant &data) const {
-        return data.value<T>();
+//!
+//! \brief The QtTIHelperFunctionArg<QVariant> class
+//!
+//! The argument of type QVariant always refers to the input value.
+//!
+template<>
+class QtTIHelperFunctionArg<QVariant>
+{
+public:
+    explicit QtTIHelperFunctionArg(const QVariant &data)
+        : _data(data)
+    {}
+    QtTIHelperFunctionArg(const QtTIHelperFunctionArg &) = delete;
+    QtTIHelperFunctionArg &operator=(const QtTIHelperFunctionArg &) = delete;
+    ~QtTIHelperFunctionArg() = default;
+
+    const QVariant &data() const { return _data; }
+
+    static int typeId() { return qMetaTypeId<QVariant>(); }
+
+    static QString typeName() {
+    #if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
+        return QString(QMetaType::typeName(qMetaTypeId<QVariant>()));
+    #else
+        return QString(QMetaType(qMetaTypeId<QVariant>()).name());
+    #endif
     }
+
+    static bool canConvert(const QVariant &data) {
+        Q_UNUSED(data)
+        return true;
+    }
+
+private:
+    const QVariant &_data;  //!< argument data
 };
 
 #endif // QTTIHELPERFUNCTIONARG_H
@@ -4,9 +4,15 @@
 #include "QtTIAbstractParserArgs.h"
 #include "QtTIAbstractParserFunc.h"
 #include "QtTIAbstractParserBlock.h"
+#include "../CompiledTemplate/QtTIRenderWriter.h"
+#include "../Expression/QtTIExpression.h"
 
 #include <QString>
 #include <QVariant>
+#include <QMap>
+#include <memory>
+
+class QtTICompiledTemplate;
 
 class QtTIAbstractParser
 {
@@ -37,6 +43,21 @@ public:
                                                                              const int lineNum,
                                                                              QtTIAbstractParserBlock *&block) = 0;
 
+    //!
+    //! \brief Parse line data and write result to render output
+    //! \param line Line data
+    //! \param lineNum Line number
+    //! \param block Abstract parser block object
+    //! \param parserArgs Render args (variables of the current render)
+    //! \param writer Render output
+    //! \return
+    //!
+    virtual std::tuple<bool/*isOk*/,QString/*err*/> parseLine(const QString &line,
+                                                              const int lineNum,
+                                                              QtTIAbstractParserBlock *&block,
+                                                              QtTIAbstractParserArgs *parserArgs,
+                                                              QtTIRenderWriter &writer) = 0;
+
     //!
     //! \brief Parse and execute abstract block data
     //! \param block Abstract parser block object
@@ -53,6 +74,63 @@ public:
     virtual std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> parseAndExecBlockData(const QString &data,
                                                                                           const QPair<int, int> &startPos) = 0;
 
+    //!
+    //! \brief Parse and execute abstract block data with render args
+    //! \param data Parser block data
+    //! \param startPos Parser block start position in line
+    //! \param parserArgs Render args (variables of the current render)
+    //! \return
+    //!
+    virtual std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> parseAndExecBlockData(const QString &data,
+                                                                                          const QPair<int, int> &startPos,
+                                                                                          QtTIAbstractParserArgs *parserArgs) = 0;
+
+    //!
+    //! \brief Execute compiled expression with render args
+    //! \param expr Compiled expression
+    //! \param startPos Parser block start position in line
+    //! \param parserArgs Render args (variables of the current render)
+    //! \return
+    //!
+    virtual std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> execExpression(const QtTIExpression &expr,
+                                                                                   const QPair<int, int> &startPos,
+                                                                                   QtTIAbstractParserArgs *parserArgs) = 0;
+
+    //!
+    //! \brief Compile expression (the parameters of the expression get the variable slots
+    //!        of the compiled template, see QtTIScope)
+    //! \param expr Expression
+    //! \return
+    //!
+    virtual QtTIExpression compileExpression(const QString &expr) = 0;
+
+    //!
+    //! \brief Get variable slot of the compiled template (see QtTIScope)
+    //! \param name Variable name
+    //! \return -1 if the template is not compiled now
+    //!
+    virtual int variableSlot(const QString &name) = 0;
+
+    //!
+    //! \brief Compile control block body
+    //! \param data Control block body (line number - line data)
+    //! \param blockLineNum Control block line number (the first line of the body is trimmed on the left)
+    //! \return
+    //!
+    virtual std::tuple<bool/*isOk*/,std::shared_ptr<QtTICompiledTemplate>/*res*/,QString/*err*/> compileBlockBody(const QMap<int/*lineNum*/,QString/*lineData*/> &data,
+                                                                                                                  const int blockLineNum) = 0;
+
+    //!
+    //! \brief Render compiled control block body to render output
+    //! \param body Compiled control block body
+    //! \param parserArgs Render args (variables of the current render)
+    //! \param writer Render output
+    //! \return
+    //!
+    virtual std::tuple<bool/*isOk*/,QString/*err*/> renderBlockBody(const QtTICompiledTemplate &body,
+                                                                    QtTIAbstractParserArgs *parserArgs,
+                                                                    QtTIRenderWriter &writer) = 0;
+
     //!
     //! \brief Trim the line on the left
     //! \param str String
@@ -3,6 +3,9 @@
 
 #include <QString>
 #include <QVariant>
+#include <tuple>
+
+#include "../Scope/QtTIParamPath.h"
 
 class QtTIAbstractParserArgs
 {
@@ -39,6 +42,13 @@ public:
     //!
     virtual QVariant param(const QString& paramName) = 0;
 
+    //!
+    //! \brief Find global help parameter value (the parameter is resolved once)
+    //! \param path Compiled parameter path
+    //! \return
+    //!
+    virtual std::tuple<bool/*isFound*/,QVariant/*res*/> findParam(const QtTIParamPath &path) = 0;
+
     //!
     //! \brief Delete all added global parameters
     //!
@@ -73,6 +83,13 @@ public:
     //!
     virtual QVariant tmpParam(const QString& paramName) = 0;
 
+    //!
+    //! \brief Find help tmp parameter value (the parameter is resolved once)
+    //! \param path Compiled parameter path
+    //! \return
+    //!
+    virtual std::tuple<bool/*isFound*/,QVariant/*res*/> findTmpParam(const QtTIParamPath &path) = 0;
+
     //!
     //! \brief Delete all added tmp parameters
     //!
@@ -80,6 +97,31 @@ public:
     //!
     virtual void clearTmpParams() = 0;
 
+    //!
+    //! \brief Set value of the variable slot (see QtTIScope)
+    //! \param slot Slot index
+    //! \param value Variable value (invalid QVariant - the slot is not set)
+    //!
+    virtual void setSlotValue(const int slot, const QVariant &value) = 0;
+
+    //!
+    //! \brief Get value of the variable slot (see QtTIScope)
+    //! \param slot Slot index
+    //! \return Invalid QVariant if the slot is not set
+    //!
+    virtual const QVariant &slotValue(const int slot) const = 0;
+
+    //!
+    //! \brief Get child value of the parameter value
+    //! \param value Parameter value (value of the first path segment)
+    //! \param path Compiled parameter path (the segments after the first one are evaluated)
+    //! \return
+    //!
+    //! === Example:
+    //!     childParam(a, QtTIParamPath("a.b.c")) == param("a.b.c")
+    //!
+    virtual QVariant childParam(const QVariant &value, const QtTIParamPath &path) = 0;
+
     //!
     //! \brief Parse help function arguments
     //! \param args String representation of arguments
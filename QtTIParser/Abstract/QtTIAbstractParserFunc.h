@@ -60,6 +60,14 @@ public:
     //! \brief Delete all added functions
     //!
     virtual void clearFunctions() = 0;
+
+    //!
+    //! \brief Get revision of the functions list (changed when a function is added or removed)
+    //! \return
+    //!
+    //! NOTE: The functions found before are valid while the revision is not changed (see QtTIFunctionCache).
+    //!
+    virtual int revision() const = 0;
 };
 
 #endif // QTTIABSTRACTPARSERFUNC_H
@@ -0,0 +1,135 @@
+#ifndef QTTICOMPILEDNODE_H
+#define QTTICOMPILEDNODE_H
+
+#include <QString>
+#include <QStringView>
+#include <QPair>
+#include <QVector>
+#include <memory>
+
+#include "../ControlBlockFabric/ControlBlocks/QtTIAbstractControlBlock.h"
+#include "../Expression/QtTIExpression.h"
+
+//!
+//! \brief The QtTICompiledNode class
+//!
+//! One node of a compiled template line. The nodes of a line are executed in order
+//! and append their output to the line buffer:
+//!  - Text          : static text (part of the template data), appended as is
+//!  - Expression    : base block `{{ ... }}`, parsed once and evaluated on every render
+//!  - ControlBlock  : finished control block `{% ... %}`, executed on every render
+//!  - RStrip        : trims trailing blank characters of the line buffer
+//!  - BlockStart    : remembers whether the line buffer has data before a control/comment block
+//!  - RStripBlockLine : trims the line buffer if there was no data before the last block
+//!
+class QtTICompiledNode
+{
+public:
+    //!
+    //! \brief Compiled node types
+    //!
+    enum class Type {
+        Text = 0,       //!< static text
+        Expression,     //!< base block `{{ ... }}`
+        ControlBlock,   //!< control block `{% ... %}`
+        RStrip,         //!< trim the line buffer on the right
+        BlockStart,     //!< check data before block
+        RStripBlockLine //!< trim the line buffer on the right (if no data before block)
+    };
+
+    QtTICompiledNode() = default;
+    explicit QtTICompiledNode(const Type type)
+        : _type(type)
+    {}
+    QtTICompiledNode(const QString &source,
+                     const int textPos,
+                     const int textSize)
+        : _type(Type::Text)
+        , _data(source)
+        , _textPos(textPos)
+        , _textSize(textSize)
+    {}
+    QtTICompiledNode(const Type type,
+                     const QString &data,
+                     const QString &body,
+                     const QPair<int, int> &startPos,
+                     const std::shared_ptr<QtTIAbstractControlBlock> &controlBlock = nullptr)
+        : _type(type)
+        , _data(data)
+        , _body(body)
+        , _startPos(startPos)
+        , _controlBlock(controlBlock)
+    {}
+    QtTICompiledNode(const Type type,
+                     const QString &data,
+                     const QString &body,
+                     const QPair<int, int> &startPos,
+                     const QtTIExpression &expression)
+        : _type(type)
+        , _data(data)
+        , _body(body)
+        , _startPos(startPos)
+        , _expression(expression)
+    {}
+    ~QtTICompiledNode() = default;
+
+    //!
+    //! \brief Get node type
+    //! \return
+    //!
+    Type type() const { return _type; }
+
+    //!
+    //! \brief Get node data (block data including control characters, for text node - the whole template data)
+    //! \return
+    //!
+    const QString &data() const { return _data; }
+
+    //!
+    //! \brief Get static text (view of the template data)
+    //! \return
+    //!
+    QStringView text() const { return QStringView(_data).mid(_textPos, _textSize); }
+
+    //!
+    //! \brief Get block body (content within control characters)
+    //! \return
+    //!
+    const QString &body() const { return _body; }
+
+    //!
+    //! \brief Get block start position
+    //! \return
+    //!
+    //! QPair<int, int>:
+    //! - first     - line number
+    //! - second    - position number in line
+    //!
+    const QPair<int, int> &startPos() const { return _startPos; }
+
+    //!
+    //! \brief Get compiled expression (base block)
+    //! \return
+    //!
+    const QtTIExpression &expression() const { return _expression; }
+
+    //!
+    //! \brief Get control block object pointer
+    //! \return
+    //!
+    const std::shared_ptr<QtTIAbstractControlBlock> &controlBlock() const { return _controlBlock; }
+
+private:
+    Type _type {Type::Text};                                            //!< node type
+    QString _data;                                                      //!< template data (text) or block data
+    int _textPos {0};                                                   //!< static text position in template data
+    int _textSize {0};                                                  //!< static text size
+    QString _body;                                                      //!< block body
+    QPair<int /*line*/, int /*pos*/> _startPos {-1, -1};                //!< block start position
+    QtTIExpression _expression;                                         //!< compiled expression
+    std::shared_ptr<QtTIAbstractControlBlock> _controlBlock {nullptr};  //!< control block object pointer
+};
+
+using QtTICompiledLine = QVector<QtTICompiledNode>;
+
+#endif // QTTICOMPILEDNODE_H
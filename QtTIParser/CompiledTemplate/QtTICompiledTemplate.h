@@ -0,0 +1,136 @@
+#ifndef QTTICOMPILEDTEMPLATE_H
+#define QTTICOMPILEDTEMPLATE_H
+
+#include <QString>
+#include <QList>
+#include <memory>
+
+#include "QtTICompiledNode.h"
+#include "../Scope/QtTIScope.h"
+
+//!
+//! \brief The QtTICompiledTemplate class
+//!
+//! Immutable result of template compilation: the template data split into lines of
+//! text segments, output expressions and control blocks. The object is created by
+//! QtTIParser::compile and can be rendered any number of times with QtTIParser::render,
+//! parsing and block classification are done only once.
+//!
+//! NOTE: The compiled template is bound to the parser that created it (control blocks
+//! keep a pointer to the parser), render it only with the same parser (interpreter).
+//!
+//! === Example:
+//!     QtTemplateInterpreter interpreter;
+//!     std::shared_ptr<const QtTICompiledTemplate> tmpl = interpreter.compileRes("Hello, {{ name }}!");
+//!     interpreter.appendHelpParam("name", "World");
+//!     QString res = interpreter.renderRes(tmpl);
+//!
+class QtTICompiledTemplate
+{
+    friend class QtTIParser;
+
+public:
+    QtTICompiledTemplate() = default;
+    ~QtTICompiledTemplate() = default;
+
+    //!
+    //! \brief Check compiled template is empty (no lines)
+    //! \return
+    //!
+    bool isEmpty() const { return _lines.isEmpty(); }
+
+    //!
+    //! \brief Get number of compiled lines
+    //! \return
+    //!
+    int lineCount() const { return _lines.size(); }
+
+    //!
+    //! \brief Get compiled lines
+    //! \return
+    //!
+    const QList<QtTICompiledLine> &lines() const { return _lines; }
+
+    //!
+    //! \brief Get template data (static text of the compiled lines refers to it)
+    //! \return
+    //!
+    const QString &source() const { return _source; }
+
+    //!
+    //! \brief Get variable slots of the template (NULL for the control block body)
+    //! \return
+    //!
+    const std::shared_ptr<const QtTIScope> &scope() const { return _scope; }
+
+    //!
+    //! \brief Get approximate memory size of compiled template (in bytes)
+    //! \return
+    //!
+    //! NOTE: The size includes the compiled expressions and the control blocks with their compiled bodies.
+    //!
+    qint64 memoryCost() const {
+        qint64 cost = _memoryCost;
+        for (const QtTICompiledLine &line : _lines) {
+            for (const QtTICompiledNode &node : line) {
+                if (node.type() == QtTICompiledNode::Type::Expression)
+                    cost += node.expression().memoryCost();
+                else if (node.type() == QtTICompiledNode::Type::ControlBlock && node.controlBlock())
+                    cost += node.controlBlock()->memoryCost();
+            }
+        }
+        return cost;
+    }
+
+private:
+    //!
+    //! \brief Set template data
+    //! \param source Template data
+    //!
+    void setSource(const QString &source) {
+        _memoryCost -= static_cast<qint64>(_source.size()) * static_cast<qint64>(sizeof(QChar));
+        _source = source;
+        _memoryCost += static_cast<qint64>(_source.size()) * static_cast<qint64>(sizeof(QChar));
+    }
+
+    //!
+    //! \brief Set variable slots of the template
+    //! \param scope Variable slots
+    //!
+    void setScope(const std::shared_ptr<const QtTIScope> &scope) {
+        _scope = scope;
+    }
+
+    //!
+    //! \brief Append compiled line
+    //! \param line Compiled line
+    //!
+    void appendLine(const QtTICompiledLine &line) {
+        _lines.append(line);
+        _memoryCost += static_cast<qint64>(sizeof(QtTICompiledLine));
+        for (const QtTICompiledNode &node : line) {
+            _memoryCost += static_cast<qint64>(sizeof(QtTICompiledNode));
+            // static text is shared with the template data
+            if (node.type() != QtTICompiledNode::Type::Text)
+                _memoryCost += static_cast<qint64>(node.data().size() + node.body().size()) * static_cast<qint64>(sizeof(QChar));
+        }
+    }
+
+    QString _source;                //!< template data
+    QList<QtTICompiledLine> _lines; //!< compiled lines
+    qint64 _memoryCost {0};         //!< approximate memory size of the lines and the template data
+    std::shared_ptr<const QtTIScope> _scope; //!< variable slots
+};
+
+//!
+//! \brief Get approximate memory size of compiled control block body (in bytes)
+//! \return
+//!
+qint64 QtTICompiledBlockBody::memoryCost() const
+{
+    if (!body)
+        return static_cast<qint64>(error.size()) * static_cast<qint64>(sizeof(QChar));
+    return body->memoryCost();
+}
+
+#endif // QTTICOMPILEDTEMPLATE_H
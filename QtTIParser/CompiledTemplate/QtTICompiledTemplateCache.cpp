@@ -0,0 +1,163 @@
+#include "QtTICompiledTemplateCache.h"
+
+#include <QMutexLocker>
+
+#include <limits>
+
+QtTICompiledTemplateCache::QtTICompiledTemplateCache(const int maxCost)
+    : _entries(maxCost)
+{}
+
+QtTICompiledTemplateCache::~QtTICompiledTemplateCache()
+{
+    _entries.clear();
+}
+
+//!
+//! \brief Get compiled template from cache
+//! \param path Canonical file path
+//! \param lastModified File modification time
+//! \param fileSize File size
+//! \return
+//!
+//! NOTE: If the file was changed (modification time or size differ), the entry is removed and NULL is returned.
+//!
+std::shared_ptr<const QtTICompiledTemplate> QtTICompiledTemplateCache::object(const QString &path,
+                                                                              const QDateTime &lastModified,
+                                                                              const qint64 fileSize)
+{
+    QMutexLocker locker(&_mutex);
+    const Entry *entry = _entries.object(path);
+    if (!entry) {
+        _misses++;
+        return nullptr;
+    }
+    if (entry->lastModified != lastModified
+        || entry->fileSize != fileSize) {
+        _entries.remove(path);
+        _misses++;
+        return nullptr;
+    }
+    _hits++;
+    return entry->compiledTemplate;
+}
+
+//!
+//! \brief Insert compiled template into cache
+//! \param path Canonical file path
+//! \param lastModified File modification time
+//! \param fileSize File size
+//! \param compiledTemplate Compiled template
+//! \return
+//!
+//! NOTE: Returns false if the template is larger than the cache limit (the template is not cached).
+//!
+bool QtTICompiledTemplateCache::insert(const QString &path,
+                                       const QDateTime &lastModified,
+                                       const qint64 fileSize,
+                                       const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate)
+{
+    if (path.isEmpty() || !compiledTemplate)
+        return false;
+
+    const qint64 cost = qMin(compiledTemplate->memoryCost(), static_cast<qint64>(std::numeric_limits<int>::max()));
+    Entry *entry = new Entry();
+    entry->compiledTemplate = compiledTemplate;
+    entry->lastModified = lastModified;
+    entry->fileSize = fileSize;
+
+    QMutexLocker locker(&_mutex);
+    return _entries.insert(path, entry, static_cast<int>(cost));
+}
+
+//!
+//! \brief Remove compiled template from cache
+//! \param path Canonical file path
+//! \return
+//!
+bool QtTICompiledTemplateCache::remove(const QString &path)
+{
+    QMutexLocker locker(&_mutex);
+    return _entries.remove(path);
+}
+
+//!
+//! \brief Remove all compiled templates from cache
+//!
+void QtTICompiledTemplateCache::clear()
+{
+    QMutexLocker locker(&_mutex);
+    _entries.clear();
+}
+
+//!
+//! \brief Get cache limit (approximate memory size in bytes)
+//! \return
+//!
+int QtTICompiledTemplateCache::maxCost() const
+{
+    QMutexLocker locker(&_mutex);
+    return _entries.maxCost();
+}
+
+//!
+//! \brief Set cache limit (approximate memory size in bytes)
+//! \param maxCost Cache limit
+//!
+//! NOTE: If the current size is larger than the new limit, the least recently used templates are evicted.
+//!
+void QtTICompiledTemplateCache::setMaxCost(const int maxCost)
+{
+    QMutexLocker locker(&_mutex);
+    _entries.setMaxCost(maxCost);
+}
+
+//!
+//! \brief Get current cache size (approximate memory size in bytes)
+//! \return
+//!
+int QtTICompiledTemplateCache::totalCost() const
+{
+    QMutexLocker locker(&_mutex);
+    return _entries.totalCost();
+}
+
+//!
+//! \brief Get number of cached templates
+//! \return
+//!
+int QtTICompiledTemplateCache::count() const
+{
+    QMutexLocker locker(&_mutex);
+    return _entries.count();
+}
+
+//!
+//! \brief Get number of cache hits
+//! \return
+//!
+quint64 QtTICompiledTemplateCache::hits() const
+{
+    QMutexLocker locker(&_mutex);
+    return _hits;
+}
+
+//!
+//! \brief Get number of cache misses (including invalidated entries)
+//! \return
+//!
+quint64 QtTICompiledTemplateCache::misses() const
+{
+    QMutexLocker locker(&_mutex);
+    return _misses;
+}
+
+//!
+//! \brief Reset hit/miss counters
+//!
+void QtTICompiledTemplateCache::resetStatistics()
+{
+    QMutexLocker locker(&_mutex);
+    _hits = 0;
+    _misses = 0;
+}
@@ -0,0 +1,73 @@
+#ifndef QTTICOMPILEDTEMPLATECACHE_H
+#define QTTICOMPILEDTEMPLATECACHE_H
+
+#include <QString>
+#include <QDateTime>
+#include <QCache>
+#include <QMutex>
+#include <memory>
+
+#include "QtTICompiledTemplate.h"
+
+#define QTTI_TEMPLATE_CACHE_DEFAULT_MAX_COST (32 * 1024 * 1024)
+
+//!
+//! \brief The QtTICompiledTemplateCache class
+//!
+//! Cache of compiled templates keyed by canonical file path. An entry is valid while
+//! the modification time and the size of the file are unchanged. The cache is limited
+//! by the approximate memory size of the compiled templates (in bytes), the least
+//! recently used templates are evicted first.
+//!
+//! NOTE: The cache is thread-safe (the interpreter is shared by the render threads),
+//!       all methods are called under the cache mutex.
+//!
+//! === Example:
+//!     QtTemplateInterpreter ti;
+//!     ti.templateCache()->setMaxCost(8 * 1024 * 1024);
+//!     ti.interpretResFromFile("/path/to/template.txt"); // miss: read and compile
+//!     ti.interpretResFromFile("/path/to/template.txt"); // hit: only render
+//!     qDebug() << ti.templateCache()->hits() << ti.templateCache()->misses();
+//!
+class QtTICompiledTemplateCache
+{
+public:
+    explicit QtTICompiledTemplateCache(const int maxCost = QTTI_TEMPLATE_CACHE_DEFAULT_MAX_COST);
+    ~QtTICompiledTemplateCache();
+
+    std::shared_ptr<const QtTICompiledTemplate> object(const QString &path,
+                                                       const QDateTime &lastModified,
+                                                       const qint64 fileSize);
+    bool insert(const QString &path,
+                const QDateTime &lastModified,
+                const qint64 fileSize,
+                const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate);
+    bool remove(const QString &path);
+    void clear();
+
+    int maxCost() const;
+    void setMaxCost(const int maxCost);
+    int totalCost() const;
+    int count() const;
+
+    quint64 hits() const;
+    quint64 misses() const;
+    void resetStatistics();
+
+private:
+    //!
+    //! \brief Cache entry
+    //!
+    struct Entry {
+        std::shared_ptr<const QtTICompiledTemplate> compiledTemplate;   //!< compiled template
+        QDateTime lastModified;                                         //!< file modification time
+        qint64 fileSize {-1};                                           //!< file size
+    };
+
+    QCache<QString, Entry> _entries;    //!< entries by canonical file path
+    quint64 _hits {0};                  //!< number of cache hits
+    quint64 _misses {0};                //!< number of cache misses
+    mutable QMutex _mutex;              //!< cache mutex
+};
+
+#endif // QTTICOMPILEDTEMPLATECACHE_H
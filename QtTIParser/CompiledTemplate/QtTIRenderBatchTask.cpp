@@ -0,0 +1,74 @@
+#include "QtTIRenderBatchTask.h"
+#include "QtTIRenderWriter.h"
+#include "../QtTIParser.h"
+#include "../QtTIRenderContext.h"
+
+QtTIRenderBatchTask::QtTIRenderBatchTask(QtTIParser *parser,
+                                         const QtTICompiledTemplate *compiledTemplate,
+                                         QtTIRenderContext *contexts,
+                                         Result *results,
+                                         const int count,
+                                         QAtomicInt *nextIndex,
+                                         QSemaphore *done)
+    : QRunnable()
+    , _parser(parser)
+    , _compiledTemplate(compiledTemplate)
+    , _contexts(contexts)
+    , _results(results)
+    , _count(count)
+    , _nextIndex(nextIndex)
+    , _done(done)
+{
+    setAutoDelete(false);
+}
+
+QtTIRenderBatchTask::QtTIRenderBatchTask(QtTIParser *parser,
+                                         const QtTIProgram *program,
+                                         QtTIRenderContext *contexts,
+                                         Result *results,
+                                         const int count,
+                                         QAtomicInt *nextIndex,
+                                         QSemaphore *done)
+    : QRunnable()
+    , _parser(parser)
+    , _program(program)
+    , _contexts(contexts)
+    , _results(results)
+    , _count(count)
+    , _nextIndex(nextIndex)
+    , _done(done)
+{
+    setAutoDelete(false);
+}
+
+QtTIRenderBatchTask::~QtTIRenderBatchTask()
+{
+    _parser = nullptr;
+    _compiledTemplate = nullptr;
+    _program = nullptr;
+    _contexts = nullptr;
+    _results = nullptr;
+    _nextIndex = nullptr;
+    _done = nullptr;
+}
+
+//!
+//! \brief Render contexts until the batch is finished
+//!
+void QtTIRenderBatchTask::run()
+{
+    for (int i = _nextIndex->fetchAndAddRelaxed(1); i < _count; i = _nextIndex->fetchAndAddRelaxed(1)) {
+        QtTIRenderWriter writer;
+        bool isOk = false;
+        QString error;
+        if (_compiledTemplate)
+            std::tie(isOk, error) = _parser->render(*_compiledTemplate, _contexts[i], writer);
+        else
+            std::tie(isOk, error) = _parser->render(*_program, _contexts[i], writer);
+        if (isOk)
+            _results[i] = std::make_tuple(true, writer.result(), "");
+        else
+            _results[i] = std::make_tuple(false, "", error);
+    }
+    _done->release();
+}
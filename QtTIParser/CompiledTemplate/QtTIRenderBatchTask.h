@@ -0,0 +1,61 @@
+#ifndef QTTIRENDERBATCHTASK_H
+#define QTTIRENDERBATCHTASK_H
+
+#include <QString>
+#include <QRunnable>
+#include <QAtomicInt>
+#include <QSemaphore>
+#include <tuple>
+
+#include "QtTICompiledTemplate.h"
+
+class QtTIParser;
+class QtTIRenderContext;
+class QtTIProgram;
+
+//!
+//! \brief The QtTIRenderBatchTask class
+//!
+//! Worker of the batch render (see QtTemplateInterpreter::renderBatch). All workers of one
+//! batch share the index of the next context: each worker takes the next not rendered
+//! context until the batch is finished, so a slow record does not hold up the others.
+//! The result of the context is stored at the same index (the input order is kept).
+//! The task renders either the compiled template or the program (see QtTemplateInterpreter::compileProgram).
+//!
+//! NOTE: The task does not own any of the passed objects and releases 'done' once at the end of 'run'.
+//!
+class QtTIRenderBatchTask : public QRunnable
+{
+public:
+    using Result = std::tuple<bool/*isOk*/,QString/*result*/,QString/*error*/>;
+
+    QtTIRenderBatchTask(QtTIParser *parser,
+                        const QtTICompiledTemplate *compiledTemplate,
+                        QtTIRenderContext *contexts,
+                        Result *results,
+                        const int count,
+                        QAtomicInt *nextIndex,
+                        QSemaphore *done);
+    QtTIRenderBatchTask(QtTIParser *parser,
+                        const QtTIProgram *program,
+                        QtTIRenderContext *contexts,
+                        Result *results,
+                        const int count,
+                        QAtomicInt *nextIndex,
+                        QSemaphore *done);
+    ~QtTIRenderBatchTask();
+
+    void run() final;
+
+private:
+    QtTIParser *_parser {nullptr};                          //!< parser pointer
+    const QtTICompiledTemplate *_compiledTemplate {nullptr};//!< compiled template pointer
+    const QtTIProgram *_program {nullptr};                  //!< program pointer (if the compiled template is NULL)
+    QtTIRenderContext *_contexts {nullptr};                 //!< render contexts array
+    Result *_results {nullptr};                             //!< results array
+    int _count {0};                                         //!< size of contexts and results arrays
+    QAtomicInt *_nextIndex {nullptr};                       //!< index of the next context
+    QSemaphore *_done {nullptr};                            //!< finished tasks counter
+};
+
+#endif // QTTIRENDERBATCHTASK_H
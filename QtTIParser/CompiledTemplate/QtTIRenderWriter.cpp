@@ -0,0 +1,222 @@
+#include "QtTIRenderWriter.h"
+
+QtTIRenderWriter::QtTIRenderWriter()
+{}
+
+QtTIRenderWriter::QtTIRenderWriter(QIODevice *device, const int flushThreshold)
+    : _device(device)
+    , _flushThreshold(flushThreshold)
+{
+    if (_flushThreshold > 0)
+        _buffer.reserve(_flushThreshold);
+}
+
+QtTIRenderWriter::QtTIRenderWriter(const Sink &sink, const int flushThreshold)
+    : _sink(sink)
+    , _flushThreshold(flushThreshold)
+{
+    if (_flushThreshold > 0)
+        _buffer.reserve(_flushThreshold);
+}
+
+QtTIRenderWriter::~QtTIRenderWriter()
+{
+    _device = nullptr;
+}
+
+//!
+//! \brief Write data
+//! \param data Data
+//!
+void QtTIRenderWriter::write(QStringView data)
+{
+    if (data.isEmpty())
+        return;
+
+    int last = static_cast<int>(data.size()) - 1;
+    while (last >= 0 && data[last].isSpace())
+        last--;
+    // only blank characters
+    if (last < 0) {
+        _pending.append(data.data(), static_cast<int>(data.size()));
+        return;
+    }
+
+    if (!_pending.isEmpty()) {
+        _buffer += _pending;
+        _pending.clear();
+    }
+    _buffer.append(data.data(), last + 1);
+    _lastChar = data[last];
+    if (last + 1 < data.size())
+        _pending.append(data.data() + last + 1, static_cast<int>(data.size()) - last - 1);
+
+    if (_flushThreshold > 0
+        && _buffer.size() >= _flushThreshold)
+        flushBuffer();
+}
+
+//!
+//! \brief Write data
+//! \param data Data
+//!
+void QtTIRenderWriter::write(const QString &data)
+{
+    write(QStringView(data));
+}
+
+//!
+//! \brief Write character
+//! \param ch Character
+//!
+void QtTIRenderWriter::write(const QChar &ch)
+{
+    write(QStringView(&ch, 1));
+}
+
+//!
+//! \brief Get size of written data (logical position of the end of data)
+//! \return
+//!
+qint64 QtTIRenderWriter::size() const
+{
+    return _flushed + _buffer.size() + _pending.size();
+}
+
+//!
+//! \brief Check nothing was written after position
+//! \param pos Logical position
+//! \return
+//!
+bool QtTIRenderWriter::isEmptyAfter(const qint64 pos) const
+{
+    return (size() <= pos);
+}
+
+//!
+//! \brief Check not blank data was written after position
+//! \param pos Logical position
+//! \return
+//!
+bool QtTIRenderWriter::hasDataAfter(const qint64 pos) const
+{
+    return (_flushed + _buffer.size() > pos);
+}
+
+//!
+//! \brief Get last written character
+//! \return
+//!
+QChar QtTIRenderWriter::lastChar() const
+{
+    if (!_pending.isEmpty())
+        return _pending[_pending.size() - 1];
+    return _lastChar;
+}
+
+//!
+//! \brief Trim the data written after position on the right
+//! \param pos Logical position
+//!
+void QtTIRenderWriter::rstrip(const qint64 pos)
+{
+    const qint64 dataEnd = _flushed + _buffer.size();
+    if (pos <= dataEnd)
+        _pending.clear();
+    else if (pos - dataEnd < _pending.size())
+        _pending.truncate(static_cast<int>(pos - dataEnd));
+}
+
+//!
+//! \brief Move the trailing blank characters written before position to the buffer
+//! \param pos Logical position (the data before it will not be trimmed)
+//!
+void QtTIRenderWriter::commit(const qint64 pos)
+{
+    const qint64 dataEnd = _flushed + _buffer.size();
+    if (_pending.isEmpty() || pos <= dataEnd)
+        return;
+
+    const int count = static_cast<int>(qMin<qint64>(pos - dataEnd, _pending.size()));
+    _buffer.append(_pending.constData(), count);
+    _lastChar = _pending[count - 1];
+    _pending.remove(0, count);
+
+    if (_flushThreshold > 0
+        && _buffer.size() >= _flushThreshold)
+        flushBuffer();
+}
+
+//!
+//! \brief Pass buffered data to the sink (trailing blank characters are kept)
+//! \return
+//!
+bool QtTIRenderWriter::flush()
+{
+    if (!_device && !_sink)
+        return !hasError();
+    return flushBuffer();
+}
+
+//!
+//! \brief Pass all data to the sink (call it after rendering)
+//! \return
+//!
+bool QtTIRenderWriter::finish()
+{
+    if (!_pending.isEmpty()) {
+        _buffer += _pending;
+        _pending.clear();
+    }
+    return flush();
+}
+
+//!
+//! \brief Get collected data (if the writer has no sink)
+//! \return
+//!
+QString QtTIRenderWriter::result() const
+{
+    return _buffer + _pending;
+}
+
+//!
+//! \brief Check has write error
+//! \return
+//!
+bool QtTIRenderWriter::hasError() const
+{
+    return !_error.isEmpty();
+}
+
+//!
+//! \brief Get write error
+//! \return
+//!
+QString QtTIRenderWriter::errorString() const
+{
+    return _error;
+}
+
+//!
+//! \brief Pass buffer to the sink
+//! \return
+//!
+bool QtTIRenderWriter::flushBuffer()
+{
+    if (_buffer.isEmpty())
+        return !hasError();
+
+    if (_device) {
+        const QByteArray data = _buffer.toUtf8();
+        if (_device->write(data) != data.size()) {
+            if (_error.isEmpty())
+                _error = QString("Write to device failed: %1").arg(_device->errorString());
+        }
+    } else if (_sink) {
+        _sink(QStringView(_buffer));
+    }
+    _flushed += _buffer.size();
+    _buffer.resize(0);
+    return !hasError();
+}
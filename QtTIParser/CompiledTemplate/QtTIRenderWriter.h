@@ -0,0 +1,81 @@
+#ifndef QTTIRENDERWRITER_H
+#define QTTIRENDERWRITER_H
+
+#include <QString>
+#include <QStringView>
+#include <QIODevice>
+#include <functional>
+
+#define QTTI_RENDER_WRITER_DEFAULT_FLUSH_THRESHOLD (16 * 1024)
+
+//!
+//! \brief The QtTIRenderWriter class
+//!
+//! Output of template rendering. The rendered data is collected in a buffer and passed
+//! to the sink (QIODevice or callback) in chunks when the buffer size reaches the flush
+//! threshold, so the memory used does not depend on the size of the output.
+//!
+//! Trailing blank characters are kept until the next not blank character is written,
+//! because the interpreter can trim them (see QtTIAbstractParser::rstrip). Positions
+//! passed to 'rstrip' and 'hasDataAfter' are logical positions returned by 'size'.
+//! The blank characters before the position passed to 'commit' can't be trimmed anymore,
+//! they are buffered and flushed as other data.
+//!
+//! Without a sink the writer only collects the data (see 'result').
+//!
+//! === Example 1:
+//!     QFile f("out.csv");
+//!     f.open(QIODevice::WriteOnly);
+//!     QtTIRenderWriter writer(&f, 64 * 1024);
+//!
+//! === Example 2:
+//!     QtTIRenderWriter writer([](QStringView chunk) {
+//!         std::cout << chunk.toUtf8().constData();
+//!     });
+//!
+class QtTIRenderWriter
+{
+public:
+    using Sink = std::function<void(QStringView)>;
+
+    QtTIRenderWriter();
+    explicit QtTIRenderWriter(QIODevice *device, const int flushThreshold = QTTI_RENDER_WRITER_DEFAULT_FLUSH_THRESHOLD);
+    explicit QtTIRenderWriter(const Sink &sink, const int flushThreshold = QTTI_RENDER_WRITER_DEFAULT_FLUSH_THRESHOLD);
+    ~QtTIRenderWriter();
+
+    QtTIRenderWriter(const QtTIRenderWriter &) = delete;
+    QtTIRenderWriter &operator=(const QtTIRenderWriter &) = delete;
+
+    void write(QStringView data);
+    void write(const QString &data);
+    void write(const QChar &ch);
+
+    qint64 size() const;
+    bool isEmptyAfter(const qint64 pos) const;
+    bool hasDataAfter(const qint64 pos) const;
+    QChar lastChar() const;
+    void rstrip(const qint64 pos);
+    void commit(const qint64 pos);
+
+    bool flush();
+    bool finish();
+
+    QString result() const;
+    bool hasError() const;
+    QString errorString() const;
+
+private:
+    bool flushBuffer();
+
+    QIODevice *_device {nullptr};   //!< output device
+    Sink _sink {nullptr};           //!< output callback
+    int _flushThreshold {-1};       //!< buffer size for flush (-1: do not flush)
+
+    QString _buffer;                //!< data not passed to the sink
+    QString _pending;               //!< trailing blank characters
+    qint64 _flushed {0};            //!< size of data passed to the sink
+    QChar _lastChar;                //!< last character of the buffer
+    QString _error;                 //!< write error
+};
+
+#endif // QTTIRENDERWRITER_H
@@ -3,16 +3,29 @@
 
 #include <QString>
 #include <QList>
-#include <QTextStream>
+#include <QStringList>
 #include <QMap>
+#include <memory>
 #include "../../Abstract/QtTIAbstractParser.h"
-#include "../../TernaryOperator/QtTIParserTernaryOperator.h"
-#include "../../NullCoalescingOperator/QtTIParserNullCoalescingOperator.h"
-#include "../../Logic/QtTIParserLogic.h"
-#include "../../Math/QtTIParserMath.h"
-#include "../../../QtTIDefines/QtTIRegExpDefines.h"
+#include "../../RegExpRegistry/QtTIRegExpRegistry.h"
 #include "../../../QtTIHelperFunction/QtTIHelperFunction.h"
 
+class QtTIProgramCompiler;
+
+//!
+//! \brief The QtTICompiledBlockBody struct
+//!
+//! Control block body compiled once when the block is closed (see QtTIAbstractControlBlock::compileBlock).
+//! If the body is not compiled, the error is returned when the body is executed.
+//!
+struct QtTICompiledBlockBody
+{
+    std::shared_ptr<QtTICompiledTemplate> body {nullptr};   //!< compiled body
+    QString error;                                          //!< compile error
+
+    inline qint64 memoryCost() const;   // see QtTICompiledTemplate.h
+};
+
 //!
 //! \brief The QtTIAbstractControlBlock class
 //!
@@ -81,9 +94,42 @@ public:
 
     //!
     //! \brief Execute control block
+    //! \param parserArgs Render args (variables of the current render)
+    //! \param writer Render output
+    //! \return
+    //!
+    virtual std::tuple<bool/*isOk*/,QString/*err*/> evalBlock(QtTIAbstractParserArgs *parserArgs, QtTIRenderWriter &writer) = 0;
+
+    //!
+    //! \brief Compile control block
+    //!
+    //! NOTE: This method is called once when the block is closed (the block body is complete).
+    //!
+    virtual void compileBlock() {}
+
+    //!
+    //! \brief Compile control block to the program instructions (see QtTIProgramCompiler)
+    //! \param compiler Program compiler
+    //! \return false - the block is not compiled (the block is executed by 'evalBlock')
+    //!
+    //! NOTE: This method is called after 'compileBlock', the instructions must have the same
+    //!       result and the same errors as 'evalBlock'.
+    //!
+    virtual bool compileProgram(QtTIProgramCompiler &compiler) const {
+        Q_UNUSED(compiler)
+        return false;
+    }
+
+    //!
+    //! \brief Get approximate memory size of control block (in bytes)
     //! \return
     //!
-    virtual std::tuple<bool/*isOk*/,QString/*res*/,QString/*err*/> evalBlock() = 0;
+    //! NOTE: The size includes the block data, the compiled expressions and the compiled bodies
+    //!       (see QtTICompiledTemplate::memoryCost).
+    //!
+    virtual qint64 memoryCost() const {
+        return static_cast<qint64>(sizeof(QtTIAbstractControlBlock));
+    }
 
     //!
     //! \brief Check is intermediate part of control block
@@ -144,103 +190,114 @@ protected:
     }
 
     //!
-    //! \brief Build control block body
+    //! \brief Get approximate memory size of string (in bytes)
+    //! \param str String
+    //! \return
+    //!
+    static qint64 stringCost(const QString &str)
+    {
+        return static_cast<qint64>(str.size()) * static_cast<qint64>(sizeof(QChar));
+    }
+
+    //!
+    //! \brief Get approximate memory size of control block body data (in bytes)
     //! \param data Control block body
     //! \return
     //!
-    //! NOTE: This method calculates line numbers from the line number of the beginning of the block.
+    static qint64 bodyCost(const QMap<int/*lineNum*/,QString/*lineData*/> &data)
+    {
+        qint64 cost = 0;
+        for (const QString &line : data)
+            cost += static_cast<qint64>(sizeof(int)) + stringCost(line);
+        return cost;
+    }
+
+    //!
+    //! \brief Compile control block body
+    //! \param data Control block body
+    //! \return
     //!
-    std::tuple<bool/*isOk*/,QString/*res*/,QString/*err*/> buildBlockBody(QString data)
+    QtTICompiledBlockBody compileBlockBody(const QMap<int/*lineNum*/,QString/*lineData*/> &data)
     {
-        QTextStream in(&data);
-        QtTIAbstractParserBlock *block = nullptr;
-        int lineNum = _lineNum - 1;
-        QString tmpData;
-        while (!in.atEnd()) {
-            if (!tmpData.isEmpty()
-                && tmpData[tmpData.size() - 1] != '\n')
-                tmpData += "\r\n";
-
-            lineNum++;
-            QString line = in.readLine();
-
-            // parse
-            bool isOk = false;
-            QString error;
-            std::tie(isOk, line, error) = _parser->parseLine(line, lineNum, block);
-            if (!isOk) {
-                if (block)
-                    delete block;
-                return std::make_tuple(false, "", error);
-            }
-            tmpData += line;
-        }
-        // check block
-        if (block && block->isUnfinished()) {
-            QString error = QString("Unfinished block in line %1!").arg(block->startPos().first);
-            delete block;
-            return std::make_tuple(false, "", error);
-        }
-        if (block)
-            delete block;
-        return std::make_tuple(true, tmpData, "");
+        QtTICompiledBlockBody result;
+        bool isOk = false;
+        std::tie(isOk, result.body, result.error) = _parser->compileBlockBody(data, _lineNum);
+        if (!isOk)
+            result.body = nullptr;
+        return result;
     }
 
     //!
     //! \brief Build control block body
-    //! \param data Control block body
+    //! \param body Compiled control block body
+    //! \param parserArgs Render args
+    //! \param writer Render output
     //! \return
     //!
-    std::tuple<bool/*isOk*/,QString/*res*/,QString/*err*/> buildBlockBody(const QMap<int/*lineNum*/,QString/*lineData*/> &data)
+    std::tuple<bool/*isOk*/,QString/*err*/> buildBlockBody(const QtTICompiledBlockBody &body,
+                                                           QtTIAbstractParserArgs *parserArgs,
+                                                           QtTIRenderWriter &writer)
     {
-        QtTIAbstractParserBlock *block = nullptr;
-        QString tmpData;
-        QMapIterator<int,QString> it(data);
-        while (it.hasNext()) {
-            it.next();
-            if (!tmpData.isEmpty()
-                && tmpData[tmpData.size() - 1] != '\n')
-                tmpData += "\r\n";
-
-            QString line = it.value();
-            if (it.key() == lineNum())
-                line = QtTIAbstractParser::lstrip(line); // trim left
-
-            // parse
-            bool isOk = false;
-            QString error;
-            std::tie(isOk, line, error) = _parser->parseLine(line, it.key(), block);
-            if (!isOk) {
-                if (block)
-                    delete block;
-                return std::make_tuple(false, "", error);
-            }
-            tmpData += line;
-        }
-        // check block
-        if (block && block->isUnfinished()) {
-            QString error = QString("Unfinished block in line %1!").arg(block->startPos().first);
-            delete block;
-            return std::make_tuple(false, "", error);
-        }
-        if (block)
-            delete block;
-        return std::make_tuple(true, tmpData, "");
+        if (!body.body)
+            return std::make_tuple(false, body.error);
+        return _parser->renderBlockBody(*body.body, parserArgs, writer);
     }
 
     //!
     //! \brief Parse parameter value from string
     //! \param str Parameter value string view
+    //! \param parserArgs Render args
     //! \return
     //!
     std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> parseParamValue(const QString &str,
                                                                             const int lineNum,
-                                                                            const int linePos)
+                                                                            const int linePos,
+                                                                            QtTIAbstractParserArgs *parserArgs)
     {
         if (str.isEmpty())
             return std::make_tuple(false, QVariant(), "Parse value failed (empty string passed)");
 
-        return _parser->parseAndExecBlockData(str, {lineNum, linePos});
+        return _parser->parseAndExecBlockData(str, {lineNum, linePos}, parserArgs);
+    }
+
+    //!
+    //! \brief Evaluate compiled parameter value expression
+    //! \param expr Compiled expression
+    //! \param parserArgs Render args
+    //! \return
+    //!
+    std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> parseParamValue(const QtTIExpression &expr,
+                                                                            const int lineNum,
+                                                                            const int linePos,
+                                                                            QtTIAbstractParserArgs *parserArgs)
+    {
+        if (expr.isEmpty())
+            return std::make_tuple(false, QVariant(), "Parse value failed (empty string passed)");
+
+        return _parser->execExpression(expr, {lineNum, linePos}, parserArgs);
+    }
+
+    //!
+    //! \brief Get all control block conditions from data
+    //! \param data Input string data
+    //! \return Trimmed conditions
+    //!
+    QStringList blockConditions(const QString &data) const
+    {
+        QStringList result;
+        if (!data.contains(QLatin1String("{%")))
+            return result;
+
+        int index = 0;
+        while (index < data.size()) {
+            QString condAll, cond;
+            std::tie(condAll, cond, index) = parseBlockCondition(data, index);
+            if (index == -1)
+                break;
+            index += condAll.size();
+            result.append(cond.trimmed());
+        }
+        return result;
     }
 
     //!
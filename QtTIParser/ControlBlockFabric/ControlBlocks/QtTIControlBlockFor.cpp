@@ -1,4 +1,5 @@
 #include "QtTIControlBlockFor.h"
+#include "../../Program/QtTIProgramCompiler.h"
 
 #include <QList>
 #include <QMap>
@@ -14,7 +15,17 @@ QtTIControlBlockFor::QtTIControlBlockFor(QtTIAbstractParser *parser,
                                          const int linePos)
     : QtTIAbstractControlBlock(parser, lineNum, linePos)
     , _blockCond(blockCond)
-{}
+{
+    const QRegularExpressionMatch m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockForStart, _blockCond);
+    if (m.hasMatch()) {
+        const QStringList paramNames = m.captured(2).trimmed().split(",");
+        for (const QString &paramName : paramNames) {
+            _paramNames.append(paramName.trimmed());
+            _paramSlots.append(parser->variableSlot(_paramNames.last()));
+        }
+        _containerExpr = parser->compileExpression(m.captured(3));
+    }
+}
 
 QtTIControlBlockFor::~QtTIControlBlockFor()
 {}
@@ -48,8 +59,7 @@ QString QtTIControlBlockFor::blockCondition() const
 //!
 bool QtTIControlBlockFor::isBlockCondStart(const QString &blockCond)
 {
-    QRegExp rx(RX_CONTROL_BLOCK_FOR_START);
-    return (rx.indexIn(blockCond) != -1);
+    return QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockForStart, blockCond).hasMatch();
 }
 
 //!
@@ -59,9 +69,7 @@ bool QtTIControlBlockFor::isBlockCondStart(const QString &blockCond)
 //!
 bool QtTIControlBlockFor::isBlockCondEnd(const QString &blockCond)
 {
-//    QRegExp rx("^(endfor)$");
-    QRegExp rx(RX_CONTROL_BLOCK_FOR_END);
-    if (rx.indexIn(blockCond) != -1)
+    if (QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockForEnd, blockCond).hasMatch())
         return isIndoorBlockComplete();
     return false;
 }
@@ -73,6 +81,7 @@ bool QtTIControlBlockFor::isBlockCondEnd(const QString &blockCond)
 void QtTIControlBlockFor::appendBlockBody(const QString &blockBody, const int lineNum)
 {
     _blockBody[lineNum].append(blockBody);
+    updateIndoorBlockDepth(blockBody);
 }
 
 //!
@@ -95,42 +104,96 @@ QString QtTIControlBlockFor::blockBody(const int lineNum) const
     return _blockBody[lineNum];
 }
 
+//!
+//! \brief Compile control block
+//!
+//! NOTE: The loop body is compiled once and executed for each element of the container.
+//!
+void QtTIControlBlockFor::compileBlock()
+{
+    _compiledBody = compileBlockBody(_blockBody);
+}
+
 //!
 //! \brief Execute control block
+//! \param parserArgs Render args
+//! \param writer Render output
 //! \return
 //!
-std::tuple<bool, QString, QString> QtTIControlBlockFor::evalBlock()
+std::tuple<bool, QString> QtTIControlBlockFor::evalBlock(QtTIAbstractParserArgs *parserArgs, QtTIRenderWriter &writer)
 {
-    QRegExp rx(RX_CONTROL_BLOCK_FOR_START);
-    if (rx.indexIn(_blockCond) != -1) {
-        const QStringList paramNames = rx.cap(2).trimmed().split(",");
-
-        bool isOk = false;
-        QVariant paramValue;
-        QString error;
-        std::tie(isOk, paramValue, error) = parseParamValue(rx.cap(3).trimmed(), lineNum(), linePos());
-        if (!isOk)
-            return std::make_tuple(false, "", error);
-        if (paramNames.isEmpty())
-            return std::make_tuple(false, "", QString("Invalid parameter names (empty) in block 'for ...' in line %1").arg(lineNum()));
-        if (paramNames.size() > 2)
-            return std::make_tuple(false, "", QString("Invalid parameter names (max two values) in block 'for ...' in line %1").arg(lineNum()));
-        if (paramValue.isNull())
-            return std::make_tuple(false, "", QString("Invalid parameter container (Null) in block 'for ...' in line %1").arg(lineNum()));
-        if (!paramValue.canConvert<QVariantList>()
-            && !paramValue.canConvert<QVariantMap>()
-            && !paramValue.canConvert<QVariantHash>())
-            return std::make_tuple(false, "", QString("Invalid container type '%1' (not List/Map/Hash) in block 'for ...' in line %2").arg(paramValue.typeName()).arg(lineNum()));
-        if (paramValue.canConvert<QVariantList>()
-            && paramNames.size() != 1)
-            return std::make_tuple(false, "", QString("Too many parameters for type List in block 'for ...' in line %1").arg(lineNum()));
-        for (const QString &arg : paramNames) {
-            if (parser()->parserArgs()->hasParam(arg))
-                return std::make_tuple(false, "", QString("Parameter with name '%1' in block 'for ...' in line %2 already declared in the global parameter list").arg(arg).arg(lineNum()));
-        }
-        return evalFor(paramNames, paramValue);
+    if (_paramNames.isEmpty())
+        return std::make_tuple(false, QString("Unsupported block condition '%1' in line %2").arg(_blockCond).arg(lineNum()));
+
+    bool isOk = false;
+    QVariant paramValue;
+    QString error;
+    std::tie(isOk, paramValue, error) = parseParamValue(_containerExpr, lineNum(), linePos(), parserArgs);
+    if (!isOk)
+        return std::make_tuple(false, error);
+    if (_paramNames.size() > 2)
+        return std::make_tuple(false, QString("Invalid parameter names (max two values) in block 'for ...' in line %1").arg(lineNum()));
+    if (paramValue.isNull())
+        return std::make_tuple(false, QString("Invalid parameter container (Null) in block 'for ...' in line %1").arg(lineNum()));
+    if (!paramValue.canConvert<QVariantList>()
+        && !paramValue.canConvert<QVariantMap>()
+        && !paramValue.canConvert<QVariantHash>())
+        return std::make_tuple(false, QString("Invalid container type '%1' (not List/Map/Hash) in block 'for ...' in line %2").arg(paramValue.typeName()).arg(lineNum()));
+    if (paramValue.canConvert<QVariantList>()
+        && _paramNames.size() != 1)
+        return std::make_tuple(false, QString("Too many parameters for type List in block 'for ...' in line %1").arg(lineNum()));
+    for (const QString &arg : _paramNames) {
+        if (parserArgs->hasParam(arg))
+            return std::make_tuple(false, QString("Parameter with name '%1' in block 'for ...' in line %2 already declared in the global parameter list").arg(arg).arg(lineNum()));
+    }
+    return evalFor(_paramNames, paramValue, parserArgs, writer);
+}
+
+//!
+//! \brief Get approximate memory size of control block (in bytes)
+//! \return
+//!
+qint64 QtTIControlBlockFor::memoryCost() const
+{
+    qint64 cost = static_cast<qint64>(sizeof(QtTIControlBlockFor))
+                  + stringCost(_blockCond)
+                  + bodyCost(_blockBody)
+                  + _containerExpr.memoryCost()
+                  + _compiledBody.memoryCost();
+    for (const QString &paramName : _paramNames)
+        cost += stringCost(paramName);
+    return cost;
+}
+
+//!
+//! \brief Compile control block to the program instructions
+//! \param compiler Program compiler
+//! \return
+//!
+bool QtTIControlBlockFor::compileProgram(QtTIProgramCompiler &compiler) const
+{
+    if (_paramNames.isEmpty()) {
+        compiler.emitError(QString("Unsupported block condition '%1' in line %2").arg(_blockCond).arg(lineNum()));
+        return true;
+    }
+
+    if (_containerExpr.isEmpty()) {
+        compiler.emitError("Parse value failed (empty string passed)");
+        return true;
     }
-    return std::make_tuple(false, "", QString("Unsupported block condition '%1' in line %2").arg(_blockCond).arg(lineNum()));
+
+    QtTIProgramLoop loop;
+    loop.paramNames = _paramNames;
+    loop.paramSlots = _paramSlots;
+    loop.lineNum = lineNum();
+    const int loopIndex = compiler.appendLoop(loop);
+    const int expr = compiler.emitExpression(_containerExpr, true, lineNum(), linePos());
+    compiler.emit(QtTIInstruction::Opcode::ForBegin, loopIndex, expr);
+    const int loopStart = compiler.emit(QtTIInstruction::Opcode::ForNext, 0, loopIndex);
+    compiler.emitLoopBody(loopIndex, _compiledBody);
+    compiler.emit(QtTIInstruction::Opcode::Jump, loopStart);
+    compiler.patchJump(loopStart);
+    return true;
 }
 
 //!
@@ -139,146 +202,156 @@ std::tuple<bool, QString, QString> QtTIControlBlockFor::evalBlock()
 //!
 bool QtTIControlBlockFor::isIndoorBlockComplete() const
 {
-    QRegExp rxStart(RX_CONTROL_BLOCK_FOR_START);
-    QRegExp rxEnd(RX_CONTROL_BLOCK_FOR_END);
-    int openForBlocks = 0;
-    QMapIterator<int,QString> it(_blockBody);
-    while (it.hasNext()) {
-        it.next();
-        const QString bodyData = it.value();
-        int index = 0;
-        while (index < bodyData.size()) {
-            QString condAll, cond;
-            std::tie(condAll, cond, index) = parseBlockCondition(bodyData, index);
-            if (index == -1)
-                break;
-            index += condAll.size();
-            cond = cond.trimmed();
-            // find start block
-            if (rxStart.indexIn(cond) != -1)
-                openForBlocks++;
-            // find end block
-            if (rxEnd.indexIn(cond) != -1)
-                openForBlocks--;
-        }
+    return (_indoorBlockDepth == 0);
+}
+
+//!
+//! \brief Update the nesting depth of internal FOR blocks by the appended body data
+//! \param blockBody Appended control block body
+//!
+//! NOTE: Each part of the body is scanned once, when it is appended.
+//!
+void QtTIControlBlockFor::updateIndoorBlockDepth(const QString &blockBody)
+{
+    for (const QString &cond : blockConditions(blockBody)) {
+        // find start block
+        if (QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockForStart, cond).hasMatch())
+            _indoorBlockDepth++;
+        // find end block
+        if (QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockForEnd, cond).hasMatch())
+            _indoorBlockDepth--;
     }
-    return (openForBlocks == 0);
 }
 
 //!
 //! \brief Execute for-loop
 //! \param args
 //! \param container
+//! \param parserArgs Render args
+//! \param writer Render output
 //! \return
 //!
-std::tuple<bool, QString, QString> QtTIControlBlockFor::evalFor(const QStringList &args, const QVariant &container)
+std::tuple<bool, QString> QtTIControlBlockFor::evalFor(const QStringList &args, const QVariant &container, QtTIAbstractParserArgs *parserArgs, QtTIRenderWriter &writer)
 {
     if (container.canConvert<QVariantList>())
-        return evalList(args[0], container);
+        return evalList(args[0], container, parserArgs, writer);
     else if (container.canConvert<QVariantMap>())
-        return evalMap(args, container.toMap());
+        return evalMap(args, container.toMap(), parserArgs, writer);
     else if (container.canConvert<QVariantHash>())
-        return evalMap(args, container.toHash());
+        return evalMap(args, container.toHash(), parserArgs, writer);
 
-    return std::make_tuple(false, "", QString("Unsupoorted container type '%1' for block 'for...' in line %2").arg(container.typeName()).arg(lineNum()));
+    return std::make_tuple(false, QString("Unsupoorted container type '%1' for block 'for...' in line %2").arg(container.typeName()).arg(lineNum()));
 }
 
 //!
 //! \brief Execute for-loop for list
 //! \param arg
 //! \param container
+//! \param parserArgs Render args
+//! \param writer Render output
 //! \return
 //!
-std::tuple<bool, QString, QString> QtTIControlBlockFor::evalList(const QString &arg, const QVariant &container)
+//! NOTE: The shadowed value of the loop variable is saved once and restored after the loop.
+//!
+std::tuple<bool, QString> QtTIControlBlockFor::evalList(const QString &arg, const QVariant &container, QtTIAbstractParserArgs *parserArgs, QtTIRenderWriter &writer)
 {
-    bool resetArg = false;
-    QVariant resetArgValue;
-    if (parser()->parserArgs()->hasTmpParam(arg)) {
-        resetArgValue = parser()->parserArgs()->tmpParam(arg);
-        resetArg = true;
-    }
+    const QVariant resetArgValue = shadowedParamValue(arg, parserArgs);
 
     QSequentialIterable iterable = container.value<QSequentialIterable>();
-    bool isOk = false;
-    QString allBody;
+    bool isOk = true;
     QString error;
+    const qint64 startPos = writer.size();
     for (const QVariant &v : iterable) {
-        if (!allBody.isEmpty()
-            && allBody[allBody.size() - 1] != '\n')
-            allBody += "\r\n";
-
-        parser()->parserArgs()->appendTmpParam(arg, v);
-        QString tmpBody;
-        std::tie(isOk, tmpBody, error) = buildBlockBody(_blockBody);
-        parser()->parserArgs()->removeTmpParam(arg);
-        if (!isOk)
-            return std::make_tuple(false, "", error);
+        if (!writer.isEmptyAfter(startPos)
+            && writer.lastChar() != '\n')
+            writer.write(QString("\r\n"));
 
-        allBody += tmpBody;
+        setParamValue(0, v, parserArgs);
+        std::tie(isOk, error) = buildBlockBody(_compiledBody, parserArgs, writer);
+        if (!isOk)
+            break;
     }
-    if (resetArg)
-        parser()->parserArgs()->appendTmpParam(arg, resetArgValue);
+    setParamValue(0, resetArgValue, parserArgs);
+    if (!isOk)
+        return std::make_tuple(false, error);
 
-    return std::make_tuple(true, allBody, "");
+    return std::make_tuple(true, "");
 }
 
 //!
 //! \brief Execute for-loop for map or hash
 //! \param args
 //! \param container
+//! \param parserArgs Render args
+//! \param writer Render output
 //! \return
 //!
-std::tuple<bool, QString, QString> QtTIControlBlockFor::evalMap(const QStringList &args, const QVariant &container)
+//! NOTE: The shadowed values of the loop variables are saved once and restored after the loop.
+//!
+std::tuple<bool, QString> QtTIControlBlockFor::evalMap(const QStringList &args, const QVariant &container, QtTIAbstractParserArgs *parserArgs, QtTIRenderWriter &writer)
 {
-    bool resetArg = false;
-    QVariantMap resetArgValues;
-    for (const QString &arg : args) {
-        if (parser()->parserArgs()->hasTmpParam(arg.trimmed())) {
-            resetArgValues.insert(arg.trimmed(), parser()->parserArgs()->tmpParam(arg));
-            resetArg = true;
-        }
-    }
+    QVariantList resetArgValues;
+    for (const QString &arg : args)
+        resetArgValues.append(shadowedParamValue(arg, parserArgs));
 
-    bool isOk = false;
-    QString allBody;
+    bool isOk = true;
     QString error;
+    const qint64 startPos = writer.size();
     QAssociativeIterable iterable = container.value<QAssociativeIterable>();
     QAssociativeIterable::const_iterator it = iterable.begin();
     const QAssociativeIterable::const_iterator end = iterable.end();
     for ( ; it != end; ++it) {
-        if (!allBody.isEmpty()
-            && allBody[allBody.size() - 1] != '\n')
-            allBody += "\r\n";
+        if (!writer.isEmptyAfter(startPos)
+            && writer.lastChar() != '\n')
+            writer.write(QString("\r\n"));
 
         if (args.size() == 1) {
-            parser()->parserArgs()->appendTmpParam(args[0].trimmed(), it.value());
+            setParamValue(0, it.value(), parserArgs);
         } else {
-            parser()->parserArgs()->appendTmpParam(args[0].trimmed(), it.key());
-            parser()->parserArgs()->appendTmpParam(args[1].trimmed(), it.value());
-        }
-
-        QString tmpBody;
-        std::tie(isOk, tmpBody, error) = buildBlockBody(_blockBody);
-
-        if (args.size() == 1) {
-            parser()->parserArgs()->removeTmpParam(args[0].trimmed());
-        } else {
-            parser()->parserArgs()->removeTmpParam(args[0].trimmed());
-            parser()->parserArgs()->removeTmpParam(args[1].trimmed());
+            setParamValue(0, it.key(), parserArgs);
+            setParamValue(1, it.value(), parserArgs);
         }
 
+        std::tie(isOk, error) = buildBlockBody(_compiledBody, parserArgs, writer);
         if (!isOk)
-            return std::make_tuple(false, "", error);
-
-        allBody += tmpBody;
+            break;
     }
 
-    if (resetArg) {
-        QMapIterator<QString, QVariant> it (resetArgValues);
-        while (it.hasNext()) {
-            it.next();
-            parser()->parserArgs()->appendTmpParam(it.key(), it.value());
-        }
-    }
-    return std::make_tuple(true, allBody, "");
+    for (int i = 0; i < resetArgValues.size(); i++)
+        setParamValue(i, resetArgValues[i], parserArgs);
+    if (!isOk)
+        return std::make_tuple(false, error);
+    return std::make_tuple(true, "");
+}
+
+//!
+//! \brief Get value of the tmp parameter shadowed by the loop variable
+//! \param arg Loop variable name
+//! \param parserArgs Render args
+//! \return Invalid QVariant if the parameter is not set
+//!
+QVariant QtTIControlBlockFor::shadowedParamValue(const QString &arg, QtTIAbstractParserArgs *parserArgs) const
+{
+    if (!parserArgs->hasTmpParam(arg))
+        return QVariant();
+    return parserArgs->tmpParam(arg);
+}
+
+//!
+//! \brief Set value of the loop variable
+//! \param index Loop variable index
+//! \param value Variable value (invalid QVariant - remove the variable)
+//! \param parserArgs Render args
+//!
+//! NOTE: If the variable has a slot (see QtTIScope), the value is stored by the slot index.
+//!
+void QtTIControlBlockFor::setParamValue(const int index, const QVariant &value, QtTIAbstractParserArgs *parserArgs) const
+{
+    const int slot = _paramSlots.value(index, -1);
+    if (slot != -1)
+        parserArgs->setSlotValue(slot, value);
+    else if (value.isValid())
+        parserArgs->appendTmpParam(_paramNames[index], value);
+    else
+        parserArgs->removeTmpParam(_paramNames[index]);
 }
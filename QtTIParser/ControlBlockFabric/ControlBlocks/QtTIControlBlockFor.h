@@ -64,18 +64,29 @@ public:
     void appendBlockBody(const QString &blockBody, const int lineNum) final;
     void setBlockBody(const QString &blockBody, const int lineNum) final;
     QString blockBody(const int lineNum) const final;
+    void compileBlock() final;
 
-    std::tuple<bool/*isOk*/,QString/*res*/,QString/*err*/> evalBlock() final;
+    std::tuple<bool/*isOk*/,QString/*err*/> evalBlock(QtTIAbstractParserArgs *parserArgs, QtTIRenderWriter &writer) final;
+    bool compileProgram(QtTIProgramCompiler &compiler) const final;
+    qint64 memoryCost() const final;
 
 private:
     QString _blockCond;
+    QStringList _paramNames;
+    QVector<int> _paramSlots;
+    QtTIExpression _containerExpr;
     QMap<int,QString> _blockBody;
+    QtTICompiledBlockBody _compiledBody;
+    int _indoorBlockDepth {0};
 
     bool isIndoorBlockComplete() const;
+    void updateIndoorBlockDepth(const QString &blockBody);
 
-    std::tuple<bool/*isOk*/,QString/*res*/,QString/*err*/> evalFor(const QStringList &args, const QVariant &container);
-    std::tuple<bool/*isOk*/,QString/*res*/,QString/*err*/> evalList(const QString &arg, const QVariant &container);
-    std::tuple<bool/*isOk*/,QString/*res*/,QString/*err*/> evalMap(const QStringList &args, const QVariant &container);
+    std::tuple<bool/*isOk*/,QString/*err*/> evalFor(const QStringList &args, const QVariant &container, QtTIAbstractParserArgs *parserArgs, QtTIRenderWriter &writer);
+    std::tuple<bool/*isOk*/,QString/*err*/> evalList(const QString &arg, const QVariant &container, QtTIAbstractParserArgs *parserArgs, QtTIRenderWriter &writer);
+    std::tuple<bool/*isOk*/,QString/*err*/> evalMap(const QStringList &args, const QVariant &container, QtTIAbstractParserArgs *parserArgs, QtTIRenderWriter &writer);
+    QVariant shadowedParamValue(const QString &arg, QtTIAbstractParserArgs *parserArgs) const;
+    void setParamValue(const int index, const QVariant &value, QtTIAbstractParserArgs *parserArgs) const;
 };
 
 #endif // QTTICONTROLBLOCKFOR_H
@@ -1,10 +1,6 @@
 #include "QtTIControlBlockIf.h"
+#include "../../Program/QtTIProgramCompiler.h"
 #include "../QtTIControlBlockFabric.h"
-#include "../../BracketsExpr/QtTIParserBracketsExpr.h"
-#include "../../TernaryOperator/QtTIParserTernaryOperator.h"
-#include "../../NullCoalescingOperator/QtTIParserNullCoalescingOperator.h"
-#include "../../Logic/QtTIParserLogic.h"
-#include "../../Math/QtTIParserMath.h"
 
 QtTIControlBlockIf::QtTIControlBlockIf(QtTIAbstractParser *parser)
     : QtTIAbstractControlBlock(parser, -1, -1)
@@ -16,7 +12,11 @@ QtTIControlBlockIf::QtTIControlBlockIf(QtTIAbstractParser *parser,
                                        const int linePos)
     : QtTIAbstractControlBlock(parser, lineNum, linePos)
     , _ifCond(blockCond)
-{}
+{
+    const QRegularExpressionMatch m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockIfStart, _ifCond);
+    if (m.hasMatch())
+        _ifExpr = parser->compileExpression(m.captured(2));
+}
 
 QtTIControlBlockIf::~QtTIControlBlockIf()
 {
@@ -51,10 +51,8 @@ QString QtTIControlBlockIf::blockCondition() const
 //!
 bool QtTIControlBlockIf::isBlockCondStart(const QString &blockCond)
 {
-    QRegExp rx(RX_CONTROL_BLOCK_IF_START);
-    QRegExp rxElseIf(RX_CONTROL_BLOCK_ELSE_IF_START);
-    return ((rx.indexIn(blockCond) != -1)
-            && (rxElseIf.indexIn(blockCond) == -1));
+    return (QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockIfStart, blockCond).hasMatch()
+            && !QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockElseIfStart, blockCond).hasMatch());
 }
 
 //!
@@ -64,11 +62,9 @@ bool QtTIControlBlockIf::isBlockCondStart(const QString &blockCond)
 //!
 bool QtTIControlBlockIf::isBlockCondIntermediate(const QString &blockCond)
 {
-    QRegExp rxElseIf(RX_CONTROL_BLOCK_ELSE_IF_START);
-    if ((rxElseIf.indexIn(blockCond) != -1) && _elseCond.isEmpty())
+    if (QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockElseIfStart, blockCond).hasMatch() && _elseCond.isEmpty())
         return isIndoorBlockComplete();
-    QRegExp rxElse(RX_CONTROL_BLOCK_ELSE);
-    if (rxElse.indexIn(blockCond) != -1 && _elseCond.isEmpty())
+    if (QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockElse, blockCond).hasMatch() && _elseCond.isEmpty())
         return isIndoorBlockComplete();
     return false;
 }
@@ -79,15 +75,15 @@ bool QtTIControlBlockIf::isBlockCondIntermediate(const QString &blockCond)
 //!
 void QtTIControlBlockIf::appendBlockCondIntermediate(const QString &blockCond)
 {
-    QRegExp rxElseIf(RX_CONTROL_BLOCK_ELSE_IF_START);
-    if (rxElseIf.indexIn(blockCond) != -1) {
+    const QRegularExpressionMatch m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockElseIfStart, blockCond);
+    if (m.hasMatch()) {
         _elseIfConds.append(blockCond);
+        _elseIfExprs.append(parser()->compileExpression(m.captured(2)));
         _elseIfBodys.append(QMap<int,QString>());
         _bodyPos = BodyPosition::ElseIf;
         return;
     }
-    QRegExp rxElse(RX_CONTROL_BLOCK_ELSE);
-    if (rxElse.indexIn(blockCond) != -1) {
+    if (QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockElse, blockCond).hasMatch()) {
         _elseCond = blockCond;
         _bodyPos = BodyPosition::Else;
         return;
@@ -101,70 +97,142 @@ void QtTIControlBlockIf::appendBlockCondIntermediate(const QString &blockCond)
 //!
 bool QtTIControlBlockIf::isBlockCondEnd(const QString &blockCond)
 {
-    QRegExp rx(RX_CONTROL_BLOCK_IF_END);
-    if (rx.indexIn(blockCond) != -1)
+    if (QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockIfEnd, blockCond).hasMatch())
         return isIndoorBlockComplete();
     return false;
 }
 
+//!
+//! \brief Compile control block
+//!
+//! NOTE: The bodies of all branches are compiled once, only the body of the selected branch is executed.
+//!
+void QtTIControlBlockIf::compileBlock()
+{
+    _compiledIfBody = compileBlockBody(_ifBody);
+    _compiledElseIfBodys.clear();
+    for (const QMap<int,QString> &elseIfBody : qAsConst(_elseIfBodys))
+        _compiledElseIfBodys.append(compileBlockBody(elseIfBody));
+    _compiledElseBody = compileBlockBody(_elseBody);
+}
+
 //!
 //! \brief Execute control block
+//! \param parserArgs Render args
+//! \param writer Render output
 //! \return
 //!
-std::tuple<bool, QString, QString> QtTIControlBlockIf::evalBlock()
+std::tuple<bool, QString> QtTIControlBlockIf::evalBlock(QtTIAbstractParserArgs *parserArgs, QtTIRenderWriter &writer)
 {
     // check IF
-    QRegExp rxIf(RX_CONTROL_BLOCK_IF_START);
-    if (rxIf.indexIn(_ifCond) != -1) {
-        QString ifConf = rxIf.cap(2).trimmed();
-        bool isOk = false;
-        QString error;
-        QVariant result;
-        std::tie(isOk, result, error) = evalCond(ifConf, parser()->parserArgs(), parser()->parserFunc());
+    if (_ifExpr.isEmpty())
+        return std::make_tuple(false, "Incorrect conditions are specified for the IF block");
+
+    bool isOk = false;
+    bool result = false;
+    QString error;
+    std::tie(isOk, result, error) = evalCond(_ifExpr, parserArgs);
+    if (!isOk)
+        return std::make_tuple(false, error);
+    if (result)
+        return buildBlockBody(_compiledIfBody, parserArgs, writer);
+
+    // check ELSEIF
+    for (int i = 0; i < _elseIfExprs.size(); i++) {
+        const QtTIExpression &elseIfExpr = _elseIfExprs[i];
+        if (elseIfExpr.isEmpty())
+            continue;
+        std::tie(isOk, result, error) = evalCond(elseIfExpr, parserArgs);
         if (!isOk)
-            return std::make_tuple(false, "", error);
-        if (result.type() == QVariant::Bool
-            && result.toBool())
-            return buildBlockBody(_ifBody);
-        else if (result.type() != QVariant::Bool
-                 && !result.isNull())
-            return buildBlockBody(_ifBody);
-    } else {
-        return std::make_tuple(false, "", "Incorrect conditions are specified for the IF block");
+            return std::make_tuple(false, error);
+        if (result)
+            return buildBlockBody(_compiledElseIfBodys[i], parserArgs, writer);
     }
 
-    // check ELSEIF
-    if (!_elseIfConds.isEmpty()) {
-        for (int i = 0; i < _elseIfConds.size(); i++) {
-            const QString elseIfCond = _elseIfConds[i];
-            const QMap<int,QString> elseIfBody = _elseIfBodys[i];
-            // check IF
-            QRegExp rxElseIf(RX_CONTROL_BLOCK_ELSE_IF_START);
-            if (rxElseIf.indexIn(elseIfCond) != -1) {
-                QString ifConf = rxElseIf.cap(2).trimmed();
-                bool isOk = false;
-                QString error;
-                QVariant result;
-                std::tie(isOk, result, error) = evalCond(ifConf, parser()->parserArgs(), parser()->parserFunc());
-                if (!isOk)
-                    return std::make_tuple(false, "", error);
-                if (result.type() == QVariant::Bool
-                    && result.toBool())
-                    return buildBlockBody(elseIfBody);
-                else if (result.type() != QVariant::Bool
-                         && !result.isNull())
-                    return buildBlockBody(elseIfBody);
+    // check ELSE
+    if (!_elseCond.isEmpty())
+        return buildBlockBody(_compiledElseBody, parserArgs, writer);
+
+    // none of the conditions matched, we return an empty result
+    return std::make_tuple(true, "");
+}
+
+//!
+//! \brief Get approximate memory size of control block (in bytes)
+//! \return
+//!
+qint64 QtTIControlBlockIf::memoryCost() const
+{
+    qint64 cost = static_cast<qint64>(sizeof(QtTIControlBlockIf))
+                  + stringCost(_ifCond)
+                  + stringCost(_elseCond)
+                  + bodyCost(_ifBody)
+                  + bodyCost(_elseBody)
+                  + _ifExpr.memoryCost()
+                  + _compiledIfBody.memoryCost()
+                  + _compiledElseBody.memoryCost();
+    for (const QString &elseIfCond : _elseIfConds)
+        cost += stringCost(elseIfCond);
+    for (const QtTIExpression &elseIfExpr : _elseIfExprs)
+        cost += elseIfExpr.memoryCost();
+    for (const QMap<int,QString> &elseIfBody : _elseIfBodys)
+        cost += bodyCost(elseIfBody);
+    for (const QtTICompiledBlockBody &compiledElseIfBody : _compiledElseIfBodys)
+        cost += compiledElseIfBody.memoryCost();
+    return cost;
+}
+
+//!
+//! \brief Compile control block to the program instructions
+//! \param compiler Program compiler
+//! \return
+//!
+//! The conditions are checked in order, the first true condition jumps to its body,
+//! the other bodies are skipped.
+//!
+//! NOTE: The branches with constant conditions are selected on compile (see
+//!       QtTIProgramCompiler::constantCondition): the false branch is removed, the true
+//!       branch is compiled without condition and the next branches are removed.
+//!
+bool QtTIControlBlockIf::compileProgram(QtTIProgramCompiler &compiler) const
+{
+    if (_ifExpr.isEmpty()) {
+        compiler.emitError("Incorrect conditions are specified for the IF block");
+        return true;
+    }
+
+    QVector<int> endJumps;
+    bool isSelected = false;
+    for (int i = -1; i < _elseIfExprs.size() && !isSelected; i++) {
+        const QtTIExpression &expr = (i == -1) ? _ifExpr : _elseIfExprs[i];
+        const QtTICompiledBlockBody &body = (i == -1) ? _compiledIfBody : _compiledElseIfBodys[i];
+        if (expr.isEmpty())
+            continue;
+
+        bool isConstant = false;
+        bool isTrue = false;
+        std::tie(isConstant, isTrue) = compiler.constantCondition(expr);
+        if (isConstant) {
+            if (isTrue) {
+                compiler.emitBody(body);
+                isSelected = true;
             }
+            continue;
         }
+
+        compiler.emitExpression(expr, false, lineNum(), linePos());
+        const int nextJump = compiler.emit(QtTIInstruction::Opcode::Branch);
+        compiler.emitBody(body);
+        endJumps.append(compiler.emit(QtTIInstruction::Opcode::Jump));
+        compiler.patchJump(nextJump);
     }
 
-    // check ELSE
-    QRegExp rxElse(RX_CONTROL_BLOCK_ELSE);
-    if (rxElse.indexIn(_elseCond) != -1)
-        return buildBlockBody(_elseBody);
+    if (!isSelected && !_elseCond.isEmpty())
+        compiler.emitBody(_compiledElseBody);
 
-    // none of the conditions matched, we return an empty result
-    return std::make_tuple(true, "", "");
+    for (const int endJump : endJumps)
+        compiler.patchJump(endJump);
+    return true;
 }
 
 //!
@@ -189,6 +257,7 @@ void QtTIControlBlockIf::appendBlockBody(const QString &blockBody, const int lin
         default:
             break;
     }
+    updateIndoorBlockDepth(blockBody);
 }
 
 //!
@@ -238,214 +307,45 @@ QString QtTIControlBlockIf::blockBody(const int lineNum) const
 //!
 bool QtTIControlBlockIf::isIndoorBlockComplete() const
 {
-    QRegExp rxStart(RX_CONTROL_BLOCK_IF_START);
-    QRegExp rxElseIfStart(RX_CONTROL_BLOCK_ELSE_IF_START);
-    QRegExp rxEnd(RX_CONTROL_BLOCK_IF_END);
-    int openIfBlocks = 0;
-
-    // check IF
-    QMapIterator<int,QString> it(_ifBody);
-    while (it.hasNext()) {
-        it.next();
-        const QString bodyData = it.value();
-        int index = 0;
-        while (index < bodyData.size()) {
-            QString condAll, cond;
-            std::tie(condAll, cond, index) = parseBlockCondition(bodyData, index);
-            if (index == -1)
-                break;
-            index += condAll.size();
-            cond = cond.trimmed();
-            // find start block
-            if (rxStart.indexIn(cond) != -1
-                && rxElseIfStart.indexIn(cond) == -1)
-                openIfBlocks++;
-            // find end block
-            if (rxEnd.indexIn(cond) != -1)
-                openIfBlocks--;
-        }
-    }
-    if (openIfBlocks != 0)
-        return false;
-
-    // check ELSEIF
-    for (int i = 0; i < _elseIfBodys.size(); i++) {
-        const QMap<int,QString> elseIfBody = _elseIfBodys[i];
-        QMapIterator<int,QString> it(elseIfBody);
-        while (it.hasNext()) {
-            it.next();
-            const QString bodyData = it.value();
-            int index = 0;
-            while (index < bodyData.size()) {
-                QString condAll, cond;
-                std::tie(condAll, cond, index) = parseBlockCondition(bodyData, index);
-                if (index == -1)
-                    break;
-                index += condAll.size();
-                cond = cond.trimmed();
-                // find start block
-                if (rxStart.indexIn(cond) != -1)
-                    openIfBlocks++;
-                // find end block
-                if (rxEnd.indexIn(cond) != -1)
-                    openIfBlocks--;
-            }
-        }
-        if (openIfBlocks != 0)
-            return false;
-    }
-
-    // check ELSE
-    QMapIterator<int,QString> it2(_elseBody);
-    while (it.hasNext()) {
-        it.next();
-        const QString bodyData = it.value();
-        int index = 0;
-        while (index < bodyData.size()) {
-            QString condAll, cond;
-            std::tie(condAll, cond, index) = parseBlockCondition(bodyData, index);
-            if (index == -1)
-                break;
-            index += condAll.size();
-            cond = cond.trimmed();
-            // find start block
-            if (rxStart.indexIn(cond) != -1)
-                openIfBlocks++;
-            // find end block
-            if (rxEnd.indexIn(cond) != -1)
-                openIfBlocks--;
-        }
-    }
-    if (openIfBlocks != 0)
-        return false;
-
-    return true;
+    return (_indoorBlockDepth == 0);
 }
 
 //!
-//! \brief Evaluate condition
-//! \param str
-//! \param parserArgs
-//! \param parserFunc
-//! \return
+//! \brief Update the nesting depth of internal IF blocks by the appended body data
+//! \param blockBody Appended control block body
 //!
-std::tuple<bool, QVariant, QString> QtTIControlBlockIf::evalCond(const QString &str,
-                                                                 QtTIAbstractParserArgs *parserArgs,
-                                                                 QtTIAbstractParserFunc *parserFunc)
+//! NOTE: Each part of the body is scanned once, when it is appended. The depth is common
+//!       for all bodies (IF, ELSEIF, ELSE), internal ELSEIF and ELSE do not change it.
+//!
+void QtTIControlBlockIf::updateIndoorBlockDepth(const QString &blockBody)
 {
-    if (str.isEmpty())
-        return std::make_tuple(false, QVariant(), "Eval condition failed (empty string passed)");
-
-    QStringList validStringsBeforeBracket({ "+", "-", "/", "%", "//", "*", "**", "and", "or", "not", "&&", "||" });
-    QtTIBracketsNode brNode = QtTIParserBracketsExpr::parseBracketsExpression(str, validStringsBeforeBracket, parserArgs, [parserArgs, parserFunc](const QString &nodeBody) {
-        return QtTIControlBlockIf::parseParamValue(nodeBody, parserArgs, parserFunc);
-    });
-    if (!brNode.isValid())
-        return std::make_tuple(false, QVariant(), QString("Invalid brackets node for expression '%1'").arg(str));
-
-    return brNode.evalNodeBody();
+    for (const QString &cond : blockConditions(blockBody)) {
+        // find start block
+        if (isBlockCondStart(cond))
+            _indoorBlockDepth++;
+        // find end block
+        if (QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockIfEnd, cond).hasMatch())
+            _indoorBlockDepth--;
+    }
 }
 
 //!
-//! \brief Parse parameter value from string
-//! \param str Parameter value string view
-//! \param parserArgs
-//! \param parserFunc
+//! \brief Evaluate condition
+//! \param expr Compiled condition
+//! \param parserArgs Render args
 //! \return
 //!
-std::tuple<bool, QVariant, QString> QtTIControlBlockIf::parseParamValue(const QString &str,
-                                                                        QtTIAbstractParserArgs *parserArgs,
-                                                                        QtTIAbstractParserFunc *parserFunc)
+//! NOTE: The condition is true if its value is bool 'true' or not NULL.
+//!
+std::tuple<bool, bool, QString> QtTIControlBlockIf::evalCond(const QtTIExpression &expr,
+                                                             QtTIAbstractParserArgs *parserArgs)
 {
-    if (str.isEmpty())
-        return std::make_tuple(false, QVariant(), "Parse value failed (empty string passed)");
-
-    // ternary
-    if (QtTIParserTernaryOperator::isTernaryOperatorExpr(str)) {
-        bool isOk = false;
-        QString error;
-        QVariant result = QtTIParserTernaryOperator::parseTernaryOperator(str, parserArgs, parserFunc, &isOk, error);
-        if (!isOk)
-            return std::make_tuple(false, QVariant(), error);
-
-        return std::make_tuple(true, result, "");
-    }
-
-    // null-coalescing
-    if (QtTIParserNullCoalescingOperator::isNullCoalescingOperatorExpr(str)) {
-        bool isOk = false;
-        QString error;
-        QVariant result = QtTIParserNullCoalescingOperator::parseNullCoalescingOperator(str, parserArgs, parserFunc, &isOk, error);
-        if (!isOk)
-            return std::make_tuple(false, QVariant(), error);
-
-        return std::make_tuple(true, result, "");
-    }
-
-    // logic
-    if (QtTIParserLogic::isLogicExpr(str)) {
-        bool isOk = false;
-        QString error;
-        QVariant result = QtTIParserLogic::parseLogic(str, parserArgs, parserFunc, &isOk, error);
-        if (!isOk)
-            return std::make_tuple(false, QVariant(), error);
-
-        return std::make_tuple(true, result, "");
-    }
-
-    // math
-    if (QtTIParserMath::isMathExpr(str)) {
-        bool isOk = false;
-        QString error;
-        QVariant result = QtTIParserMath::parseMath(str, parserArgs, parserFunc, &isOk, error);
-        if (!isOk)
-            return std::make_tuple(false, QVariant(), error);
-
-        return std::make_tuple(true, result, "");
-    }
-
-    QString tmpStr = str;
-    QRegExp rx("not\\s+(.*)");
-    const bool useNot = rx.exactMatch(str);
-    if (useNot)
-        tmpStr = rx.cap(1);
-
-    // function
-    QRegExp rxFunc(RX_FUNC);
-    if (rxFunc.indexIn(tmpStr) != -1) {
-        QString funcName = rxFunc.cap(2).trimmed();
-        QVariantList funcArgs = parserArgs->parseHelpFunctionArgs(rxFunc.cap(3).trimmed());
-        bool isOk = false;
-        QString error;
-        QVariant result;
-        std::tie(isOk, result, error) = parserFunc->evalHelpFunction(funcName, funcArgs);
-        if (!isOk)
-            return std::make_tuple(false, QVariant(), error);
-        if (useNot) {
-            if (result.type() == QVariant::Bool)
-                return std::make_tuple(true, !result.toBool(), "");
-            else if (result.isNull())
-                return std::make_tuple(true, true, "");
-            else
-                return std::make_tuple(true, false, "");
-        }
-        return std::make_tuple(true, result, "");
-    }
-
-    // arg
-    QVariantList tmp = parserArgs->parseHelpFunctionArgs(tmpStr);
-    if (tmp.isEmpty())
-        return std::make_tuple(false, QVariant(), "Parse value failed");
-    if (tmp.size() > 1)
-        return std::make_tuple(false, QVariant(), "Parse value failed (more than one argument is given)");
-
-    if (useNot) {
-        if (tmp[0].type() == QVariant::Bool)
-            return std::make_tuple(true, !tmp[0].toBool(), "");
-        else if (tmp[0].isNull())
-            return std::make_tuple(true, true, "");
-        else
-            return std::make_tuple(true, false, "");
-    }
-    return std::make_tuple(true, tmp[0], "");
+    bool isOk = false;
+    QVariant result;
+    QString error;
+    std::tie(isOk, result, error) = expr.eval(parserArgs, parser()->parserFunc());
+    if (!isOk)
+        return std::make_tuple(false, false, error);
+
+    return std::make_tuple(true, QtTIExprNode::isTrue(result), "");
 }
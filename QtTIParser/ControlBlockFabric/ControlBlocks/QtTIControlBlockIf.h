@@ -96,32 +96,40 @@ public:
     bool isBlockCondIntermediate(const QString &blockCond) final;
     void appendBlockCondIntermediate(const QString &blockCond) final;
     bool isBlockCondEnd(const QString &blockCond) final;
-    std::tuple<bool/*isOk*/,QString/*res*/,QString/*err*/> evalBlock() final;
+    std::tuple<bool/*isOk*/,QString/*err*/> evalBlock(QtTIAbstractParserArgs *parserArgs, QtTIRenderWriter &writer) final;
+    bool compileProgram(QtTIProgramCompiler &compiler) const final;
+    qint64 memoryCost() const final;
 
     void appendBlockBody(const QString &blockBody, const int lineNum) final;
     void setBlockBody(const QString &blockBody, const int lineNum) final;
     QString blockBody(const int lineNum) const final;
+    void compileBlock() final;
 
 private:
     QString _ifCond;
     QString _elseCond;
     QStringList _elseIfConds;
 
+    QtTIExpression _ifExpr;
+    QList<QtTIExpression> _elseIfExprs;
+
     BodyPosition _bodyPos {BodyPosition::If};
 
     QMap<int,QString> _ifBody;
     QMap<int,QString> _elseBody;
     QList<QMap<int,QString>> _elseIfBodys;
 
-    bool isIndoorBlockComplete() const;
+    QtTICompiledBlockBody _compiledIfBody;
+    QtTICompiledBlockBody _compiledElseBody;
+    QList<QtTICompiledBlockBody> _compiledElseIfBodys;
 
-    static std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> evalCond(const QString &str,
-                                                                            QtTIAbstractParserArgs *parserArgs,
-                                                                            QtTIAbstractParserFunc *parserFunc);
+    int _indoorBlockDepth {0};
+
+    bool isIndoorBlockComplete() const;
+    void updateIndoorBlockDepth(const QString &blockBody);
 
-    static std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> parseParamValue(const QString &str,
-                                                                                   QtTIAbstractParserArgs *parserArgs,
-                                                                                   QtTIAbstractParserFunc *parserFunc);
+    std::tuple<bool/*isOk*/,bool/*res*/,QString/*err*/> evalCond(const QtTIExpression &expr,
+                                                                 QtTIAbstractParserArgs *parserArgs);
 };
 
 #endif // QTTICONTROLBLOCKIF_H
@@ -1,4 +1,5 @@
 #include "QtTIControlBlockSet.h"
+#include "../../Program/QtTIProgramCompiler.h"
 
 QtTIControlBlockSet::QtTIControlBlockSet(QtTIAbstractParser *parser)
     : QtTIAbstractControlBlock(parser, -1, -1)
@@ -10,7 +11,14 @@ QtTIControlBlockSet::QtTIControlBlockSet(QtTIAbstractParser *parser,
                                          const int linePos)
     : QtTIAbstractControlBlock(parser, lineNum, linePos)
     , _blockCond(blockCond)
-{}
+{
+    const QRegularExpressionMatch m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockSet, _blockCond);
+    if (m.hasMatch()) {
+        _paramName = m.captured(2).trimmed();
+        _paramSlot = parser->variableSlot(_paramName);
+        _paramExpr = parser->compileExpression(m.captured(3));
+    }
+}
 
 QtTIControlBlockSet::~QtTIControlBlockSet()
 {}
@@ -44,8 +52,7 @@ QString QtTIControlBlockSet::blockCondition() const
 //!
 bool QtTIControlBlockSet::isBlockCondStart(const QString &blockCond)
 {
-    QRegExp rx(RX_CONTROL_BLOCK_SET);
-    return (rx.indexIn(blockCond) != -1);
+    return QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockSet, blockCond).hasMatch();
 }
 
 //!
@@ -60,29 +67,69 @@ bool QtTIControlBlockSet::isBlockCondEnd(const QString &blockCond)
 
 //!
 //! \brief Execute control block
+//! \param parserArgs Render args
+//! \param writer Render output
+//! \return
+//!
+std::tuple<bool, QString> QtTIControlBlockSet::evalBlock(QtTIAbstractParserArgs *parserArgs, QtTIRenderWriter &writer)
+{
+    Q_UNUSED(writer)
+
+    if (_paramName.isEmpty())
+        return std::make_tuple(false, QString("Unsupported block condition '%1' in line %2").arg(_blockCond).arg(lineNum()));
+
+    bool isOk = false;
+    QVariant paramValue;
+    QString error;
+    std::tie(isOk, paramValue, error) = parseParamValue(_paramExpr, lineNum(), linePos(), parserArgs);
+    if (!isOk)
+        return std::make_tuple(false, QString("Parse parameter value in block 'set ...' in line %1 failed! Error: %2").arg(lineNum()).arg(error));
+    if (paramValue.isNull() && paramValue.type() != QVariant::Type::String)
+        return std::make_tuple(false, QString("Invalid parameter value (Null) in line %1").arg(lineNum()));
+    if (parserArgs->hasParam(_paramName))
+        return std::make_tuple(false, QString("Parameter with name '%1' in line %2 already declared in the global parameter list").arg(_paramName).arg(lineNum()));
+
+    if (_paramSlot != -1)
+        parserArgs->setSlotValue(_paramSlot, paramValue);
+    else
+        parserArgs->appendTmpParam(_paramName, paramValue);
+    return std::make_tuple(true, "");
+}
+
+//!
+//! \brief Get approximate memory size of control block (in bytes)
+//! \return
+//!
+qint64 QtTIControlBlockSet::memoryCost() const
+{
+    return static_cast<qint64>(sizeof(QtTIControlBlockSet))
+           + stringCost(_blockCond)
+           + stringCost(_paramName)
+           + _paramExpr.memoryCost();
+}
+
+//!
+//! \brief Compile control block to the program instructions
+//! \param compiler Program compiler
 //! \return
 //!
-std::tuple<bool, QString, QString> QtTIControlBlockSet::evalBlock()
+bool QtTIControlBlockSet::compileProgram(QtTIProgramCompiler &compiler) const
 {
-    QRegExp rx(RX_CONTROL_BLOCK_SET);
-    if (rx.indexIn(_blockCond) != -1) {
-        QString paramName = rx.cap(2).trimmed();
-        QString paramExpr = rx.cap(3).trimmed();
-        bool isOk = false;
-        QVariant paramValue;
-        QString error;
-        std::tie(isOk, paramValue, error) = parseParamValue(paramExpr, lineNum(), linePos());
-        if (!isOk)
-            return std::make_tuple(false, "", QString("Parse parameter value in block 'set ...' in line %1 failed! Error: %2").arg(lineNum()).arg(error));
-        if (paramName.isEmpty())
-            return std::make_tuple(false, "", QString("Invalid parameter name (empty) in line %1").arg(lineNum()));
-        if (paramValue.isNull() && paramValue.type() != QVariant::Type::String)
-            return std::make_tuple(false, "", QString("Invalid parameter value (Null) in line %1").arg(lineNum()));
-        if (parser()->parserArgs()->hasParam(paramName))
-            return std::make_tuple(false, "", QString("Parameter with name '%1' in line %2 already declared in the global parameter list").arg(paramName).arg(lineNum()));
+    if (_paramName.isEmpty()) {
+        compiler.emitError(QString("Unsupported block condition '%1' in line %2").arg(_blockCond).arg(lineNum()));
+        return true;
+    }
 
-        parser()->parserArgs()->appendTmpParam(paramName, paramValue);
-        return std::make_tuple(true, "", "");
+    QtTIProgramSet set;
+    set.paramName = _paramName;
+    set.paramSlot = _paramSlot;
+    set.lineNum = lineNum();
+    const QString errorFormat = QString("Parse parameter value in block 'set ...' in line %1 failed! Error: %2").arg(lineNum());
+    if (_paramExpr.isEmpty()) {
+        compiler.emitError(errorFormat.arg("Parse value failed (empty string passed)"));
+        return true;
     }
-    return std::make_tuple(false, "", QString("Unsupported block condition '%1' in line %2").arg(_blockCond).arg(lineNum()));
+    const int expr = compiler.emitExpression(_paramExpr, true, lineNum(), linePos(), errorFormat);
+    compiler.emit(QtTIInstruction::Opcode::SetParam, compiler.appendSet(set), expr);
+    return true;
 }
@@ -47,10 +47,15 @@ public:
     bool isBlockCondStart(const QString &blockCond) final;
     bool isBlockCondEnd(const QString &blockCond) final;
 
-    std::tuple<bool/*isOk*/,QString/*res*/,QString/*err*/> evalBlock() final;
+    std::tuple<bool/*isOk*/,QString/*err*/> evalBlock(QtTIAbstractParserArgs *parserArgs, QtTIRenderWriter &writer) final;
+    bool compileProgram(QtTIProgramCompiler &compiler) const final;
+    qint64 memoryCost() const final;
 
 private:
     QString _blockCond;
+    QString _paramName;
+    int _paramSlot {-1};
+    QtTIExpression _paramExpr;
 };
 
 #endif // QTTICONTROLBLOCKSET_H
@@ -1,4 +1,5 @@
 #include "QtTIControlBlockUnset.h"
+#include "../../Program/QtTIProgramCompiler.h"
 
 QtTIControlBlockUnset::QtTIControlBlockUnset(QtTIAbstractParser *parser)
     : QtTIAbstractControlBlock(parser, -1, -1)
@@ -44,8 +45,7 @@ QString QtTIControlBlockUnset::blockCondition() const
 //!
 bool QtTIControlBlockUnset::isBlockCondStart(const QString &blockCond)
 {
-    QRegExp rx(RX_CONTROL_BLOCK_UNSET);
-    return (rx.indexIn(blockCond) != -1);
+    return QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockUnset, blockCond).hasMatch();
 }
 
 //!
@@ -60,21 +60,57 @@ bool QtTIControlBlockUnset::isBlockCondEnd(const QString &blockCond)
 
 //!
 //! \brief Execute control block
+//! \param parserArgs Render args
+//! \param writer Render output
 //! \return
 //!
-std::tuple<bool, QString, QString> QtTIControlBlockUnset::evalBlock()
+std::tuple<bool, QString> QtTIControlBlockUnset::evalBlock(QtTIAbstractParserArgs *parserArgs, QtTIRenderWriter &writer)
 {
-    QRegExp rx(RX_CONTROL_BLOCK_UNSET);
-    if (rx.indexIn(_blockCond) != -1) {
-        QString paramName = rx.cap(2).trimmed();
+    Q_UNUSED(writer)
+
+    const QRegularExpressionMatch m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockUnset, _blockCond);
+    if (m.hasMatch()) {
+        QString paramName = m.captured(2).trimmed();
         // check
         if (paramName.isEmpty())
-            return std::make_tuple(false, "", QString("Invalid parameter name (empty) in line %1").arg(lineNum()));
-        if (parser()->parserArgs()->hasTmpParam(paramName))
-            parser()->parserArgs()->removeTmpParam(paramName);
+            return std::make_tuple(false, QString("Invalid parameter name (empty) in line %1").arg(lineNum()));
+        if (parserArgs->hasTmpParam(paramName))
+            parserArgs->removeTmpParam(paramName);
+
+        return std::make_tuple(true, "");
+    }
+    return std::make_tuple(false, QString("Unsupported block condition '%1' in line %2").arg(_blockCond).arg(lineNum()));
+}
+
+//!
+//! \brief Get approximate memory size of control block (in bytes)
+//! \return
+//!
+qint64 QtTIControlBlockUnset::memoryCost() const
+{
+    return static_cast<qint64>(sizeof(QtTIControlBlockUnset))
+           + stringCost(_blockCond);
+}
+
+//!
+//! \brief Compile control block to the program instructions
+//! \param compiler Program compiler
+//! \return
+//!
+bool QtTIControlBlockUnset::compileProgram(QtTIProgramCompiler &compiler) const
+{
+    const QRegularExpressionMatch m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::ControlBlockUnset, _blockCond);
+    if (!m.hasMatch()) {
+        compiler.emitError(QString("Unsupported block condition '%1' in line %2").arg(_blockCond).arg(lineNum()));
+        return true;
+    }
 
-        return std::make_tuple(true, "", "");
+    const QString paramName = m.captured(2).trimmed();
+    if (paramName.isEmpty()) {
+        compiler.emitError(QString("Invalid parameter name (empty) in line %1").arg(lineNum()));
+        return true;
     }
-    return std::make_tuple(false, "", QString("Unsupported block condition '%1' in line %2").arg(_blockCond).arg(lineNum()));
+    compiler.emit(QtTIInstruction::Opcode::UnsetParam, compiler.appendText(paramName));
+    return true;
 }
 
@@ -0,0 +1,188 @@
+#include "QtTIExprFolder.h"
+
+//!
+//! \brief Fold constant sub-expressions of the expression tree
+//! \param node Expression node
+//! \param resolvePath Parameter resolver (optional)
+//! \return Folded node (the same node, if nothing is folded)
+//!
+QtTIExprNodePtr QtTIExprFolder::fold(const QtTIExprNodePtr &node, const PathResolver &resolvePath)
+{
+    if (!node)
+        return node;
+
+    switch (node->kind()) {
+        case QtTIExprNode::Kind::Literal:
+            return node;
+        case QtTIExprNode::Kind::Path: {
+            if (!resolvePath)
+                return node;
+            const QtTIExprNodePtr constant = resolvePath(static_cast<const QtTIExprPathNode &>(*node));
+            return constant ? constant : node;
+        }
+        case QtTIExprNode::Kind::Call: {
+            const QtTIExprCallNode &call = static_cast<const QtTIExprCallNode &>(*node);
+            QVector<QtTIExprNodePtr> args;
+            args.reserve(call.args().size());
+            bool isChanged = false;
+            for (const QtTIExprNodePtr &arg : call.args()) {
+                args.append(fold(arg, resolvePath));
+                isChanged = isChanged || (args.last() != arg);
+            }
+            if (!isChanged)
+                return node;
+            return std::make_shared<QtTIExprCallNode>(call.name(), args);
+        }
+        case QtTIExprNode::Kind::Array: {
+            const QtTIExprArrayNode &array = static_cast<const QtTIExprArrayNode &>(*node);
+            QVector<QtTIExprNodePtr> items;
+            items.reserve(array.items().size());
+            bool isChanged = false;
+            bool isAllConstant = true;
+            for (const QtTIExprNodePtr &item : array.items()) {
+                items.append(fold(item, resolvePath));
+                isChanged = isChanged || (items.last() != item);
+                isAllConstant = isAllConstant && isConstant(items.last());
+            }
+            const QtTIExprNodePtr result = isChanged ? std::make_shared<QtTIExprArrayNode>(items) : node;
+            if (!isAllConstant)
+                return result;
+            return evalConstant(result);
+        }
+        case QtTIExprNode::Kind::Map: {
+            const QtTIExprMapNode &map = static_cast<const QtTIExprMapNode &>(*node);
+            QVector<QPair<QString, QtTIExprNodePtr>> items;
+            items.reserve(map.items().size());
+            bool isChanged = false;
+            bool isAllConstant = true;
+            for (const QPair<QString, QtTIExprNodePtr> &item : map.items()) {
+                items.append(qMakePair(item.first, fold(item.second, resolvePath)));
+                isChanged = isChanged || (items.last().second != item.second);
+                isAllConstant = isAllConstant && isConstant(items.last().second);
+            }
+            const QtTIExprNodePtr result = isChanged ? std::make_shared<QtTIExprMapNode>(items, map.isHash()) : node;
+            if (!isAllConstant)
+                return result;
+            return evalConstant(result);
+        }
+        case QtTIExprNode::Kind::Negate:
+        case QtTIExprNode::Kind::Not: {
+            const QtTIExprUnaryNode &unary = static_cast<const QtTIExprUnaryNode &>(*node);
+            const QtTIExprNodePtr operand = fold(unary.operand(), resolvePath);
+            const QtTIExprNodePtr result = (operand != unary.operand())
+                                           ? std::make_shared<QtTIExprUnaryNode>(node->kind(), operand)
+                                           : node;
+            if (!isConstant(operand))
+                return result;
+            return evalConstant(result);
+        }
+        case QtTIExprNode::Kind::Math: {
+            const QtTIExprMathNode &math = static_cast<const QtTIExprMathNode &>(*node);
+            const QtTIExprNodePtr left = fold(math.left(), resolvePath);
+            const QtTIExprNodePtr right = fold(math.right(), resolvePath);
+            const QtTIExprNodePtr result = (left != math.left() || right != math.right())
+                                           ? std::make_shared<QtTIExprMathNode>(math.op(), left, right)
+                                           : node;
+            if (!isConstant(left) || !isConstant(right))
+                return result;
+            return evalConstant(result);
+        }
+        case QtTIExprNode::Kind::Compare: {
+            const QtTIExprCompareNode &compare = static_cast<const QtTIExprCompareNode &>(*node);
+            const QtTIExprNodePtr left = fold(compare.left(), resolvePath);
+            const QtTIExprNodePtr right = fold(compare.right(), resolvePath);
+            const QtTIExprNodePtr result = (left != compare.left() || right != compare.right())
+                                           ? std::make_shared<QtTIExprCompareNode>(compare.op(), left, right)
+                                           : node;
+            if (!isConstant(left) || !isConstant(right))
+                return result;
+            return evalConstant(result);
+        }
+        case QtTIExprNode::Kind::And:
+        case QtTIExprNode::Kind::Or: {
+            const QtTIExprLogicNode &logic = static_cast<const QtTIExprLogicNode &>(*node);
+            const QtTIExprNodePtr left = fold(logic.left(), resolvePath);
+            const QtTIExprNodePtr right = fold(logic.right(), resolvePath);
+            const QtTIExprNodePtr result = (left != logic.left() || right != logic.right())
+                                           ? std::make_shared<QtTIExprLogicNode>(node->kind(), left, right)
+                                           : node;
+            if (!isConstant(left))
+                return result;
+            // the right operand is evaluated only if the left one does not define the result
+            const bool isRightNeeded = (node->kind() == QtTIExprNode::Kind::And) == isTrueConstant(left);
+            if (isRightNeeded && !isConstant(right))
+                return result;
+            return evalConstant(result);
+        }
+        case QtTIExprNode::Kind::Ternary: {
+            const QtTIExprTernaryNode &ternary = static_cast<const QtTIExprTernaryNode &>(*node);
+            const QtTIExprNodePtr cond = fold(ternary.cond(), resolvePath);
+            const QtTIExprNodePtr thenNode = fold(ternary.thenNode(), resolvePath);
+            const QtTIExprNodePtr elseNode = fold(ternary.elseNode(), resolvePath);
+            const QtTIExprNodePtr result = (cond != ternary.cond()
+                                            || thenNode != ternary.thenNode()
+                                            || elseNode != ternary.elseNode())
+                                           ? std::make_shared<QtTIExprTernaryNode>(cond, thenNode, elseNode)
+                                           : node;
+            if (!isConstant(cond))
+                return result;
+            const QtTIExprNodePtr &selected = isTrueConstant(cond) ? thenNode : elseNode;
+            if (selected && !isConstant(selected))
+                return result;
+            return evalConstant(result);
+        }
+        case QtTIExprNode::Kind::NullCoalescing: {
+            const QtTIExprNullCoalescingNode &nullCoalescing = static_cast<const QtTIExprNullCoalescingNode &>(*node);
+            const QtTIExprNodePtr left = fold(nullCoalescing.left(), resolvePath);
+            const QtTIExprNodePtr right = fold(nullCoalescing.right(), resolvePath);
+            const QtTIExprNodePtr result = (left != nullCoalescing.left() || right != nullCoalescing.right())
+                                           ? std::make_shared<QtTIExprNullCoalescingNode>(left, right)
+                                           : node;
+            if (!isConstant(left))
+                return result;
+            if (!isTrueConstant(left) && !isConstant(right))
+                return result;
+            return evalConstant(result);
+        }
+    }
+    return node;
+}
+
+
+// --- Private methods ---
+
+//!
+//! \brief Evaluate node with constant operands and replace it by the literal node
+//! \param node Expression node (all evaluated operands are literals)
+//! \return Literal node or the same node, if the evaluation is failed
+//!
+QtTIExprNodePtr QtTIExprFolder::evalConstant(const QtTIExprNodePtr &node)
+{
+    bool isOk = false;
+    QtTIValue value;
+    QString error;
+    std::tie(isOk, value, error) = node->evalValue(nullptr, nullptr);
+    if (!isOk)
+        return node;
+    return std::make_shared<QtTIExprLiteralNode>(value.toVariant());
+}
+
+//!
+//! \brief Check node is constant (literal)
+//! \param node Expression node
+//! \return
+//!
+bool QtTIExprFolder::isConstant(const QtTIExprNodePtr &node)
+{
+    return (node && node->kind() == QtTIExprNode::Kind::Literal);
+}
+
+//!
+//! \brief Check value of the literal node is true (see QtTIValue::isTrue)
+//! \param node Literal node
+//! \return
+//!
+bool QtTIExprFolder::isTrueConstant(const QtTIExprNodePtr &node)
+{
+    return std::get<1>(node->evalValue(nullptr, nullptr)).isTrue();
+}
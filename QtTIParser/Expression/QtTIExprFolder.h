@@ -0,0 +1,48 @@
+#ifndef QTTIEXPRFOLDER_H
+#define QTTIEXPRFOLDER_H
+
+#include <functional>
+
+#include "QtTIExprNode.h"
+
+//!
+//! \brief The QtTIExprFolder class
+//!
+//! Constant folding of the expression tree (see QtTIExpression::compile): the sub-expressions
+//! without parameters and help functions are evaluated once, when the expression is compiled,
+//! and replaced by the literal nodes (the result is kept as shared QVariant).
+//!
+//! Folded nodes:
+//!  - arrays and maps (hashes) of constant items: [1, 2, 3] / { 'a': 1, 'b': [2, 3] }
+//!  - math, comparison and unary operations on constant operands: 60 * 60 * 24 / not true
+//!  - 'and', 'or', ternary and null-coalescing operators, if all evaluated operands are constant
+//!
+//! NOTE: The node with the evaluation error is not folded (the error is returned on render).
+//! NOTE: The help functions are not called on compile (the functions can be changed after it),
+//!       the result of the pure function with constant arguments is cached on the first call
+//!       (see QtTIAbstractHelperFunction::isPure, QtTIFunctionCache::constantResult).
+//!
+//! The parameters can be replaced by constants (see PathResolver, QtTIProgramCompiler::specialize),
+//! the operations on them are folded as on the literals.
+//!
+//! === Example:
+//!     {{ value({ 'rub': 'RUB', 'usd': 'USD' }, currency) }}   - the map is built once
+//!     {{ price * (1 + 20 / 100) }}                           - '1 + 20 / 100' is folded to 1.2
+//!
+class QtTIExprFolder
+{
+public:
+    //!
+    //! \brief Parameter resolver: the constant node of the parameter, NULL - the parameter is not constant
+    //!
+    using PathResolver = std::function<QtTIExprNodePtr(const QtTIExprPathNode &)>;
+
+    static QtTIExprNodePtr fold(const QtTIExprNodePtr &node, const PathResolver &resolvePath = PathResolver());
+
+private:
+    static QtTIExprNodePtr evalConstant(const QtTIExprNodePtr &node);
+    static bool isConstant(const QtTIExprNodePtr &node);
+    static bool isTrueConstant(const QtTIExprNodePtr &node);
+};
+
+#endif // QTTIEXPRFOLDER_H
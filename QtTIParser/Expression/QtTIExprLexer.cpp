@@ -0,0 +1,186 @@
+#include "QtTIExprLexer.h"
+
+#include <QStringList>
+
+//!
+//! \brief Split expression into tokens
+//! \param expr Expression
+//! \return
+//!
+//! Tokens:
+//!     numbers     : 123 / i123 / ui123 / l123 / ul123 / 123.45 / d123.45 / f123.45 (the sign is a separate token)
+//!     strings     : '...' / "..." / s'...' / b'...' (the content is not unescaped)
+//!     booleans    : true / false / True / False / TRUE / FALSE
+//!     operators   : ** // == != <> >= <= => && || ?? + - * / % < > ? : , . ( ) [ ] { } and or not
+//!     identifiers : other words (after '.' any word is an identifier)
+//!
+//! The last token is always 'End'.
+//!
+std::tuple<bool, QVector<QtTIExprToken>, QString> QtTIExprLexer::tokenize(const QString &expr)
+{
+    static const QStringList twoCharOps({ "**", "//", "==", "!=", "<>", ">=", "<=", "=>", "&&", "||", "??" });
+    static const QString oneCharOps("+-*/%<>?:,.()[]{}");
+    static const QStringList boolWords({ "true", "false", "True", "False", "TRUE", "FALSE" });
+    static const QStringList opWords({ "and", "or", "not" });
+
+    QVector<QtTIExprToken> tokens;
+    const int size = expr.size();
+    int pos = 0;
+    while (pos < size) {
+        const QChar ch = expr[pos];
+        if (ch.isSpace()) {
+            pos++;
+            continue;
+        }
+
+        // string
+        if (ch == '\'' || ch == '"') {
+            int end = pos + 1;
+            while (end < size
+                   && !(expr[end] == ch && expr[end - 1] != '\\'))
+                end++;
+            if (end >= size)
+                return std::make_tuple(false, QVector<QtTIExprToken>(), QString("Unterminated string (position %1)").arg(pos));
+            tokens.append(QtTIExprToken(QtTIExprToken::Type::String, expr.mid(pos + 1, end - pos - 1), pos, end - pos + 1));
+            pos = end + 1;
+            continue;
+        }
+
+        // word
+        if (isWordChar(ch)) {
+            int end = pos;
+            while (end < size && isWordChar(expr[end]))
+                end++;
+            const QString word = expr.mid(pos, end - pos);
+            const QChar chNext = (end < size) ? expr[end] : QChar();
+
+            // path segment
+            if (!tokens.isEmpty() && tokens.last().isOperator(".")) {
+                tokens.append(QtTIExprToken(QtTIExprToken::Type::Identifier, word, pos, end - pos));
+                pos = end;
+                continue;
+            }
+
+            // string with type prefix
+            if ((word == "s" || word == "b")
+                && (chNext == '\'' || chNext == '"')) {
+                int strEnd = end + 1;
+                while (strEnd < size
+                       && !(expr[strEnd] == chNext && expr[strEnd - 1] != '\\'))
+                    strEnd++;
+                if (strEnd >= size)
+                    return std::make_tuple(false, QVector<QtTIExprToken>(), QString("Unterminated string (position %1)").arg(pos));
+                tokens.append(QtTIExprToken(QtTIExprToken::Type::String, expr.mid(end + 1, strEnd - end - 1), pos, strEnd - pos + 1, word));
+                pos = strEnd + 1;
+                continue;
+            }
+
+            // map with type prefix
+            if ((word == "m" || word == "h")
+                && chNext == '{') {
+                tokens.append(QtTIExprToken(QtTIExprToken::Type::Operator, "{", pos, end - pos + 1, word));
+                pos = end + 1;
+                continue;
+            }
+
+            // double
+            if (chNext == '.'
+                && end + 1 < size
+                && expr[end + 1].isDigit()) {
+                QString prefix;
+                if (word.startsWith('d') || word.startsWith('f'))
+                    prefix = word.left(1);
+                const QString digits = word.mid(prefix.size());
+                if (isDigits(digits)) {
+                    const int fracEnd = skipDigits(expr, end + 1);
+                    tokens.append(QtTIExprToken(QtTIExprToken::Type::Double,
+                                                digits + expr.mid(end, fracEnd - end),
+                                                pos,
+                                                fracEnd - pos,
+                                                prefix));
+                    pos = fracEnd;
+                    continue;
+                }
+            }
+
+            // integer
+            QString prefix;
+            if (word.startsWith("ui") || word.startsWith("ul"))
+                prefix = word.left(2);
+            else if (word.startsWith('i') || word.startsWith('l'))
+                prefix = word.left(1);
+            if (isDigits(word.mid(prefix.size()))) {
+                tokens.append(QtTIExprToken(QtTIExprToken::Type::Int, word.mid(prefix.size()), pos, end - pos, prefix));
+                pos = end;
+                continue;
+            }
+
+            if (boolWords.contains(word))
+                tokens.append(QtTIExprToken(QtTIExprToken::Type::Bool, word, pos, end - pos));
+            else if (opWords.contains(word))
+                tokens.append(QtTIExprToken(QtTIExprToken::Type::Operator, word, pos, end - pos));
+            else
+                tokens.append(QtTIExprToken(QtTIExprToken::Type::Identifier, word, pos, end - pos));
+            pos = end;
+            continue;
+        }
+
+        // operators
+        const QString op = expr.mid(pos, 2);
+        if (twoCharOps.contains(op)) {
+            tokens.append(QtTIExprToken(QtTIExprToken::Type::Operator, op, pos, 2));
+            pos += 2;
+            continue;
+        }
+        if (oneCharOps.contains(ch)) {
+            tokens.append(QtTIExprToken(QtTIExprToken::Type::Operator, QString(ch), pos, 1));
+            pos++;
+            continue;
+        }
+        return std::make_tuple(false, QVector<QtTIExprToken>(), QString("Unexpected character '%1' (position %2)").arg(ch).arg(pos));
+    }
+    tokens.append(QtTIExprToken(QtTIExprToken::Type::End, QString(), size, 0));
+    return std::make_tuple(true, tokens, "");
+}
+
+
+// --- Private methods ---
+
+//!
+//! \brief Check is word character (letter, digit or underscore)
+//! \param ch Character
+//! \return
+//!
+bool QtTIExprLexer::isWordChar(const QChar &ch)
+{
+    return (ch.isLetterOrNumber() || ch == '_');
+}
+
+//!
+//! \brief Check string contains only digits (and not empty)
+//! \param str String
+//! \return
+//!
+bool QtTIExprLexer::isDigits(const QString &str)
+{
+    if (str.isEmpty())
+        return false;
+    for (const QChar &ch : str) {
+        if (!ch.isDigit())
+            return false;
+    }
+    return true;
+}
+
+//!
+//! \brief Skip digits
+//! \param expr Expression
+//! \param pos Start position
+//! \return Position after the last digit
+//!
+int QtTIExprLexer::skipDigits(const QString &expr, int pos)
+{
+    while (pos < expr.size() && expr[pos].isDigit())
+        pos++;
+    return pos;
+}
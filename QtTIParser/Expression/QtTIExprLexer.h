@@ -0,0 +1,36 @@
+#ifndef QTTIEXPRLEXER_H
+#define QTTIEXPRLEXER_H
+
+#include <QString>
+#include <QVector>
+#include <tuple>
+
+#include "QtTIExprToken.h"
+
+//!
+//! \brief The QtTIExprLexer class
+//!
+//! Splits the expression into tokens in one pass (see QtTIExprToken).
+//!
+//! === Example:
+//!     a.b + -2 > size(c) ? 'yes' : 'no'
+//!
+//!     Identifier(a) Operator(.) Identifier(b) Operator(+) Operator(-) Int(2) Operator(>)
+//!     Identifier(size) Operator(() Identifier(c) Operator()) Operator(?) String(yes)
+//!     Operator(:) String(no) End
+//!
+class QtTIExprLexer
+{
+public:
+    QtTIExprLexer() = default;
+    ~QtTIExprLexer() = default;
+
+    static std::tuple<bool/*isOk*/,QVector<QtTIExprToken>/*res*/,QString/*err*/> tokenize(const QString &expr);
+
+private:
+    static bool isWordChar(const QChar &ch);
+    static bool isDigits(const QString &str);
+    static int skipDigits(const QString &expr, int pos);
+};
+
+#endif // QTTIEXPRLEXER_H
@@ -0,0 +1,413 @@
+#include "QtTIExprNode.h"
+
+//!
+//! \brief Check value is true
+//! \param value Value
+//! \return
+//!
+//! If 'value' type is bool - return bool value.
+//! If 'value' type is not bool - return check result value is not NULL.
+//!
+bool QtTIExprNode::isTrue(const QVariant &value)
+{
+    return QtTIParserLogic::compare(value);
+}
+
+//!
+//! \brief Evaluate node as QtTIValue
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+//! NOTE: By default the QVariant result of 'eval' is converted, the math, logic and ternary
+//!       nodes evaluate QtTIValue directly.
+//!
+std::tuple<bool, QtTIValue, QString> QtTIExprNode::evalValue(QtTIAbstractParserArgs *parserArgs,
+                                                             QtTIAbstractParserFunc *parserFunc) const
+{
+    bool isOk = false;
+    QVariant value;
+    QString error;
+    std::tie(isOk, value, error) = eval(parserArgs, parserFunc);
+    if (!isOk)
+        return std::make_tuple(false, QtTIValue(), error);
+    return std::make_tuple(true, QtTIValue::fromVariant(value), QString());
+}
+
+//!
+//! \brief Convert QtTIValue result of evaluation to QVariant result
+//! \param result
+//! \return
+//!
+std::tuple<bool, QVariant, QString> QtTIExprNode::toVariantResult(const std::tuple<bool, QtTIValue, QString> &result)
+{
+    return std::make_tuple(std::get<0>(result), std::get<1>(result).toVariant(), std::get<2>(result));
+}
+
+//!
+//! \brief Evaluate literal
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QVariant, QString> QtTIExprLiteralNode::eval(QtTIAbstractParserArgs *parserArgs,
+                                                              QtTIAbstractParserFunc *parserFunc) const
+{
+    Q_UNUSED(parserArgs)
+    Q_UNUSED(parserFunc)
+    return std::make_tuple(true, _value, "");
+}
+
+//!
+//! \brief Evaluate literal as QtTIValue
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QtTIValue, QString> QtTIExprLiteralNode::evalValue(QtTIAbstractParserArgs *parserArgs,
+                                                                    QtTIAbstractParserFunc *parserFunc) const
+{
+    Q_UNUSED(parserArgs)
+    Q_UNUSED(parserFunc)
+    return std::make_tuple(true, _constValue, QString());
+}
+
+//!
+//! \brief Evaluate parameter
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QVariant, QString> QtTIExprPathNode::eval(QtTIAbstractParserArgs *parserArgs,
+                                                           QtTIAbstractParserFunc *parserFunc) const
+{
+    Q_UNUSED(parserFunc)
+    if (_slot != -1) {
+        const QVariant &value = parserArgs->slotValue(_slot);
+        if (value.isValid())
+            return std::make_tuple(true, parserArgs->childParam(value, _path), "");
+    }
+
+    bool isFound = false;
+    QVariant value;
+    std::tie(isFound, value) = parserArgs->findParam(_path);
+    if (isFound)
+        return std::make_tuple(true, value, "");
+    std::tie(isFound, value) = parserArgs->findTmpParam(_path);
+    if (isFound)
+        return std::make_tuple(true, value, "");
+
+    return std::make_tuple(true, QVariant(), "");
+}
+
+//!
+//! \brief Evaluate help function
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QVariant, QString> QtTIExprCallNode::eval(QtTIAbstractParserArgs *parserArgs,
+                                                           QtTIAbstractParserFunc *parserFunc) const
+{
+    if (!parserFunc)
+        return std::make_tuple(false, QVariant(), "QtTIParserFunc is NULL");
+
+    QVariant result;
+    if (_isConstant && _functionCache->constantResult(parserFunc, result))
+        return std::make_tuple(true, result, "");
+
+    QVariantList argValues;
+    argValues.reserve(_args.size());
+    for (const QtTIExprNodePtr &arg : _args) {
+        bool isOk = false;
+        QVariant value;
+        QString error;
+        std::tie(isOk, value, error) = arg->eval(parserArgs, parserFunc);
+        if (!isOk)
+            return std::make_tuple(false, QVariant(), error);
+        argValues.append(value);
+    }
+
+    const QtTIAbstractHelperFunction *f = _functionCache->function(parserFunc, _name, argValues);
+    if (!f)
+        return std::make_tuple(false,
+                               QVariant(),
+                               QString("Not found help function '%1 (%2)'")
+                               .arg(_name,
+                                    QtTIAbstractHelperFunction::typesToStr(QtTIAbstractHelperFunction::vListArgsTypes(argValues))));
+    if (!_isConstant || !f->isPure())
+        return f->callFunction(argValues);
+
+    bool isOk = false;
+    QString error;
+    std::tie(isOk, result, error) = f->callFunction(argValues);
+    if (isOk)
+        _functionCache->setConstantResult(parserFunc, result);
+    return std::make_tuple(isOk, result, error);
+}
+
+//!
+//! \brief Evaluate array
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QVariant, QString> QtTIExprArrayNode::eval(QtTIAbstractParserArgs *parserArgs,
+                                                            QtTIAbstractParserFunc *parserFunc) const
+{
+    QVariantList result;
+    result.reserve(_items.size());
+    for (const QtTIExprNodePtr &item : _items) {
+        bool isOk = false;
+        QVariant value;
+        QString error;
+        std::tie(isOk, value, error) = item->eval(parserArgs, parserFunc);
+        if (!isOk)
+            return std::make_tuple(false, QVariant(), error);
+        result.append(value);
+    }
+    return std::make_tuple(true, result, "");
+}
+
+//!
+//! \brief Evaluate map or hash
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QVariant, QString> QtTIExprMapNode::eval(QtTIAbstractParserArgs *parserArgs,
+                                                          QtTIAbstractParserFunc *parserFunc) const
+{
+    QVariantMap resultMap;
+    QVariantHash resultHash;
+    for (const QPair<QString, QtTIExprNodePtr> &item : _items) {
+        bool isOk = false;
+        QVariant value;
+        QString error;
+        std::tie(isOk, value, error) = item.second->eval(parserArgs, parserFunc);
+        if (!isOk)
+            return std::make_tuple(false, QVariant(), error);
+        if (_isHash)
+            resultHash.insert(item.first, value);
+        else
+            resultMap.insert(item.first, value);
+    }
+    if (_isHash)
+        return std::make_tuple(true, resultHash, "");
+    return std::make_tuple(true, resultMap, "");
+}
+
+//!
+//! \brief Evaluate unary operation
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QVariant, QString> QtTIExprUnaryNode::eval(QtTIAbstractParserArgs *parserArgs,
+                                                            QtTIAbstractParserFunc *parserFunc) const
+{
+    return toVariantResult(evalValue(parserArgs, parserFunc));
+}
+
+//!
+//! \brief Evaluate unary operation as QtTIValue
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QtTIValue, QString> QtTIExprUnaryNode::evalValue(QtTIAbstractParserArgs *parserArgs,
+                                                                  QtTIAbstractParserFunc *parserFunc) const
+{
+    bool isOk = false;
+    QtTIValue value;
+    QString error;
+    std::tie(isOk, value, error) = _operand->evalValue(parserArgs, parserFunc);
+    if (!isOk)
+        return std::make_tuple(false, QtTIValue(), error);
+
+    if (kind() == Kind::Not)
+        return std::make_tuple(true, QtTIValue(!value.isTrue()), QString());
+    return QtTIParserMath::calcMathOperation(QtTIValue(0), value, QtTIParserMath::MathOperation::Subtract);
+}
+
+//!
+//! \brief Evaluate math operation
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QVariant, QString> QtTIExprMathNode::eval(QtTIAbstractParserArgs *parserArgs,
+                                                           QtTIAbstractParserFunc *parserFunc) const
+{
+    return toVariantResult(evalValue(parserArgs, parserFunc));
+}
+
+//!
+//! \brief Evaluate math operation as QtTIValue
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QtTIValue, QString> QtTIExprMathNode::evalValue(QtTIAbstractParserArgs *parserArgs,
+                                                                 QtTIAbstractParserFunc *parserFunc) const
+{
+    bool isOk = false;
+    QtTIValue left;
+    QtTIValue right;
+    QString error;
+    std::tie(isOk, left, error) = _left->evalValue(parserArgs, parserFunc);
+    if (!isOk)
+        return std::make_tuple(false, QtTIValue(), error);
+    std::tie(isOk, right, error) = _right->evalValue(parserArgs, parserFunc);
+    if (!isOk)
+        return std::make_tuple(false, QtTIValue(), error);
+
+    return QtTIParserMath::calcMathOperation(left, right, _op);
+}
+
+//!
+//! \brief Evaluate comparison
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QVariant, QString> QtTIExprCompareNode::eval(QtTIAbstractParserArgs *parserArgs,
+                                                              QtTIAbstractParserFunc *parserFunc) const
+{
+    return toVariantResult(evalValue(parserArgs, parserFunc));
+}
+
+//!
+//! \brief Evaluate comparison as QtTIValue
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QtTIValue, QString> QtTIExprCompareNode::evalValue(QtTIAbstractParserArgs *parserArgs,
+                                                                    QtTIAbstractParserFunc *parserFunc) const
+{
+    bool isOk = false;
+    QtTIValue left;
+    QtTIValue right;
+    QString error;
+    std::tie(isOk, left, error) = _left->evalValue(parserArgs, parserFunc);
+    if (!isOk)
+        return std::make_tuple(false, QtTIValue(), error);
+    std::tie(isOk, right, error) = _right->evalValue(parserArgs, parserFunc);
+    if (!isOk)
+        return std::make_tuple(false, QtTIValue(), error);
+
+    return std::make_tuple(true, QtTIValue(QtTIParserLogic::compare(left, right, _op)), QString());
+}
+
+//!
+//! \brief Evaluate logic operation
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QVariant, QString> QtTIExprLogicNode::eval(QtTIAbstractParserArgs *parserArgs,
+                                                            QtTIAbstractParserFunc *parserFunc) const
+{
+    return toVariantResult(evalValue(parserArgs, parserFunc));
+}
+
+//!
+//! \brief Evaluate logic operation as QtTIValue
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QtTIValue, QString> QtTIExprLogicNode::evalValue(QtTIAbstractParserArgs *parserArgs,
+                                                                  QtTIAbstractParserFunc *parserFunc) const
+{
+    bool isOk = false;
+    QtTIValue value;
+    QString error;
+    std::tie(isOk, value, error) = _left->evalValue(parserArgs, parserFunc);
+    if (!isOk)
+        return std::make_tuple(false, QtTIValue(), error);
+
+    const bool leftRes = value.isTrue();
+    // the result is known without the right operand
+    if (kind() == Kind::And && !leftRes)
+        return std::make_tuple(true, QtTIValue(false), QString());
+    if (kind() == Kind::Or && leftRes)
+        return std::make_tuple(true, QtTIValue(true), QString());
+
+    std::tie(isOk, value, error) = _right->evalValue(parserArgs, parserFunc);
+    if (!isOk)
+        return std::make_tuple(false, QtTIValue(), error);
+    return std::make_tuple(true, QtTIValue(value.isTrue()), QString());
+}
+
+//!
+//! \brief Evaluate ternary operator
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QVariant, QString> QtTIExprTernaryNode::eval(QtTIAbstractParserArgs *parserArgs,
+                                                              QtTIAbstractParserFunc *parserFunc) const
+{
+    return toVariantResult(evalValue(parserArgs, parserFunc));
+}
+
+//!
+//! \brief Evaluate ternary operator as QtTIValue
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QtTIValue, QString> QtTIExprTernaryNode::evalValue(QtTIAbstractParserArgs *parserArgs,
+                                                                    QtTIAbstractParserFunc *parserFunc) const
+{
+    bool isOk = false;
+    QtTIValue condValue;
+    QString error;
+    std::tie(isOk, condValue, error) = _cond->evalValue(parserArgs, parserFunc);
+    if (!isOk)
+        return std::make_tuple(false, QtTIValue(), error);
+
+    if (condValue.isTrue()) {
+        if (!_then)
+            return std::make_tuple(true, condValue, QString());
+        return _then->evalValue(parserArgs, parserFunc);
+    }
+    if (!_else)
+        return std::make_tuple(true, QtTIValue(), QString());
+    return _else->evalValue(parserArgs, parserFunc);
+}
+
+//!
+//! \brief Evaluate null-coalescing operator
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QVariant, QString> QtTIExprNullCoalescingNode::eval(QtTIAbstractParserArgs *parserArgs,
+                                                                     QtTIAbstractParserFunc *parserFunc) const
+{
+    return toVariantResult(evalValue(parserArgs, parserFunc));
+}
+
+//!
+//! \brief Evaluate null-coalescing operator as QtTIValue
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QtTIValue, QString> QtTIExprNullCoalescingNode::evalValue(QtTIAbstractParserArgs *parserArgs,
+                                                                           QtTIAbstractParserFunc *parserFunc) const
+{
+    bool isOk = false;
+    QtTIValue value;
+    QString error;
+    std::tie(isOk, value, error) = _left->evalValue(parserArgs, parserFunc);
+    if (!isOk)
+        return std::make_tuple(false, QtTIValue(), error);
+
+    if (value.isTrue())
+        return std::make_tuple(true, value, QString());
+    return _right->evalValue(parserArgs, parserFunc);
+}
@@ -0,0 +1,394 @@
+#ifndef QTTIEXPRNODE_H
+#define QTTIEXPRNODE_H
+
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include <QPair>
+#include <memory>
+#include <tuple>
+
+#include "../Abstract/QtTIAbstractParserArgs.h"
+#include "../Abstract/QtTIAbstractParserFunc.h"
+#include "../Logic/QtTIParserLogic.h"
+#include "../Math/QtTIParserMath.h"
+#include "../Scope/QtTIParamPath.h"
+#include "../Scope/QtTIScope.h"
+#include "../Scope/QtTIFunctionCache.h"
+#include "QtTIValue.h"
+
+class QtTIExprNode;
+using QtTIExprNodePtr = std::shared_ptr<const QtTIExprNode>;
+
+//!
+//! \brief The QtTIExprNode class
+//!
+//! Node of the expression tree (see QtTIExprParser). The tree is immutable after parsing
+//! and can be evaluated any number of times (also from several threads with different args).
+//!
+//! NOTE: The intermediate results of the math, logic and ternary nodes are passed as QtTIValue
+//!       (see evalValue), the result is converted to QVariant only by 'eval' of the root node.
+//!
+class QtTIExprNode
+{
+public:
+    //!
+    //! \brief Expression node kinds
+    //!
+    enum class Kind {
+        Literal = 0,    //!< constant value: 1, 'abc', true
+        Path,           //!< parameter: a / a.b / a.method(1)
+        Call,           //!< help function: func(a, b)
+        Array,          //!< array: [a, b]
+        Map,            //!< map or hash: { a: 1 } / h{ a: 1 }
+        Negate,         //!< -a
+        Not,            //!< not a
+        Math,           //!< a + b / a ** b / ...
+        Compare,        //!< a == b / a < b / ...
+        And,            //!< a and b / a && b
+        Or,             //!< a or b / a || b
+        Ternary,        //!< a ? b : c / a ?: c / a ? b
+        NullCoalescing  //!< a ?? b
+    };
+
+    explicit QtTIExprNode(const Kind kind)
+        : _kind(kind)
+    {}
+    virtual ~QtTIExprNode() = default;
+
+    //!
+    //! \brief Get node kind
+    //! \return
+    //!
+    Kind kind() const { return _kind; }
+
+    //!
+    //! \brief Evaluate node
+    //! \param parserArgs Render args
+    //! \param parserFunc Help functions
+    //! \return
+    //!
+    virtual std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> eval(QtTIAbstractParserArgs *parserArgs,
+                                                                         QtTIAbstractParserFunc *parserFunc) const = 0;
+    virtual std::tuple<bool/*isOk*/,QtTIValue/*res*/,QString/*err*/> evalValue(QtTIAbstractParserArgs *parserArgs,
+                                                                               QtTIAbstractParserFunc *parserFunc) const;
+
+    static bool isTrue(const QVariant &value);
+
+protected:
+    static std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> toVariantResult(const std::tuple<bool, QtTIValue, QString> &result);
+
+private:
+    Kind _kind {Kind::Literal}; //!< node kind
+};
+
+//!
+//! \brief The QtTIExprLiteralNode class
+//!
+class QtTIExprLiteralNode : public QtTIExprNode
+{
+public:
+    explicit QtTIExprLiteralNode(const QVariant &value)
+        : QtTIExprNode(Kind::Literal)
+        , _value(value)
+        , _constValue(QtTIValue::fromVariant(value))
+    {}
+
+    const QVariant &value() const { return _value; }
+
+    std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> eval(QtTIAbstractParserArgs *parserArgs,
+                                                                 QtTIAbstractParserFunc *parserFunc) const final;
+
+    std::tuple<bool/*isOk*/,QtTIValue/*res*/,QString/*err*/> evalValue(QtTIAbstractParserArgs *parserArgs,
+                                                                       QtTIAbstractParserFunc *parserFunc) const final;
+
+private:
+    QVariant _value;        //!< constant value
+    QtTIValue _constValue;  //!< constant value (unboxed)
+};
+
+//!
+//! \brief The QtTIExprPathNode class
+//!
+//! NOTE: The path is looked up in the global parameters first, then in the tmp parameters.
+//! An unknown parameter is evaluated as invalid QVariant (not an error).
+//!
+//! If the parameter has a slot (see QtTIScope) and the slot is set ('for' and 'set' variables),
+//! the value is taken from the slot, the rest of the path is evaluated on it.
+//!
+//! NOTE: The path is split into segments once, when the node is created (see QtTIParamPath).
+//!
+class QtTIExprPathNode : public QtTIExprNode
+{
+public:
+    explicit QtTIExprPathNode(const QString &path, QtTIScope *scope = nullptr)
+        : QtTIExprNode(Kind::Path)
+        , _path(path, scope)
+    {
+        if (scope && !_path.isEmpty() && !_path.segments().first().isMethod)
+            _slot = scope->slot(_path.name());
+    }
+
+    const QString &path() const { return _path.path(); }
+    const QtTIParamPath &paramPath() const { return _path; }
+    int slot() const { return _slot; }
+
+    std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> eval(QtTIAbstractParserArgs *parserArgs,
+                                                                 QtTIAbstractParserFunc *parserFunc) const final;
+
+private:
+    QtTIParamPath _path;    //!< parameter path
+    int _slot {-1};         //!< parameter slot index
+};
+
+//!
+//! \brief The QtTIExprCallNode class
+//!
+//! NOTE: The help function overload is cached by the argument types (see QtTIFunctionCache).
+//! NOTE: If all arguments are literals, the result of the pure help function is cached on the first
+//!       call (see QtTIAbstractHelperFunction::isPure).
+//!
+class QtTIExprCallNode : public QtTIExprNode
+{
+public:
+    QtTIExprCallNode(const QString &name, const QVector<QtTIExprNodePtr> &args)
+        : QtTIExprNode(Kind::Call)
+        , _name(name)
+        , _args(args)
+        , _functionCache(std::make_shared<QtTIFunctionCache>())
+    {
+        for (const QtTIExprNodePtr &arg : _args) {
+            if (arg->kind() != Kind::Literal) {
+                _isConstant = false;
+                break;
+            }
+        }
+    }
+
+    const QString &name() const { return _name; }
+    const QVector<QtTIExprNodePtr> &args() const { return _args; }
+    bool isConstant() const { return _isConstant; }
+
+    std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> eval(QtTIAbstractParserArgs *parserArgs,
+                                                                 QtTIAbstractParserFunc *parserFunc) const final;
+
+private:
+    QString _name;                  //!< help function name
+    QVector<QtTIExprNodePtr> _args; //!< help function arguments
+    std::shared_ptr<QtTIFunctionCache> _functionCache;  //!< help function overloads cache
+    bool _isConstant {true};        //!< all arguments are literals
+};
+
+//!
+//! \brief The QtTIExprArrayNode class
+//!
+class QtTIExprArrayNode : public QtTIExprNode
+{
+public:
+    explicit QtTIExprArrayNode(const QVector<QtTIExprNodePtr> &items)
+        : QtTIExprNode(Kind::Array)
+        , _items(items)
+    {}
+
+    const QVector<QtTIExprNodePtr> &items() const { return _items; }
+
+    std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> eval(QtTIAbstractParserArgs *parserArgs,
+                                                                 QtTIAbstractParserFunc *parserFunc) const final;
+
+private:
+    QVector<QtTIExprNodePtr> _items; //!< array items
+};
+
+//!
+//! \brief The QtTIExprMapNode class
+//!
+class QtTIExprMapNode : public QtTIExprNode
+{
+public:
+    QtTIExprMapNode(const QVector<QPair<QString, QtTIExprNodePtr>> &items, const bool isHash)
+        : QtTIExprNode(Kind::Map)
+        , _items(items)
+        , _isHash(isHash)
+    {}
+
+    const QVector<QPair<QString, QtTIExprNodePtr>> &items() const { return _items; }
+    bool isHash() const { return _isHash; }
+
+    std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> eval(QtTIAbstractParserArgs *parserArgs,
+                                                                 QtTIAbstractParserFunc *parserFunc) const final;
+
+private:
+    QVector<QPair<QString, QtTIExprNodePtr>> _items; //!< map keys and values
+    bool _isHash {false};                             //!< QVariantHash (true) or QVariantMap (false)
+};
+
+//!
+//! \brief The QtTIExprUnaryNode class
+//!
+//! Kind::Negate - arithmetic negation (0 - value)
+//! Kind::Not    - logical negation (result is bool)
+//!
+class QtTIExprUnaryNode : public QtTIExprNode
+{
+public:
+    QtTIExprUnaryNode(const Kind kind, const QtTIExprNodePtr &operand)
+        : QtTIExprNode(kind)
+        , _operand(operand)
+    {}
+
+    const QtTIExprNodePtr &operand() const { return _operand; }
+
+    std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> eval(QtTIAbstractParserArgs *parserArgs,
+                                                                 QtTIAbstractParserFunc *parserFunc) const final;
+    std::tuple<bool/*isOk*/,QtTIValue/*res*/,QString/*err*/> evalValue(QtTIAbstractParserArgs *parserArgs,
+                                                                       QtTIAbstractParserFunc *parserFunc) const final;
+
+private:
+    QtTIExprNodePtr _operand; //!< operand
+};
+
+//!
+//! \brief The QtTIExprMathNode class
+//!
+class QtTIExprMathNode : public QtTIExprNode
+{
+public:
+    QtTIExprMathNode(const QtTIParserMath::MathOperation op, const QtTIExprNodePtr &left, const QtTIExprNodePtr &right)
+        : QtTIExprNode(Kind::Math)
+        , _op(op)
+        , _left(left)
+        , _right(right)
+    {}
+
+    QtTIParserMath::MathOperation op() const { return _op; }
+    const QtTIExprNodePtr &left() const { return _left; }
+    const QtTIExprNodePtr &right() const { return _right; }
+
+    std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> eval(QtTIAbstractParserArgs *parserArgs,
+                                                                 QtTIAbstractParserFunc *parserFunc) const final;
+    std::tuple<bool/*isOk*/,QtTIValue/*res*/,QString/*err*/> evalValue(QtTIAbstractParserArgs *parserArgs,
+                                                                       QtTIAbstractParserFunc *parserFunc) const final;
+
+private:
+    QtTIParserMath::MathOperation _op {QtTIParserMath::MathOperation::Invalid}; //!< math operation: + - * / % // **
+    QtTIExprNodePtr _left;  //!< left operand
+    QtTIExprNodePtr _right; //!< right operand
+};
+
+//!
+//! \brief The QtTIExprCompareNode class
+//!
+class QtTIExprCompareNode : public QtTIExprNode
+{
+public:
+    QtTIExprCompareNode(const QtTIParserLogic::LogicalOperation op, const QtTIExprNodePtr &left, const QtTIExprNodePtr &right)
+        : QtTIExprNode(Kind::Compare)
+        , _op(op)
+        , _left(left)
+        , _right(right)
+    {}
+
+    QtTIParserLogic::LogicalOperation op() const { return _op; }
+    const QtTIExprNodePtr &left() const { return _left; }
+    const QtTIExprNodePtr &right() const { return _right; }
+
+    std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> eval(QtTIAbstractParserArgs *parserArgs,
+                                                                 QtTIAbstractParserFunc *parserFunc) const final;
+    std::tuple<bool/*isOk*/,QtTIValue/*res*/,QString/*err*/> evalValue(QtTIAbstractParserArgs *parserArgs,
+                                                                       QtTIAbstractParserFunc *parserFunc) const final;
+
+private:
+    QtTIParserLogic::LogicalOperation _op {QtTIParserLogic::LogicalOperation::Invalid}; //!< comparison operation
+    QtTIExprNodePtr _left;  //!< left operand
+    QtTIExprNodePtr _right; //!< right operand
+};
+
+//!
+//! \brief The QtTIExprLogicNode class
+//!
+//! Kind::And / Kind::Or - the right operand is evaluated only if needed (result is bool)
+//!
+class QtTIExprLogicNode : public QtTIExprNode
+{
+public:
+    QtTIExprLogicNode(const Kind kind, const QtTIExprNodePtr &left, const QtTIExprNodePtr &right)
+        : QtTIExprNode(kind)
+        , _left(left)
+        , _right(right)
+    {}
+
+    const QtTIExprNodePtr &left() const { return _left; }
+    const QtTIExprNodePtr &right() const { return _right; }
+
+    std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> eval(QtTIAbstractParserArgs *parserArgs,
+                                                                 QtTIAbstractParserFunc *parserFunc) const final;
+    std::tuple<bool/*isOk*/,QtTIValue/*res*/,QString/*err*/> evalValue(QtTIAbstractParserArgs *parserArgs,
+                                                                       QtTIAbstractParserFunc *parserFunc) const final;
+
+private:
+    QtTIExprNodePtr _left;  //!< left operand
+    QtTIExprNodePtr _right; //!< right operand
+};
+
+//!
+//! \brief The QtTIExprTernaryNode class
+//!
+//!     cond ? then : else
+//!     cond ?: else        ('then' is NULL, the condition value is returned if it is true)
+//!     cond ? then         ('else' is NULL, invalid QVariant is returned if the condition is false)
+//!
+//! NOTE: Only the selected branch is evaluated.
+//!
+class QtTIExprTernaryNode : public QtTIExprNode
+{
+public:
+    QtTIExprTernaryNode(const QtTIExprNodePtr &cond, const QtTIExprNodePtr &thenNode, const QtTIExprNodePtr &elseNode)
+        : QtTIExprNode(Kind::Ternary)
+        , _cond(cond)
+        , _then(thenNode)
+        , _else(elseNode)
+    {}
+
+    const QtTIExprNodePtr &cond() const { return _cond; }
+    const QtTIExprNodePtr &thenNode() const { return _then; }
+    const QtTIExprNodePtr &elseNode() const { return _else; }
+
+    std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> eval(QtTIAbstractParserArgs *parserArgs,
+                                                                 QtTIAbstractParserFunc *parserFunc) const final;
+    std::tuple<bool/*isOk*/,QtTIValue/*res*/,QString/*err*/> evalValue(QtTIAbstractParserArgs *parserArgs,
+                                                                       QtTIAbstractParserFunc *parserFunc) const final;
+
+private:
+    QtTIExprNodePtr _cond;  //!< condition
+    QtTIExprNodePtr _then;  //!< value if true
+    QtTIExprNodePtr _else;  //!< value if false
+};
+
+//!
+//! \brief The QtTIExprNullCoalescingNode class
+//!
+//! NOTE: The right operand is evaluated only if the left one is NULL (or false).
+//!
+class QtTIExprNullCoalescingNode : public QtTIExprNode
+{
+public:
+    QtTIExprNullCoalescingNode(const QtTIExprNodePtr &left, const QtTIExprNodePtr &right)
+        : QtTIExprNode(Kind::NullCoalescing)
+        , _left(left)
+        , _right(right)
+    {}
+
+    const QtTIExprNodePtr &left() const { return _left; }
+    const QtTIExprNodePtr &right() const { return _right; }
+
+    std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> eval(QtTIAbstractParserArgs *parserArgs,
+                                                                 QtTIAbstractParserFunc *parserFunc) const final;
+    std::tuple<bool/*isOk*/,QtTIValue/*res*/,QString/*err*/> evalValue(QtTIAbstractParserArgs *parserArgs,
+                                                                       QtTIAbstractParserFunc *parserFunc) const final;
+
+private:
+    QtTIExprNodePtr _left;  //!< value
+    QtTIExprNodePtr _right; //!< default value
+};
+
+#endif // QTTIEXPRNODE_H
@@ -0,0 +1,566 @@
+#include "QtTIExprParser.h"
+#include "QtTIExprLexer.h"
+
+QtTIExprParser::QtTIExprParser(const QString &expr, const QVector<QtTIExprToken> &tokens, QtTIScope *scope)
+    : _expr(expr)
+    , _tokens(tokens)
+    , _scope(scope)
+{}
+
+//!
+//! \brief Parse expression
+//! \param expr Expression
+//! \param scope Variable slots of the compiled template (the parameters get slot indices), can be NULL
+//! \return
+//!
+//! === Supported expressions:
+//!     literals    : 1 / -2 / ul3 / 1.5 / f1.5 / 'abc' / b"abc" / true / [1, 2] / { a: 1, b => 2 } / h{ a: 1 }
+//!     parameters  : a / a.b.c / a.method(1)
+//!     functions   : func() / func(a, 1 + 2)
+//!     math        : a + b / a - b / a * b / a / b / a % b / a // b / a ** b / -a
+//!     comparison  : a == b / a != b / a <> b / a > b / a < b / a >= b / a <= b
+//!     logic       : a and b / a && b / a or b / a || b / not a
+//!     ternary     : a ? b : c / a ?: c / a ? b
+//!     null-coalescing : a ?? b
+//!     brackets    : (a + b) * c
+//!
+std::tuple<bool, QtTIExprNodePtr, QString> QtTIExprParser::parse(const QString &expr, QtTIScope *scope)
+{
+    bool isOk = false;
+    QVector<QtTIExprToken> tokens;
+    QString error;
+    std::tie(isOk, tokens, error) = QtTIExprLexer::tokenize(expr);
+    if (!isOk)
+        return std::make_tuple(false, nullptr, error);
+    if (tokens.size() <= 1)
+        return std::make_tuple(false, nullptr, "Expression is empty");
+
+    QtTIExprParser parser(expr, tokens, scope);
+    QtTIExprNodePtr root = parser.parseTernary();
+    if (root && parser.current().type() != QtTIExprToken::Type::End)
+        root = parser.unexpected();
+    if (!root)
+        return std::make_tuple(false, nullptr, parser._error);
+
+    return std::make_tuple(true, root, "");
+}
+
+
+// --- Private methods ---
+
+//!
+//! \brief Parse ternary operator
+//! \return
+//!
+//! === Example:
+//!     a ? b : c
+//!     a ?: c
+//!     a ? b
+//!
+QtTIExprNodePtr QtTIExprParser::parseTernary()
+{
+    QtTIExprNodePtr cond = parseNullCoalescing();
+    if (!cond)
+        return nullptr;
+    if (!accept("?"))
+        return cond;
+
+    if (accept(":")) {
+        QtTIExprNodePtr elseNode = parseTernary();
+        if (!elseNode)
+            return nullptr;
+        return std::make_shared<QtTIExprTernaryNode>(cond, nullptr, elseNode);
+    }
+
+    QtTIExprNodePtr thenNode = parseTernary();
+    if (!thenNode)
+        return nullptr;
+    QtTIExprNodePtr elseNode;
+    if (accept(":")) {
+        elseNode = parseTernary();
+        if (!elseNode)
+            return nullptr;
+    }
+    return std::make_shared<QtTIExprTernaryNode>(cond, thenNode, elseNode);
+}
+
+//!
+//! \brief Parse null-coalescing operator
+//! \return
+//!
+QtTIExprNodePtr QtTIExprParser::parseNullCoalescing()
+{
+    QtTIExprNodePtr left = parseOr();
+    while (left && accept("??")) {
+        QtTIExprNodePtr right = parseOr();
+        if (!right)
+            return nullptr;
+        left = std::make_shared<QtTIExprNullCoalescingNode>(left, right);
+    }
+    return left;
+}
+
+//!
+//! \brief Parse logic 'or'
+//! \return
+//!
+QtTIExprNodePtr QtTIExprParser::parseOr()
+{
+    QtTIExprNodePtr left = parseAnd();
+    while (left && (accept("or") || accept("||"))) {
+        QtTIExprNodePtr right = parseAnd();
+        if (!right)
+            return nullptr;
+        left = std::make_shared<QtTIExprLogicNode>(QtTIExprNode::Kind::Or, left, right);
+    }
+    return left;
+}
+
+//!
+//! \brief Parse logic 'and'
+//! \return
+//!
+QtTIExprNodePtr QtTIExprParser::parseAnd()
+{
+    QtTIExprNodePtr left = parseNot();
+    while (left && (accept("and") || accept("&&"))) {
+        QtTIExprNodePtr right = parseNot();
+        if (!right)
+            return nullptr;
+        left = std::make_shared<QtTIExprLogicNode>(QtTIExprNode::Kind::And, left, right);
+    }
+    return left;
+}
+
+//!
+//! \brief Parse logic 'not'
+//! \return
+//!
+QtTIExprNodePtr QtTIExprParser::parseNot()
+{
+    if (!accept("not"))
+        return parseCompare();
+
+    QtTIExprNodePtr operand = parseNot();
+    if (!operand)
+        return nullptr;
+    return std::make_shared<QtTIExprUnaryNode>(QtTIExprNode::Kind::Not, operand);
+}
+
+//!
+//! \brief Parse comparison
+//! \return
+//!
+QtTIExprNodePtr QtTIExprParser::parseCompare()
+{
+    QtTIExprNodePtr left = parseAdditive();
+    if (!left
+        || current().type() != QtTIExprToken::Type::Operator)
+        return left;
+
+    const QtTIParserLogic::LogicalOperation op = QtTIParserLogic::strToOperation(current().text());
+    if (op == QtTIParserLogic::LogicalOperation::Invalid)
+        return left;
+    _index++;
+
+    QtTIExprNodePtr right = parseAdditive();
+    if (!right)
+        return nullptr;
+    return std::make_shared<QtTIExprCompareNode>(op, left, right);
+}
+
+//!
+//! \brief Parse math '+' and '-'
+//! \return
+//!
+QtTIExprNodePtr QtTIExprParser::parseAdditive()
+{
+    QtTIExprNodePtr left = parseMultiplicative();
+    while (left
+           && (current().isOperator("+") || current().isOperator("-"))) {
+        const QtTIParserMath::MathOperation op = QtTIParserMath::strToOperation(current().text());
+        _index++;
+        QtTIExprNodePtr right = parseMultiplicative();
+        if (!right)
+            return nullptr;
+        left = std::make_shared<QtTIExprMathNode>(op, left, right);
+    }
+    return left;
+}
+
+//!
+//! \brief Parse math '*', '/', '%' and '//'
+//! \return
+//!
+QtTIExprNodePtr QtTIExprParser::parseMultiplicative()
+{
+    QtTIExprNodePtr left = parseUnary();
+    while (left
+           && (current().isOperator("*")
+               || current().isOperator("/")
+               || current().isOperator("%")
+               || current().isOperator("//"))) {
+        const QtTIParserMath::MathOperation op = QtTIParserMath::strToOperation(current().text());
+        _index++;
+        QtTIExprNodePtr right = parseUnary();
+        if (!right)
+            return nullptr;
+        left = std::make_shared<QtTIExprMathNode>(op, left, right);
+    }
+    return left;
+}
+
+//!
+//! \brief Parse unary '-' and '+'
+//! \return
+//!
+QtTIExprNodePtr QtTIExprParser::parseUnary()
+{
+    if ((!current().isOperator("-") && !current().isOperator("+"))
+        || isSignedNumber())
+        return parsePower();
+
+    const bool isNegate = current().isOperator("-");
+    _index++;
+    QtTIExprNodePtr operand = parseUnary();
+    if (!operand || !isNegate)
+        return operand;
+    return std::make_shared<QtTIExprUnaryNode>(QtTIExprNode::Kind::Negate, operand);
+}
+
+//!
+//! \brief Parse math '**'
+//! \return
+//!
+QtTIExprNodePtr QtTIExprParser::parsePower()
+{
+    QtTIExprNodePtr left = parsePrimary();
+    while (left && accept("**")) {
+        QtTIExprNodePtr right = parsePowerOperand();
+        if (!right)
+            return nullptr;
+        left = std::make_shared<QtTIExprMathNode>(QtTIParserMath::MathOperation::Power, left, right);
+    }
+    return left;
+}
+
+//!
+//! \brief Parse right operand of '**' (may have unary '-' or '+')
+//! \return
+//!
+QtTIExprNodePtr QtTIExprParser::parsePowerOperand()
+{
+    if ((!current().isOperator("-") && !current().isOperator("+"))
+        || isSignedNumber())
+        return parsePrimary();
+
+    const bool isNegate = current().isOperator("-");
+    _index++;
+    QtTIExprNodePtr operand = parsePowerOperand();
+    if (!operand || !isNegate)
+        return operand;
+    return std::make_shared<QtTIExprUnaryNode>(QtTIExprNode::Kind::Negate, operand);
+}
+
+//!
+//! \brief Parse literal, parameter, function or brackets
+//! \return
+//!
+QtTIExprNodePtr QtTIExprParser::parsePrimary()
+{
+    const QtTIExprToken &token = current();
+    if (isSignedNumber()) {
+        _index++;
+        return parseNumber(token.text());
+    }
+
+    switch (token.type()) {
+        case QtTIExprToken::Type::Int:
+        case QtTIExprToken::Type::Double:
+            return parseNumber(QString());
+        case QtTIExprToken::Type::String: {
+            _index++;
+            if (token.prefix() == "b")
+                return std::make_shared<QtTIExprLiteralNode>(QVariant(token.text().toUtf8()));
+            return std::make_shared<QtTIExprLiteralNode>(QVariant(token.text()));
+        }
+        case QtTIExprToken::Type::Bool: {
+            _index++;
+            return std::make_shared<QtTIExprLiteralNode>(QVariant(token.text().toLower() == "true"));
+        }
+        case QtTIExprToken::Type::Identifier: {
+            if (next().isOperator("("))
+                return parseCall();
+            return parsePath();
+        }
+        case QtTIExprToken::Type::Operator: {
+            if (accept("(")) {
+                QtTIExprNodePtr node = parseTernary();
+                if (!node || !expect(")"))
+                    return nullptr;
+                return node;
+            }
+            if (token.isOperator("["))
+                return parseArray();
+            if (token.isOperator("{"))
+                return parseMap();
+            break;
+        }
+        default:
+            break;
+    }
+    return unexpected();
+}
+
+//!
+//! \brief Parse number literal
+//! \param sign Number sign ('-', '+' or empty)
+//! \return
+//!
+QtTIExprNodePtr QtTIExprParser::parseNumber(const QString &sign)
+{
+    const QtTIExprToken &token = current();
+    _index++;
+    const QString value = sign + token.text();
+    if (token.type() == QtTIExprToken::Type::Double) {
+        if (token.prefix() == "f")
+            return std::make_shared<QtTIExprLiteralNode>(QVariant(value.toFloat()));
+        return std::make_shared<QtTIExprLiteralNode>(QVariant(value.toDouble()));
+    }
+    if (token.prefix() == "l")
+        return std::make_shared<QtTIExprLiteralNode>(QVariant(value.toLongLong()));
+    else if (token.prefix() == "ul")
+        return std::make_shared<QtTIExprLiteralNode>(QVariant(value.toULongLong()));
+    else if (token.prefix() == "ui")
+        return std::make_shared<QtTIExprLiteralNode>(QVariant(value.toUInt()));
+    return std::make_shared<QtTIExprLiteralNode>(QVariant(value.toInt()));
+}
+
+//!
+//! \brief Parse array
+//! \return
+//!
+//! === Example:
+//!     [ 1, -2, 'abc', a.b ]
+//!
+QtTIExprNodePtr QtTIExprParser::parseArray()
+{
+    _index++; // '['
+    QVector<QtTIExprNodePtr> items;
+    if (!parseList("]", items))
+        return nullptr;
+    return std::make_shared<QtTIExprArrayNode>(items);
+}
+
+//!
+//! \brief Parse map or hash
+//! \return
+//!
+//! === Example:
+//!     { a: 1, 'b': 'abc', c => a.b }
+//!     h{ a: 1 }
+//!
+QtTIExprNodePtr QtTIExprParser::parseMap()
+{
+    const bool isHash = (current().prefix() == "h");
+    _index++; // '{'
+    QVector<QPair<QString, QtTIExprNodePtr>> items;
+    if (accept("}"))
+        return std::make_shared<QtTIExprMapNode>(items, isHash);
+
+    while (true) {
+        const QtTIExprToken &keyToken = current();
+        QString key;
+        switch (keyToken.type()) {
+            case QtTIExprToken::Type::String:
+                key = keyToken.text();
+                break;
+            case QtTIExprToken::Type::Identifier:
+            case QtTIExprToken::Type::Int:
+            case QtTIExprToken::Type::Double:
+            case QtTIExprToken::Type::Bool:
+                key = _expr.mid(keyToken.pos(), keyToken.length());
+                break;
+            default:
+                return unexpected();
+        }
+        _index++;
+        if (!accept(":") && !accept("=>")) {
+            _error = QString("Expected ':' or '=>' (position %1)").arg(current().pos());
+            return nullptr;
+        }
+
+        QtTIExprNodePtr value = parseTernary();
+        if (!value)
+            return nullptr;
+        items.append(qMakePair(key, value));
+
+        if (accept("}"))
+            break;
+        if (!expect(","))
+            return nullptr;
+    }
+    return std::make_shared<QtTIExprMapNode>(items, isHash);
+}
+
+//!
+//! \brief Parse help function
+//! \return
+//!
+//! === Example:
+//!     func (a, 'b', 1 + 2)
+//!
+QtTIExprNodePtr QtTIExprParser::parseCall()
+{
+    const QString name = current().text();
+    _index += 2; // name and '('
+    QVector<QtTIExprNodePtr> args;
+    if (!parseList(")", args))
+        return nullptr;
+    return std::make_shared<QtTIExprCallNode>(name, args);
+}
+
+//!
+//! \brief Parse parameter path
+//! \return
+//!
+//! NOTE: The arguments of class methods are passed as is (see QtTIParserArgs::param).
+//!
+//! === Example:
+//!     a.b.c
+//!     a.index(1).name
+//!
+QtTIExprNodePtr QtTIExprParser::parsePath()
+{
+    QString path;
+    while (true) {
+        path += current().text();
+        _index++;
+
+        // class method
+        if (current().isOperator("(")) {
+            const int argsStart = current().pos() + 1;
+            int openBrackets = 0;
+            while (true) {
+                const QtTIExprToken &token = current();
+                if (token.type() == QtTIExprToken::Type::End) {
+                    _error = QString("Expected ')' (position %1)").arg(token.pos());
+                    return nullptr;
+                }
+                if (token.isOperator("("))
+                    openBrackets++;
+                if (token.isOperator(")")
+                    && --openBrackets == 0)
+                    break;
+                _index++;
+            }
+            path += QString("(%1)").arg(_expr.mid(argsStart, current().pos() - argsStart).trimmed());
+            _index++;
+        }
+
+        // next segment: name or list index
+        if (!current().isOperator(".")
+            || (next().type() != QtTIExprToken::Type::Identifier
+                && !(next().type() == QtTIExprToken::Type::Int && next().prefix().isEmpty())))
+            break;
+        path += '.';
+        _index++;
+    }
+    return std::make_shared<QtTIExprPathNode>(path, _scope);
+}
+
+//!
+//! \brief Parse comma separated expressions up to the closing operator
+//! \param closeOp Closing operator
+//! \param[out] items Parsed expressions
+//! \return
+//!
+bool QtTIExprParser::parseList(const char *closeOp, QVector<QtTIExprNodePtr> &items)
+{
+    if (accept(closeOp))
+        return true;
+
+    while (true) {
+        QtTIExprNodePtr item = parseTernary();
+        if (!item)
+            return false;
+        items.append(item);
+
+        if (accept(closeOp))
+            return true;
+        if (!expect(","))
+            return false;
+    }
+}
+
+//!
+//! \brief Get current token
+//! \return
+//!
+const QtTIExprToken &QtTIExprParser::current() const
+{
+    return _tokens[qMin(_index, _tokens.size() - 1)];
+}
+
+//!
+//! \brief Get token after current
+//! \return
+//!
+const QtTIExprToken &QtTIExprParser::next() const
+{
+    return _tokens[qMin(_index + 1, _tokens.size() - 1)];
+}
+
+//!
+//! \brief Check current token is sign of number literal
+//! \return
+//!
+bool QtTIExprParser::isSignedNumber() const
+{
+    return ((current().isOperator("-") || current().isOperator("+"))
+            && (next().type() == QtTIExprToken::Type::Int
+                || next().type() == QtTIExprToken::Type::Double));
+}
+
+//!
+//! \brief Skip current token if it is the operator
+//! \param op Operator
+//! \return
+//!
+bool QtTIExprParser::accept(const char *op)
+{
+    if (!current().isOperator(op))
+        return false;
+    _index++;
+    return true;
+}
+
+//!
+//! \brief Skip current token if it is the operator (else set error)
+//! \param op Operator
+//! \return
+//!
+bool QtTIExprParser::expect(const char *op)
+{
+    if (accept(op))
+        return true;
+    if (_error.isEmpty())
+        _error = QString("Expected '%1' (position %2)").arg(op).arg(current().pos());
+    return false;
+}
+
+//!
+//! \brief Set error for unexpected current token
+//! \return NULL
+//!
+QtTIExprNodePtr QtTIExprParser::unexpected()
+{
+    if (_error.isEmpty()) {
+        const QtTIExprToken &token = current();
+        if (token.type() == QtTIExprToken::Type::End)
+            _error = QString("Unexpected end of expression");
+        else
+            _error = QString("Unexpected token '%1' (position %2)").arg(_expr.mid(token.pos(), token.length())).arg(token.pos());
+    }
+    return nullptr;
+}
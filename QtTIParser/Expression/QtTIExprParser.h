@@ -0,0 +1,83 @@
+#ifndef QTTIEXPRPARSER_H
+#define QTTIEXPRPARSER_H
+
+#include <QString>
+#include <QVector>
+#include <tuple>
+
+#include "QtTIExprToken.h"
+#include "QtTIExprNode.h"
+#include "../Scope/QtTIScope.h"
+
+//!
+//! \brief The QtTIExprParser class
+//!
+//! Recursive descent (precedence climbing) parser of the expression into the tree of
+//! QtTIExprNode. The expression is tokenized and parsed in one linear pass.
+//!
+//! === Operator priority (from lowest to highest):
+//!     ?: ?                     (ternary, right-associative)
+//!     ??                       (null-coalescing)
+//!     or ||
+//!     and &&
+//!     not
+//!     == != <> > < >= <=
+//!     + -
+//!     * / % //
+//!     - (unary)
+//!     **                       (left-associative)
+//!     literals, parameters, functions, ( ... ), [ ... ], { ... }
+//!
+//! NOTE: The sign before a number is a part of the number literal ('-2 ** 2' is 4).
+//!
+//! === Example:
+//!     bool isOk = false;
+//!     QtTIExprNodePtr root;
+//!     QString error;
+//!     std::tie(isOk, root, error) = QtTIExprParser::parse("(a + b) * 2 > 10 ? 'yes' : 'no'");
+//!
+class QtTIExprParser
+{
+public:
+    ~QtTIExprParser() = default;
+
+    static std::tuple<bool/*isOk*/,QtTIExprNodePtr/*res*/,QString/*err*/> parse(const QString &expr, QtTIScope *scope = nullptr);
+
+private:
+    QtTIExprParser(const QString &expr, const QVector<QtTIExprToken> &tokens, QtTIScope *scope);
+
+    QtTIExprNodePtr parseTernary();
+    QtTIExprNodePtr parseNullCoalescing();
+    QtTIExprNodePtr parseOr();
+    QtTIExprNodePtr parseAnd();
+    QtTIExprNodePtr parseNot();
+    QtTIExprNodePtr parseCompare();
+    QtTIExprNodePtr parseAdditive();
+    QtTIExprNodePtr parseMultiplicative();
+    QtTIExprNodePtr parseUnary();
+    QtTIExprNodePtr parsePower();
+    QtTIExprNodePtr parsePowerOperand();
+    QtTIExprNodePtr parsePrimary();
+    QtTIExprNodePtr parseNumber(const QString &sign);
+    QtTIExprNodePtr parseArray();
+    QtTIExprNodePtr parseMap();
+    QtTIExprNodePtr parseCall();
+    QtTIExprNodePtr parsePath();
+
+    bool parseList(const char *closeOp, QVector<QtTIExprNodePtr> &items);
+
+    const QtTIExprToken &current() const;
+    const QtTIExprToken &next() const;
+    bool isSignedNumber() const;
+    bool accept(const char *op);
+    bool expect(const char *op);
+    QtTIExprNodePtr unexpected();
+
+    const QString &_expr;               //!< expression
+    QVector<QtTIExprToken> _tokens;     //!< expression tokens
+    QtTIScope *_scope {nullptr};        //!< variable slots (optional)
+    int _index {0};                     //!< current token index
+    QString _error;                     //!< parse error
+};
+
+#endif // QTTIEXPRPARSER_H
@@ -0,0 +1,91 @@
+#ifndef QTTIEXPRTOKEN_H
+#define QTTIEXPRTOKEN_H
+
+#include <QString>
+
+//!
+//! \brief The QtTIExprToken class
+//!
+//! One token of the expression (see QtTIExprLexer):
+//!  - Int / Double : number literal ('text' - digits, 'prefix' - type prefix: i, ui, l, ul, d, f)
+//!  - String       : string literal ('text' - string content, 'prefix' - type prefix: s, b)
+//!  - Bool         : boolean literal
+//!  - Identifier   : parameter, function or method name
+//!  - Operator     : operator or punctuation (and, or, not are operators too; 'prefix' of '{' - map type: m, h)
+//!  - End          : end of the expression
+//!
+class QtTIExprToken
+{
+public:
+    enum class Type {
+        End = 0,
+        Int,
+        Double,
+        String,
+        Bool,
+        Identifier,
+        Operator
+    };
+
+    QtTIExprToken() = default;
+    QtTIExprToken(const Type type,
+                  const QString &text,
+                  const int pos,
+                  const int length,
+                  const QString &prefix = QString())
+        : _type(type)
+        , _text(text)
+        , _prefix(prefix)
+        , _pos(pos)
+        , _length(length)
+    {}
+    ~QtTIExprToken() = default;
+
+    //!
+    //! \brief Get token type
+    //! \return
+    //!
+    Type type() const { return _type; }
+
+    //!
+    //! \brief Get token text
+    //! \return
+    //!
+    const QString &text() const { return _text; }
+
+    //!
+    //! \brief Get token type prefix (literals)
+    //! \return
+    //!
+    const QString &prefix() const { return _prefix; }
+
+    //!
+    //! \brief Get token position in expression
+    //! \return
+    //!
+    int pos() const { return _pos; }
+
+    //!
+    //! \brief Get token length in expression (including quotes and prefixes)
+    //! \return
+    //!
+    int length() const { return _length; }
+
+    //!
+    //! \brief Check token is operator
+    //! \param op Operator
+    //! \return
+    //!
+    bool isOperator(const char *op) const {
+        return (_type == Type::Operator && _text == QLatin1String(op));
+    }
+
+private:
+    Type _type {Type::End}; //!< token type
+    QString _text;          //!< token text
+    QString _prefix;        //!< literal type prefix
+    int _pos {-1};          //!< position in expression
+    int _length {0};        //!< length in expression
+};
+
+#endif // QTTIEXPRTOKEN_H
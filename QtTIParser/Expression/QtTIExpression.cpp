@@ -0,0 +1,180 @@
+#include "QtTIExpression.h"
+#include "QtTIExprParser.h"
+#include "QtTIExprFolder.h"
+
+//!
+//! \brief Compile expression
+//! \param expr Expression
+//! \param scope Variable slots of the compiled template (see QtTIScope), can be NULL
+//! \return
+//!
+QtTIExpression QtTIExpression::compile(const QString &expr, QtTIScope *scope)
+{
+    QtTIExpression result;
+    result._source = expr.trimmed();
+    if (result._source.isEmpty())
+        return result;
+
+    bool isOk = false;
+    QString error;
+    QtTIExprNodePtr root;
+    std::tie(isOk, root, error) = QtTIExprParser::parse(result._source, scope);
+    if (!isOk) {
+        result._error = QString("Incorrect expression '%1': %2").arg(result._source, error);
+        return result;
+    }
+    result._kind = root->kind();
+    result._root = QtTIExprFolder::fold(root);
+    return result;
+}
+
+//!
+//! \brief Evaluate expression
+//! \param parserArgs Render args
+//! \param parserFunc Help functions
+//! \return
+//!
+std::tuple<bool, QVariant, QString> QtTIExpression::eval(QtTIAbstractParserArgs *parserArgs,
+                                                         QtTIAbstractParserFunc *parserFunc) const
+{
+    if (!parserArgs)
+        return std::make_tuple(false, QVariant(), "QtTIParserArgs is NULL");
+    if (isEmpty())
+        return std::make_tuple(false, QVariant(), "Expression is empty");
+    if (!isValid())
+        return std::make_tuple(false, QVariant(), _error);
+
+    return _root->eval(parserArgs, parserFunc);
+}
+
+//!
+//! \brief Get approximate memory size of the expression (in bytes)
+//! \return
+//!
+//! The size of the source, the error and the nodes of the expression tree (see QtTICompiledTemplate::memoryCost).
+//!
+qint64 QtTIExpression::memoryCost() const
+{
+    return static_cast<qint64>(sizeof(QtTIExpression))
+           + static_cast<qint64>(_source.size() + _error.size()) * static_cast<qint64>(sizeof(QChar))
+           + nodeCost(_root);
+}
+
+
+// --- Private methods ---
+
+//!
+//! \brief Get approximate memory size of the expression node with its operands
+//! \param node Expression node
+//! \return
+//!
+qint64 QtTIExpression::nodeCost(const QtTIExprNodePtr &node)
+{
+    if (!node)
+        return 0;
+
+    switch (node->kind()) {
+        case QtTIExprNode::Kind::Literal:
+            return static_cast<qint64>(sizeof(QtTIExprLiteralNode))
+                   + valueCost(static_cast<const QtTIExprLiteralNode &>(*node).value());
+        case QtTIExprNode::Kind::Path: {
+            const QtTIParamPath &paramPath = static_cast<const QtTIExprPathNode &>(*node).paramPath();
+            qint64 cost = static_cast<qint64>(sizeof(QtTIExprPathNode))
+                          + static_cast<qint64>(paramPath.path().size()) * static_cast<qint64>(sizeof(QChar));
+            for (const QtTIParamPath::Segment &segment : paramPath.segments()) {
+                // the segment names are interned in the scope of the template
+                cost += static_cast<qint64>(sizeof(QtTIParamPath::Segment))
+                        + static_cast<qint64>(segment.methodArgs.size()) * static_cast<qint64>(sizeof(QChar));
+                for (const QVariant &arg : segment.constArgs)
+                    cost += valueCost(arg);
+            }
+            return cost;
+        }
+        case QtTIExprNode::Kind::Call: {
+            const QtTIExprCallNode &call = static_cast<const QtTIExprCallNode &>(*node);
+            qint64 cost = static_cast<qint64>(sizeof(QtTIExprCallNode))
+                          + static_cast<qint64>(call.name().size()) * static_cast<qint64>(sizeof(QChar));
+            for (const QtTIExprNodePtr &arg : call.args())
+                cost += nodeCost(arg);
+            return cost;
+        }
+        case QtTIExprNode::Kind::Array: {
+            qint64 cost = static_cast<qint64>(sizeof(QtTIExprArrayNode));
+            for (const QtTIExprNodePtr &item : static_cast<const QtTIExprArrayNode &>(*node).items())
+                cost += nodeCost(item);
+            return cost;
+        }
+        case QtTIExprNode::Kind::Map: {
+            qint64 cost = static_cast<qint64>(sizeof(QtTIExprMapNode));
+            for (const QPair<QString, QtTIExprNodePtr> &item : static_cast<const QtTIExprMapNode &>(*node).items())
+                cost += static_cast<qint64>(item.first.size()) * static_cast<qint64>(sizeof(QChar)) + nodeCost(item.second);
+            return cost;
+        }
+        case QtTIExprNode::Kind::Negate:
+        case QtTIExprNode::Kind::Not:
+            return static_cast<qint64>(sizeof(QtTIExprUnaryNode))
+                   + nodeCost(static_cast<const QtTIExprUnaryNode &>(*node).operand());
+        case QtTIExprNode::Kind::Math: {
+            const QtTIExprMathNode &math = static_cast<const QtTIExprMathNode &>(*node);
+            return static_cast<qint64>(sizeof(QtTIExprMathNode)) + nodeCost(math.left()) + nodeCost(math.right());
+        }
+        case QtTIExprNode::Kind::Compare: {
+            const QtTIExprCompareNode &compare = static_cast<const QtTIExprCompareNode &>(*node);
+            return static_cast<qint64>(sizeof(QtTIExprCompareNode)) + nodeCost(compare.left()) + nodeCost(compare.right());
+        }
+        case QtTIExprNode::Kind::And:
+        case QtTIExprNode::Kind::Or: {
+            const QtTIExprLogicNode &logic = static_cast<const QtTIExprLogicNode &>(*node);
+            return static_cast<qint64>(sizeof(QtTIExprLogicNode)) + nodeCost(logic.left()) + nodeCost(logic.right());
+        }
+        case QtTIExprNode::Kind::Ternary: {
+            const QtTIExprTernaryNode &ternary = static_cast<const QtTIExprTernaryNode &>(*node);
+            return static_cast<qint64>(sizeof(QtTIExprTernaryNode))
+                   + nodeCost(ternary.cond())
+                   + nodeCost(ternary.thenNode())
+                   + nodeCost(ternary.elseNode());
+        }
+        case QtTIExprNode::Kind::NullCoalescing: {
+            const QtTIExprNullCoalescingNode &nullCoalescing = static_cast<const QtTIExprNullCoalescingNode &>(*node);
+            return static_cast<qint64>(sizeof(QtTIExprNullCoalescingNode))
+                   + nodeCost(nullCoalescing.left())
+                   + nodeCost(nullCoalescing.right());
+        }
+    }
+    return 0;
+}
+
+//!
+//! \brief Get approximate memory size of the constant value (strings and containers of the literals)
+//! \param value Constant value
+//! \return
+//!
+qint64 QtTIExpression::valueCost(const QVariant &value)
+{
+    switch (value.userType()) {
+        case QMetaType::QString:
+            return static_cast<qint64>(value.toString().size()) * static_cast<qint64>(sizeof(QChar));
+        case QMetaType::QVariantList: {
+            qint64 cost = 0;
+            for (const QVariant &item : value.toList())
+                cost += static_cast<qint64>(sizeof(QVariant)) + valueCost(item);
+            return cost;
+        }
+        case QMetaType::QVariantMap: {
+            const QVariantMap map = value.toMap();
+            qint64 cost = 0;
+            for (auto it = map.constBegin(); it != map.constEnd(); ++it)
+                cost += static_cast<qint64>(sizeof(QVariant) + it.key().size() * sizeof(QChar)) + valueCost(it.value());
+            return cost;
+        }
+        case QMetaType::QVariantHash: {
+            const QVariantHash hash = value.toHash();
+            qint64 cost = 0;
+            for (auto it = hash.constBegin(); it != hash.constEnd(); ++it)
+                cost += static_cast<qint64>(sizeof(QVariant) + it.key().size() * sizeof(QChar)) + valueCost(it.value());
+            return cost;
+        }
+        default:
+            return 0;
+    }
+}
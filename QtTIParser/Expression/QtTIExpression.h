@@ -0,0 +1,87 @@
+#ifndef QTTIEXPRESSION_H
+#define QTTIEXPRESSION_H
+
+#include <QString>
+#include <QVariant>
+#include <tuple>
+
+#include "QtTIExprNode.h"
+#include "../Scope/QtTIScope.h"
+
+//!
+//! \brief The QtTIExpression class
+//!
+//! Compiled expression: the source text and the expression tree (see QtTIExprParser).
+//! The expression is parsed once and can be evaluated any number of times with different
+//! args. If the expression is incorrect, the parse error is returned on evaluation.
+//!
+//! NOTE: The constant sub-expressions are folded on compile (see QtTIExprFolder), the kind of
+//!       the parsed expression is kept (see kind).
+//!
+//! === Example:
+//!     QtTIExpression expr = QtTIExpression::compile("a > 5 ? 'big' : 'small'");
+//!     bool isOk = false;
+//!     QVariant result;
+//!     QString error;
+//!     std::tie(isOk, result, error) = expr.eval(&tiArgs, &tiFuncs);
+//!
+class QtTIExpression
+{
+public:
+    QtTIExpression() = default;
+    ~QtTIExpression() = default;
+
+    static QtTIExpression compile(const QString &expr, QtTIScope *scope = nullptr);
+
+    //!
+    //! \brief Check expression is parsed successfully
+    //! \return
+    //!
+    bool isValid() const { return (_root != nullptr); }
+
+    //!
+    //! \brief Check expression is empty (only blank characters)
+    //! \return
+    //!
+    bool isEmpty() const { return _source.isEmpty(); }
+
+    //!
+    //! \brief Get expression source (trimmed)
+    //! \return
+    //!
+    const QString &source() const { return _source; }
+
+    //!
+    //! \brief Get parse error
+    //! \return
+    //!
+    const QString &error() const { return _error; }
+
+    //!
+    //! \brief Get expression tree root
+    //! \return
+    //!
+    const QtTIExprNodePtr &root() const { return _root; }
+
+    //!
+    //! \brief Get kind of the parsed expression (the root kind before the constant folding)
+    //! \return
+    //!
+    QtTIExprNode::Kind kind() const { return _kind; }
+
+    std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> eval(QtTIAbstractParserArgs *parserArgs,
+                                                                 QtTIAbstractParserFunc *parserFunc) const;
+
+    qint64 memoryCost() const;
+
+private:
+    static qint64 nodeCost(const QtTIExprNodePtr &node);
+    static qint64 valueCost(const QVariant &value);
+
+    QString _source;                    //!< expression source
+    QtTIExprNodePtr _root {nullptr};    //!< expression tree root
+    QtTIExprNode::Kind _kind {QtTIExprNode::Kind::Literal}; //!< kind of the parsed expression
+    QString _error;                     //!< parse error
+};
+
+#endif // QTTIEXPRESSION_H
@@ -0,0 +1,268 @@
+#include "QtTIValue.h"
+
+//!
+//! \brief Create value from QVariant
+//! \param value
+//! \return
+//!
+//! NOTE: Numbers, bool and string are read directly from the QVariant storage,
+//!       other types are kept as QVariant.
+//!
+QtTIValue QtTIValue::fromVariant(const QVariant &value)
+{
+    switch (value.userType()) {
+        case QMetaType::UnknownType:
+            return QtTIValue();
+        case QMetaType::Bool:
+            return QtTIValue(*static_cast<const bool *>(value.constData()));
+        case QMetaType::Int:
+            return QtTIValue(*static_cast<const int *>(value.constData()));
+        case QMetaType::UInt:
+            return QtTIValue(*static_cast<const uint *>(value.constData()));
+        case QMetaType::LongLong:
+            return QtTIValue(*static_cast<const qlonglong *>(value.constData()));
+        case QMetaType::ULongLong:
+            return QtTIValue(*static_cast<const qulonglong *>(value.constData()));
+        case QMetaType::Float:
+            return QtTIValue(*static_cast<const float *>(value.constData()));
+        case QMetaType::Double:
+            return QtTIValue(*static_cast<const double *>(value.constData()));
+        case QMetaType::QString:
+            return QtTIValue(*static_cast<const QString *>(value.constData()));
+        default:
+            break;
+    }
+
+    QtTIValue result;
+    new (&result._data.v) QVariant(value);
+    result._type = Type::Variant;
+    return result;
+}
+
+//!
+//! \brief Copy value
+//! \param other
+//! \return
+//!
+QtTIValue &QtTIValue::operator=(const QtTIValue &other)
+{
+    if (this == &other)
+        return *this;
+    if (hasObject())
+        destroy();
+    _type = other._type;
+    copyData(other);
+    return *this;
+}
+
+//!
+//! \brief Move value
+//! \param other
+//! \return
+//!
+QtTIValue &QtTIValue::operator=(QtTIValue &&other) noexcept
+{
+    if (this == &other)
+        return *this;
+    if (hasObject())
+        destroy();
+    _type = other._type;
+    moveData(std::move(other));
+    return *this;
+}
+
+//!
+//! \brief Convert value to QVariant
+//! \return
+//!
+QVariant QtTIValue::toVariant() const
+{
+    switch (_type) {
+        case Type::Invalid:
+            return QVariant();
+        case Type::Bool:
+            return QVariant(_data.b);
+        case Type::Int:
+            return QVariant(static_cast<int>(_data.i));
+        case Type::UInt:
+            return QVariant(static_cast<uint>(_data.u));
+        case Type::LongLong:
+            return QVariant(static_cast<qlonglong>(_data.i));
+        case Type::ULongLong:
+            return QVariant(static_cast<qulonglong>(_data.u));
+        case Type::Float:
+            return QVariant(static_cast<float>(_data.d));
+        case Type::Double:
+            return QVariant(_data.d);
+        case Type::String:
+            return QVariant(_data.s);
+        case Type::Variant:
+            return _data.v;
+    }
+    return QVariant();
+}
+
+//!
+//! \brief Check value is true
+//! \return
+//!
+//! If value type is bool - return bool value.
+//! If value type is not bool - return check result value is not NULL (as QVariant::isNull).
+//!
+bool QtTIValue::isTrue() const
+{
+    switch (_type) {
+        case Type::Invalid:
+            return false;
+        case Type::Bool:
+            return _data.b;
+        case Type::String:
+            return !_data.s.isNull();
+        case Type::Variant:
+            return !_data.v.isNull();
+        default:
+            break;
+    }
+    return true;
+}
+
+//!
+//! \brief Convert value to signed integer (real numbers are rounded as QVariant::toLongLong)
+//! \return
+//!
+qint64 QtTIValue::toInt64() const
+{
+    switch (_type) {
+        case Type::Bool:
+            return _data.b ? 1 : 0;
+        case Type::Int:
+        case Type::LongLong:
+            return _data.i;
+        case Type::UInt:
+        case Type::ULongLong:
+            return static_cast<qint64>(_data.u);
+        case Type::Float:
+        case Type::Double:
+            return qRound64(_data.d);
+        case Type::String:
+            return _data.s.toLongLong();
+        case Type::Variant:
+            return _data.v.toLongLong();
+        default:
+            break;
+    }
+    return 0;
+}
+
+//!
+//! \brief Convert value to unsigned integer (real numbers are rounded as QVariant::toULongLong)
+//! \return
+//!
+quint64 QtTIValue::toUInt64() const
+{
+    switch (_type) {
+        case Type::Bool:
+            return _data.b ? 1 : 0;
+        case Type::Int:
+        case Type::LongLong:
+            return static_cast<quint64>(_data.i);
+        case Type::UInt:
+        case Type::ULongLong:
+            return _data.u;
+        case Type::Float:
+        case Type::Double:
+            return static_cast<quint64>(qRound64(_data.d));
+        case Type::String:
+            return _data.s.toULongLong();
+        case Type::Variant:
+            return _data.v.toULongLong();
+        default:
+            break;
+    }
+    return 0;
+}
+
+//!
+//! \brief Convert value to real number
+//! \return
+//!
+double QtTIValue::toDouble() const
+{
+    switch (_type) {
+        case Type::Bool:
+            return _data.b ? 1.0 : 0.0;
+        case Type::Int:
+        case Type::LongLong:
+            return static_cast<double>(_data.i);
+        case Type::UInt:
+        case Type::ULongLong:
+            return static_cast<double>(_data.u);
+        case Type::Float:
+        case Type::Double:
+            return _data.d;
+        case Type::String:
+            return _data.s.toDouble();
+        case Type::Variant:
+            return _data.v.toDouble();
+        default:
+            break;
+    }
+    return 0.0;
+}
+
+//!
+//! \brief Select type for calc operation
+//! \param left
+//! \param right
+//! \return
+//!
+//! The type with the larger size is selected, for the same sizes - the left type
+//! (or the right one if it is real number).
+//!
+QtTIValue::Type QtTIValue::calcType(const QtTIValue &left, const QtTIValue &right)
+{
+    const int lTypeSize = typeSize(left._type);
+    const int rTypeSize = typeSize(right._type);
+    if (rTypeSize > lTypeSize)
+        return right._type;
+    if (rTypeSize == lTypeSize
+        && right._type != left._type
+        && right.isReal())
+        return right._type;
+    return left._type;
+}
+
+//!
+//! \brief Get size of the number type
+//! \param type
+//! \return
+//!
+int QtTIValue::typeSize(const Type type)
+{
+    switch (type) {
+        case Type::Int:
+        case Type::UInt:
+        case Type::Float:
+            return 4;
+        case Type::LongLong:
+        case Type::ULongLong:
+        case Type::Double:
+            return 8;
+        default:
+            break;
+    }
+    return 0;
+}
+
+//!
+//! \brief Destroy the string or the QVariant (the value becomes invalid)
+//!
+void QtTIValue::destroy()
+{
+    if (_type == Type::String)
+        _data.s.~QString();
+    else if (_type == Type::Variant)
+        _data.v.~QVariant();
+    _type = Type::Invalid;
+    _data.i = 0;
+}
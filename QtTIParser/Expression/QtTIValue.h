@@ -0,0 +1,167 @@
+#ifndef QTTIVALUE_H
+#define QTTIVALUE_H
+
+#include <QString>
+#include <QVariant>
+#include <cstring>
+#include <new>
+#include <utility>
+
+//!
+//! \brief The QtTIValue class
+//!
+//! Compact tagged value for the intermediate results of the expression evaluation
+//! (see QtTIExprNode::evalValue). Numbers and bool are kept unboxed, the string shares
+//! the string data, containers and objects are kept as QVariant (shared, not copied).
+//! The value is converted to and from QVariant only at the boundary of the expression.
+//!
+//! The string and the QVariant are kept in the same storage as the numbers, so the value is
+//! not larger than the QVariant plus the type, and bool and numbers are copied without
+//! the string and QVariant copy constructors.
+//!
+//! The numeric type of the value is kept (Int, UInt, LongLong, ...), the results of the math
+//! operations have the same types as the results of QVariant based calculations.
+//!
+//! === Example:
+//!     QtTIValue v = QtTIValue::fromVariant(QVariant(10));
+//!     v.type()     - QtTIValue::Type::Int
+//!     v.toInt64()  - 10
+//!     v.toVariant()- QVariant(int, 10)
+//!
+class QtTIValue
+{
+public:
+    //!
+    //! \brief Value types
+    //!
+    enum class Type {
+        Invalid = 0,
+        Bool,
+        Int,
+        UInt,
+        LongLong,
+        ULongLong,
+        Float,
+        Double,
+        String,
+        Variant     //!< container, object or other type (kept as QVariant)
+    };
+
+    QtTIValue() = default;
+    QtTIValue(const bool value) : _type(Type::Bool) { _data.b = value; }
+    QtTIValue(const int value) : _type(Type::Int) { _data.i = value; }
+    QtTIValue(const uint value) : _type(Type::UInt) { _data.u = value; }
+    QtTIValue(const qlonglong value) : _type(Type::LongLong) { _data.i = value; }
+    QtTIValue(const qulonglong value) : _type(Type::ULongLong) { _data.u = value; }
+    QtTIValue(const float value) : _type(Type::Float) { _data.d = static_cast<double>(value); }
+    QtTIValue(const double value) : _type(Type::Double) { _data.d = value; }
+    QtTIValue(const QString &value) : _type(Type::String) { new (&_data.s) QString(value); }
+    ~QtTIValue() { if (hasObject()) destroy(); }
+
+    QtTIValue(const QtTIValue &other) : _type(other._type) { copyData(other); }
+    QtTIValue(QtTIValue &&other) noexcept : _type(other._type) { moveData(std::move(other)); }
+    QtTIValue &operator=(const QtTIValue &other);
+    QtTIValue &operator=(QtTIValue &&other) noexcept;
+
+    static QtTIValue fromVariant(const QVariant &value);
+    QVariant toVariant() const;
+
+    //!
+    //! \brief Get value type
+    //! \return
+    //!
+    Type type() const { return _type; }
+
+    //!
+    //! \brief Check value is number (not bool)
+    //! \return
+    //!
+    bool isNumber() const { return (_type >= Type::Int && _type <= Type::Double); }
+
+    //!
+    //! \brief Check value is real number
+    //! \return
+    //!
+    bool isReal() const { return (_type == Type::Float || _type == Type::Double); }
+
+    bool isTrue() const;
+
+    qint64 toInt64() const;
+    quint64 toUInt64() const;
+    double toDouble() const;
+
+    //!
+    //! \brief Get bool value (only for Type::Bool)
+    //! \return
+    //!
+    bool boolValue() const { return _data.b; }
+
+    //!
+    //! \brief Get string value (only for Type::String)
+    //! \return
+    //!
+    const QString &stringValue() const { return _data.s; }
+
+    static Type calcType(const QtTIValue &left, const QtTIValue &right);
+
+private:
+    static int typeSize(const Type type);
+
+    //!
+    //! \brief Check value keeps the string or the QVariant (not trivially copied)
+    //! \return
+    //!
+    bool hasObject() const { return (_type == Type::String || _type == Type::Variant); }
+
+    //!
+    //! \brief Copy data of the value with the same type (the data must be empty)
+    //! \param other
+    //!
+    void copyData(const QtTIValue &other) {
+        if (!other.hasObject())
+            std::memcpy(static_cast<void *>(&_data), &other._data, sizeof(quint64));
+        else if (other._type == Type::String)
+            new (&_data.s) QString(other._data.s);
+        else
+            new (&_data.v) QVariant(other._data.v);
+    }
+
+    //!
+    //! \brief Move data of the value with the same type (the data must be empty)
+    //! \param other
+    //!
+    void moveData(QtTIValue &&other) noexcept {
+        if (!other.hasObject())
+            std::memcpy(static_cast<void *>(&_data), &other._data, sizeof(quint64));
+        else if (other._type == Type::String)
+            new (&_data.s) QString(std::move(other._data.s));
+        else
+            new (&_data.v) QVariant(std::move(other._data.v));
+    }
+
+    void destroy();
+
+private:
+    //!
+    //! \brief The Data union
+    //!
+    //! The active member is selected by the value type, the string and the QVariant
+    //! are constructed and destroyed by QtTIValue.
+    //!
+    union Data {
+        bool b;
+        qint64 i;
+        quint64 u;
+        double d;
+        QString s;      //!< string value (Type::String)
+        QVariant v;     //!< other value (Type::Variant)
+
+        Data() : i(0) {}
+        ~Data() {}
+    };
+
+    Type _type {Type::Invalid}; //!< value type
+    Data _data;                 //!< value
+};
+
+#endif // QTTIVALUE_H
@@ -1,8 +1,5 @@
 #include "QtTIParserLogic.h"
-#include "../BracketsExpr/QtTIParserBracketsExpr.h"
-#include "../Math/QtTIParserMath.h"
-#include "../../QtTIDefines/QtTIRegExpDefines.h"
-#include <QRegExp>
+#include "../Expression/QtTIExpression.h"
 
 //!
 //! \brief Check is logic expression
@@ -11,10 +8,28 @@
 //!
 bool QtTIParserLogic::isLogicExpr(const QString &expr)
 {
-    QRegExp rx(RX_LOGIC_v1);
-    QRegExp rx_2(RX_LOGIC_v2);
-    return ((rx.indexIn(expr) != -1)
-            || (rx_2.indexIn(expr) != -1));
+    return isLogicExpr(QtTIExpression::compile(expr));
+}
+
+//!
+//! \brief Check is logic expression (the root of the expression tree is the comparison or the logic operation)
+//! \param expr Compiled expression
+//! \return
+//!
+bool QtTIParserLogic::isLogicExpr(const QtTIExpression &expr)
+{
+    if (!expr.isValid())
+        return false;
+    switch (expr.kind()) {
+        case QtTIExprNode::Kind::Compare:
+        case QtTIExprNode::Kind::And:
+        case QtTIExprNode::Kind::Or:
+        case QtTIExprNode::Kind::Not:
+            return true;
+        default:
+            break;
+    }
+    return false;
 }
 
 //!
@@ -43,7 +58,9 @@ bool QtTIParserLogic::isLogicExpr(const QString &expr)
 //!      - ||: equivalent of method 'or'
 //!
 //! === Brackets support:
-//!     Supported grouping expressions with brackets '(...expr...)':
+//!     Supported grouping expressions with brackets '(...expr...)', the expression is evaluated
+//!     as an expression tree (see QtTIExprParser), the results of the brackets are passed as values,
+//!     the right operand of 'and' / 'or' is evaluated only if the result is not known from the left one:
 //!         {% set a = 10.5 %}
 //!         {% set b = 2 %}
 //!         {% set aa = { a:1, b:2, c:3 } %}
@@ -67,231 +84,20 @@ QVariant QtTIParserLogic::parseLogic(const QString &expr,
         error = QString("QtTIParserFunc is NULL");
         return QVariant();
     }
-    if (!QtTIParserLogic::isLogicExpr(expr)) {
+    const QtTIExpression compiledExpr = QtTIExpression::compile(expr);
+    if (!QtTIParserLogic::isLogicExpr(compiledExpr)) {
         error = QString("Incorrect logic expression '%1'").arg(expr);
         return QVariant();
     }
 
-    QStringList validStringsBeforeBracket({ "and", "or", "not", "&&", "||" });
-    QtTIBracketsNode brNode = QtTIParserBracketsExpr::parseBracketsExpression(expr, validStringsBeforeBracket, parserArgs, [parserArgs, parserFunc](const QString &nodeBody) {
-        bool isOk = false;
-        QString error;
-        QVariant result = QtTIParserLogic::parseLogicWithoutBrackets(nodeBody, parserArgs, parserFunc, &isOk, error);
-        return std::make_tuple(isOk, result, error);
-    });
-    if (!brNode.isValid()) {
-        error = QString("Invalid brackets node for expression '%1'").arg(expr);
-        return QVariant();
-    }
     bool isOkLocal = false;
     QVariant result;
-    std::tie(isOkLocal, result, error) = brNode.evalNodeBody();
+    std::tie(isOkLocal, result, error) = compiledExpr.eval(parserArgs, parserFunc);
     if (isOk)
         *isOk = isOkLocal;
-    return result;
-}
-
-//!
-//! \brief Parse logic expression without brackets and exec
-//! \param expr
-//! \param parserArgs
-//! \param parserFunc
-//! \param isOk
-//! \param error
-//! \return
-//!
-QVariant QtTIParserLogic::parseLogicWithoutBrackets(const QString &expr,
-                                                    QtTIAbstractParserArgs *parserArgs,
-                                                    QtTIAbstractParserFunc *parserFunc,
-                                                    bool *isOk,
-                                                    QString &error)
-{
-    if (isOk)
-        *isOk = false;
-    error.clear();
-    if (!parserArgs) {
-        error = QString("QtTIParserArgs is NULL");
+    if (!isOkLocal)
         return QVariant();
-    }
-    if (!parserFunc) {
-        error = QString("QtTIParserFunc is NULL");
-        return QVariant();
-    }
-
-    // check is math expr
-    if (QtTIParserMath::isMathExpr(expr))
-        return QtTIParserMath::parseMath(expr, parserArgs, parserFunc, isOk, error);
-
-    // check is logic expr
-    if (!QtTIParserLogic::isLogicExpr(expr)) {
-        error = QString("Incorrect logic expression '%1'").arg(expr);
-        return QVariant();
-    }
-
-    bool isOkLocal = false;
-    bool result = false;
-    std::tie(isOkLocal, result, error) = QtTIParserLogic::compareBlockCondition(expr, parserArgs, parserFunc);
-    if (isOk)
-        *isOk = isOkLocal;
-    return result;
-}
-
-//!
-//! \brief Parse logic expression and compare (with: and, or, &&, ||)
-//! \param str
-//! \param parserArgs
-//! \param parserFunc
-//! \return
-//!
-//! === Example
-//!         a > 5 and b <= 2
-//!
-std::tuple<bool, bool, QString> QtTIParserLogic::compareBlockCondition(const QString &str,
-                                                                       QtTIAbstractParserArgs *parserArgs,
-                                                                       QtTIAbstractParserFunc *parserFunc)
-{
-    QString expression = str.trimmed();
-    QRegExp rxInvalid("^(&&|and|\\|\\||or)\\s+");
-    if (rxInvalid.indexIn(expression) != -1)
-        return std::make_tuple(false, false, "The condition is set incorrectly: condition cannot start with '&&', '||', 'and', 'or'");
-
-    QRegExp rxAnd("\\s+(&&|and)\\s+");
-    QRegExp rxOr("\\s+(\\|\\||or)\\s+");
-    if (rxOr.indexIn(expression) != -1) {
-        expression = expression.replace(" || ", " or ");
-        bool exResult = false;
-        const QStringList exSections = expression.split(" or ");
-        for (const QString &e : exSections) {
-            bool isOk = false;
-            bool res = false;
-            QString err;
-            std::tie(isOk, res, err) = compareBlockCondition(e, parserArgs, parserFunc);
-            if (!isOk)
-                return std::make_tuple(false, false, err);
-            // If 'true', then you don’t have to check further and return the result
-            if (res)
-                return std::make_tuple(true, true, "");
-            exResult |= res;
-        }
-        return std::make_tuple(true, exResult, "");
-    } else if (rxAnd.indexIn(expression) != -1) {
-        expression = expression.replace(" && ", " and ");
-        bool exResult = true;
-        const QStringList exSections = expression.split(" and ");
-        for (const QString &e : exSections) {
-            bool isOk = false;
-            bool res = false;
-            QString err;
-            std::tie(isOk, res, err) = compareBlockCondition(e, parserArgs, parserFunc);
-            if (!isOk)
-                return std::make_tuple(false, false, err);
-            // If 'false', then you don’t have to check further and return the result
-            if (!res)
-                return std::make_tuple(true, false, "");
-            exResult &= res;
-        }
-        return std::make_tuple(true, exResult, "");
-    }
-    return compareExpression(expression, parserArgs, parserFunc);
-}
-
-//!
-//! \brief Parse logic expression and compare (without: and, or, &&, ||)
-//! \param str
-//! \param parserArgs
-//! \param parserFunc
-//! \return
-//!
-//! === Example
-//!         a > 5
-//!
-std::tuple<bool, bool, QString> QtTIParserLogic::compareExpression(const QString &str,
-                                                                   QtTIAbstractParserArgs *parserArgs,
-                                                                   QtTIAbstractParserFunc *parserFunc)
-{
-    QRegExp rxLeftRight(RX_LOGIC_LEFT_RIGHT);
-    QRegExp rxOne(RX_LOGIC_ONE);
-    if (rxLeftRight.indexIn(str) != -1) {
-        QString notVal = rxLeftRight.cap(2).trimmed();
-        QString left = rxLeftRight.cap(3).trimmed();
-        if (left.isEmpty())
-            return std::make_tuple(false, false, "Invalid exptression left parameter (not specified)");
-        QString cond = rxLeftRight.cap(4).trimmed();
-        if (cond.isEmpty())
-            return std::make_tuple(false, false, "Invalid exptression condition (not specified)");
-        QString right = rxLeftRight.cap(5).trimmed();
-        if (right.isEmpty())
-            return std::make_tuple(false, false, "Invalid exptression right parameter (not specified)");
-        QVariant vLeft;
-        QVariant vRight;
-        // parse
-        bool isOk = false;
-        QString error;
-        std::tie(isOk, vLeft, error) = parseParamValue(left, parserArgs, parserFunc);
-        if (!isOk)
-            return std::make_tuple(false, false, error);
-
-        std::tie(isOk, vRight, error) = parseParamValue(right, parserArgs, parserFunc);
-        if (!isOk)
-            return std::make_tuple(false, false, error);
-
-        // compare
-        bool res = compare(vLeft, vRight, cond);
-        if (!notVal.isEmpty())
-            res = !res;
-        return std::make_tuple(true, res, "");
-    } else if (rxOne.indexIn(str) != -1) {
-        QString notVal = rxOne.cap(2).trimmed();
-        QString left = rxOne.cap(3).trimmed();
-        if (left.isEmpty())
-            return std::make_tuple(false, false, "Invalid exptression parameter (not specified)");
-        QVariant vLeft;
-        // parse
-        bool isOk = false;
-        QString error;
-        std::tie(isOk, vLeft, error) = parseParamValue(left, parserArgs, parserFunc);
-        if (!isOk)
-            return std::make_tuple(false, false, error);
-
-        // compare
-        bool res = compare(vLeft);
-        if (!notVal.isEmpty())
-            res = !res;
-        return std::make_tuple(true, res, "");
-    }
-    return std::make_tuple(false, false, QString("Invalid exptression '%1'").arg(str));
-}
-
-//!
-//! \brief Parse parameter value from string
-//! \param str Parameter value string view
-//! \param parserArgs
-//! \param parserFunc
-//! \return
-//!
-std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> QtTIParserLogic::parseParamValue(const QString &str,
-                                                                                         QtTIAbstractParserArgs *parserArgs,
-                                                                                         QtTIAbstractParserFunc *parserFunc)
-{
-    if (str.isEmpty())
-        return std::make_tuple(false, QVariant(), "Parse value failed (empty string passed)");
-
-    // function
-    QRegExp rxFunc(RX_FUNC);
-    if (rxFunc.indexIn(str) != -1) {
-        QString funcName = rxFunc.cap(2).trimmed();
-        QVariantList funcArgs = parserArgs->parseHelpFunctionArgs(rxFunc.cap(3).trimmed());
-        return parserFunc->evalHelpFunction(funcName, funcArgs);
-    }
-
-    // arg
-    QVariantList tmp = parserArgs->parseHelpFunctionArgs(str);
-    if (tmp.isEmpty())
-        return std::make_tuple(false, QVariant(), "Parse value failed");
-    if (tmp.size() > 1)
-        return std::make_tuple(false, QVariant(), "Parse value failed (more than one argument is given)");
-
-    return std::make_tuple(true, tmp[0], "");
+    return QVariant(QtTIParserLogic::compare(result));
 }
 
 //!
@@ -318,32 +124,82 @@ bool QtTIParserLogic::compare(const QVariant &left)
 //! \return
 //!
 bool QtTIParserLogic::compare(const QVariant &left, const QVariant &right, const QString &cond)
+{
+    return compare(left, right, strToOperation(cond));
+}
+
+//!
+//! \brief Compare values
+//! \param left
+//! \param right
+//! \param operation
+//! \return
+//!
+bool QtTIParserLogic::compare(const QVariant &left, const QVariant &right, const LogicalOperation operation)
 {
     switch (static_cast<int>(left.type())) {
         case QVariant::Int:
-            return compare(left.toInt(), right.toInt(), strToOperation(cond));
+            return compare(left.toInt(), right.toInt(), operation);
         case QVariant::UInt:
-            return compare(left.toUInt(), right.toUInt(), strToOperation(cond));
+            return compare(left.toUInt(), right.toUInt(), operation);
         case QVariant::Double:
-            return compare(left.toDouble(), right.toDouble(), strToOperation(cond));
+            return compare(left.toDouble(), right.toDouble(), operation);
         case QMetaType::Float:
-            return compare(left.toFloat(), right.toFloat(), strToOperation(cond));
+            return compare(left.toFloat(), right.toFloat(), operation);
         case QVariant::LongLong:
-            return compare(left.toLongLong(), right.toLongLong(), strToOperation(cond));
+            return compare(left.toLongLong(), right.toLongLong(), operation);
         case QVariant::ULongLong:
-            return compare(left.toULongLong(), right.toULongLong(), strToOperation(cond));
+            return compare(left.toULongLong(), right.toULongLong(), operation);
         case QVariant::Bool:
-            return compare(left.toBool(), right.toBool(), strToOperation(cond));
+            return compare(left.toBool(), right.toBool(), operation);
         case QVariant::String:
-            return compare(left.toString(), right.toString(), strToOperation(cond));
+            return compare(left.toString(), right.toString(), operation);
         case QVariant::ByteArray:
-            return compare(left.toByteArray(), right.toByteArray(), strToOperation(cond));
+            return compare(left.toByteArray(), right.toByteArray(), operation);
         default:
             break;
     }
     return false;
 }
 
+//!
+//! \brief Compare values
+//! \param left
+//! \param right
+//! \param operation
+//! \return
+//!
+//! NOTE: Numbers, bool and strings are compared unboxed (the right value is converted
+//!       to the left value type), other types are compared as QVariant.
+//!
+bool QtTIParserLogic::compare(const QtTIValue &left, const QtTIValue &right, const LogicalOperation operation)
+{
+    if (left.isNumber() && right.isNumber()) {
+        switch (left.type()) {
+            case QtTIValue::Type::Int:
+                return compare(static_cast<int>(left.toInt64()), static_cast<int>(right.toInt64()), operation);
+            case QtTIValue::Type::UInt:
+                return compare(static_cast<uint>(left.toUInt64()), static_cast<uint>(right.toUInt64()), operation);
+            case QtTIValue::Type::Double:
+                return compare(left.toDouble(), right.toDouble(), operation);
+            case QtTIValue::Type::Float:
+                return compare(static_cast<float>(left.toDouble()), static_cast<float>(right.toDouble()), operation);
+            case QtTIValue::Type::LongLong:
+                return compare(left.toInt64(), right.toInt64(), operation);
+            case QtTIValue::Type::ULongLong:
+                return compare(left.toUInt64(), right.toUInt64(), operation);
+            default:
+                break;
+        }
+    } else if (left.type() == right.type()) {
+        if (left.type() == QtTIValue::Type::Bool)
+            return compare(left.boolValue(), right.boolValue(), operation);
+        if (left.type() == QtTIValue::Type::String)
+            return compare(left.stringValue(), right.stringValue(), operation);
+    }
+    return compare(left.toVariant(), right.toVariant(), operation);
+}
+
 //!
 //! \brief Template method for compare values
 //! \param left
@@ -6,6 +6,9 @@
 
 #include "../Abstract/QtTIAbstractParserArgs.h"
 #include "../Abstract/QtTIAbstractParserFunc.h"
+#include "../Expression/QtTIValue.h"
+
+class QtTIExpression;
 
 class QtTIParserLogic
 {
@@ -24,40 +27,25 @@ public:
     ~QtTIParserLogic() = default;
 
     static bool isLogicExpr(const QString &expr);
+    static bool isLogicExpr(const QtTIExpression &expr);
     static QVariant parseLogic(const QString &expr,
                                QtTIAbstractParserArgs *parserArgs,
                                QtTIAbstractParserFunc *parserFunc,
                                bool *isOk,
                                QString &error);
 
-private:
-    static QVariant parseLogicWithoutBrackets(const QString &expr,
-                                              QtTIAbstractParserArgs *parserArgs,
-                                              QtTIAbstractParserFunc *parserFunc,
-                                              bool *isOk,
-                                              QString &error);
-
-    static std::tuple<bool/*isOk*/,bool/*res*/,QString/*err*/> compareBlockCondition(const QString &str,
-                                                                                     QtTIAbstractParserArgs *parserArgs,
-                                                                                     QtTIAbstractParserFunc *parserFunc);
-
-    static std::tuple<bool/*isOk*/,bool/*res*/,QString/*err*/> compareExpression(const QString &str,
-                                                                                 QtTIAbstractParserArgs *parserArgs,
-                                                                                 QtTIAbstractParserFunc *parserFunc);
-
-    static std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> parseParamValue(const QString &str,
-                                                                                   QtTIAbstractParserArgs *parserArgs,
-                                                                                   QtTIAbstractParserFunc *parserFunc);
-
     static bool compare(const QVariant &left);
     static bool compare(const QVariant &left, const QVariant &right, const QString &cond);
+    static bool compare(const QVariant &left, const QVariant &right, const LogicalOperation operation);
+    static bool compare(const QtTIValue &left, const QtTIValue &right, const LogicalOperation operation);
 
+    static LogicalOperation strToOperation(const QString &cond);
+
+private:
     template<typename T>
     static bool compare(const T &left,
                         const T &right,
                         const LogicalOperation &operation);
-
-    static LogicalOperation strToOperation(const QString &cond);
 };
 
 #endif // QTTIPARSERLOGIC_H
@@ -1,9 +1,8 @@
 #include "QtTIParserMath.h"
 
-#include "../BracketsExpr/QtTIParserBracketsExpr.h"
-#include "../../QtTIDefines/QtTIRegExpDefines.h"
+#include "../Expression/QtTIExpression.h"
+#include "../RegExpRegistry/QtTIRegExpRegistry.h"
 
-#include <QRegExp>
 #include <qmath.h>
 
 //!
@@ -13,8 +12,7 @@
 //!
 bool QtTIParserMath::isMathExpr(const QString &expr)
 {
-    QRegExp rx(RX_MATH_OP);
-    return (rx.indexIn(expr) != -1);
+    return QtTIRegExpRegistry::match(QtTIRegExpRegistry::MathOp, expr).hasMatch();
 }
 
 //!
@@ -50,7 +48,8 @@ bool QtTIParserMath::isMathExpr(const QString &expr)
 //!             {{ 2 ** 3 }} would return 8
 //!
 //! === Brackets support:
-//!     Supported grouping expressions with brackets '(...expr...)':
+//!     Supported grouping expressions with brackets '(...expr...)', the expression is evaluated
+//!     as an expression tree (see QtTIExprParser), the results of the brackets are passed as values:
 //!         {{ ( 10.5 + 2 * 2 ) / 3 + 10 - 1 + 2 ** 2 }} is 17.833333333333332
 //!         {{ ( 10.5 + 2 * (2 + 5)) / (3 + 10 * 2) - (1 + 2) ** 2 }} is -7.934782608695652
 //!
@@ -68,365 +67,205 @@ QVariant QtTIParserMath::parseMath(const QString &expr, QtTIAbstractParserArgs *
         return QVariant();
     }
 
-    QStringList validStringsBeforeBracket({ "+", "-", "/", "%", "//", "*", "**" });
-    QtTIBracketsNode brNode = QtTIParserBracketsExpr::parseBracketsExpression(expr, validStringsBeforeBracket, parserArgs, [parserArgs, parserFunc](const QString &nodeBody) {
-        bool isOk = false;
-        QString error;
-        QVariant result = QtTIParserMath::parseMathWithoutBrackets(nodeBody, parserArgs, parserFunc, &isOk, error);
-        return std::make_tuple(isOk, result, error);
-    });
-    if (!brNode.isValid()) {
-        error = QString("Invalid brackets node for expression '%1'").arg(expr);
-        return QVariant();
-    }
     bool isOkLocal = false;
     QVariant result;
-    std::tie(isOkLocal, result, error) = brNode.evalNodeBody();
+    std::tie(isOkLocal, result, error) = QtTIExpression::compile(expr).eval(parserArgs, parserFunc);
     if (isOk)
         *isOk = isOkLocal;
     return result;
 }
 
 //!
-//! \brief Parse math expression without brackets and calculate
-//! \param expr
-//! \param parserArgs
-//! \param parserFunc
-//! \param[in,out] isOk
-//! \param[in,out] error
+//! \brief Calculate math operation
+//! \param left
+//! \param right
+//! \param op
 //! \return
 //!
-QVariant QtTIParserMath::parseMathWithoutBrackets(const QString &expr, QtTIAbstractParserArgs *parserArgs, QtTIAbstractParserFunc *parserFunc, bool *isOk, QString &error)
-{
-    if (isOk)
-        *isOk = false;
-    error.clear();
-    if (!parserArgs) {
-        error = QString("QtTIParserArgs is NULL");
-        return QVariant();
-    }
-    if (!QtTIParserMath::isMathExpr(expr)) {
-        error = QString("Incorrect math expression '%1'").arg(expr);
-        return QVariant();
-    }
-
-    QList<QtTIMathAction> actions;
-    bool parseIsOk = false;
-    parseLR(expr, &actions, parserArgs, parserFunc, &parseIsOk, error);
-    if (!parseIsOk)
-        return QVariant();
-
-    // calc math operations
-    int pos = 0;
-    int opPriority = 0;
-    while (true) {
-        if (pos == actions.size()) {
-            if (opPriority == MAX_OP_PRIORITY)
-                break;
-            opPriority++;
-            pos = 0;
-            continue;
-        }
-        QtTIMathAction actLeft;
-        if (pos > 0)
-            actLeft = actions[pos - 1];
-        QtTIMathAction actRight;
-        if (pos < actions.size() - 1)
-            actRight = actions[pos + 1];
-        QtTIMathAction act = actions[pos];
-        if (act.opPriority() != opPriority) {
-            pos++;
-            continue;
-        }
-        bool calcIsOk = false;
-        QVariant calcRes;
-        std::tie(calcIsOk, calcRes, error) = calcMathOperation(act.left(), act.right(), act.op());
-        if (!calcIsOk)
-            return QVariant();
-
-        if (actLeft.isValid())
-            actLeft.setRight(calcRes);
-        if (actRight.isValid())
-            actRight.setLeft(calcRes);
-
-        // update
-        if (pos > 0)
-            actions.replace(pos - 1, actLeft);
-        if (pos < actions.size() - 1)
-            actions.replace(pos + 1, actRight);
-
-        actions.removeAt(pos);
-        if (actions.isEmpty()) {
-            if (isOk)
-                *isOk = true;
-            return calcRes;
-        }
-    }
-    error = QString("Incorrect execution of a math expression '%1'").arg(expr);
-    return QVariant();
-}
-
-//!
-//! \brief Parse left and right values
-//! \param expr
-//! \param actions
-//! \param parserArgs
-//! \param parserFunc
-//! \param[in,out] isOk
-//! \param[in,out] error
-//!
-void QtTIParserMath::parseLR(const QString &expr, QList<QtTIMathAction> *actions, QtTIAbstractParserArgs *parserArgs, QtTIAbstractParserFunc *parserFunc, bool *isOk, QString &error)
+std::tuple<bool, QVariant, QString> QtTIParserMath::calcMathOperation(const QVariant &left, const QVariant &right, const QString &op)
 {
-    if (isOk)
-        *isOk = false;
-    error.clear();
-    QRegExp rxMath(RX_MATH_OP_SEARCH);
-    if (rxMath.indexIn(expr, 0) != -1) {
-        if (rxMath.captureCount() < 3)
-            return;
-
-        QString condLeft = rxMath.cap(1).trimmed();
-        QString condOp = rxMath.cap(2).trimmed();
-        QString condRight = rxMath.cap(3).trimmed();
-        QVariant condLeftVal;
-        QVariant condRightVal;
-        bool parseIsOk = false;
-        if (rxMath.indexIn(condLeft) != -1) {
-            parseLR(condLeft.trimmed(), actions, parserArgs, parserFunc, &parseIsOk, error);
-            if (!parseIsOk) {
-                error = QString("Parse condition left value failed (condition: '%1')!").arg(condLeft.trimmed());
-                return;
-            }
-            const int pos = actions->size() - 1;
-            if (pos < 0)
-                return;
-            condLeftVal = actions->at(pos).right();
-        } else {
-            std::tie(parseIsOk, condLeftVal, error) = QtTIParserMath::parseParamValue(condLeft.trimmed(), parserArgs, parserFunc);
-            if (!parseIsOk) {
-                error = QString("Parse condition left value failed (condition: '%1')!").arg(condLeft.trimmed());
-                return;
-            }
-        }
-
-        const int rPos = actions->size();
-        if (rxMath.indexIn(condRight) != -1) {
-            parseLR(condRight.trimmed(), actions, parserArgs, parserFunc, &parseIsOk, error);
-            if (!parseIsOk) {
-                error = QString("Parse condition right value failed (condition: '%1')!").arg(condRight.trimmed());
-                return;
-            }
-            if (rPos >= actions->size())
-                return;
-            condRightVal = actions->at(rPos).left();
-        } else {
-            std::tie(parseIsOk, condRightVal, error) = QtTIParserMath::parseParamValue(condRight.trimmed(), parserArgs, parserFunc);
-            if (!parseIsOk) {
-                error = QString("Parse condition right value failed (condition: '%1')!").arg(condRight.trimmed());
-                return;
-            }
-        }
-        actions->insert(rPos, QtTIMathAction(condLeftVal, condRightVal, condOp));
-        if (isOk)
-            *isOk = true;
-    }
+    const MathOperation operation = strToOperation(op);
+    if (operation == MathOperation::Invalid)
+        return std::make_tuple(false, QVariant(), QString("Unsupported math operator '%1'").arg(op));
+    return calcMathOperation(left, right, operation);
 }
 
 //!
-//! \brief Parse parameter value from string
-//! \param str Parameter value string view
+//! \brief Calculate math operation
+//! \param left
+//! \param right
+//! \param operation
 //! \return
 //!
-std::tuple<bool, QVariant, QString> QtTIParserMath::parseParamValue(const QString &str, QtTIAbstractParserArgs *parserArgs, QtTIAbstractParserFunc *parserFunc)
+std::tuple<bool, QVariant, QString> QtTIParserMath::calcMathOperation(const QVariant &left, const QVariant &right, const MathOperation operation)
 {
-    if (str.isEmpty())
-        return std::make_tuple(false, QVariant(), "Parse value failed (empty string passed)");
-
-    // math
-    if (QtTIParserMath::isMathExpr(str)) {
-        bool isOk = false;
-        QString error;
-        QVariant result = QtTIParserMath::parseMath(str, parserArgs, parserFunc, &isOk, error);
-        if (!isOk)
-            return std::make_tuple(false, QVariant(), error);
-
-        return std::make_tuple(true, result, "");
-    }
-
-    // function
-    QRegExp rxFunc(RX_FUNC);
-    if (rxFunc.indexIn(str) != -1) {
-        QString funcName = rxFunc.cap(2).trimmed();
-        QVariantList funcArgs = parserArgs->parseHelpFunctionArgs(rxFunc.cap(3).trimmed());
-        return parserFunc->evalHelpFunction(funcName, funcArgs);
-    }
-
-    // arg
-    QVariantList tmp = parserArgs->parseHelpFunctionArgs(str);
-    if (tmp.isEmpty())
-        return std::make_tuple(false, QVariant(), "Parse value failed");
-    if (tmp.size() > 1)
-        return std::make_tuple(false, QVariant(), "Parse value failed (more than one argument is given)");
-
-    return std::make_tuple(true, tmp[0], "");
+    bool isOk = false;
+    QtTIValue result;
+    QString error;
+    std::tie(isOk, result, error) = calcMathOperation(QtTIValue::fromVariant(left), QtTIValue::fromVariant(right), operation);
+    return std::make_tuple(isOk, result.toVariant(), error);
 }
 
 //!
-//! \brief Select type for calc operation
+//! \brief Calculate math operation
 //! \param left
 //! \param right
+//! \param operation
 //! \return
 //!
-int QtTIParserMath::selectCalcType(const QVariant &left, const QVariant &right)
-{
-    const int lType = static_cast<int>(left.type());
-    const int rType = static_cast<int>(right.type());
-    const ulong lTypeSize = QtTIParserMath::typeSize(left);
-    const ulong rTypeSize = QtTIParserMath::typeSize(right);
-    int calcType = lType;
-    if (rTypeSize > lTypeSize) {
-        calcType = rType;
-    } else if (rTypeSize == lTypeSize
-               && rType != lType) {
-        if (rType == QVariant::Double
-            || rType == QMetaType::Float)
-            calcType = rType;
-    }
-    return calcType;
-}
-
+//! NOTE: The numbers are calculated unboxed (see QtTIValue), the type of the result is selected
+//!       by the operand types (the larger type, for the same sizes - the real one or the left one).
 //!
-//! \brief Select value type size
-//! \param value
-//! \return
-//!
-ulong QtTIParserMath::typeSize(const QVariant &value)
+std::tuple<bool, QtTIValue, QString> QtTIParserMath::calcMathOperation(const QtTIValue &left, const QtTIValue &right, const MathOperation operation)
 {
-    switch (static_cast<int>(value.type())) {
-        case QVariant::Int:
-            return sizeof (value.toInt());      // 4
-        case QVariant::UInt:
-            return sizeof (value.toUInt());     // 4
-        case QMetaType::Float:
-            return sizeof (value.toFloat());    // 4
-        case QVariant::Double:
-            return sizeof (value.toDouble());   // 8
-        case QVariant::LongLong:
-            return sizeof (value.toLongLong()); // 8
-        case QVariant::ULongLong:
-            return sizeof (value.toULongLong());// 8
+    if (!left.isNumber())
+        return std::make_tuple(false, QtTIValue(), QString("Unsupported left value type '%1' for operator '%2'").arg(left.toVariant().typeName(), operationToStr(operation)));
+    if (!right.isNumber())
+        return std::make_tuple(false, QtTIValue(), QString("Unsupported right value type '%1' for operator '%2'").arg(right.toVariant().typeName(), operationToStr(operation)));
+
+    const QtTIValue::Type cType = QtTIValue::calcType(left, right);
+    switch (cType) {
+        case QtTIValue::Type::Int:
+            return calcMathOperation_t_int<int>(static_cast<int>(left.toInt64()), static_cast<int>(right.toInt64()), operation);
+        case QtTIValue::Type::UInt:
+            return calcMathOperation_t_int<uint>(static_cast<uint>(left.toUInt64()), static_cast<uint>(right.toUInt64()), operation);
+        case QtTIValue::Type::Double:
+            return calcMathOperation_t_real<double>(left.toDouble(), right.toDouble(), operation);
+        case QtTIValue::Type::Float:
+            return calcMathOperation_t_real<float>(static_cast<float>(left.toDouble()), static_cast<float>(right.toDouble()), operation);
+        case QtTIValue::Type::LongLong:
+            return calcMathOperation_t_int<qlonglong>(left.toInt64(), right.toInt64(), operation);
+        case QtTIValue::Type::ULongLong:
+            return calcMathOperation_t_int<qulonglong>(left.toUInt64(), right.toUInt64(), operation);
         default:
             break;
     }
-    return 0;
+    return std::make_tuple(false, QtTIValue(), QString("Unsupported calc type '%1' for operator '%2'").arg(static_cast<int>(cType)).arg(operationToStr(operation)));
 }
 
 //!
-//! \brief Calculate math operation
-//! \param left
-//! \param right
+//! \brief Convert string view operator to enum 'QtTIParserMath::MathOperation' value
 //! \param op
 //! \return
 //!
-std::tuple<bool, QVariant, QString> QtTIParserMath::calcMathOperation(const QVariant &left, const QVariant &right, const QString &op)
+QtTIParserMath::MathOperation QtTIParserMath::strToOperation(const QString &op)
 {
-    QList<int> supTypes({QVariant::Int,
-                         QVariant::UInt,
-                         QVariant::Double,
-                         QMetaType::Float,
-                         QVariant::LongLong,
-                         QVariant::ULongLong});
+    if (op == "+")
+        return MathOperation::Add;
+    else if (op == "-")
+        return MathOperation::Subtract;
+    else if (op == "*")
+        return MathOperation::Multiply;
+    else if (op == "/")
+        return MathOperation::Divide;
+    else if (op == "%")
+        return MathOperation::Modulo;
+    else if (op == "//")
+        return MathOperation::FloorDivide;
+    else if (op == "**")
+        return MathOperation::Power;
 
-    if (!supTypes.contains(static_cast<int>(left.type())))
-        return std::make_tuple(false, QVariant(), QString("Unsupported left value type '%1' for operator '%2'").arg(left.typeName(), op));
-    if (!supTypes.contains(static_cast<int>(right.type())))
-        return std::make_tuple(false, QVariant(), QString("Unsupported right value type '%1' for operator '%2'").arg(right.typeName(), op));
+    return MathOperation::Invalid;
+}
 
-    const int cType = QtTIParserMath::selectCalcType(left, right);
-    switch (cType) {
-        case QVariant::Int:
-            return calcMathOperation_t_int<int>(left.toInt(), right.toInt(), op);
-        case QVariant::UInt:
-            return calcMathOperation_t_int<uint>(left.toUInt(), right.toUInt(), op);
-        case QVariant::Double:
-            return calcMathOperation_t_real<double>(left.toDouble(), right.toDouble(), op);
-        case QMetaType::Float:
-            return calcMathOperation_t_real<float>(left.toFloat(), right.toFloat(), op);
-        case QVariant::LongLong:
-            return calcMathOperation_t_int<qlonglong>(left.toLongLong(), right.toLongLong(), op);
-        case QVariant::ULongLong:
-            return calcMathOperation_t_int<qulonglong>(left.toULongLong(), right.toULongLong(), op);
+//!
+//! \brief Convert enum 'QtTIParserMath::MathOperation' value to string view operator
+//! \param operation
+//! \return
+//!
+QString QtTIParserMath::operationToStr(const MathOperation operation)
+{
+    switch (operation) {
+        case MathOperation::Add:
+            return QString("+");
+        case MathOperation::Subtract:
+            return QString("-");
+        case MathOperation::Multiply:
+            return QString("*");
+        case MathOperation::Divide:
+            return QString("/");
+        case MathOperation::Modulo:
+            return QString("%");
+        case MathOperation::FloorDivide:
+            return QString("//");
+        case MathOperation::Power:
+            return QString("**");
         default:
             break;
     }
-    return std::make_tuple(false, QVariant(), QString("Unsupported calc type '%1' for operator '%2'").arg(cType).arg(op));
+    return QString();
 }
 
 //!
 //! \brief Template method for calculate math operation for integer numbers
 //! \param left
 //! \param right
-//! \param op
+//! \param operation
 //! \return
 //!
 template<typename T>
-std::tuple<bool, QVariant, QString> QtTIParserMath::calcMathOperation_t_int(const T &left, const T &right, const QString &op)
+std::tuple<bool, QtTIValue, QString> QtTIParserMath::calcMathOperation_t_int(const T &left, const T &right, const MathOperation operation)
 {
-    if (op == "+") {
-        return std::make_tuple(true, left + right, "");
-    } else if (op == "-") {
-        return std::make_tuple(true, left - right, "");
-    } else if (op == "/") {
-        if (right == 0)
-            return std::make_tuple(false, QVariant(), "Division by zero!");
-        return std::make_tuple(true, left / right, "");
-    } else if (op == "*") {
-        return std::make_tuple(true, left * right, "");
-    } else if (op == "%") {
-        if (right == 0)
-            return std::make_tuple(false, QVariant(), "Division by zero!");
-        return std::make_tuple(true, left % right, "");
-    } else if (op == "//") {
-        if (right == 0)
-            return std::make_tuple(false, QVariant(), "Division by zero!");
-        return std::make_tuple(true, static_cast<int>(left / right), "");
-    } else if (op == "**") {
-        return std::make_tuple(true, std::pow(left, right), "");
+    switch (operation) {
+        case MathOperation::Add:
+            return std::make_tuple(true, left + right, QString());
+        case MathOperation::Subtract:
+            return std::make_tuple(true, left - right, QString());
+        case MathOperation::Divide:
+            if (right == 0)
+                return std::make_tuple(false, QtTIValue(), QString("Division by zero!"));
+            return std::make_tuple(true, left / right, QString());
+        case MathOperation::Multiply:
+            return std::make_tuple(true, left * right, QString());
+        case MathOperation::Modulo:
+            if (right == 0)
+                return std::make_tuple(false, QtTIValue(), QString("Division by zero!"));
+            return std::make_tuple(true, left % right, QString());
+        case MathOperation::FloorDivide:
+            if (right == 0)
+                return std::make_tuple(false, QtTIValue(), QString("Division by zero!"));
+            return std::make_tuple(true, static_cast<int>(left / right), QString());
+        case MathOperation::Power:
+            return std::make_tuple(true, std::pow(left, right), QString());
+        default:
+            break;
     }
-    return std::make_tuple(false, QVariant(), QString("Unsupported math operator '%1'").arg(op));
+    return std::make_tuple(false, QtTIValue(), QString("Unsupported math operator '%1'").arg(operationToStr(operation)));
 }
 
 //!
 //! \brief Template method for calculate math operation for real numbers
 //! \param left
 //! \param right
-//! \param op
+//! \param operation
 //! \return
 //!
 template<typename T>
-std::tuple<bool, QVariant, QString> QtTIParserMath::calcMathOperation_t_real(const T &left, const T &right, const QString &op)
+std::tuple<bool, QtTIValue, QString> QtTIParserMath::calcMathOperation_t_real(const T &left, const T &right, const MathOperation operation)
 {
-    if (op == "+") {
-        return std::make_tuple(true, left + right, "");
-    } else if (op == "-") {
-        return std::make_tuple(true, left - right, "");
-    } else if (op == "/") {
-        if (right == 0.0)
-            return std::make_tuple(false, QVariant(), "Division by zero!");
-        return std::make_tuple(true, left / right, "");
-    } else if (op == "*") {
-        return std::make_tuple(true, left * right, "");
-    } else if (op == "%") {
-        if (right == 0.0)
-            return std::make_tuple(false, QVariant(), "Division by zero!");
-        return std::make_tuple(true, std::fmod(left, right), "");
-    } else if (op == "//") {
-        if (right == 0.0)
-            return std::make_tuple(false, QVariant(), "Division by zero!");
-        return std::make_tuple(true, static_cast<int>(left / right), "");
-    } else if (op == "**") {
-        return std::make_tuple(true, std::pow(left, right), "");
+    switch (operation) {
+        case MathOperation::Add:
+            return std::make_tuple(true, left + right, QString());
+        case MathOperation::Subtract:
+            return std::make_tuple(true, left - right, QString());
+        case MathOperation::Divide:
+            if (right == 0.0)
+                return std::make_tuple(false, QtTIValue(), QString("Division by zero!"));
+            return std::make_tuple(true, left / right, QString());
+        case MathOperation::Multiply:
+            return std::make_tuple(true, left * right, QString());
+        case MathOperation::Modulo:
+            if (right == 0.0)
+                return std::make_tuple(false, QtTIValue(), QString("Division by zero!"));
+            return std::make_tuple(true, std::fmod(left, right), QString());
+        case MathOperation::FloorDivide:
+            if (right == 0.0)
+                return std::make_tuple(false, QtTIValue(), QString("Division by zero!"));
+            return std::make_tuple(true, static_cast<int>(left / right), QString());
+        case MathOperation::Power:
+            return std::make_tuple(true, std::pow(left, right), QString());
+        default:
+            break;
     }
-
-    return std::make_tuple(false, QVariant(), QString("Unsupported math operator '%1'").arg(op));
+    return std::make_tuple(false, QtTIValue(), QString("Unsupported math operator '%1'").arg(operationToStr(operation)));
 }
@@ -3,36 +3,45 @@
 
 #include <QString>
 #include <QVariant>
-#include "QtTIMathAction.h"
+#include <tuple>
+
 #include "../Abstract/QtTIAbstractParserArgs.h"
 #include "../Abstract/QtTIAbstractParserFunc.h"
+#include "../Expression/QtTIValue.h"
 
 class QtTIParserMath
 {
 public:
+    enum class MathOperation {
+        Invalid = 0,
+        Add,            //!< сложение (+)
+        Subtract,       //!< вычитание (-)
+        Multiply,       //!< умножение (*)
+        Divide,         //!< деление (/)
+        Modulo,         //!< остаток от деления (%)
+        FloorDivide,    //!< целочисленное деление (//)
+        Power           //!< возведение в степень (**)
+    };
+
     QtTIParserMath() = default;
     ~QtTIParserMath() = default;
 
     static bool isMathExpr(const QString &expr);
     static QVariant parseMath(const QString &expr, QtTIAbstractParserArgs *parserArgs, QtTIAbstractParserFunc *parserFunc, bool *isOk, QString &error);
 
-private:
-    static QVariant parseMathWithoutBrackets(const QString &expr, QtTIAbstractParserArgs *parserArgs, QtTIAbstractParserFunc *parserFunc, bool *isOk, QString &error);
-
-    static void parseLR(const QString &expr, QList<QtTIMathAction> *actions, QtTIAbstractParserArgs *parserArgs, QtTIAbstractParserFunc *parserFunc, bool *isOk, QString &error);
-
-    static std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> parseParamValue(const QString &str, QtTIAbstractParserArgs *parserArgs, QtTIAbstractParserFunc *parserFunc);
-
-    static int selectCalcType(const QVariant &left, const QVariant &right);
-    static ulong typeSize(const QVariant &value);
-
     static std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> calcMathOperation(const QVariant &left, const QVariant &right, const QString &op);
+    static std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> calcMathOperation(const QVariant &left, const QVariant &right, const MathOperation operation);
+    static std::tuple<bool/*isOk*/,QtTIValue/*res*/,QString/*err*/> calcMathOperation(const QtTIValue &left, const QtTIValue &right, const MathOperation operation);
 
+    static MathOperation strToOperation(const QString &op);
+    static QString operationToStr(const MathOperation operation);
+
+private:
     template<typename T>
-    static std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> calcMathOperation_t_int(const T &left, const T &right, const QString &op);
+    static std::tuple<bool/*isOk*/,QtTIValue/*res*/,QString/*err*/> calcMathOperation_t_int(const T &left, const T &right, const MathOperation operation);
 
     template<typename T>
-    static std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> calcMathOperation_t_real(const T &left, const T &right, const QString &op);
+    static std::tuple<bool/*isOk*/,QtTIValue/*res*/,QString/*err*/> calcMathOperation_t_real(const T &left, const T &right, const MathOperation operation);
 };
 
 #endif // QTTIPARSERMATH_H
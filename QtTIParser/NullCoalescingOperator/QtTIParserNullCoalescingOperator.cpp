@@ -1,9 +1,5 @@
 #include "QtTIParserNullCoalescingOperator.h"
-#include "../BracketsExpr/QtTIParserBracketsExpr.h"
-#include "../Logic/QtTIParserLogic.h"
-#include "../Math/QtTIParserMath.h"
-#include "../../QtTIDefines/QtTIRegExpDefines.h"
-#include <QRegExp>
+#include "../Expression/QtTIExpression.h"
 
 //!
 //! \brief Check is null-coalescing operator expression
@@ -12,8 +8,18 @@
 //!
 bool QtTIParserNullCoalescingOperator::isNullCoalescingOperatorExpr(const QString &expr)
 {
-    QRegExp rx(RX_NULL_COALESCING);
-    return (rx.indexIn(expr) != -1);
+    return isNullCoalescingOperatorExpr(QtTIExpression::compile(expr));
+}
+
+//!
+//! \brief Check is null-coalescing operator expression (the root of the expression tree is the null-coalescing operator)
+//! \param expr Compiled expression
+//! \return
+//!
+bool QtTIParserNullCoalescingOperator::isNullCoalescingOperatorExpr(const QtTIExpression &expr)
+{
+    return (expr.isValid()
+            && expr.kind() == QtTIExprNode::Kind::NullCoalescing);
 }
 
 //!
@@ -30,7 +36,9 @@ bool QtTIParserNullCoalescingOperator::isNullCoalescingOperatorExpr(const QStrin
 //!         {{ foo ?? 'no' }}
 //!
 //! === Brackets support:
-//!     Supported grouping expressions with brackets '(...expr...)':
+//!     Supported grouping expressions with brackets '(...expr...)', the expression is evaluated
+//!     as an expression tree (see QtTIExprParser), the right operand is evaluated only
+//!     if the left one is NULL (the operands are split by the expression parser, not by regular expressions):
 //!         {% set a = 10.5 %}
 //!         {% set b = 2 %}
 //!         {% set aa = { a:1, b:2, c:3 } %}
@@ -55,118 +63,16 @@ QVariant QtTIParserNullCoalescingOperator::parseNullCoalescingOperator(const QSt
         error = QString("QtTIParserFunc is NULL");
         return QVariant();
     }
-    if (!QtTIParserNullCoalescingOperator::isNullCoalescingOperatorExpr(expr)) {
+    const QtTIExpression compiledExpr = QtTIExpression::compile(expr);
+    if (!QtTIParserNullCoalescingOperator::isNullCoalescingOperatorExpr(compiledExpr)) {
         error = QString("Incorrect null-coalescing operator expression '%1'").arg(expr);
         return QVariant();
     }
 
-    QRegExp rx(RX_NULL_COALESCING);
-    if (rx.indexIn(expr) != -1) {
-        QString ternCond = rx.cap(1).trimmed();
-        QString ternCondFalse = rx.cap(2).trimmed();
-
-        bool calcIsOk = false;
-        QVariant ternCondVal;
-        std::tie(calcIsOk, ternCondVal, error) = QtTIParserNullCoalescingOperator::evalCond(ternCond, parserArgs, parserFunc);
-        if (!calcIsOk) {
-            if (isOk)
-                *isOk = false;
-            return QVariant();
-        }
-
-        QVariant ternResultFalse;
-        std::tie(calcIsOk, ternResultFalse, error) = QtTIParserNullCoalescingOperator::evalCond(ternCondFalse, parserArgs, parserFunc);
-        if (!calcIsOk) {
-            if (isOk)
-                *isOk = false;
-            return QVariant();
-        }
-        if (isOk)
-            *isOk = true;
-
-        if (ternCondVal.type() == QVariant::Bool)
-            return (ternCondVal.toBool() ? ternCondVal : ternResultFalse);
-
-        return (!ternCondVal.isNull() ? ternCondVal : ternResultFalse);
-    }
-    error = QString("Could not recognize null-coalescing operator for expression '%1'").arg(expr);
-    return QVariant();
-}
-
-//!
-//! \brief Evaluate condition
-//! \param str
-//! \param parserArgs
-//! \param parserFunc
-//! \return
-//!
-std::tuple<bool, QVariant, QString> QtTIParserNullCoalescingOperator::evalCond(const QString &str,
-                                                                               QtTIAbstractParserArgs *parserArgs,
-                                                                               QtTIAbstractParserFunc *parserFunc)
-{
-    if (str.isEmpty())
-        return std::make_tuple(false, QVariant(), "Eval condition failed (empty string passed)");
-
-    QStringList validStringsBeforeBracket({ "+", "-", "/", "%", "//", "*", "**", "and", "or", "not", "&&", "||" });
-    QtTIBracketsNode brNode = QtTIParserBracketsExpr::parseBracketsExpression(str, validStringsBeforeBracket, parserArgs, [parserArgs, parserFunc](const QString &nodeBody) {
-        return QtTIParserNullCoalescingOperator::parseParamValue(nodeBody, parserArgs, parserFunc);
-    });
-    if (!brNode.isValid())
-        return std::make_tuple(false, QVariant(), QString("Invalid brackets node for expression '%1'").arg(str));
-
-    return brNode.evalNodeBody();
-}
-
-//!
-//! \brief Parse parameter value from string
-//! \param str Parameter value string view
-//! \param parserArgs
-//! \param parserFunc
-//! \return
-//!
-std::tuple<bool, QVariant, QString> QtTIParserNullCoalescingOperator::parseParamValue(const QString &str,
-                                                                                      QtTIAbstractParserArgs *parserArgs,
-                                                                                      QtTIAbstractParserFunc *parserFunc)
-{
-    if (str.isEmpty())
-        return std::make_tuple(false, QVariant(), "Parse value failed (empty string passed)");
-
-    // logic
-    if (QtTIParserLogic::isLogicExpr(str)) {
-        bool isOk = false;
-        QString error;
-        QVariant result = QtTIParserLogic::parseLogic(str, parserArgs, parserFunc, &isOk, error);
-        if (!isOk)
-            return std::make_tuple(false, QVariant(), error);
-
-        return std::make_tuple(true, result, "");
-    }
-
-    // math
-    if (QtTIParserMath::isMathExpr(str)) {
-        bool isOk = false;
-        QString error;
-        QVariant result = QtTIParserMath::parseMath(str, parserArgs, parserFunc, &isOk, error);
-        if (!isOk)
-            return std::make_tuple(false, QVariant(), error);
-
-        return std::make_tuple(true, result, "");
-    }
-
-    // function
-    QRegExp rxFunc(RX_FUNC);
-    if (rxFunc.indexIn(str) != -1) {
-        QString funcName = rxFunc.cap(2).trimmed();
-        QVariantList funcArgs = parserArgs->parseHelpFunctionArgs(rxFunc.cap(3).trimmed());
-        return parserFunc->evalHelpFunction(funcName, funcArgs);
-    }
-
-    // arg
-    QVariantList tmp = parserArgs->parseHelpFunctionArgs(str);
-    if (tmp.isEmpty())
-        return std::make_tuple(false, QVariant(), "Parse value failed");
-    if (tmp.size() > 1)
-        return std::make_tuple(false, QVariant(), "Parse value failed (more than one argument is given)");
-
-    return std::make_tuple(true, tmp[0], "");
+    bool isOkLocal = false;
+    QVariant result;
+    std::tie(isOkLocal, result, error) = compiledExpr.eval(parserArgs, parserFunc);
+    if (isOk)
+        *isOk = isOkLocal;
+    return result;
 }
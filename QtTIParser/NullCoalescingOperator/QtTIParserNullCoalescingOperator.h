@@ -7,6 +7,8 @@
 #include "../Abstract/QtTIAbstractParserArgs.h"
 #include "../Abstract/QtTIAbstractParserFunc.h"
 
+class QtTIExpression;
+
 class QtTIParserNullCoalescingOperator
 {
 public:
@@ -14,20 +16,12 @@ public:
     ~QtTIParserNullCoalescingOperator() = default;
 
     static bool isNullCoalescingOperatorExpr(const QString &expr);
+    static bool isNullCoalescingOperatorExpr(const QtTIExpression &expr);
     static QVariant parseNullCoalescingOperator(const QString &expr,
                                                 QtTIAbstractParserArgs *parserArgs,
                                                 QtTIAbstractParserFunc *parserFunc,
                                                 bool *isOk,
                                                 QString &error);
-
-private:
-    static std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> evalCond(const QString &str,
-                                                                            QtTIAbstractParserArgs *parserArgs,
-                                                                            QtTIAbstractParserFunc *parserFunc);
-
-    static std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> parseParamValue(const QString &str,
-                                                                                   QtTIAbstractParserArgs *parserArgs,
-                                                                                   QtTIAbstractParserFunc *parserFunc);
 };
 
 #endif // QTTIPARSERNULLCOALESCINGOPERATOR_H
@@ -0,0 +1,369 @@
+#include "QtTIProgram.h"
+
+#include <QDataStream>
+
+static const quint32 ProgramMagic = 0x51544950;  //!< 'QTIP'
+static const quint32 ProgramVersion = 3;         //!< version of the serialized program
+
+//!
+//! \brief Serialize program
+//! \return
+//!
+//! NOTE: The program with control blocks executed by the interpreter can't be serialized (see isSerializable).
+//!
+std::tuple<bool, QByteArray, QString> QtTIProgram::serialize() const
+{
+    if (!isSerializable())
+        return std::make_tuple(false, QByteArray(), "Program with custom control blocks can't be serialized");
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    stream << ProgramMagic << ProgramVersion;
+    stream << (_scope ? _scope->slotNames() : QStringList());
+
+    stream << static_cast<qint32>(_instructions.size());
+    for (const QtTIInstruction &instruction : _instructions)
+        stream << static_cast<qint32>(instruction.op) << static_cast<qint32>(instruction.a) << static_cast<qint32>(instruction.b);
+
+    stream << _texts << _constantData << _mapKeys;
+
+    stream << static_cast<qint32>(_paths.size());
+    for (const QtTIParamPath &path : _paths)
+        stream << path.path();
+
+    stream << static_cast<qint32>(_calls.size());
+    for (const QtTIProgramCall &call : _calls)
+        stream << call.name << call.isConstant;
+
+    stream << static_cast<qint32>(_exprs.size());
+    for (const QtTIProgramExpr &expr : _exprs)
+        stream << expr.isExec << static_cast<qint32>(expr.lineNum) << static_cast<qint32>(expr.linePos)
+               << expr.errorFormat << expr.invalidResultError << static_cast<qint32>(expr.site);
+
+    stream << static_cast<qint32>(_sites.size());
+    for (const QtTIProgramSite &site : _sites)
+        stream << site.data << static_cast<qint32>(site.lineNum) << static_cast<qint32>(site.linePos);
+
+    stream << static_cast<qint32>(_loops.size());
+    for (const QtTIProgramLoop &loop : _loops)
+        stream << loop.paramNames << loop.paramSlots << static_cast<qint32>(loop.lineNum);
+
+    stream << static_cast<qint32>(_sets.size());
+    for (const QtTIProgramSet &set : _sets)
+        stream << set.paramName << static_cast<qint32>(set.paramSlot) << static_cast<qint32>(set.lineNum);
+
+    stream << static_cast<qint32>(_cacheCount) << static_cast<qint32>(_paramCaches.size());
+    for (auto it = _paramCaches.constBegin(); it != _paramCaches.constEnd(); ++it)
+        stream << it.key() << it.value();
+
+    if (stream.status() != QDataStream::Ok)
+        return std::make_tuple(false, QByteArray(), "Write program data failed");
+    return std::make_tuple(true, data, "");
+}
+
+//!
+//! \brief Restore serialized program
+//! \param data Serialized program (see serialize)
+//! \return
+//!
+//! NOTE: The instructions are checked (pool indexes, jump targets, stack depth),
+//!       the restored program has new (empty) help function caches.
+//!
+std::tuple<bool, std::shared_ptr<QtTIProgram>, QString> QtTIProgram::deserialize(const QByteArray &data)
+{
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (stream.status() != QDataStream::Ok || magic != ProgramMagic)
+        return std::make_tuple(false, nullptr, "Invalid program data");
+    if (version != ProgramVersion)
+        return std::make_tuple(false, nullptr, QString("Unsupported program version '%1'").arg(version));
+
+    std::shared_ptr<QtTIProgram> program = std::make_shared<QtTIProgram>();
+
+    QStringList slotNames;
+    stream >> slotNames;
+    std::shared_ptr<QtTIScope> scope = std::make_shared<QtTIScope>();
+    for (const QString &name : slotNames)
+        scope->slot(name);
+
+    qint32 count = 0;
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+        qint32 op = 0;
+        qint32 a = 0;
+        qint32 b = 0;
+        stream >> op >> a >> b;
+        if (op < static_cast<qint32>(QtTIInstruction::Opcode::Text)
+            || op > static_cast<qint32>(QtTIInstruction::Opcode::ClearCache))
+            return std::make_tuple(false, nullptr, QString("Invalid operation code '%1'").arg(op));
+        QtTIInstruction instruction;
+        instruction.op = static_cast<QtTIInstruction::Opcode>(op);
+        instruction.a = a;
+        instruction.b = b;
+        program->_instructions.append(instruction);
+    }
+
+    stream >> program->_texts >> program->_constantData >> program->_mapKeys;
+    for (const QVariant &value : program->_constantData)
+        program->_constants.append(QtTIValue::fromVariant(value));
+
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+        QString path;
+        stream >> path;
+        program->_paths.append(QtTIParamPath(path, scope.get()));
+    }
+
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+        QtTIProgramCall call;
+        stream >> call.name >> call.isConstant;
+        call.functionCache = std::make_shared<QtTIFunctionCache>();
+        program->_calls.append(call);
+    }
+
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+        QtTIProgramExpr expr;
+        qint32 lineNum = 0;
+        qint32 linePos = 0;
+        qint32 site = 0;
+        stream >> expr.isExec >> lineNum >> linePos >> expr.errorFormat >> expr.invalidResultError >> site;
+        expr.lineNum = lineNum;
+        expr.linePos = linePos;
+        expr.site = site;
+        program->_exprs.append(expr);
+    }
+
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+        QtTIProgramSite site;
+        qint32 lineNum = 0;
+        qint32 linePos = 0;
+        stream >> site.data >> lineNum >> linePos;
+        site.lineNum = lineNum;
+        site.linePos = linePos;
+        program->_sites.append(site);
+    }
+
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+        QtTIProgramLoop loop;
+        qint32 lineNum = 0;
+        stream >> loop.paramNames >> loop.paramSlots >> lineNum;
+        loop.lineNum = lineNum;
+        program->_loops.append(loop);
+    }
+
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+        QtTIProgramSet set;
+        qint32 paramSlot = 0;
+        qint32 lineNum = 0;
+        stream >> set.paramName >> paramSlot >> lineNum;
+        set.paramSlot = paramSlot;
+        set.lineNum = lineNum;
+        program->_sets.append(set);
+    }
+
+    qint32 cacheCount = 0;
+    stream >> cacheCount >> count;
+    program->_cacheCount = cacheCount;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+        QString paramName;
+        QVector<int> caches;
+        stream >> paramName >> caches;
+        program->_paramCaches.insert(paramName, caches);
+    }
+
+    if (stream.status() != QDataStream::Ok)
+        return std::make_tuple(false, nullptr, "Read program data failed");
+
+    program->_scope = scope;
+    const QString error = program->verify();
+    if (!error.isEmpty())
+        return std::make_tuple(false, nullptr, error);
+    return std::make_tuple(true, program, "");
+}
+
+//!
+//! \brief Check instructions of the program
+//! \return Error (empty - the program is correct)
+//!
+//! The operands must refer to the pool items, the jumps must refer to the instructions
+//! and the stack depth must be the same for all paths to the instruction.
+//!
+QString QtTIProgram::verify() const
+{
+    const int size = _instructions.size();
+    const int slotCount = _scope ? _scope->slotCount() : 0;
+    auto isIndex = [](const int index, const int count) { return (index >= 0 && index < count); };
+    auto isTarget = [size](const int target) { return (target >= 0 && target <= size); };
+
+    if (_cacheCount < 0)
+        return "Invalid number of the cached values";
+    for (const QVector<int> &caches : _paramCaches) {
+        for (const int cache : caches) {
+            if (!isIndex(cache, _cacheCount))
+                return QString("Invalid cached value %1").arg(cache);
+        }
+    }
+
+    QVector<int> depths(size + 1, -1);
+    QVector<int> queue;
+    depths[0] = 0;
+    queue.append(0);
+    while (!queue.isEmpty()) {
+        int pc = queue.takeLast();
+        int depth = depths[pc];
+        while (pc < size) {
+            const QtTIInstruction &instruction = _instructions.at(pc);
+            bool isOperandsOk = true;
+            int pops = 0;
+            int pushes = 0;
+            int target = -1;
+            int targetDepth = depth;
+            bool isEnd = false;
+            switch (instruction.op) {
+                case QtTIInstruction::Opcode::Text:
+                case QtTIInstruction::Opcode::UnsetParam:
+                    isOperandsOk = isIndex(instruction.a, _texts.size());
+                    break;
+                case QtTIInstruction::Opcode::Fail:
+                    isOperandsOk = isIndex(instruction.a, _texts.size());
+                    isEnd = true;
+                    break;
+                case QtTIInstruction::Opcode::EnterBlock:
+                    isOperandsOk = isIndex(instruction.a, _sites.size());
+                    break;
+                case QtTIInstruction::Opcode::EvalBlock:
+                    isOperandsOk = isIndex(instruction.a, _blocks.size());
+                    break;
+                case QtTIInstruction::Opcode::ExprBegin:
+                    isOperandsOk = isIndex(instruction.a, _exprs.size())
+                                   && (_exprs.at(instruction.a).site == -1 || isIndex(_exprs.at(instruction.a).site, _sites.size()));
+                    break;
+                case QtTIInstruction::Opcode::Output:
+                    isOperandsOk = isIndex(instruction.a, _exprs.size());
+                    pops = 1;
+                    break;
+                case QtTIInstruction::Opcode::Branch:
+                case QtTIInstruction::Opcode::JumpIfFalsePop:
+                    isOperandsOk = isTarget(instruction.a);
+                    pops = 1;
+                    target = instruction.a;
+                    targetDepth = depth - 1;
+                    break;
+                case QtTIInstruction::Opcode::SetParam:
+                    isOperandsOk = isIndex(instruction.a, _sets.size())
+                                   && isIndex(instruction.b, _exprs.size())
+                                   && isIndex(_sets.at(instruction.a).paramSlot + 1, slotCount + 1);
+                    pops = 1;
+                    break;
+                case QtTIInstruction::Opcode::ForBegin:
+                    isOperandsOk = isIndex(instruction.a, _loops.size())
+                                   && isIndex(instruction.b, _exprs.size())
+                                   && _loops.at(instruction.a).paramSlots.size() == _loops.at(instruction.a).paramNames.size();
+                    if (isOperandsOk) {
+                        for (const int slot : _loops.at(instruction.a).paramSlots)
+                            isOperandsOk = isOperandsOk && isIndex(slot + 1, slotCount + 1);
+                    }
+                    pops = 1;
+                    break;
+                case QtTIInstruction::Opcode::ForNext:
+                    isOperandsOk = isTarget(instruction.a) && isIndex(instruction.b, _loops.size());
+                    target = instruction.a;
+                    break;
+                case QtTIInstruction::Opcode::Jump:
+                    isOperandsOk = isTarget(instruction.a);
+                    target = instruction.a;
+                    isEnd = true;
+                    break;
+                case QtTIInstruction::Opcode::PushConst:
+                    isOperandsOk = isIndex(instruction.a, _constants.size());
+                    pushes = 1;
+                    break;
+                case QtTIInstruction::Opcode::LoadParam:
+                    isOperandsOk = isIndex(instruction.a, _paths.size()) && isIndex(instruction.b + 1, slotCount + 1);
+                    pushes = 1;
+                    break;
+                case QtTIInstruction::Opcode::Call:
+                    isOperandsOk = isIndex(instruction.a, _calls.size()) && instruction.b >= 0;
+                    pops = instruction.b;
+                    pushes = 1;
+                    break;
+                case QtTIInstruction::Opcode::MakeList:
+                    isOperandsOk = instruction.b >= 0;
+                    pops = instruction.b;
+                    pushes = 1;
+                    break;
+                case QtTIInstruction::Opcode::MakeMap:
+                    isOperandsOk = isIndex(instruction.a, _mapKeys.size());
+                    pops = isOperandsOk ? _mapKeys.at(instruction.a).size() : 0;
+                    pushes = 1;
+                    break;
+                case QtTIInstruction::Opcode::Negate:
+                case QtTIInstruction::Opcode::Not:
+                case QtTIInstruction::Opcode::ToBool:
+                    pops = 1;
+                    pushes = 1;
+                    break;
+                case QtTIInstruction::Opcode::Math:
+                case QtTIInstruction::Opcode::Compare:
+                    pops = 2;
+                    pushes = 1;
+                    break;
+                case QtTIInstruction::Opcode::JumpIfFalseKeep:
+                case QtTIInstruction::Opcode::JumpIfTrueKeep:
+                    isOperandsOk = isTarget(instruction.a);
+                    pops = 1;
+                    target = instruction.a;
+                    targetDepth = depth;
+                    break;
+                case QtTIInstruction::Opcode::LoadCached:
+                    isOperandsOk = isIndex(instruction.a, _cacheCount) && isTarget(instruction.b);
+                    target = instruction.b;
+                    targetDepth = depth + 1;
+                    break;
+                case QtTIInstruction::Opcode::StoreCached:
+                    isOperandsOk = isIndex(instruction.a, _cacheCount);
+                    pops = 1;
+                    pushes = 1;
+                    break;
+                default:
+                    break;
+            }
+            if (!isOperandsOk)
+                return QString("Invalid operands of instruction %1").arg(pc);
+            if (depth < pops)
+                return QString("Stack underflow in instruction %1").arg(pc);
+
+            if (target != -1) {
+                if (depths[target] == -1) {
+                    depths[target] = targetDepth;
+                    queue.append(target);
+                } else if (depths[target] != targetDepth) {
+                    return QString("Invalid stack depth in instruction %1").arg(target);
+                }
+            }
+            if (isEnd)
+                break;
+
+            depth = depth - pops + pushes;
+            pc++;
+            if (depths[pc] != -1) {
+                if (depths[pc] != depth)
+                    return QString("Invalid stack depth in instruction %1").arg(pc);
+                break;
+            }
+            depths[pc] = depth;
+        }
+    }
+    return QString();
+}
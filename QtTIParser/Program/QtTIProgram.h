@@ -0,0 +1,315 @@
+#ifndef QTTIPROGRAM_H
+#define QTTIPROGRAM_H
+
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+#include <QByteArray>
+#include <QHash>
+#include <memory>
+#include <tuple>
+
+#include "../Expression/QtTIValue.h"
+#include "../Scope/QtTIParamPath.h"
+#include "../Scope/QtTIScope.h"
+#include "../Scope/QtTIFunctionCache.h"
+
+class QtTIAbstractControlBlock;
+
+//!
+//! \brief The QtTIInstruction struct
+//!
+//! One instruction of the program: the operation code and two operands
+//! (indexes of the program pools, jump target, number of values, ...).
+//!
+struct QtTIInstruction
+{
+    //!
+    //! \brief Operation codes
+    //!
+    enum class Opcode {
+        // template
+        Text = 0,       //!< write text 'a'
+        BodyBegin,      //!< start of the template (or control block body)
+        BodyEnd,        //!< end of the template (or control block body)
+        LineBegin,      //!< start of the line (line end between the lines of the body)
+        RStrip,         //!< trim the line buffer on the right
+        BlockStart,     //!< check data before block
+        RStripBlockLine,//!< trim the line buffer on the right (if no data before block)
+        EnterBlock,     //!< start of the control block 'a' (site of the errors)
+        LeaveBlock,     //!< end of the control block
+        EvalBlock,      //!< execute control block 'a' by the interpreter
+        Fail,           //!< error 'a' (b = 1 - error of the expression evaluation)
+        ExprBegin,      //!< start of the expression 'a' (site of the errors)
+        Output,         //!< pop value and write it (expression 'a')
+        Branch,         //!< pop value and jump to 'a' if it is false (condition of the control block)
+        SetParam,       //!< pop value and set variable 'a' (expression 'b')
+        UnsetParam,     //!< remove variable with name 'a'
+        ForBegin,       //!< pop container and start loop 'a' (expression 'b')
+        ForNext,        //!< set variables of the next element of the loop 'b' or jump to 'a' after the last one
+        Jump,           //!< jump to 'a'
+        // expression
+        PushConst,      //!< push constant 'a'
+        LoadParam,      //!< push parameter by path 'a' (slot 'b', -1 - no slot)
+        Call,           //!< pop 'b' arguments and push result of help function 'a'
+        MakeList,       //!< pop 'b' values and push list
+        MakeMap,        //!< pop values of keys 'a' and push map (b = 1 - hash)
+        Negate,         //!< -value
+        Not,            //!< not value
+        Math,           //!< math operation 'a' (see QtTIParserMath::MathOperation)
+        Compare,        //!< comparison 'a' (see QtTIParserLogic::LogicalOperation)
+        ToBool,         //!< convert value to bool
+        JumpIfFalseKeep,//!< jump to 'a' if value is false (the value is kept), otherwise pop value
+        JumpIfTrueKeep, //!< jump to 'a' if value is true (the value is kept), otherwise pop value
+        JumpIfFalsePop, //!< pop value and jump to 'a' if it is false
+        LoadCached,     //!< push cached value 'a' and jump to 'b' if it is set (see QtTIProgram::cacheCount)
+        StoreCached,    //!< set cached value 'a' to the value on the stack (the value is kept)
+        ClearCache      //!< drop all cached values
+    };
+
+    Opcode op {Opcode::Text};   //!< operation code
+    int a {0};                  //!< first operand
+    int b {0};                  //!< second operand
+};
+
+//!
+//! \brief The QtTIProgramExpr struct
+//!
+//! Expression of the program: how the errors of the expression are reported.
+//!
+struct QtTIProgramExpr
+{
+    bool isExec {false};        //!< errors get the block position (see QtTIParser::execExpression)
+    int lineNum {-1};           //!< block line number
+    int linePos {-1};           //!< block position number in line
+    QString errorFormat;        //!< format of the error ('%1' - error)
+    QString invalidResultError; //!< error if the result is invalid (empty - the result is not checked)
+    int site {-1};              //!< site of the errors (output expression), -1 - no site
+};
+
+//!
+//! \brief The QtTIProgramSite struct
+//!
+//! Block of the template, the errors inside the block are reported with its data and position.
+//!
+struct QtTIProgramSite
+{
+    QString data;       //!< block data
+    int lineNum {-1};   //!< line number
+    int linePos {-1};   //!< position number in line
+};
+
+//!
+//! \brief The QtTIProgramLoop struct
+//!
+struct QtTIProgramLoop
+{
+    QStringList paramNames;     //!< loop variable names
+    QVector<int> paramSlots;    //!< loop variable slots (-1 - no slot)
+    int lineNum {-1};           //!< block line number
+};
+
+//!
+//! \brief The QtTIProgramSet struct
+//!
+struct QtTIProgramSet
+{
+    QString paramName;          //!< variable name
+    int paramSlot {-1};         //!< variable slot (-1 - no slot)
+    int lineNum {-1};           //!< block line number
+};
+
+//!
+//! \brief The QtTIProgramCall struct
+//!
+struct QtTIProgramCall
+{
+    QString name;                                       //!< help function name
+    bool isConstant {false};                            //!< all arguments are constants (see QtTIExprCallNode::isConstant)
+    std::shared_ptr<QtTIFunctionCache> functionCache;   //!< help function overloads cache
+};
+
+//!
+//! \brief The QtTIProgram class
+//!
+//! Compiled template lowered to a flat list of instructions (see QtTIProgramCompiler) and executed
+//! by a dispatch loop (see QtTIProgramRunner). The instructions refer to the pools of the program
+//! (texts, constants, parameter paths, help functions, ...) by index. The program is immutable
+//! after compilation and can be rendered any number of times (also from several threads).
+//!
+//! The program does not refer to the template data and to the parser, it can be serialized and
+//! restored (see serialize, deserialize), unless it has control blocks executed by the interpreter
+//! (custom control blocks, see QtTIAbstractControlBlock::compileProgram).
+//!
+//! === Example:
+//!     {% for a in list %}{{ a + 1 }}{% endfor %}
+//!
+//!     BodyBegin
+//!     LineBegin
+//!     EnterBlock      site 0
+//!     ExprBegin       expr 0
+//!     LoadParam       path 0 (list)
+//!     ForBegin        loop 0
+//!     ForNext         -> end
+//!     BodyBegin
+//!     LineBegin
+//!     ExprBegin       expr 1
+//!     LoadParam       path 1 (a)
+//!     PushConst       1
+//!     Math            +
+//!     Output          expr 1
+//!     BodyEnd
+//!     Jump            -> ForNext
+//!     end: LeaveBlock
+//!     BodyEnd
+//!
+//! The values of the help function calls and the parameter paths can be cached for one render
+//! (see cacheCount, QtTIProgramCompiler::emitNode): the cached value is evaluated on first use
+//! and dropped when the loop or 'set' variable it depends on is changed (see paramCaches).
+//!
+//! === Example:
+//!     {% for a in list %}{{ a * size(items) }}{% endfor %}
+//!
+//!     ...
+//!     LoadParam       path 1 (a)
+//!     LoadCached      cache 0 -> end
+//!     LoadParam       path 2 (items)
+//!     Call            size, 1
+//!     StoreCached     cache 0
+//!     end: Math       *
+//!     ...
+//!
+class QtTIProgram
+{
+    friend class QtTIProgramCompiler;
+
+public:
+    QtTIProgram() = default;
+    ~QtTIProgram() = default;
+
+    //!
+    //! \brief Get instructions
+    //! \return
+    //!
+    const QVector<QtTIInstruction> &instructions() const { return _instructions; }
+
+    //!
+    //! \brief Get variable slots of the template
+    //! \return
+    //!
+    const std::shared_ptr<const QtTIScope> &scope() const { return _scope; }
+
+    //!
+    //! \brief Get text or name
+    //! \param index Pool index
+    //! \return
+    //!
+    const QString &text(const int index) const { return _texts.at(index); }
+
+    //!
+    //! \brief Get constant
+    //! \param index Pool index
+    //! \return
+    //!
+    const QtTIValue &constant(const int index) const { return _constants.at(index); }
+
+    //!
+    //! \brief Get parameter path
+    //! \param index Pool index
+    //! \return
+    //!
+    const QtTIParamPath &path(const int index) const { return _paths.at(index); }
+
+    //!
+    //! \brief Get help function
+    //! \param index Pool index
+    //! \return
+    //!
+    const QtTIProgramCall &call(const int index) const { return _calls.at(index); }
+
+    //!
+    //! \brief Get keys of the map
+    //! \param index Pool index
+    //! \return
+    //!
+    const QStringList &mapKeys(const int index) const { return _mapKeys.at(index); }
+
+    //!
+    //! \brief Get expression
+    //! \param index Pool index
+    //! \return
+    //!
+    const QtTIProgramExpr &expr(const int index) const { return _exprs.at(index); }
+
+    //!
+    //! \brief Get block (site of the errors)
+    //! \param index Pool index
+    //! \return
+    //!
+    const QtTIProgramSite &site(const int index) const { return _sites.at(index); }
+
+    //!
+    //! \brief Get 'for' loop
+    //! \param index Pool index
+    //! \return
+    //!
+    const QtTIProgramLoop &loop(const int index) const { return _loops.at(index); }
+
+    //!
+    //! \brief Get 'set' variable
+    //! \param index Pool index
+    //! \return
+    //!
+    const QtTIProgramSet &set(const int index) const { return _sets.at(index); }
+
+    //!
+    //! \brief Get control block executed by the interpreter
+    //! \param index Pool index
+    //! \return
+    //!
+    const std::shared_ptr<QtTIAbstractControlBlock> &block(const int index) const { return _blocks.at(index); }
+
+    //!
+    //! \brief Get number of the cached values (see QtTIInstruction::Opcode::LoadCached)
+    //! \return
+    //!
+    int cacheCount() const { return _cacheCount; }
+
+    //!
+    //! \brief Get cached values of the parameters (parameter name => cached values depending on it)
+    //! \return
+    //!
+    const QHash<QString, QVector<int>> &paramCaches() const { return _paramCaches; }
+
+    //!
+    //! \brief Check program can be serialized (no control blocks executed by the interpreter)
+    //! \return
+    //!
+    bool isSerializable() const { return _blocks.isEmpty(); }
+
+    std::tuple<bool/*isOk*/,QByteArray/*res*/,QString/*err*/> serialize() const;
+    static std::tuple<bool/*isOk*/,std::shared_ptr<QtTIProgram>/*res*/,QString/*err*/> deserialize(const QByteArray &data);
+
+private:
+    QString verify() const;
+
+private:
+    QVector<QtTIInstruction> _instructions;                 //!< instructions
+    std::shared_ptr<const QtTIScope> _scope;                //!< variable slots
+    QStringList _texts;                                     //!< texts and names
+    QVariantList _constantData;                             //!< constants (for serialization)
+    QVector<QtTIValue> _constants;                          //!< constants
+    QVector<QtTIParamPath> _paths;                          //!< parameter paths
+    QVector<QtTIProgramCall> _calls;                        //!< help functions
+    QVector<QStringList> _mapKeys;                          //!< keys of the maps
+    QVector<QtTIProgramExpr> _exprs;                        //!< expressions
+    QVector<QtTIProgramSite> _sites;                        //!< blocks (sites of the errors)
+    QVector<QtTIProgramLoop> _loops;                        //!< 'for' loops
+    QVector<QtTIProgramSet> _sets;                          //!< 'set' variables
+    QVector<std::shared_ptr<QtTIAbstractControlBlock>> _blocks; //!< control blocks executed by the interpreter
+    int _cacheCount {0};                                    //!< number of the cached values
+    QHash<QString, QVector<int>> _paramCaches;              //!< parameter name => cached values depending on it
+};
+
+#endif // QTTIPROGRAM_H
@@ -0,0 +1,771 @@
+#include "QtTIProgramCompiler.h"
+#include "../Expression/QtTIExprFolder.h"
+
+//!
+//! \brief Compile template to the program
+//! \param compiledTemplate Compiled template
+//! \return
+//!
+std::shared_ptr<QtTIProgram> QtTIProgramCompiler::compile(const QtTICompiledTemplate &compiledTemplate)
+{
+    std::shared_ptr<QtTIProgram> program = std::make_shared<QtTIProgram>();
+    program->_scope = compiledTemplate.scope();
+
+    QtTIProgramCompiler compiler(program.get());
+    compiler.emitTemplate(compiledTemplate);
+    return program;
+}
+
+//!
+//! \brief Compile template to the program specialized against the frozen global parameters
+//! \param compiledTemplate Compiled template
+//! \param parserArgs Global parameters (the values of the frozen parameters are taken on compile)
+//! \param frozenParams Names of the frozen parameters
+//! \return
+//!
+//! The frozen parameters are replaced by the constants (the paths with class methods and the
+//! loop and 'set' variables are not replaced), then:
+//!  - the expressions on the constants are folded (see QtTIExprFolder)
+//!  - the 'if' branches with constant conditions are selected (the other branches are removed)
+//!  - the output expressions with constant results are written as static text
+//!
+//! NOTE: The specialized program keeps the values of the frozen parameters, compile it again
+//!       after the frozen parameters are changed. The render context must not hide them.
+//!
+std::shared_ptr<QtTIProgram> QtTIProgramCompiler::specialize(const QtTICompiledTemplate &compiledTemplate,
+                                                             QtTIAbstractParserArgs *parserArgs,
+                                                             const QStringList &frozenParams)
+{
+    std::shared_ptr<QtTIProgram> program = std::make_shared<QtTIProgram>();
+    program->_scope = compiledTemplate.scope();
+
+    QtTIProgramCompiler compiler(program.get());
+    if (parserArgs) {
+        compiler._frozenArgs = parserArgs;
+        for (const QString &paramName : frozenParams)
+            compiler._frozenParams.insert(paramName);
+    }
+    compiler.emitTemplate(compiledTemplate);
+    return program;
+}
+
+//!
+//! \brief Append instruction
+//! \param op Operation code
+//! \param a First operand
+//! \param b Second operand
+//! \return Instruction position
+//!
+int QtTIProgramCompiler::emit(const QtTIInstruction::Opcode op, const int a, const int b)
+{
+    QtTIInstruction instruction;
+    instruction.op = op;
+    instruction.a = a;
+    instruction.b = b;
+    _program->_instructions.append(instruction);
+    return _program->_instructions.size() - 1;
+}
+
+//!
+//! \brief Set jump target of the instruction to the next instruction position
+//! \param index Instruction position
+//!
+void QtTIProgramCompiler::patchJump(const int index)
+{
+    _program->_instructions[index].a = position();
+    _lastText = -1;
+}
+
+//!
+//! \brief Append expression instructions (the result is pushed to the stack)
+//! \param expr Compiled expression
+//! \param isExec The expression is executed as block data (see QtTIParser::execExpression)
+//! \param lineNum Block line number
+//! \param linePos Block position number in line
+//! \param errorFormat Format of the error ('%1' - error)
+//! \param site Site of the errors (output expression), -1 - no site
+//! \return Expression index
+//!
+//! NOTE: Empty or invalid expression is compiled to the error (the error is returned when the
+//!       instruction is executed, as by the interpreter).
+//!
+int QtTIProgramCompiler::emitExpression(const QtTIExpression &expr,
+                                        const bool isExec,
+                                        const int lineNum,
+                                        const int linePos,
+                                        const QString &errorFormat,
+                                        const int site)
+{
+    QtTIProgramExpr info;
+    info.isExec = isExec;
+    info.lineNum = lineNum;
+    info.linePos = linePos;
+    info.errorFormat = errorFormat;
+    info.site = site;
+    if (isExec
+        && expr.isValid()
+        && (expr.root()->kind() == QtTIExprNode::Kind::Path
+            || expr.root()->kind() == QtTIExprNode::Kind::Call))
+        info.invalidResultError = QString("Unsupported help parameter '%1' in line %2 (position %3)")
+                                  .arg(expr.source()).arg(lineNum).arg(linePos);
+
+    const int index = _program->_exprs.size();
+    _program->_exprs.append(info);
+    emit(QtTIInstruction::Opcode::ExprBegin, index);
+
+    if (expr.isEmpty()) {
+        if (isExec)
+            emit(QtTIInstruction::Opcode::Fail, appendText("Block data is Empty!"), 0);
+        else
+            emit(QtTIInstruction::Opcode::Fail, appendText("Expression is empty"), 1);
+    } else if (!expr.isValid()) {
+        emit(QtTIInstruction::Opcode::Fail, appendText(expr.error()), 1);
+    } else {
+        emitNode(specializeNode(expr.root()));
+    }
+    return index;
+}
+
+//!
+//! \brief Append instructions of the control block body
+//! \param body Compiled block body
+//!
+void QtTIProgramCompiler::emitBody(const QtTICompiledBlockBody &body)
+{
+    if (!body.body) {
+        emitError(body.error);
+        return;
+    }
+    emitTemplate(*body.body);
+}
+
+//!
+//! \brief Append instructions of the 'for' loop body
+//! \param loopIndex Loop index (see appendLoop)
+//! \param body Compiled block body
+//!
+//! NOTE: The expressions of the body depending on the loop variables are not cached (see emitNode).
+//!
+void QtTIProgramCompiler::emitLoopBody(const int loopIndex, const QtTICompiledBlockBody &body)
+{
+    _loopStack.append(loopIndex);
+    emitBody(body);
+    _loopStack.removeLast();
+}
+
+//!
+//! \brief Append error instruction
+//! \param error Error
+//!
+void QtTIProgramCompiler::emitError(const QString &error)
+{
+    emit(QtTIInstruction::Opcode::Fail, appendText(error), 0);
+}
+
+//!
+//! \brief Check the condition is constant (see specialize)
+//! \param expr Condition
+//! \return
+//!
+//! NOTE: The condition with the evaluation error is not constant (the error is returned on render).
+//!
+std::tuple<bool, bool> QtTIProgramCompiler::constantCondition(const QtTIExpression &expr) const
+{
+    if (!expr.isValid())
+        return std::make_tuple(false, false);
+    const QtTIExprNodePtr root = specializeNode(expr.root());
+    if (root->kind() != QtTIExprNode::Kind::Literal)
+        return std::make_tuple(false, false);
+    return std::make_tuple(true, std::get<1>(root->evalValue(nullptr, nullptr)).isTrue());
+}
+
+//!
+//! \brief Append text (or name) to the program
+//! \param text
+//! \return Text index
+//!
+int QtTIProgramCompiler::appendText(const QString &text)
+{
+    _program->_texts.append(text);
+    return _program->_texts.size() - 1;
+}
+
+//!
+//! \brief Append 'for' loop to the program
+//! \param loop
+//! \return Loop index
+//!
+int QtTIProgramCompiler::appendLoop(const QtTIProgramLoop &loop)
+{
+    _program->_loops.append(loop);
+    return _program->_loops.size() - 1;
+}
+
+//!
+//! \brief Append 'set' variable to the program
+//! \param set
+//! \return Variable index
+//!
+int QtTIProgramCompiler::appendSet(const QtTIProgramSet &set)
+{
+    _program->_sets.append(set);
+    return _program->_sets.size() - 1;
+}
+
+//!
+//! \brief Append instructions of the template (or control block body)
+//! \param body Compiled template
+//!
+void QtTIProgramCompiler::emitTemplate(const QtTICompiledTemplate &body)
+{
+    emit(QtTIInstruction::Opcode::BodyBegin);
+    for (const QtTICompiledLine &line : body.lines()) {
+        emit(QtTIInstruction::Opcode::LineBegin);
+        emitLine(line);
+    }
+    emit(QtTIInstruction::Opcode::BodyEnd);
+}
+
+//!
+//! \brief Append instructions of the template line
+//! \param line Compiled line
+//!
+void QtTIProgramCompiler::emitLine(const QtTICompiledLine &line)
+{
+    for (const QtTICompiledNode &node : line) {
+        switch (node.type()) {
+            case QtTICompiledNode::Type::Text:
+                if (!node.text().isEmpty())
+                    emitText(node.text().toString());
+                break;
+            case QtTICompiledNode::Type::Expression: {
+                // the constant result is written as static text
+                const QtTIExprNodePtr root = node.expression().isValid() ? specializeNode(node.expression().root()) : nullptr;
+                if (root && root->kind() == QtTIExprNode::Kind::Literal) {
+                    const QVariant &value = static_cast<const QtTIExprLiteralNode &>(*root).value();
+                    if (value.isValid()) {
+                        emitText(value.toString());
+                        break;
+                    }
+                }
+                const int site = appendSite(node.data(), node.startPos());
+                const int expr = emitExpression(node.expression(), true, node.startPos().first, node.startPos().second, QString("%1"), site);
+                emit(QtTIInstruction::Opcode::Output, expr);
+                break;
+            }
+            case QtTICompiledNode::Type::ControlBlock: {
+                const std::shared_ptr<QtTIAbstractControlBlock> &controlBlock = node.controlBlock();
+                if (!controlBlock)
+                    break;
+                emit(QtTIInstruction::Opcode::EnterBlock, appendSite(node.data(), node.startPos()));
+                if (!controlBlock->compileProgram(*this)) {
+                    _program->_blocks.append(controlBlock);
+                    emit(QtTIInstruction::Opcode::EvalBlock, _program->_blocks.size() - 1);
+                }
+                emit(QtTIInstruction::Opcode::LeaveBlock);
+                break;
+            }
+            case QtTICompiledNode::Type::RStrip:
+                emit(QtTIInstruction::Opcode::RStrip);
+                break;
+            case QtTICompiledNode::Type::BlockStart:
+                emit(QtTIInstruction::Opcode::BlockStart);
+                break;
+            case QtTICompiledNode::Type::RStripBlockLine:
+                emit(QtTIInstruction::Opcode::RStripBlockLine);
+                break;
+        }
+    }
+}
+
+//!
+//! \brief Append text instruction of the line
+//! \param text Static text (or constant result of the output expression)
+//!
+//! NOTE: The text following the text instruction is appended to it (one write on render).
+//!
+void QtTIProgramCompiler::emitText(const QString &text)
+{
+    if (_lastText != -1 && _lastText == position() - 1) {
+        _program->_texts[_program->_instructions[_lastText].a] += text;
+        return;
+    }
+    _lastText = emit(QtTIInstruction::Opcode::Text, appendText(text));
+}
+
+//!
+//! \brief Append instructions of the expression node (the result is pushed to the stack)
+//! \param node Expression node
+//! \param cachedParams Parameters of the cached expression containing the node (NULL - no cached expression)
+//!
+//! The help function calls and the parameter paths with fields are cached (see isCached): the value
+//! is evaluated on first use and kept till the parameters of the expression are changed. The node
+//! inside the cached expression is cached, if it depends on less parameters (it is kept longer).
+//!
+//! === Example:
+//!     {% for row in rows %}{{ row.price * rate(config.currency) }}{% endfor %}
+//!
+//!     'row.price' - not cached (depends on the loop variable)
+//!     'rate(config.currency)' - evaluated once per render
+//!
+void QtTIProgramCompiler::emitNode(const QtTIExprNodePtr &node, const QSet<QString> *cachedParams)
+{
+    QSet<QString> params;
+    if (!isCached(node, params)
+        || (cachedParams && params == *cachedParams)) {
+        emitOperation(node, cachedParams);
+        return;
+    }
+
+    const int cache = appendCache(cacheKey(node), params);
+    const int load = emit(QtTIInstruction::Opcode::LoadCached, cache);
+    emitOperation(node, &params);
+    emit(QtTIInstruction::Opcode::StoreCached, cache);
+    _program->_instructions[load].b = position();
+    _lastText = -1;
+}
+
+//!
+//! \brief Append instructions of the expression operation (the operands are appended by emitNode)
+//! \param node Expression node
+//! \param cachedParams Parameters of the cached expression containing the node (NULL - no cached expression)
+//!
+void QtTIProgramCompiler::emitOperation(const QtTIExprNodePtr &node, const QSet<QString> *cachedParams)
+{
+    switch (node->kind()) {
+        case QtTIExprNode::Kind::Literal: {
+            const QtTIExprLiteralNode &literal = static_cast<const QtTIExprLiteralNode &>(*node);
+            emit(QtTIInstruction::Opcode::PushConst, appendConstant(literal.value()));
+            break;
+        }
+        case QtTIExprNode::Kind::Path: {
+            const QtTIExprPathNode &path = static_cast<const QtTIExprPathNode &>(*node);
+            _program->_paths.append(path.paramPath());
+            emit(QtTIInstruction::Opcode::LoadParam, _program->_paths.size() - 1, path.slot());
+            // the class method can change the values being cached
+            for (const QtTIParamPath::Segment &segment : path.paramPath().segments()) {
+                if (segment.isMethod) {
+                    emit(QtTIInstruction::Opcode::ClearCache);
+                    break;
+                }
+            }
+            break;
+        }
+        case QtTIExprNode::Kind::Call: {
+            const QtTIExprCallNode &call = static_cast<const QtTIExprCallNode &>(*node);
+            for (const QtTIExprNodePtr &arg : call.args())
+                emitNode(arg, cachedParams);
+            QtTIProgramCall programCall;
+            programCall.name = call.name();
+            programCall.isConstant = call.isConstant();
+            programCall.functionCache = std::make_shared<QtTIFunctionCache>();
+            _program->_calls.append(programCall);
+            emit(QtTIInstruction::Opcode::Call, _program->_calls.size() - 1, call.args().size());
+            break;
+        }
+        case QtTIExprNode::Kind::Array: {
+            const QtTIExprArrayNode &array = static_cast<const QtTIExprArrayNode &>(*node);
+            for (const QtTIExprNodePtr &item : array.items())
+                emitNode(item, cachedParams);
+            emit(QtTIInstruction::Opcode::MakeList, 0, array.items().size());
+            break;
+        }
+        case QtTIExprNode::Kind::Map: {
+            const QtTIExprMapNode &map = static_cast<const QtTIExprMapNode &>(*node);
+            QStringList keys;
+            for (const QPair<QString, QtTIExprNodePtr> &item : map.items()) {
+                emitNode(item.second, cachedParams);
+                keys.append(item.first);
+            }
+            _program->_mapKeys.append(keys);
+            emit(QtTIInstruction::Opcode::MakeMap, _program->_mapKeys.size() - 1, map.isHash() ? 1 : 0);
+            break;
+        }
+        case QtTIExprNode::Kind::Negate:
+        case QtTIExprNode::Kind::Not: {
+            const QtTIExprUnaryNode &unary = static_cast<const QtTIExprUnaryNode &>(*node);
+            emitNode(unary.operand(), cachedParams);
+            emit(node->kind() == QtTIExprNode::Kind::Not ? QtTIInstruction::Opcode::Not
+                                                         : QtTIInstruction::Opcode::Negate);
+            break;
+        }
+        case QtTIExprNode::Kind::Math: {
+            const QtTIExprMathNode &math = static_cast<const QtTIExprMathNode &>(*node);
+            emitNode(math.left(), cachedParams);
+            emitNode(math.right(), cachedParams);
+            emit(QtTIInstruction::Opcode::Math, static_cast<int>(math.op()));
+            break;
+        }
+        case QtTIExprNode::Kind::Compare: {
+            const QtTIExprCompareNode &compare = static_cast<const QtTIExprCompareNode &>(*node);
+            emitNode(compare.left(), cachedParams);
+            emitNode(compare.right(), cachedParams);
+            emit(QtTIInstruction::Opcode::Compare, static_cast<int>(compare.op()));
+            break;
+        }
+        case QtTIExprNode::Kind::And:
+        case QtTIExprNode::Kind::Or: {
+            const QtTIExprLogicNode &logic = static_cast<const QtTIExprLogicNode &>(*node);
+            emitNode(logic.left(), cachedParams);
+            emit(QtTIInstruction::Opcode::ToBool);
+            const int jump = emit(node->kind() == QtTIExprNode::Kind::And ? QtTIInstruction::Opcode::JumpIfFalseKeep
+                                                                          : QtTIInstruction::Opcode::JumpIfTrueKeep);
+            emitNode(logic.right(), cachedParams);
+            emit(QtTIInstruction::Opcode::ToBool);
+            patchJump(jump);
+            break;
+        }
+        case QtTIExprNode::Kind::Ternary: {
+            const QtTIExprTernaryNode &ternary = static_cast<const QtTIExprTernaryNode &>(*node);
+            emitNode(ternary.cond(), cachedParams);
+            if (ternary.thenNode()) {
+                const int elseJump = emit(QtTIInstruction::Opcode::JumpIfFalsePop);
+                emitNode(ternary.thenNode(), cachedParams);
+                const int endJump = emit(QtTIInstruction::Opcode::Jump);
+                patchJump(elseJump);
+                if (ternary.elseNode())
+                    emitNode(ternary.elseNode(), cachedParams);
+                else
+                    emit(QtTIInstruction::Opcode::PushConst, appendConstant(QVariant()));
+                patchJump(endJump);
+            } else {
+                // a ?: b - the value of the condition is the result
+                const int endJump = emit(QtTIInstruction::Opcode::JumpIfTrueKeep);
+                if (ternary.elseNode())
+                    emitNode(ternary.elseNode(), cachedParams);
+                else
+                    emit(QtTIInstruction::Opcode::PushConst, appendConstant(QVariant()));
+                patchJump(endJump);
+            }
+            break;
+        }
+        case QtTIExprNode::Kind::NullCoalescing: {
+            const QtTIExprNullCoalescingNode &nullCoalescing = static_cast<const QtTIExprNullCoalescingNode &>(*node);
+            emitNode(nullCoalescing.left(), cachedParams);
+            const int endJump = emit(QtTIInstruction::Opcode::JumpIfTrueKeep);
+            emitNode(nullCoalescing.right(), cachedParams);
+            patchJump(endJump);
+            break;
+        }
+    }
+}
+
+//!
+//! \brief Get the expression node with the frozen parameters replaced by constants (see specialize)
+//! \param node Expression node
+//! \return
+//!
+QtTIExprNodePtr QtTIProgramCompiler::specializeNode(const QtTIExprNodePtr &node) const
+{
+    if (!_frozenArgs || _frozenParams.isEmpty())
+        return node;
+    return QtTIExprFolder::fold(node, [this](const QtTIExprPathNode &path) { return frozenParam(path); });
+}
+
+//!
+//! \brief Get constant node of the frozen parameter
+//! \param path Parameter node
+//! \return NULL if the parameter is not frozen (or can't be replaced by the constant)
+//!
+//! NOTE: The values of the built-in types (numbers, strings, containers, ...) are replaced,
+//!       the pointers and the user types are taken on render (the program stays serializable).
+//!
+QtTIExprNodePtr QtTIProgramCompiler::frozenParam(const QtTIExprPathNode &path) const
+{
+    const QtTIParamPath &paramPath = path.paramPath();
+    if (path.slot() != -1
+        || paramPath.isEmpty()
+        || !_frozenParams.contains(paramPath.name()))
+        return nullptr;
+    for (const QtTIParamPath::Segment &segment : paramPath.segments()) {
+        if (segment.isMethod)
+            return nullptr;
+    }
+
+    bool isFound = false;
+    QVariant value;
+    std::tie(isFound, value) = _frozenArgs->findParam(paramPath);
+    if (!isFound
+        || value.userType() >= QMetaType::User
+        || value.userType() == QMetaType::QObjectStar
+        || value.userType() == QMetaType::VoidStar)
+        return nullptr;
+    return std::make_shared<QtTIExprLiteralNode>(value);
+}
+
+//!
+//! \brief Check the value of the expression node is cached (see emitNode)
+//! \param node Expression node
+//! \param params Parameters of the node (the result)
+//! \return
+//!
+//! Cached nodes: the help function calls (the calls with constant arguments are cached by
+//! QtTIFunctionCache) and the parameter paths with fields, without the class methods and
+//! not depending on the variables of the innermost loop being compiled.
+//!
+bool QtTIProgramCompiler::isCached(const QtTIExprNodePtr &node, QSet<QString> &params) const
+{
+    if (node->kind() == QtTIExprNode::Kind::Call) {
+        if (static_cast<const QtTIExprCallNode &>(*node).isConstant())
+            return false;
+    } else if (node->kind() == QtTIExprNode::Kind::Path) {
+        if (static_cast<const QtTIExprPathNode &>(*node).paramPath().segments().size() < 2)
+            return false;
+    } else {
+        return false;
+    }
+
+    if (!nodeParams(node, params))
+        return false;
+    if (!_loopStack.isEmpty()) {
+        for (const QString &paramName : _program->_loops.at(_loopStack.last()).paramNames) {
+            if (params.contains(paramName))
+                return false;
+        }
+    }
+    return true;
+}
+
+//!
+//! \brief Append cached value to the program
+//! \param key Expression key (see cacheKey), empty - the value is not shared
+//! \param params Parameters of the expression
+//! \return Cached value index
+//!
+//! NOTE: The expressions with the same key share the cached value.
+//!
+int QtTIProgramCompiler::appendCache(const QString &key, const QSet<QString> &params)
+{
+    if (!key.isEmpty()) {
+        const auto it = _cacheKeys.constFind(key);
+        if (it != _cacheKeys.constEnd())
+            return it.value();
+    }
+
+    const int index = _program->_cacheCount++;
+    for (const QString &paramName : params)
+        _program->_paramCaches[paramName].append(index);
+    if (!key.isEmpty())
+        _cacheKeys.insert(key, index);
+    return index;
+}
+
+//!
+//! \brief Get parameters of the expression node
+//! \param node Expression node
+//! \param params Parameter names (the result)
+//! \return false - the node has the class method calls (the value can't be cached)
+//!
+bool QtTIProgramCompiler::nodeParams(const QtTIExprNodePtr &node, QSet<QString> &params)
+{
+    if (!node)
+        return true;
+
+    switch (node->kind()) {
+        case QtTIExprNode::Kind::Literal:
+            return true;
+        case QtTIExprNode::Kind::Path: {
+            const QtTIParamPath &paramPath = static_cast<const QtTIExprPathNode &>(*node).paramPath();
+            if (paramPath.isEmpty())
+                return false;
+            for (const QtTIParamPath::Segment &segment : paramPath.segments()) {
+                if (segment.isMethod)
+                    return false;
+            }
+            params.insert(paramPath.name());
+            return true;
+        }
+        case QtTIExprNode::Kind::Call: {
+            for (const QtTIExprNodePtr &arg : static_cast<const QtTIExprCallNode &>(*node).args()) {
+                if (!nodeParams(arg, params))
+                    return false;
+            }
+            return true;
+        }
+        case QtTIExprNode::Kind::Array: {
+            for (const QtTIExprNodePtr &item : static_cast<const QtTIExprArrayNode &>(*node).items()) {
+                if (!nodeParams(item, params))
+                    return false;
+            }
+            return true;
+        }
+        case QtTIExprNode::Kind::Map: {
+            for (const QPair<QString, QtTIExprNodePtr> &item : static_cast<const QtTIExprMapNode &>(*node).items()) {
+                if (!nodeParams(item.second, params))
+                    return false;
+            }
+            return true;
+        }
+        case QtTIExprNode::Kind::Negate:
+        case QtTIExprNode::Kind::Not:
+            return nodeParams(static_cast<const QtTIExprUnaryNode &>(*node).operand(), params);
+        case QtTIExprNode::Kind::Math: {
+            const QtTIExprMathNode &math = static_cast<const QtTIExprMathNode &>(*node);
+            return nodeParams(math.left(), params) && nodeParams(math.right(), params);
+        }
+        case QtTIExprNode::Kind::Compare: {
+            const QtTIExprCompareNode &compare = static_cast<const QtTIExprCompareNode &>(*node);
+            return nodeParams(compare.left(), params) && nodeParams(compare.right(), params);
+        }
+        case QtTIExprNode::Kind::And:
+        case QtTIExprNode::Kind::Or: {
+            const QtTIExprLogicNode &logic = static_cast<const QtTIExprLogicNode &>(*node);
+            return nodeParams(logic.left(), params) && nodeParams(logic.right(), params);
+        }
+        case QtTIExprNode::Kind::Ternary: {
+            const QtTIExprTernaryNode &ternary = static_cast<const QtTIExprTernaryNode &>(*node);
+            return nodeParams(ternary.cond(), params)
+                   && nodeParams(ternary.thenNode(), params)
+                   && nodeParams(ternary.elseNode(), params);
+        }
+        case QtTIExprNode::Kind::NullCoalescing: {
+            const QtTIExprNullCoalescingNode &nullCoalescing = static_cast<const QtTIExprNullCoalescingNode &>(*node);
+            return nodeParams(nullCoalescing.left(), params) && nodeParams(nullCoalescing.right(), params);
+        }
+    }
+    return false;
+}
+
+//!
+//! \brief Get key of the expression node (the same expressions have the same key)
+//! \param node Expression node
+//! \return Empty if the node has the constants of the containers (the key is not built)
+//!
+//! NOTE: The strings are prefixed with the length, so the keys of the different expressions differ.
+//!
+QString QtTIProgramCompiler::cacheKey(const QtTIExprNodePtr &node)
+{
+    if (!node)
+        return QString("~");
+
+    auto joinKeys = [](const QVector<QtTIExprNodePtr> &nodes) {
+        QStringList keys;
+        for (const QtTIExprNodePtr &item : nodes) {
+            const QString key = cacheKey(item);
+            if (key.isEmpty())
+                return QString();
+            keys.append(key);
+        }
+        return keys.join(',');
+    };
+    auto binaryKey = [](const QtTIExprNodePtr &left, const QString &op, const QtTIExprNodePtr &right) {
+        const QString leftKey = cacheKey(left);
+        const QString rightKey = cacheKey(right);
+        if (leftKey.isEmpty() || rightKey.isEmpty())
+            return QString();
+        return "(" + leftKey + " " + op + " " + rightKey + ")";
+    };
+
+    switch (node->kind()) {
+        case QtTIExprNode::Kind::Literal: {
+            const QVariant &value = static_cast<const QtTIExprLiteralNode &>(*node).value();
+            switch (value.userType()) {
+                case QMetaType::UnknownType:
+                    return QString("#");
+                case QMetaType::Bool:
+                case QMetaType::Int:
+                case QMetaType::UInt:
+                case QMetaType::LongLong:
+                case QMetaType::ULongLong:
+                case QMetaType::Double:
+                case QMetaType::QString: {
+                    const QString str = value.toString();
+                    return "#" + QString(value.typeName()) + ":" + QString::number(str.size()) + ":" + str;
+                }
+                default:
+                    return QString();
+            }
+        }
+        case QtTIExprNode::Kind::Path: {
+            const QString &path = static_cast<const QtTIExprPathNode &>(*node).path();
+            return "$" + QString::number(path.size()) + ":" + path;
+        }
+        case QtTIExprNode::Kind::Call: {
+            const QtTIExprCallNode &call = static_cast<const QtTIExprCallNode &>(*node);
+            const QString args = joinKeys(call.args());
+            if (args.isEmpty() && !call.args().isEmpty())
+                return QString();
+            return call.name() + "(" + args + ")";
+        }
+        case QtTIExprNode::Kind::Array: {
+            const QtTIExprArrayNode &array = static_cast<const QtTIExprArrayNode &>(*node);
+            const QString items = joinKeys(array.items());
+            if (items.isEmpty() && !array.items().isEmpty())
+                return QString();
+            return "[" + items + "]";
+        }
+        case QtTIExprNode::Kind::Map: {
+            const QtTIExprMapNode &map = static_cast<const QtTIExprMapNode &>(*node);
+            QStringList items;
+            for (const QPair<QString, QtTIExprNodePtr> &item : map.items()) {
+                const QString key = cacheKey(item.second);
+                if (key.isEmpty())
+                    return QString();
+                items.append(QString::number(item.first.size()) + ":" + item.first + "=" + key);
+            }
+            return (map.isHash() ? "h{" : "{") + items.join(',') + "}";
+        }
+        case QtTIExprNode::Kind::Negate:
+        case QtTIExprNode::Kind::Not: {
+            const QString key = cacheKey(static_cast<const QtTIExprUnaryNode &>(*node).operand());
+            if (key.isEmpty())
+                return QString();
+            return (node->kind() == QtTIExprNode::Kind::Not ? "!" : "-") + key;
+        }
+        case QtTIExprNode::Kind::Math: {
+            const QtTIExprMathNode &math = static_cast<const QtTIExprMathNode &>(*node);
+            return binaryKey(math.left(), "m" + QString::number(static_cast<int>(math.op())), math.right());
+        }
+        case QtTIExprNode::Kind::Compare: {
+            const QtTIExprCompareNode &compare = static_cast<const QtTIExprCompareNode &>(*node);
+            return binaryKey(compare.left(), "c" + QString::number(static_cast<int>(compare.op())), compare.right());
+        }
+        case QtTIExprNode::Kind::And:
+        case QtTIExprNode::Kind::Or: {
+            const QtTIExprLogicNode &logic = static_cast<const QtTIExprLogicNode &>(*node);
+            return binaryKey(logic.left(), node->kind() == QtTIExprNode::Kind::And ? "&&" : "||", logic.right());
+        }
+        case QtTIExprNode::Kind::Ternary: {
+            const QtTIExprTernaryNode &ternary = static_cast<const QtTIExprTernaryNode &>(*node);
+            const QString condKey = cacheKey(ternary.cond());
+            const QString thenKey = cacheKey(ternary.thenNode());
+            const QString elseKey = cacheKey(ternary.elseNode());
+            if (condKey.isEmpty() || thenKey.isEmpty() || elseKey.isEmpty())
+                return QString();
+            return "(" + condKey + " ? " + thenKey + " : " + elseKey + ")";
+        }
+        case QtTIExprNode::Kind::NullCoalescing: {
+            const QtTIExprNullCoalescingNode &nullCoalescing = static_cast<const QtTIExprNullCoalescingNode &>(*node);
+            return binaryKey(nullCoalescing.left(), "??", nullCoalescing.right());
+        }
+    }
+    return QString();
+}
+
+//!
+//! \brief Append constant to the program
+//! \param value
+//! \return Constant index
+//!
+int QtTIProgramCompiler::appendConstant(const QVariant &value)
+{
+    _program->_constantData.append(value);
+    _program->_constants.append(QtTIValue::fromVariant(value));
+    return _program->_constants.size() - 1;
+}
+
+//!
+//! \brief Append block (site of the errors) to the program
+//! \param data Block data
+//! \param startPos Block start position
+//! \return Site index
+//!
+int QtTIProgramCompiler::appendSite(const QString &data, const QPair<int, int> &startPos)
+{
+    QtTIProgramSite site;
+    site.data = data;
+    site.lineNum = startPos.first;
+    site.linePos = startPos.second;
+    _program->_sites.append(site);
+    return _program->_sites.size() - 1;
+}
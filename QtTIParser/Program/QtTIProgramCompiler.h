@@ -0,0 +1,110 @@
+#ifndef QTTIPROGRAMCOMPILER_H
+#define QTTIPROGRAMCOMPILER_H
+
+#include <QString>
+#include <QStringList>
+#include <QSet>
+#include <QHash>
+#include <QVector>
+#include <memory>
+#include <tuple>
+
+#include "QtTIProgram.h"
+#include "../CompiledTemplate/QtTICompiledTemplate.h"
+#include "../ControlBlockFabric/ControlBlocks/QtTIAbstractControlBlock.h"
+#include "../Expression/QtTIExpression.h"
+#include "../Abstract/QtTIAbstractParserArgs.h"
+
+//!
+//! \brief The QtTIProgramCompiler class
+//!
+//! Lowers the compiled template (see QtTICompiledTemplate) to the program instructions (see QtTIProgram):
+//!  - static text, output expressions and line trimming are lowered as is
+//!  - expressions are lowered to the stack operations (the operands are evaluated before the operation,
+//!    'and', 'or', ternary and null-coalescing operators jump over the not evaluated operand)
+//!  - control blocks are lowered by the blocks (see QtTIAbstractControlBlock::compileProgram),
+//!    other control blocks are executed by the interpreter (see QtTIInstruction::Opcode::EvalBlock)
+//!
+//! The errors of the program have the same text as the errors of the interpreter.
+//!
+//! The output expressions with constant results are written as static text, the 'if' branches
+//! with constant conditions are selected on compile (see constantCondition).
+//!
+//! The help function calls and the parameter paths are cached for one render (see emitNode): the value
+//! is evaluated on first use, the identical expressions share the cached value. Inside the 'for' loop
+//! only the expressions not depending on the loop variables are cached (loop invariants), so they are
+//! evaluated once per loop, not once per element.
+//!
+//! The program can be specialized against the frozen global parameters (see specialize): the
+//! frozen parameters are replaced by their current values and the expressions are folded again
+//! (see QtTIExprFolder), so the residual program evaluates only the other (per render) data.
+//!
+//! === Example:
+//!     std::shared_ptr<QtTIProgram> program = QtTIProgramCompiler::compile(*compiledTemplate);
+//!     std::shared_ptr<QtTIProgram> specialized = QtTIProgramCompiler::specialize(*compiledTemplate,
+//!                                                                               parserArgs,
+//!                                                                               QStringList({ "site", "features" }));
+//!
+class QtTIProgramCompiler
+{
+public:
+    static std::shared_ptr<QtTIProgram> compile(const QtTICompiledTemplate &compiledTemplate);
+    static std::shared_ptr<QtTIProgram> specialize(const QtTICompiledTemplate &compiledTemplate,
+                                                   QtTIAbstractParserArgs *parserArgs,
+                                                   const QStringList &frozenParams);
+
+    //!
+    //! \brief Get position of the next instruction
+    //! \return
+    //!
+    int position() const { return _program->_instructions.size(); }
+
+    int emit(const QtTIInstruction::Opcode op, const int a = 0, const int b = 0);
+    void patchJump(const int index);
+    int emitExpression(const QtTIExpression &expr,
+                       const bool isExec,
+                       const int lineNum,
+                       const int linePos,
+                       const QString &errorFormat = QString("%1"),
+                       const int site = -1);
+    void emitBody(const QtTICompiledBlockBody &body);
+    void emitLoopBody(const int loopIndex, const QtTICompiledBlockBody &body);
+    void emitError(const QString &error);
+
+    std::tuple<bool/*isConstant*/,bool/*isTrue*/> constantCondition(const QtTIExpression &expr) const;
+
+    int appendText(const QString &text);
+    int appendLoop(const QtTIProgramLoop &loop);
+    int appendSet(const QtTIProgramSet &set);
+
+private:
+    explicit QtTIProgramCompiler(QtTIProgram *program)
+        : _program(program)
+    {}
+
+    void emitTemplate(const QtTICompiledTemplate &body);
+    void emitLine(const QtTICompiledLine &line);
+    void emitText(const QString &text);
+    void emitNode(const QtTIExprNodePtr &node, const QSet<QString> *cachedParams = nullptr);
+    void emitOperation(const QtTIExprNodePtr &node, const QSet<QString> *cachedParams);
+    bool isCached(const QtTIExprNodePtr &node, QSet<QString> &params) const;
+    int appendCache(const QString &key, const QSet<QString> &params);
+    static bool nodeParams(const QtTIExprNodePtr &node, QSet<QString> &params);
+    static QString cacheKey(const QtTIExprNodePtr &node);
+
+    QtTIExprNodePtr specializeNode(const QtTIExprNodePtr &node) const;
+    QtTIExprNodePtr frozenParam(const QtTIExprPathNode &path) const;
+
+    int appendConstant(const QVariant &value);
+    int appendSite(const QString &data, const QPair<int, int> &startPos);
+
+private:
+    QtTIProgram *_program {nullptr};                //!< program being compiled
+    QtTIAbstractParserArgs *_frozenArgs {nullptr};  //!< values of the frozen parameters (see specialize)
+    QSet<QString> _frozenParams;                    //!< frozen parameter names
+    int _lastText {-1};                             //!< position of the last text instruction (-1 - can't be merged)
+    QVector<int> _loopStack;                        //!< 'for' loops being compiled (the innermost last)
+    QHash<QString, int> _cacheKeys;                 //!< expression key => cached value (see cacheKey)
+};
+
+#endif // QTTIPROGRAMCOMPILER_H
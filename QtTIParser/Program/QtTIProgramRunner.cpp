@@ -0,0 +1,550 @@
+#include "QtTIProgramRunner.h"
+
+#include "../ControlBlockFabric/ControlBlocks/QtTIAbstractControlBlock.h"
+#include "../Logic/QtTIParserLogic.h"
+#include "../Math/QtTIParserMath.h"
+
+//!
+//! \brief Execute program
+//! \param program Program
+//! \param parserArgs Render args (variable slots of the program scope are set)
+//! \param parserFunc Help functions
+//! \param writer Output writer
+//! \return
+//!
+std::tuple<bool, QString> QtTIProgramRunner::run(const QtTIProgram &program,
+                                                 QtTIAbstractParserArgs *parserArgs,
+                                                 QtTIAbstractParserFunc *parserFunc,
+                                                 QtTIRenderWriter &writer)
+{
+    if (!parserArgs)
+        return std::make_tuple(false, "Parser args is NULL!");
+
+    QtTIProgramRunner runner(program, parserArgs, parserFunc, writer);
+    return runner.exec();
+}
+
+//!
+//! \brief Dispatch loop
+//! \return
+//!
+std::tuple<bool, QString> QtTIProgramRunner::exec()
+{
+    static const QString lineEnd = QStringLiteral("\r\n");
+
+    const QVector<QtTIInstruction> &instructions = _program.instructions();
+    const int size = instructions.size();
+    int pc = 0;
+    while (pc < size) {
+        const QtTIInstruction &instruction = instructions.at(pc++);
+        switch (instruction.op) {
+            case QtTIInstruction::Opcode::Text:
+                _writer.write(_program.text(instruction.a));
+                break;
+            case QtTIInstruction::Opcode::BodyBegin: {
+                Body body;
+                body.startPos = _writer.size();
+                body.lineStartPos = body.startPos;
+                _bodies.push_back(body);
+                break;
+            }
+            case QtTIInstruction::Opcode::BodyEnd:
+                if (_bodies.empty())
+                    return fail("Invalid program: unexpected end of the body");
+                _bodies.pop_back();
+                break;
+            case QtTIInstruction::Opcode::LineBegin: {
+                if (_bodies.empty())
+                    return fail("Invalid program: line outside of the body");
+                Body &body = _bodies.back();
+                if (!_writer.isEmptyAfter(body.startPos)
+                    && _writer.lastChar() != '\n')
+                    _writer.write(lineEnd);
+                body.lineStartPos = _writer.size();
+                // the lines of the template can't be trimmed by other lines
+                if (_bodies.size() == 1)
+                    _writer.commit(body.lineStartPos);
+                break;
+            }
+            case QtTIInstruction::Opcode::RStrip:
+                if (_bodies.empty())
+                    return fail("Invalid program: line outside of the body");
+                _writer.rstrip(_bodies.back().lineStartPos);
+                break;
+            case QtTIInstruction::Opcode::BlockStart:
+                if (_bodies.empty())
+                    return fail("Invalid program: line outside of the body");
+                _bodies.back().hasDataBeforeBlock = _writer.hasDataAfter(_bodies.back().lineStartPos);
+                break;
+            case QtTIInstruction::Opcode::RStripBlockLine:
+                if (_bodies.empty())
+                    return fail("Invalid program: line outside of the body");
+                if (!_bodies.back().hasDataBeforeBlock)
+                    _writer.rstrip(_bodies.back().lineStartPos);
+                break;
+            case QtTIInstruction::Opcode::EnterBlock:
+                _sites.push_back(instruction.a);
+                break;
+            case QtTIInstruction::Opcode::LeaveBlock:
+                if (_sites.empty())
+                    return fail("Invalid program: unexpected end of the block");
+                _sites.pop_back();
+                break;
+            case QtTIInstruction::Opcode::EvalBlock: {
+                bool isOk = false;
+                QString error;
+                std::tie(isOk, error) = _program.block(instruction.a)->evalBlock(_parserArgs, _writer);
+                if (!isOk)
+                    return fail(error);
+                clearCache();
+                break;
+            }
+            case QtTIInstruction::Opcode::Fail:
+                return fail(_program.text(instruction.a), instruction.b == 1);
+            case QtTIInstruction::Opcode::ExprBegin:
+                _expr = instruction.a;
+                break;
+            case QtTIInstruction::Opcode::Output: {
+                const QtTIValue value = pop();
+                const QtTIProgramExpr &expr = _program.expr(instruction.a);
+                if (value.type() == QtTIValue::Type::Invalid
+                    && !expr.invalidResultError.isEmpty())
+                    return fail(expr.invalidResultError);
+                _expr = -1;
+                if (value.type() == QtTIValue::Type::String)
+                    _writer.write(value.stringValue());
+                else
+                    _writer.write(value.toVariant().toString());
+                break;
+            }
+            case QtTIInstruction::Opcode::Branch:
+                _expr = -1;
+                if (!pop().isTrue())
+                    pc = instruction.a;
+                break;
+            case QtTIInstruction::Opcode::SetParam: {
+                const QtTIValue value = pop();
+                const QtTIProgramExpr &expr = _program.expr(instruction.b);
+                if (value.type() == QtTIValue::Type::Invalid
+                    && !expr.invalidResultError.isEmpty())
+                    return fail(expr.invalidResultError);
+                _expr = -1;
+
+                const QtTIProgramSet &set = _program.set(instruction.a);
+                const QVariant paramValue = value.toVariant();
+                if (paramValue.isNull()
+                    && paramValue.type() != QVariant::String)
+                    return fail(QString("Invalid parameter value (Null) in line %1").arg(set.lineNum));
+                if (_parserArgs->hasParam(set.paramName))
+                    return fail(QString("Parameter with name '%1' in line %2 already declared in the global parameter list").arg(set.paramName).arg(set.lineNum));
+                if (set.paramSlot != -1)
+                    _parserArgs->setSlotValue(set.paramSlot, paramValue);
+                else
+                    _parserArgs->appendTmpParam(set.paramName, paramValue);
+                invalidateCache(set.paramName);
+                break;
+            }
+            case QtTIInstruction::Opcode::UnsetParam: {
+                const QString &paramName = _program.text(instruction.a);
+                if (_parserArgs->hasTmpParam(paramName))
+                    _parserArgs->removeTmpParam(paramName);
+                invalidateCache(paramName);
+                break;
+            }
+            case QtTIInstruction::Opcode::ForBegin: {
+                const QtTIValue value = pop();
+                const QtTIProgramExpr &expr = _program.expr(instruction.b);
+                if (value.type() == QtTIValue::Type::Invalid
+                    && !expr.invalidResultError.isEmpty())
+                    return fail(expr.invalidResultError);
+                _expr = -1;
+
+                const QString error = startLoop(instruction.a, value.toVariant());
+                if (!error.isEmpty())
+                    return fail(error);
+                break;
+            }
+            case QtTIInstruction::Opcode::ForNext:
+                if (_loops.empty() || _loops.back()->loop != instruction.b)
+                    return fail("Invalid program: loop is not started");
+                if (!nextLoop()) {
+                    endLoop();
+                    pc = instruction.a;
+                }
+                break;
+            case QtTIInstruction::Opcode::Jump:
+                pc = instruction.a;
+                break;
+            case QtTIInstruction::Opcode::PushConst:
+                _stack.push_back(_program.constant(instruction.a));
+                break;
+            case QtTIInstruction::Opcode::LoadParam:
+                _stack.push_back(QtTIValue::fromVariant(loadParam(instruction.a, instruction.b)));
+                break;
+            case QtTIInstruction::Opcode::Call: {
+                if (!_parserFunc)
+                    return fail("QtTIParserFunc is NULL", true);
+
+                const int base = static_cast<int>(_stack.size()) - instruction.b;
+                const QtTIProgramCall &call = _program.call(instruction.a);
+                QVariant result;
+                if (call.isConstant && call.functionCache->constantResult(_parserFunc, result)) {
+                    _stack.erase(_stack.begin() + base, _stack.end());
+                    _stack.push_back(QtTIValue::fromVariant(result));
+                    break;
+                }
+
+                QVariantList args;
+                args.reserve(instruction.b);
+                for (int i = base; i < static_cast<int>(_stack.size()); i++)
+                    args.append(_stack[i].toVariant());
+                _stack.erase(_stack.begin() + base, _stack.end());
+
+                const QtTIAbstractHelperFunction *f = call.functionCache->function(_parserFunc, call.name, args);
+                if (!f)
+                    return fail(QString("Not found help function '%1 (%2)'")
+                                .arg(call.name,
+                                     QtTIAbstractHelperFunction::typesToStr(QtTIAbstractHelperFunction::vListArgsTypes(args))),
+                                true);
+                bool isOk = false;
+                QString error;
+                std::tie(isOk, result, error) = f->callFunction(args);
+                if (!isOk)
+                    return fail(error, true);
+                if (call.isConstant && f->isPure())
+                    call.functionCache->setConstantResult(_parserFunc, result);
+                // the impure function can change the cached values (as the class methods),
+                // the values being evaluated with it are not cached
+                if (!f->isPure())
+                    clearCache();
+                _stack.push_back(QtTIValue::fromVariant(result));
+                break;
+            }
+            case QtTIInstruction::Opcode::MakeList: {
+                const int base = static_cast<int>(_stack.size()) - instruction.b;
+                QVariantList result;
+                result.reserve(instruction.b);
+                for (int i = base; i < static_cast<int>(_stack.size()); i++)
+                    result.append(_stack[i].toVariant());
+                _stack.erase(_stack.begin() + base, _stack.end());
+                _stack.push_back(QtTIValue::fromVariant(result));
+                break;
+            }
+            case QtTIInstruction::Opcode::MakeMap: {
+                const QStringList &keys = _program.mapKeys(instruction.a);
+                const int base = static_cast<int>(_stack.size()) - keys.size();
+                QVariant result;
+                if (instruction.b == 1) {
+                    QVariantHash hash;
+                    for (int i = 0; i < keys.size(); i++)
+                        hash.insert(keys[i], _stack[base + i].toVariant());
+                    result = hash;
+                } else {
+                    QVariantMap map;
+                    for (int i = 0; i < keys.size(); i++)
+                        map.insert(keys[i], _stack[base + i].toVariant());
+                    result = map;
+                }
+                _stack.erase(_stack.begin() + base, _stack.end());
+                _stack.push_back(QtTIValue::fromVariant(result));
+                break;
+            }
+            case QtTIInstruction::Opcode::Negate: {
+                bool isOk = false;
+                QtTIValue result;
+                QString error;
+                std::tie(isOk, result, error) = QtTIParserMath::calcMathOperation(QtTIValue(0), _stack.back(), QtTIParserMath::MathOperation::Subtract);
+                if (!isOk)
+                    return fail(error, true);
+                _stack.back() = result;
+                break;
+            }
+            case QtTIInstruction::Opcode::Not:
+                _stack.back() = QtTIValue(!_stack.back().isTrue());
+                break;
+            case QtTIInstruction::Opcode::Math: {
+                const QtTIValue right = pop();
+                bool isOk = false;
+                QtTIValue result;
+                QString error;
+                std::tie(isOk, result, error) = QtTIParserMath::calcMathOperation(_stack.back(), right, static_cast<QtTIParserMath::MathOperation>(instruction.a));
+                if (!isOk)
+                    return fail(error, true);
+                _stack.back() = result;
+                break;
+            }
+            case QtTIInstruction::Opcode::Compare: {
+                const QtTIValue right = pop();
+                _stack.back() = QtTIValue(QtTIParserLogic::compare(_stack.back(), right, static_cast<QtTIParserLogic::LogicalOperation>(instruction.a)));
+                break;
+            }
+            case QtTIInstruction::Opcode::ToBool:
+                _stack.back() = QtTIValue(_stack.back().isTrue());
+                break;
+            case QtTIInstruction::Opcode::JumpIfFalseKeep:
+                if (!_stack.back().isTrue())
+                    pc = instruction.a;
+                else
+                    _stack.pop_back();
+                break;
+            case QtTIInstruction::Opcode::JumpIfTrueKeep:
+                if (_stack.back().isTrue())
+                    pc = instruction.a;
+                else
+                    _stack.pop_back();
+                break;
+            case QtTIInstruction::Opcode::JumpIfFalsePop:
+                if (!pop().isTrue())
+                    pc = instruction.a;
+                break;
+            case QtTIInstruction::Opcode::LoadCached: {
+                Cached &cached = _cache[instruction.a];
+                if (cached.isSet) {
+                    _stack.push_back(cached.value);
+                    pc = instruction.b;
+                } else {
+                    cached.generation = _cacheGeneration;
+                }
+                break;
+            }
+            case QtTIInstruction::Opcode::StoreCached: {
+                Cached &cached = _cache[instruction.a];
+                if (cached.generation == _cacheGeneration) {
+                    cached.value = _stack.back();
+                    cached.isSet = true;
+                }
+                break;
+            }
+            case QtTIInstruction::Opcode::ClearCache:
+                clearCache();
+                break;
+        }
+    }
+
+    if (!_bodies.empty() || !_sites.empty() || !_loops.empty())
+        return fail("Invalid program: unexpected end of the program");
+    return std::make_tuple(true, "");
+}
+
+//!
+//! \brief Stop execution with error
+//! \param error Error
+//! \param isEvalError Error of the expression evaluation
+//! \return
+//!
+//! The error is formatted as the error of the interpreter: the position of the expression,
+//! the format of the block and the data of the blocks being executed (the innermost first).
+//! The shadowed variables of the loops being executed are restored.
+//!
+std::tuple<bool, QString> QtTIProgramRunner::fail(const QString &error, const bool isEvalError)
+{
+    QString result = error;
+    if (_expr != -1) {
+        const QtTIProgramExpr &expr = _program.expr(_expr);
+        if (isEvalError && expr.isExec)
+            result = QString("%1 in line %2 (position %3)")
+                     .arg(result)
+                     .arg(expr.lineNum)
+                     .arg(expr.linePos);
+        result = expr.errorFormat.arg(result);
+        if (expr.site != -1)
+            _sites.push_back(expr.site);
+    }
+    for (auto it = _sites.rbegin(); it != _sites.rend(); ++it) {
+        const QtTIProgramSite &site = _program.site(*it);
+        result = QString("Eval control block '%1' in line %2 (position %3) failed! Error: %4")
+                 .arg(site.data)
+                 .arg(site.lineNum)
+                 .arg(site.linePos)
+                 .arg(result);
+    }
+
+    while (!_loops.empty())
+        endLoop();
+    return std::make_tuple(false, result);
+}
+
+//!
+//! \brief Start 'for' loop
+//! \param loopIndex Loop index
+//! \param container Loop container
+//! \return Error (empty - the loop is started)
+//!
+//! NOTE: The container is checked as by QtTIControlBlockFor::evalBlock.
+//!
+QString QtTIProgramRunner::startLoop(const int loopIndex, const QVariant &container)
+{
+    const QtTIProgramLoop &loop = _program.loop(loopIndex);
+    if (loop.paramNames.size() > 2)
+        return QString("Invalid parameter names (max two values) in block 'for ...' in line %1").arg(loop.lineNum);
+    if (container.isNull())
+        return QString("Invalid parameter container (Null) in block 'for ...' in line %1").arg(loop.lineNum);
+    if (!container.canConvert<QVariantList>()
+        && !container.canConvert<QVariantMap>()
+        && !container.canConvert<QVariantHash>())
+        return QString("Invalid container type '%1' (not List/Map/Hash) in block 'for ...' in line %2").arg(container.typeName()).arg(loop.lineNum);
+    if (container.canConvert<QVariantList>()
+        && loop.paramNames.size() != 1)
+        return QString("Too many parameters for type List in block 'for ...' in line %1").arg(loop.lineNum);
+    for (const QString &paramName : loop.paramNames) {
+        if (_parserArgs->hasParam(paramName))
+            return QString("Parameter with name '%1' in block 'for ...' in line %2 already declared in the global parameter list").arg(paramName).arg(loop.lineNum);
+    }
+
+    std::unique_ptr<Loop> frame(new Loop);
+    frame->loop = loopIndex;
+    for (const QString &paramName : loop.paramNames)
+        frame->resetValues.append(_parserArgs->hasTmpParam(paramName) ? _parserArgs->tmpParam(paramName) : QVariant());
+    frame->startPos = _writer.size();
+
+    // the iterators refer to the container data, the container is kept by the loop
+    if (container.canConvert<QVariantList>()) {
+        frame->container = container;
+        frame->list.reset(new QSequentialIterable(frame->container.value<QSequentialIterable>()));
+        frame->listIt.reset(new QSequentialIterable::const_iterator(frame->list->begin()));
+        frame->listEnd.reset(new QSequentialIterable::const_iterator(frame->list->end()));
+    } else {
+        if (container.canConvert<QVariantMap>())
+            frame->container = container.toMap();
+        else
+            frame->container = container.toHash();
+        frame->map.reset(new QAssociativeIterable(frame->container.value<QAssociativeIterable>()));
+        frame->mapIt.reset(new QAssociativeIterable::const_iterator(frame->map->begin()));
+        frame->mapEnd.reset(new QAssociativeIterable::const_iterator(frame->map->end()));
+    }
+    _loops.push_back(std::move(frame));
+    return QString();
+}
+
+//!
+//! \brief Set variables of the next element of the innermost loop
+//! \return false - no more elements
+//!
+bool QtTIProgramRunner::nextLoop()
+{
+    Loop &frame = *_loops.back();
+    const QtTIProgramLoop &loop = _program.loop(frame.loop);
+    if (frame.list) {
+        if (*frame.listIt == *frame.listEnd)
+            return false;
+    } else {
+        if (*frame.mapIt == *frame.mapEnd)
+            return false;
+    }
+
+    if (!_writer.isEmptyAfter(frame.startPos)
+        && _writer.lastChar() != '\n')
+        _writer.write(QString("\r\n"));
+
+    if (frame.list) {
+        setLoopValue(loop, 0, **frame.listIt);
+        ++(*frame.listIt);
+    } else {
+        if (loop.paramNames.size() == 1) {
+            setLoopValue(loop, 0, frame.mapIt->value());
+        } else {
+            setLoopValue(loop, 0, frame.mapIt->key());
+            setLoopValue(loop, 1, frame.mapIt->value());
+        }
+        ++(*frame.mapIt);
+    }
+    for (const QString &paramName : loop.paramNames)
+        invalidateCache(paramName);
+    return true;
+}
+
+//!
+//! \brief End the innermost loop (the shadowed variables are restored)
+//!
+void QtTIProgramRunner::endLoop()
+{
+    const Loop &frame = *_loops.back();
+    const QtTIProgramLoop &loop = _program.loop(frame.loop);
+    for (int i = 0; i < frame.resetValues.size(); i++) {
+        setLoopValue(loop, i, frame.resetValues[i]);
+        invalidateCache(loop.paramNames[i]);
+    }
+    _loops.pop_back();
+}
+
+//!
+//! \brief Set loop variable value
+//! \param loop Loop
+//! \param index Variable index
+//! \param value Variable value (invalid - remove variable)
+//!
+void QtTIProgramRunner::setLoopValue(const QtTIProgramLoop &loop, const int index, const QVariant &value)
+{
+    const int slot = loop.paramSlots.value(index, -1);
+    if (slot != -1)
+        _parserArgs->setSlotValue(slot, value);
+    else if (value.isValid())
+        _parserArgs->appendTmpParam(loop.paramNames[index], value);
+    else
+        _parserArgs->removeTmpParam(loop.paramNames[index]);
+}
+
+//!
+//! \brief Get parameter value (see QtTIExprPathNode::eval)
+//! \param pathIndex Path index
+//! \param slot Parameter slot (-1 - no slot)
+//! \return
+//!
+QVariant QtTIProgramRunner::loadParam(const int pathIndex, const int slot) const
+{
+    const QtTIParamPath &path = _program.path(pathIndex);
+    if (slot != -1) {
+        const QVariant &value = _parserArgs->slotValue(slot);
+        if (value.isValid())
+            return _parserArgs->childParam(value, path);
+    }
+
+    bool isFound = false;
+    QVariant value;
+    std::tie(isFound, value) = _parserArgs->findParam(path);
+    if (isFound)
+        return value;
+    std::tie(isFound, value) = _parserArgs->findTmpParam(path);
+    if (isFound)
+        return value;
+    return QVariant();
+}
+
+//!
+//! \brief Drop cached values depending on the parameter
+//! \param paramName Parameter name (loop or 'set' variable)
+//!
+void QtTIProgramRunner::invalidateCache(const QString &paramName)
+{
+    const auto it = _program.paramCaches().constFind(paramName);
+    if (it == _program.paramCaches().constEnd())
+        return;
+    for (const int index : it.value()) {
+        _cache[index].isSet = false;
+        _cache[index].value = QtTIValue();
+    }
+}
+
+//!
+//! \brief Drop all cached values (the parameters can be changed by the class methods, the impure help
+//!        functions or the control blocks)
+//!
+void QtTIProgramRunner::clearCache()
+{
+    for (Cached &cached : _cache) {
+        cached.isSet = false;
+        cached.value = QtTIValue();
+    }
+    _cacheGeneration++;
+}
+
+//!
+//! \brief Pop value from the stack
+//! \return
+//!
+QtTIValue QtTIProgramRunner::pop()
+{
+    const QtTIValue value = _stack.back();
+    _stack.pop_back();
+    return value;
+}
@@ -0,0 +1,118 @@
+#ifndef QTTIPROGRAMRUNNER_H
+#define QTTIPROGRAMRUNNER_H
+
+#include <QString>
+#include <QVariant>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "QtTIProgram.h"
+#include "../Abstract/QtTIAbstractParserArgs.h"
+#include "../Abstract/QtTIAbstractParserFunc.h"
+#include "../CompiledTemplate/QtTIRenderWriter.h"
+
+//!
+//! \brief The QtTIProgramRunner class
+//!
+//! Executes the program (see QtTIProgram) by one dispatch loop: the expression values are kept
+//! on the value stack (see QtTIValue), the bodies, the blocks and the 'for' loops are kept on
+//! their own stacks (no recursion, no virtual calls per node).
+//!
+//! The runner is created for one render, the program is not changed. The cached values of the program
+//! (see QtTIProgram::cacheCount) are kept by the runner, so they are evaluated at most once per render
+//! while the variables they depend on are not changed.
+//!
+//! === Example:
+//!     bool isOk = false;
+//!     QString error;
+//!     std::tie(isOk, error) = QtTIProgramRunner::run(*program, &context, &parserFunc, writer);
+//!
+class QtTIProgramRunner
+{
+public:
+    static std::tuple<bool/*isOk*/,QString/*err*/> run(const QtTIProgram &program,
+                                                       QtTIAbstractParserArgs *parserArgs,
+                                                       QtTIAbstractParserFunc *parserFunc,
+                                                       QtTIRenderWriter &writer);
+
+private:
+    //!
+    //! \brief Body being executed (see QtTIParser::renderBlockBody)
+    //!
+    struct Body
+    {
+        qint64 startPos {0};            //!< writer position of the body start
+        qint64 lineStartPos {0};        //!< writer position of the line start
+        bool hasDataBeforeBlock {true}; //!< the line has data before the control block
+    };
+
+    //!
+    //! \brief 'for' loop being executed
+    //!
+    struct Loop
+    {
+        int loop {-1};                                                  //!< loop index
+        QVariant container;                                             //!< container (kept for the iterators)
+        qint64 startPos {0};                                            //!< writer position of the loop start
+        QVariantList resetValues;                                       //!< shadowed variable values
+        std::unique_ptr<QSequentialIterable> list;                      //!< list iterable
+        std::unique_ptr<QSequentialIterable::const_iterator> listIt;    //!< list iterator
+        std::unique_ptr<QSequentialIterable::const_iterator> listEnd;   //!< list end
+        std::unique_ptr<QAssociativeIterable> map;                      //!< map (hash) iterable
+        std::unique_ptr<QAssociativeIterable::const_iterator> mapIt;    //!< map (hash) iterator
+        std::unique_ptr<QAssociativeIterable::const_iterator> mapEnd;   //!< map (hash) end
+    };
+
+    //!
+    //! \brief Cached value (see QtTIInstruction::Opcode::LoadCached)
+    //!
+    struct Cached
+    {
+        QtTIValue value;            //!< value
+        bool isSet {false};         //!< the value is evaluated
+        quint64 generation {0};     //!< cache generation on the evaluation start
+    };
+
+    QtTIProgramRunner(const QtTIProgram &program,
+                      QtTIAbstractParserArgs *parserArgs,
+                      QtTIAbstractParserFunc *parserFunc,
+                      QtTIRenderWriter &writer)
+        : _program(program)
+        , _parserArgs(parserArgs)
+        , _parserFunc(parserFunc)
+        , _writer(writer)
+        , _cache(program.cacheCount())
+    {}
+
+    std::tuple<bool/*isOk*/,QString/*err*/> exec();
+    std::tuple<bool/*isOk*/,QString/*err*/> fail(const QString &error, const bool isEvalError = false);
+
+    QString startLoop(const int loopIndex, const QVariant &container);
+    bool nextLoop();
+    void endLoop();
+    void setLoopValue(const QtTIProgramLoop &loop, const int index, const QVariant &value);
+
+    QVariant loadParam(const int pathIndex, const int slot) const;
+
+    void invalidateCache(const QString &paramName);
+    void clearCache();
+
+    QtTIValue pop();
+
+private:
+    const QtTIProgram &_program;                    //!< program
+    QtTIAbstractParserArgs *_parserArgs {nullptr};  //!< render args
+    QtTIAbstractParserFunc *_parserFunc {nullptr};  //!< help functions
+    QtTIRenderWriter &_writer;                      //!< output writer
+
+    std::vector<QtTIValue> _stack;                  //!< value stack
+    std::vector<Body> _bodies;                      //!< bodies being executed
+    std::vector<int> _sites;                        //!< blocks being executed (sites of the errors)
+    std::vector<std::unique_ptr<Loop>> _loops;      //!< 'for' loops being executed
+    std::vector<Cached> _cache;                     //!< cached values
+    quint64 _cacheGeneration {0};                   //!< cache generation (changed when the cache is cleared)
+    int _expr {-1};                                 //!< expression being evaluated (-1 - no expression)
+};
+
+#endif // QTTIPROGRAMRUNNER_H
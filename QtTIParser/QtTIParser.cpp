@@ -2,13 +2,14 @@
 #include "QtTIParserBlock.h"
 #include "QtTIParserArgs.h"
 #include "QtTIParserFunc.h"
-#include "Math/QtTIParserMath.h"
-#include "Logic/QtTIParserLogic.h"
-#include "TernaryOperator/QtTIParserTernaryOperator.h"
-#include "NullCoalescingOperator/QtTIParserNullCoalescingOperator.h"
+#include "Expression/QtTIExpression.h"
+#include "TemplateLexer/QtTITemplateLexer.h"
+#include "Program/QtTIProgramRunner.h"
 #include "../QtTIDefines/QtTIRegExpDefines.h"
 #include "../QtTIHelperFunction/QtTIHelperFunction.h"
 
+#include <QStringView>
+
 QtTIParser::QtTIParser()
     : QtTIAbstractParser()
 {
@@ -47,274 +48,743 @@ QtTIAbstractParserFunc *QtTIParser::parserFunc()
 //! \param block Abstract parser block object
 //! \return
 //!
+//! NOTE: This method compiles the line and renders it immediately, use 'compile' and 'render' to reuse the compiled data.
+//!
 std::tuple<bool, QString, QString> QtTIParser::parseLine(const QString &line,
                                                          const int lineNum,
                                                          QtTIAbstractParserBlock *&block)
 {
+    QtTIRenderWriter writer;
+    bool isOk = false;
+    QString error;
+    std::tie(isOk, error) = parseLine(line, lineNum, block, &_parserArgs, writer);
+    if (!isOk)
+        return std::make_tuple(false, "", error);
+    writer.finish();
+    return std::make_tuple(true, writer.result(), "");
+}
+
+//!
+//! \brief Parse line data and write result to render output
+//! \param line Line data
+//! \param lineNum Line number
+//! \param block Abstract parser block object
+//! \param parserArgs Render args (variables of the current render)
+//! \param writer Render output
+//! \return
+//!
+std::tuple<bool, QString> QtTIParser::parseLine(const QString &line,
+                                                const int lineNum,
+                                                QtTIAbstractParserBlock *&block,
+                                                QtTIAbstractParserArgs *parserArgs,
+                                                QtTIRenderWriter &writer)
+{
+    const QtTIParserBlock *prevBlock = dynamic_cast<QtTIParserBlock*>(block);
+    bool hasDataBeforeBlock = prevBlock ? prevBlock->hasDataBeforeBlock() : true;
+
+    bool isOk = false;
+    QtTICompiledLine compiledLine;
+    QString error;
+    std::tie(isOk, compiledLine, error) = compileLine(line, lineNum, block);
+    if (!isOk)
+        return std::make_tuple(false, error);
+
+    std::tie(isOk, error) = renderLine(compiledLine, hasDataBeforeBlock, parserArgs, writer);
+    if (!isOk)
+        return std::make_tuple(false, error);
+
+    // save the render state for the next line of the unfinished block
     QtTIParserBlock *rBlock = dynamic_cast<QtTIParserBlock*>(block);
-    QtTIParserBlock lastBlock;
     if (rBlock)
-        lastBlock = *rBlock;
-    QtTIParserBlock tmpBlock;
-    bool isBlock = rBlock ? rBlock->isUnfinished() : false;
-    bool isString = false;
-    QString tmpLine;
-    for (int i = 0; i < line.size(); i++) {
-        const int chPos = i;
-        const QChar ch = line[chPos];
-
-        QChar chPrev;
-        if (i > 0)
-            chPrev = line[i - 1];
-        QChar chNext;
-        if (i < line.size() - 1)
-            chNext = line[i + 1];
-
-        // check is string
-        if ((ch == '"' || ch == '\'')
-            && chPrev != '\\'
-            && isBlock)
-            isString = !isString;
-
-        // check start block
-        if (!isString
-            && !isBlock
-            && ch == '{'
-            && (chNext == '{'
-                || chNext == '%'
-                || chNext == '#')) {
-            tmpBlock._data += ch;
-            tmpBlock._startPos.first = lineNum;
-            tmpBlock._startPos.second = chPos;
-            tmpBlock._hasDataBeforeBlock = !tmpLine.trimmed().isEmpty();
-            isBlock = true;
-            continue;
+        rBlock->setHasDataBeforeBlock(hasDataBeforeBlock);
+    return std::make_tuple(true, "");
+}
+
+//!
+//! \brief Compile template data
+//! \param data Template data
+//! \return
+//!
+//! NOTE: The templates can be compiled from several threads, they are compiled one at a time.
+//!       The scope of the template being compiled is used only by the compiling thread (see compileScope).
+//!
+std::tuple<bool, std::shared_ptr<QtTICompiledTemplate>, QString> QtTIParser::compile(QString data)
+{
+    QMutexLocker locker(&_compileMutex);
+
+    // variable names of the template and of the control block bodies get the slots of one scope
+    std::shared_ptr<QtTIScope> scope = std::make_shared<QtTIScope>();
+    _compileScope = scope.get();
+    _compileThread.store(QThread::currentThread(), std::memory_order_release);
+    bool isOk = false;
+    std::shared_ptr<QtTICompiledTemplate> compiledTemplate;
+    QString error;
+    std::tie(isOk, compiledTemplate, error) = compileTemplate(data);
+    _compileThread.store(nullptr, std::memory_order_release);
+    _compileScope = nullptr;
+    if (!isOk)
+        return std::make_tuple(false, nullptr, error);
+
+    compiledTemplate->setScope(scope);
+    return std::make_tuple(true, compiledTemplate, "");
+}
+
+//!
+//! \brief Compile template data with the current scope
+//! \param data Template data
+//! \return
+//!
+std::tuple<bool, std::shared_ptr<QtTICompiledTemplate>, QString> QtTIParser::compileTemplate(const QString &data)
+{
+    static const QString lineEndData = QStringLiteral("\r\n");
+    const QString lineEndAppender = data.contains(QChar('\n')) ? lineEndData : QString();
+
+    std::shared_ptr<QtTICompiledTemplate> compiledTemplate = std::make_shared<QtTICompiledTemplate>();
+    compiledTemplate->setSource(data);
+
+    // the data is tokenized in one pass, the tokens are compiled line by line
+    QtTITemplateLexer lexer(data);
+    QVector<QtTITemplateToken> tokens;
+    QtTIAbstractParserBlock *block = nullptr;
+    while (!lexer.atEnd()) {
+        const int lineNum = lexer.lineNum();
+        const QStringView line = lexer.nextLine(tokens, unfinishedBlockType(block));
+        bool isOk = false;
+        QtTICompiledLine compiledLine;
+        QString error;
+        std::tie(isOk, compiledLine, error) = compileTokens(data, tokens, lineNum, line, lineEndAppender, block);
+        if (!isOk) {
+            if (block)
+                delete block;
+            return std::make_tuple(false, nullptr, error);
         }
-        // check end block
-        QChar blockEndControlSymbol = tmpBlock.endControlSymbol();
-        if (rBlock
-            && rBlock->isUnfinished())
-            blockEndControlSymbol = rBlock->endControlSymbol();
-
-        if (!isString
-            && isBlock
-            && ch == '}'
-            && (chPrev == '}'
-                || chPrev == '%'
-                || chPrev == '#')
-            && chPrev == blockEndControlSymbol) {
-            tmpBlock._data += ch;
-            tmpBlock._endPos.first = lineNum;
-            tmpBlock._endPos.second = chPos;
-
-            // check is block end
-            bool isBlockCondEnd = false;
-            if (rBlock
-                && rBlock->type() == QtTIParserBlock::Type::Control
-                && rBlock->controlBlock()) {
-                if (rBlock->controlBlock()->isBlockCondIntermediate(tmpBlock.body().trimmed())) {
-                    rBlock->controlBlock()->appendBlockCondIntermediate(tmpBlock.body().trimmed());
-                } else if (rBlock->controlBlock()->isBlockCondEnd(tmpBlock.body().trimmed())) {
-                    isBlockCondEnd = true;
-                    // update end pos
-                    rBlock->_endPos = tmpBlock.endPos_ref();
-                } else {
-                    rBlock->controlBlock()->appendBlockBody(tmpBlock.data_ref(), tmpBlock.startPos_ref().first);
+        compiledTemplate->appendLine(compiledLine);
+    }
+
+    // check block
+    if (block && block->isUnfinished()) {
+        QString error = QString("Unfinished block in line %1 (position %2)!")
+                        .arg(block->startPos().first)
+                        .arg(block->startPos().second);
+        delete block;
+        return std::make_tuple(false, nullptr, error);
+    }
+
+    if (block)
+        delete block;
+    return std::make_tuple(true, compiledTemplate, "");
+}
+
+//!
+//! \brief Create render context (variables of one render)
+//! \return
+//!
+//! NOTE: The context only refers to the global parameters and the help functions of the parser.
+//!
+QtTIRenderContext QtTIParser::createRenderContext() const
+{
+    return QtTIRenderContext(&_parserArgs);
+}
+
+//!
+//! \brief Render compiled template
+//! \param compiledTemplate Compiled template object
+//! \return
+//!
+//! NOTE: Variables of the template ('set', 'for') are stored in a new render context.
+//!
+std::tuple<bool, QString, QString> QtTIParser::render(const QtTICompiledTemplate &compiledTemplate)
+{
+    QtTIRenderContext context = createRenderContext();
+    QtTIRenderWriter writer;
+    bool isOk = false;
+    QString error;
+    std::tie(isOk, error) = render(compiledTemplate, context, writer);
+    if (!isOk)
+        return std::make_tuple(false, "", error);
+    return std::make_tuple(true, writer.result(), "");
+}
+
+//!
+//! \brief Render compiled template to render output
+//! \param compiledTemplate Compiled template object
+//! \param writer Render output
+//! \return
+//!
+//! NOTE: Variables of the template ('set', 'for') are stored in a new render context.
+//!
+std::tuple<bool, QString> QtTIParser::render(const QtTICompiledTemplate &compiledTemplate, QtTIRenderWriter &writer)
+{
+    QtTIRenderContext context = createRenderContext();
+    return render(compiledTemplate, context, writer);
+}
+
+//!
+//! \brief Render compiled template with render context to render output
+//! \param compiledTemplate Compiled template object
+//! \param context Render context (see createRenderContext)
+//! \param writer Render output
+//! \return
+//!
+//! NOTE: The parser is not changed while rendering, so it is safe to render in several threads at once,
+//!       each thread with its own context and writer.
+//! NOTE: Tmp parameters of the context are cleared after rendering.
+//! NOTE: In case of error, the data rendered before the error may have already been passed to the writer sink.
+//!
+std::tuple<bool, QString> QtTIParser::render(const QtTICompiledTemplate &compiledTemplate,
+                                             QtTIRenderContext &context,
+                                             QtTIRenderWriter &writer)
+{
+    if (context.sharedArgs() != &_parserArgs)
+        return std::make_tuple(false, "Render context was created by another parser");
+
+    bool isOk = false;
+    QString error;
+    context.setScope(compiledTemplate.scope());
+    std::tie(isOk, error) = renderBody(compiledTemplate, &context, writer, true);
+    context.clearTmpParams();
+    if (!isOk)
+        return std::make_tuple(false, error);
+
+    if (!writer.finish())
+        return std::make_tuple(false, writer.errorString());
+    return std::make_tuple(true, "");
+}
+
+//!
+//! \brief Render program with render context to render output
+//! \param program Compiled template program (see QtTIProgramCompiler)
+//! \param context Render context (see createRenderContext)
+//! \param writer Render output
+//! \return
+//!
+//! The result and the errors are the same as for the compiled template, the program is executed
+//! by one dispatch loop (see QtTIProgramRunner).
+//!
+//! NOTE: Tmp parameters of the context are cleared after rendering.
+//!
+std::tuple<bool, QString> QtTIParser::render(const QtTIProgram &program,
+                                             QtTIRenderContext &context,
+                                             QtTIRenderWriter &writer)
+{
+    if (context.sharedArgs() != &_parserArgs)
+        return std::make_tuple(false, "Render context was created by another parser");
+
+    bool isOk = false;
+    QString error;
+    context.setScope(program.scope());
+    std::tie(isOk, error) = QtTIProgramRunner::run(program, &context, &_parserFunc, writer);
+    context.clearTmpParams();
+    if (!isOk)
+        return std::make_tuple(false, error);
+
+    if (!writer.finish())
+        return std::make_tuple(false, writer.errorString());
+    return std::make_tuple(true, "");
+}
+
+//!
+//! \brief Compile expression (the parameters of the expression get the variable slots
+//!        of the compiled template, see QtTIScope)
+//! \param expr Expression
+//! \return
+//!
+//! NOTE: Out of QtTIParser::compile the expression is compiled without slots.
+//!
+QtTIExpression QtTIParser::compileExpression(const QString &expr)
+{
+    return QtTIExpression::compile(expr, compileScope());
+}
+
+//!
+//! \brief Get variable slot of the compiled template (see QtTIScope)
+//! \param name Variable name
+//! \return -1 if the template is not compiled now
+//!
+int QtTIParser::variableSlot(const QString &name)
+{
+    QtTIScope *scope = compileScope();
+    if (!scope)
+        return -1;
+    return scope->slot(name);
+}
+
+//!
+//! \brief Get scope of the template being compiled by the current thread
+//! \return NULL if the current thread does not compile the template
+//!
+QtTIScope *QtTIParser::compileScope() const
+{
+    if (_compileThread.load(std::memory_order_acquire) != QThread::currentThread())
+        return nullptr;
+    return _compileScope;
+}
+
+//!
+//! \brief Compile control block body
+//! \param data Control block body (line number - line data)
+//! \param blockLineNum Control block line number (the first line of the body is trimmed on the left)
+//! \return
+//!
+//! NOTE: Nested control blocks are compiled with their bodies, the body is not parsed on render.
+//!
+std::tuple<bool, std::shared_ptr<QtTICompiledTemplate>, QString> QtTIParser::compileBlockBody(const QMap<int, QString> &data,
+                                                                                              const int blockLineNum)
+{
+    std::shared_ptr<QtTICompiledTemplate> compiledBody = std::make_shared<QtTICompiledTemplate>();
+    QtTIAbstractParserBlock *block = nullptr;
+    QMapIterator<int,QString> it(data);
+    while (it.hasNext()) {
+        it.next();
+        QString line = it.value();
+        if (it.key() == blockLineNum)
+            line = QtTIAbstractParser::lstrip(line); // trim left
+
+        bool isOk = false;
+        QtTICompiledLine compiledLine;
+        QString error;
+        std::tie(isOk, compiledLine, error) = compileLine(line, it.key(), block);
+        if (!isOk) {
+            if (block)
+                delete block;
+            return std::make_tuple(false, nullptr, error);
+        }
+        compiledBody->appendLine(compiledLine);
+    }
+
+    // check block
+    if (block && block->isUnfinished()) {
+        QString error = QString("Unfinished block in line %1!").arg(block->startPos().first);
+        delete block;
+        return std::make_tuple(false, nullptr, error);
+    }
+    if (block)
+        delete block;
+    return std::make_tuple(true, compiledBody, "");
+}
+
+//!
+//! \brief Render compiled control block body to render output
+//! \param body Compiled control block body (or template)
+//! \param parserArgs Render args (variables of the current render)
+//! \param writer Render output
+//! \return
+//!
+std::tuple<bool, QString> QtTIParser::renderBlockBody(const QtTICompiledTemplate &body,
+                                                      QtTIAbstractParserArgs *parserArgs,
+                                                      QtTIRenderWriter &writer)
+{
+    return renderBody(body, parserArgs, writer, false);
+}
+
+//!
+//! \brief Render compiled template or control block body to render output
+//! \param body Compiled control block body (or template)
+//! \param parserArgs Render args (variables of the current render)
+//! \param writer Render output
+//! \param isTemplate The body is the rendered template (not the body of a control block)
+//! \return
+//!
+//! The lines of the template can't trim the data of the previous lines, so the trailing blank
+//! characters are committed to the writer at the start of each template line (see QtTIRenderWriter::commit).
+//! The lines of a control block body can be trimmed by the line that contains the block.
+//!
+std::tuple<bool, QString> QtTIParser::renderBody(const QtTICompiledTemplate &body,
+                                                 QtTIAbstractParserArgs *parserArgs,
+                                                 QtTIRenderWriter &writer,
+                                                 const bool isTemplate)
+{
+    const qint64 startPos = writer.size();
+    bool hasDataBeforeBlock = true;
+    for (const QtTICompiledLine &compiledLine : body.lines()) {
+        if (!writer.isEmptyAfter(startPos)
+            && writer.lastChar() != '\n')
+            writer.write(QString("\r\n"));
+        if (isTemplate)
+            writer.commit(writer.size());
+
+        bool isOk = false;
+        QString error;
+        std::tie(isOk, error) = renderLine(compiledLine, hasDataBeforeBlock, parserArgs, writer);
+        if (!isOk)
+            return std::make_tuple(false, error);
+    }
+    return std::make_tuple(true, "");
+}
+
+//!
+//! \brief Compile line data (split line into text segments, expressions and control blocks)
+//! \param line Line data
+//! \param lineNum Line number
+//! \param block Abstract parser block object
+//! \return
+//!
+std::tuple<bool, QtTICompiledLine, QString> QtTIParser::compileLine(const QString &line,
+                                                                    const int lineNum,
+                                                                    QtTIAbstractParserBlock *&block)
+{
+    QtTITemplateLexer lexer(line, false, lineNum);
+    QVector<QtTITemplateToken> tokens;
+    const QStringView lineView = lexer.nextLine(tokens, unfinishedBlockType(block));
+    return compileTokens(line, tokens, lineNum, lineView, QString(), block);
+}
+
+//!
+//! \brief Get block body (block data without control characters)
+//! \param blockData Block data (finished block)
+//! \return
+//!
+QString QtTIParser::blockBody(const QString &blockData)
+{
+    return blockData.mid(2, blockData.size() - 4);
+}
+
+//!
+//! \brief Get type of the block unfinished on the previous line
+//! \param block Abstract parser block object
+//! \return Invalid if there is no unfinished block
+//!
+QtTIAbstractParserBlock::Type QtTIParser::unfinishedBlockType(const QtTIAbstractParserBlock *block)
+{
+    if (!block || !block->isUnfinished())
+        return QtTIAbstractParserBlock::Type::Invalid;
+    return QtTITemplateLexer::blockType(block->data_ref());
+}
+
+//!
+//! \brief Compile tokens of one line
+//! \param data Template data (the tokens refer to it)
+//! \param tokens Template tokens of the line
+//! \param lineNum Line number
+//! \param line Line data (without line end)
+//! \param lineEnd Line end appended to the line data
+//! \param block Abstract parser block object (unfinished block or control block which body is collected)
+//! \return
+//!
+//! NOTE: Static text is not copied, the text nodes refer to the template data.
+//!
+std::tuple<bool, QtTICompiledLine, QString> QtTIParser::compileTokens(const QString &data,
+                                                                      const QVector<QtTITemplateToken> &tokens,
+                                                                      const int lineNum,
+                                                                      const QStringView line,
+                                                                      const QString &lineEnd,
+                                                                      QtTIAbstractParserBlock *&block)
+{
+    QtTIParserBlock *rBlock = dynamic_cast<QtTIParserBlock*>(block);
+
+    // the last block of the line (trailing blank characters are removed after control and comment blocks)
+    bool isLastBlockStrip = false;
+    bool isLastBlockUnfinished = false;
+    int lastBlockEndPos = -1;
+    std::shared_ptr<QtTIAbstractControlBlock> lastControlBlock;
+    if (rBlock) {
+        const QtTIAbstractParserBlock::Type blockType = QtTITemplateLexer::blockType(rBlock->data_ref());
+        isLastBlockStrip = (blockType == QtTIAbstractParserBlock::Type::Control
+                            || blockType == QtTIAbstractParserBlock::Type::Comment);
+        isLastBlockUnfinished = rBlock->isUnfinished();
+        lastBlockEndPos = rBlock->endPos_ref().second;
+        lastControlBlock = rBlock->controlBlock();
+    }
+
+    QtTICompiledLine tmpLine;
+    QVector<std::shared_ptr<QtTIAbstractControlBlock>> closedControlBlocks;
+    bool isLineEndInBlock = false;
+    for (const QtTITemplateToken &token : tokens) {
+        const bool isBlockBody = rBlock && rBlock->controlBlock();
+        switch (token.type()) {
+            case QtTITemplateToken::Type::Text: {
+                if (isBlockBody)
+                    rBlock->controlBlock()->appendBlockBody(token.view(data).toString(), lineNum);
+                else
+                    appendTextNode(tmpLine, data, token.pos(), token.length());
+                break;
+            }
+            case QtTITemplateToken::Type::BlockBegin:
+            case QtTITemplateToken::Type::BlockPart: {
+                // the line end is the part of the unfinished block
+                const QString blockData = token.view(data).toString() + lineEnd;
+                isLineEndInBlock = true;
+
+                // the block is executed with the control block body
+                if (isBlockBody) {
+                    rBlock->controlBlock()->appendBlockBody(blockData, lineNum);
+                    isLastBlockStrip = true;
+                    isLastBlockUnfinished = false;
+                    lastBlockEndPos = rBlock->endPos_ref().second;
+                    lastControlBlock = rBlock->controlBlock();
+                    break;
                 }
-            } else {               
-                if (!rBlock) {
-                    rBlock = new QtTIParserBlock();
-                    rBlock->_data = tmpBlock.data_ref();
-                    rBlock->_startPos = tmpBlock.startPos_ref();
-                    rBlock->_endPos = tmpBlock.endPos_ref();
-                    rBlock->_hasDataBeforeBlock = tmpBlock.hasDataBeforeBlock();
-                } else if (rBlock->isUnfinished()) {
-                    rBlock->_data += tmpBlock.data_ref();
-                    rBlock->_endPos = tmpBlock.endPos_ref();
+
+                if (token.type() == QtTITemplateToken::Type::BlockPart) {
+                    rBlock->_data += blockData;
                 } else {
-                    rBlock->clear();
-                    rBlock->_data = tmpBlock.data_ref();
-                    rBlock->_startPos = tmpBlock.startPos_ref();
-                    rBlock->_endPos = tmpBlock.endPos_ref();
-                    rBlock->_hasDataBeforeBlock = tmpBlock.hasDataBeforeBlock();
+                    if (!rBlock)
+                        rBlock = new QtTIParserBlock();
+                    else
+                        rBlock->clear();
+                    rBlock->_data = blockData;
+                    rBlock->_startPos = QPair<int, int>(lineNum, token.linePos());
+                    rBlock->_hasDataBeforeBlock = hasTextData(tmpLine);
+                    tmpLine.append(QtTICompiledNode(QtTICompiledNode::Type::BlockStart));
                 }
+                isLastBlockStrip = (token.blockType() == QtTIAbstractParserBlock::Type::Control
+                                    || token.blockType() == QtTIAbstractParserBlock::Type::Comment);
+                isLastBlockUnfinished = true;
+                lastBlockEndPos = -1;
+                lastControlBlock = nullptr;
+                break;
+            }
+            case QtTITemplateToken::Type::Block:
+            case QtTITemplateToken::Type::BlockEnd: {
+                const QString blockData = token.view(data).toString();
+                const QPair<int, int> endPos(lineNum, token.linePos() + token.length() - 1);
 
-//                qDebug() << "IS BLOCK: "
-//                         << rBlock->isValid()
-//                         << static_cast<int>(rBlock->type())
-//                         << rBlock->startPos()
-//                         << rBlock->endPos()
-//                         << rBlock->data_ref()
-//                         << rBlock->body();
-
-                // check is valid block
-                if (!rBlock->isValid()) {
-                    rBlock->_endPos.first = -1;
-                    rBlock->_endPos.second = -1;
-                    tmpBlock.clear();
-                    isBlock = false;
-                    continue;
+                bool isBlockCondEnd = false;
+                if (isBlockBody) {
+                    const QString blockCond = token.bodyView(data).trimmed().toString();
+                    if (rBlock->controlBlock()->isBlockCondIntermediate(blockCond)) {
+                        rBlock->controlBlock()->appendBlockCondIntermediate(blockCond);
+                    } else if (rBlock->controlBlock()->isBlockCondEnd(blockCond)) {
+                        isBlockCondEnd = true;
+                        // update end pos
+                        rBlock->setEndPos(endPos);
+                    } else {
+                        rBlock->controlBlock()->appendBlockBody(blockData, lineNum);
+                    }
+                } else {
+                    if (token.type() == QtTITemplateToken::Type::BlockEnd) {
+                        rBlock->_data += blockData;
+                    } else {
+                        if (!rBlock)
+                            rBlock = new QtTIParserBlock();
+                        else
+                            rBlock->clear();
+                        rBlock->_data = blockData;
+                        rBlock->_startPos = QPair<int, int>(lineNum, token.linePos());
+                        rBlock->_hasDataBeforeBlock = hasTextData(tmpLine);
+                        tmpLine.append(QtTICompiledNode(QtTICompiledNode::Type::BlockStart));
+                    }
+                    rBlock->_endPos = endPos;
+
+                    // create control block
+                    if (token.blockType() == QtTIAbstractParserBlock::Type::Control) {
+                        const QString blockCond = blockBody(rBlock->data_ref()).trimmed();
+                        QtTIAbstractControlBlock *bfObject = _blockFabric.createBlock(blockCond,
+                                                                                      rBlock->startPos_ref().first,
+                                                                                      rBlock->startPos_ref().second);
+                        if (!bfObject) {
+                            QString err = QString("Unsupported control block '%1' in line %2 (position %3)")
+                                          .arg(rBlock->data_ref())
+                                          .arg(rBlock->startPos_ref().first)
+                                          .arg(rBlock->startPos_ref().second);
+                            delete rBlock;
+                            block = rBlock = nullptr;
+                            return std::make_tuple(false, QtTICompiledLine(), err);
+                        }
+                        rBlock->setControlBlock(bfObject);
+                        // check is block ended
+                        isBlockCondEnd = rBlock->controlBlock()->isBlockCondEnd(blockCond);
+                    }
                 }
 
-                // check block type
-                if (rBlock->type() == QtTIParserBlock::Type::Control) {
-                    QtTIAbstractControlBlock *bfObject = _blockFabric.createBlock(rBlock->body().trimmed(),
-                                                                                  rBlock->startPos_ref().first,
-                                                                                  rBlock->startPos_ref().second);
-                    if (!bfObject) {
-                        QString err = QString("Unsupported control block '%1' in line %2 (position %3)")
-                                      .arg(rBlock->data_ref())
-                                      .arg(rBlock->startPos_ref().first)
-                                      .arg(rBlock->startPos_ref().second);
-                        rBlock->clear();
-                        delete rBlock;
-                        block = rBlock = nullptr;
-                        return std::make_tuple(false, "", err);
+                const QtTIAbstractParserBlock::Type blockType = isBlockBody ? QtTIAbstractParserBlock::Type::Control
+                                                                            : token.blockType();
+                isLastBlockStrip = (blockType == QtTIAbstractParserBlock::Type::Control
+                                    || blockType == QtTIAbstractParserBlock::Type::Comment);
+                isLastBlockUnfinished = false;
+                lastBlockEndPos = rBlock->endPos_ref().second;
+                lastControlBlock = rBlock->controlBlock();
+
+                // compile block
+                if (blockType == QtTIAbstractParserBlock::Type::Base) {
+                    const QString body = blockBody(rBlock->data_ref());
+                    tmpLine.append(QtTICompiledNode(QtTICompiledNode::Type::Expression,
+                                                    rBlock->data_ref(),
+                                                    body,
+                                                    rBlock->startPos_ref(),
+                                                    compileExpression(body)));
+                    // clear block object
+                    rBlock->clear();
+                } else if (blockType == QtTIAbstractParserBlock::Type::Control
+                           && isBlockCondEnd) {
+
+                    // removing extra blank characters
+                    if (isBlank(line, rBlock->endPos_ref().second + 1)) {
+                        tmpLine.append(QtTICompiledNode(QtTICompiledNode::Type::RStrip));
+                        if (rBlock->controlBlock()) {
+                            QString cBlockBody = rBlock->controlBlock()->blockBody(lineNum);
+                            rBlock->controlBlock()->setBlockBody(QtTIParser::rstrip(cBlockBody), lineNum);
+                        }
                     }
-                    rBlock->setControlBlock(bfObject);
-                    // check is block ended
-                    isBlockCondEnd = rBlock->controlBlock()->isBlockCondEnd(rBlock->body().trimmed());
+
+                    tmpLine.append(QtTICompiledNode(QtTICompiledNode::Type::ControlBlock,
+                                                    rBlock->data_ref(),
+                                                    rBlock->body(),
+                                                    rBlock->startPos_ref(),
+                                                    rBlock->controlBlock()));
+                    closedControlBlocks.append(rBlock->controlBlock());
+                    // clear block object
+                    rBlock->clear();
+                } else if (blockType == QtTIAbstractParserBlock::Type::Comment) {
+                    // clear block object
+                    rBlock->clear();
                 }
+                break;
             }
+            default:
+                break;
+        }
+    }
 
-            // check is valid block
-            if (rBlock->type() == QtTIParserBlock::Type::Invalid) {
-                QString err = QString("Invalid block '%1' in line %2 (position %3)")
-                              .arg(rBlock->data_ref())
-                              .arg(rBlock->startPos_ref().first)
-                              .arg(rBlock->startPos_ref().second);
-                rBlock->clear();
-                delete rBlock;
-                block = rBlock = nullptr;
-                return std::make_tuple(false, "", err);
-            }
+    // line end
+    if (!isLineEndInBlock && !lineEnd.isEmpty()) {
+        if (rBlock && rBlock->controlBlock())
+            rBlock->controlBlock()->appendBlockBody(lineEnd, lineNum);
+        else
+            appendTextNode(tmpLine, lineEnd, 0, lineEnd.size());
+    }
+
+    // NOTE: whether there is data before the last block is known only after rendering
+    if (isLastBlockStrip
+        && (isLastBlockUnfinished || isBlank(line, lastBlockEndPos + 1))) {
+        tmpLine.append(QtTICompiledNode(QtTICompiledNode::Type::RStripBlockLine));
+        // the block body has already been trimmed when the block was closed
+        if (lastControlBlock) {
+            QString cBlockBody = lastControlBlock->blockBody(lineNum);
+            lastControlBlock->setBlockBody(QtTIParser::rstrip(cBlockBody), lineNum);
+        }
+    }
 
-            lastBlock = *rBlock;
+    // the bodies of the closed blocks are complete
+    for (const std::shared_ptr<QtTIAbstractControlBlock> &controlBlock : qAsConst(closedControlBlocks))
+        controlBlock->compileBlock();
 
-            // eval block
-            if (rBlock->type() == QtTIParserBlock::Type::Base) {
+    if (rBlock && rBlock->isEmpty()) {
+        delete rBlock;
+        rBlock = nullptr;
+    }
+    block = rBlock;
+    return std::make_tuple(true, tmpLine, "");
+}
+
+//!
+//! \brief Render compiled line data (evaluate expressions and execute control blocks)
+//! \param compiledLine Compiled line
+//! \param hasDataBeforeBlock Has data before the last started block (render state shared between lines)
+//! \param parserArgs Render args (variables of the current render)
+//! \param writer Render output
+//! \return
+//!
+std::tuple<bool, QString> QtTIParser::renderLine(const QtTICompiledLine &compiledLine,
+                                                 bool &hasDataBeforeBlock,
+                                                 QtTIAbstractParserArgs *parserArgs,
+                                                 QtTIRenderWriter &writer)
+{
+    const qint64 lineStartPos = writer.size();
+    for (const QtTICompiledNode &node : compiledLine) {
+        switch (node.type()) {
+            case QtTICompiledNode::Type::Text: {
+                writer.write(node.text());
+                break;
+            }
+            case QtTICompiledNode::Type::Expression: {
                 bool isOk = false;
                 QVariant res;
                 QString err;
-                std::tie(isOk, res, err) = parseAndExecBlockData(rBlock);
+                std::tie(isOk, res, err) = execExpression(node.expression(), node.startPos(), parserArgs);
                 if (!isOk) {
                     QString errFull = QString("Eval control block '%1' in line %2 (position %3) failed! Error: %4")
-                                      .arg(rBlock->data_ref())
-                                      .arg(rBlock->startPos_ref().first)
-                                      .arg(rBlock->startPos_ref().second)
+                                      .arg(node.data())
+                                      .arg(node.startPos().first)
+                                      .arg(node.startPos().second)
                                       .arg(err);
-                    rBlock->clear();
-                    delete rBlock;
-                    block = rBlock = nullptr;
-                    return std::make_tuple(false, "", errFull);
-                }
-
-                // clear block object
-                rBlock->clear();
-                // add to tmpLine
-                tmpLine += res.toString();
-            } else if (rBlock->type() == QtTIParserBlock::Type::Control
-                       && isBlockCondEnd) {
-
-                // removing extra blank characters
-                const int lPos = rBlock->endPos_ref().second + 1;
-                const QString lineEnd = line.mid(lPos);
-                if (lineEnd.trimmed().isEmpty()) {
-                    tmpLine = QtTIParser::rstrip(tmpLine);
-                    if (rBlock->controlBlock()) {
-                        QString cBlockBody = rBlock->controlBlock()->blockBody(lineNum);
-                        rBlock->controlBlock()->setBlockBody(QtTIParser::rstrip(cBlockBody), lineNum);
-                    }
+                    return std::make_tuple(false, errFull);
                 }
-
+                writer.write(res.toString());
+                break;
+            }
+            case QtTICompiledNode::Type::ControlBlock: {
+                if (!node.controlBlock())
+                    break;
                 bool isOk = false;
-                QString res, err;
-                std::tie(isOk, res, err) = rBlock->controlBlock()->evalBlock();
+                QString err;
+                std::tie(isOk, err) = node.controlBlock()->evalBlock(parserArgs, writer);
                 if (!isOk) {
                     QString errFull = QString("Eval control block '%1' in line %2 (position %3) failed! Error: %4")
-                                      .arg(rBlock->data_ref())
-                                      .arg(rBlock->startPos_ref().first)
-                                      .arg(rBlock->startPos_ref().second)
+                                      .arg(node.data())
+                                      .arg(node.startPos().first)
+                                      .arg(node.startPos().second)
                                       .arg(err);
-                    rBlock->clear();
-                    delete rBlock;
-                    block = rBlock = nullptr;
-                    return std::make_tuple(false, "", errFull);
+                    return std::make_tuple(false, errFull);
                 }
-                // clear block object
-                rBlock->clear();
-                // add to tmpLine,
-                tmpLine += res;
-            } else if (rBlock->type() == QtTIParserBlock::Type::Comment) {
-                // clear block object
-                rBlock->clear();
+                break;
             }
-            // clear
-            tmpBlock.clear();
-            isBlock = false;
-            continue;
-        }
-        // check
-        if (isBlock)
-            tmpBlock._data += ch;
-        else if (!isBlock
-                 && rBlock
-                 && rBlock->type() == QtTIParserBlock::Type::Control
-                 && rBlock->controlBlock())
-            rBlock->controlBlock()->appendBlockBody(ch, lineNum);
-        else
-            tmpLine += ch;
-    }
-    if (isBlock) {
-        if (rBlock
-            && rBlock->type() == QtTIParserBlock::Type::Control
-            && rBlock->controlBlock()) {
-            rBlock->controlBlock()->appendBlockBody(tmpBlock.data_ref(), tmpBlock.startPos_ref().first);
-        } else {
-            if (!rBlock) {
-                rBlock = new QtTIParserBlock();
-                rBlock->_data = tmpBlock.data_ref();
-                rBlock->_startPos = tmpBlock.startPos_ref();
-                rBlock->_endPos = tmpBlock.endPos_ref();
-                rBlock->_hasDataBeforeBlock = tmpBlock.hasDataBeforeBlock();
-            } else if (rBlock->isUnfinished()) {
-                rBlock->_data += tmpBlock.data_ref();
-                rBlock->_endPos = tmpBlock.endPos_ref();
-            } else {
-                rBlock->clear();
-                rBlock->_data = tmpBlock.data_ref();
-                rBlock->_startPos = tmpBlock.startPos_ref();
-                rBlock->_endPos = tmpBlock.endPos_ref();
-                rBlock->_hasDataBeforeBlock = tmpBlock.hasDataBeforeBlock();
+            case QtTICompiledNode::Type::RStrip: {
+                writer.rstrip(lineStartPos);
+                break;
             }
-        }
-        lastBlock = *rBlock;
-    }
-    if (!lastBlock.hasDataBeforeBlock()) {
-        if (!lastBlock.isUnfinished()
-            && (lastBlock.type() == QtTIParserBlock::Type::Control
-                || lastBlock.type() == QtTIParserBlock::Type::Comment)) {
-            const int lPos = lastBlock.endPos_ref().second + 1;
-            const QString lineEnd = line.mid(lPos);
-            if (lineEnd.trimmed().isEmpty()) {
-                tmpLine = QtTIParser::rstrip(tmpLine);
-                if (lastBlock.controlBlock()) {
-                    QString cBlockBody = lastBlock.controlBlock()->blockBody(lineNum);
-                    lastBlock.controlBlock()->setBlockBody(QtTIParser::rstrip(cBlockBody), lineNum);
-                }
+            case QtTICompiledNode::Type::BlockStart: {
+                hasDataBeforeBlock = writer.hasDataAfter(lineStartPos);
+                break;
             }
-        } else if (lastBlock.isUnfinished()
-                   && (lastBlock.potentialType() == QtTIParserBlock::Type::Control
-                       || lastBlock.potentialType() == QtTIParserBlock::Type::Comment)) {
-            tmpLine = QtTIParser::rstrip(tmpLine);
+            case QtTICompiledNode::Type::RStripBlockLine: {
+                if (!hasDataBeforeBlock)
+                    writer.rstrip(lineStartPos);
+                break;
+            }
+            default:
+                break;
         }
     }
-    if (rBlock && rBlock->isEmpty()) {
-        delete rBlock;
-        rBlock = nullptr;
+    return std::make_tuple(true, "");
+}
+
+//!
+//! \brief Append static text to compiled line
+//! \param compiledLine Compiled line
+//! \param source Template data
+//! \param pos Text position in template data
+//! \param size Text size
+//!
+void QtTIParser::appendTextNode(QtTICompiledLine &compiledLine, const QString &source, const int pos, const int size)
+{
+    if (size <= 0)
+        return;
+    compiledLine.append(QtTICompiledNode(source, pos, size));
+}
+
+//!
+//! \brief Check compiled line has data (not blank static text or expressions)
+//! \param compiledLine Compiled line
+//! \return
+//!
+//! NOTE: The result of the expressions is unknown before rendering, so any expression is considered as data.
+//!
+bool QtTIParser::hasTextData(const QtTICompiledLine &compiledLine)
+{
+    for (const QtTICompiledNode &node : compiledLine) {
+        if (node.type() == QtTICompiledNode::Type::Expression)
+            return true;
+        if (node.type() == QtTICompiledNode::Type::Text
+            && !isBlank(node.text()))
+            return true;
     }
-    block = rBlock;
-    return std::make_tuple(true, tmpLine, "");
+    return false;
+}
+
+//!
+//! \brief Check string has only blank characters (starting from the position)
+//! \param str String
+//! \param pos Start position
+//! \return
+//!
+bool QtTIParser::isBlank(QStringView str, const int pos)
+{
+    for (int i = qMax(pos, 0); i < str.size(); i++) {
+        if (!str.at(i).isSpace())
+            return false;
+    }
+    return true;
 }
 
 //!
@@ -338,74 +808,62 @@ std::tuple<bool, QVariant, QString> QtTIParser::parseAndExecBlockData(QtTIAbstra
 //!
 std::tuple<bool, QVariant, QString> QtTIParser::parseAndExecBlockData(const QString &data, const QPair<int, int> &startPos)
 {
-    if (data.isEmpty())
+    return parseAndExecBlockData(data, startPos, &_parserArgs);
+}
+
+//!
+//! \brief Parse and execute abstract block data with render args
+//! \param data Parser block data
+//! \param startPos Parser block start position in line
+//! \param parserArgs Render args (variables of the current render)
+//! \return
+//!
+std::tuple<bool, QVariant, QString> QtTIParser::parseAndExecBlockData(const QString &data,
+                                                                     const QPair<int, int> &startPos,
+                                                                     QtTIAbstractParserArgs *parserArgs)
+{
+    return execExpression(QtTIExpression::compile(data), startPos, parserArgs);
+}
+
+//!
+//! \brief Execute compiled expression with render args
+//! \param expr Compiled expression
+//! \param startPos Parser block start position in line
+//! \param parserArgs Render args (variables of the current render)
+//! \return
+//!
+//! NOTE: If the expression is a parameter or a function and its value is invalid, an error is returned.
+//!
+std::tuple<bool, QVariant, QString> QtTIParser::execExpression(const QtTIExpression &expr,
+                                                              const QPair<int, int> &startPos,
+                                                              QtTIAbstractParserArgs *parserArgs)
+{
+    if (!parserArgs)
+        return std::make_tuple(false, QVariant(), "Parser args is NULL!");
+    if (expr.isEmpty())
         return std::make_tuple(false, QVariant(), "Block data is Empty!");
     if (startPos.first == -1 || startPos.second == -1)
         return std::make_tuple(false, QVariant(), "Invalid block data position!");
 
-    // check condition
+    bool isOk = false;
     QVariant resultValue;
-    if (QtTIParserTernaryOperator::isTernaryOperatorExpr(data)) {
-        bool calcIsOk = false;
-        QString calcErr;
-        const QVariant calcRes = QtTIParserTernaryOperator::parseTernaryOperator(data, &_parserArgs, &_parserFunc, &calcIsOk, calcErr);
-        if (!calcIsOk) {
-            const QString error = QString("%1 in line %2 (position %3)")
-                                  .arg(calcErr)
-                                  .arg(startPos.first)
-                                  .arg(startPos.second);
-            return std::make_tuple(false, QVariant(), error);
-        }
-        resultValue = calcRes;
-
-    } else if (QtTIParserNullCoalescingOperator::isNullCoalescingOperatorExpr(data)) {
-        bool calcIsOk = false;
-        QString calcErr;
-        const QVariant calcRes = QtTIParserNullCoalescingOperator::parseNullCoalescingOperator(data, &_parserArgs, &_parserFunc, &calcIsOk, calcErr);
-        if (!calcIsOk) {
-            const QString error = QString("%1 in line %2 (position %3)")
-                                  .arg(calcErr)
-                                  .arg(startPos.first)
-                                  .arg(startPos.second);
-            return std::make_tuple(false, QVariant(), error);
-        }
-        resultValue = calcRes;
-
-    } else if (QtTIParserLogic::isLogicExpr(data)) {
-        bool calcIsOk = false;
-        QString calcErr;
-        const QVariant calcRes = QtTIParserLogic::parseLogic(data, &_parserArgs, &_parserFunc, &calcIsOk, calcErr);
-        if (!calcIsOk) {
-            const QString error = QString("%1 in line %2 (position %3)")
-                                  .arg(calcErr)
-                                  .arg(startPos.first)
-                                  .arg(startPos.second);
-            return std::make_tuple(false, QVariant(), error);
-        }
-        resultValue = calcRes;
-
-    } else if (QtTIParserMath::isMathExpr(data)) {
-        bool calcIsOk = false;
-        QString calcErr;
-        const QVariant calcRes = QtTIParserMath::parseMath(data, &_parserArgs, &_parserFunc, &calcIsOk, calcErr);
-        if (!calcIsOk) {
-            const QString error = QString("%1 in line %2 (position %3)")
-                                  .arg(calcErr)
-                                  .arg(startPos.first)
-                                  .arg(startPos.second);
-            return std::make_tuple(false, QVariant(), error);
-        }
-        resultValue = calcRes;
-
-    } else {
-        resultValue = _parserArgs.prepareHelpFunctionArg(data);
-        if (!resultValue.isValid()) {
-            const QString error = QString("Unsupported help parameter '%1' in line %2 (position %3)")
-                                  .arg(data)
-                                  .arg(startPos.first)
-                                  .arg(startPos.second);
-            return std::make_tuple(false, QVariant(), error);
-        }
+    QString error;
+    std::tie(isOk, resultValue, error) = expr.eval(parserArgs, &_parserFunc);
+    if (!isOk) {
+        error = QString("%1 in line %2 (position %3)")
+                .arg(error)
+                .arg(startPos.first)
+                .arg(startPos.second);
+        return std::make_tuple(false, QVariant(), error);
+    }
+    if (!resultValue.isValid()
+        && (expr.root()->kind() == QtTIExprNode::Kind::Path
+            || expr.root()->kind() == QtTIExprNode::Kind::Call)) {
+        error = QString("Unsupported help parameter '%1' in line %2 (position %3)")
+                .arg(expr.source())
+                .arg(startPos.first)
+                .arg(startPos.second);
+        return std::make_tuple(false, QVariant(), error);
     }
     return std::make_tuple(true, resultValue, "");
 }
@@ -2,11 +2,21 @@
 #define QTTIPARSER_H
 
 #include <QString>
+#include <QStringView>
+#include <QVector>
+#include <QMutex>
+#include <QThread>
 #include <tuple>
+#include <memory>
+#include <atomic>
 
 #include "ControlBlockFabric/QtTIControlBlockFabric.h"
+#include "CompiledTemplate/QtTICompiledTemplate.h"
+#include "Program/QtTIProgram.h"
+#include "TemplateLexer/QtTITemplateToken.h"
 #include "Abstract/QtTIAbstractParser.h"
 #include "QtTIParserArgs.h"
+#include "QtTIRenderContext.h"
 #include "QtTIParserFunc.h"
 
 class QtTIParser : public QtTIAbstractParser
@@ -21,11 +31,70 @@ public:
     std::tuple<bool/*isOk*/,QString/*res*/,QString/*err*/> parseLine(const QString &line,
                                                                      const int lineNum,
                                                                      QtTIAbstractParserBlock *&block) final;
+    std::tuple<bool/*isOk*/,QString/*err*/> parseLine(const QString &line,
+                                                      const int lineNum,
+                                                      QtTIAbstractParserBlock *&block,
+                                                      QtTIAbstractParserArgs *parserArgs,
+                                                      QtTIRenderWriter &writer) final;
+
+    std::tuple<bool/*isOk*/,std::shared_ptr<QtTICompiledTemplate>/*res*/,QString/*err*/> compile(QString data);
+    QtTIRenderContext createRenderContext() const;
+    std::tuple<bool/*isOk*/,QString/*res*/,QString/*err*/> render(const QtTICompiledTemplate &compiledTemplate);
+    std::tuple<bool/*isOk*/,QString/*err*/> render(const QtTICompiledTemplate &compiledTemplate, QtTIRenderWriter &writer);
+    std::tuple<bool/*isOk*/,QString/*err*/> render(const QtTICompiledTemplate &compiledTemplate,
+                                                   QtTIRenderContext &context,
+                                                   QtTIRenderWriter &writer);
+    std::tuple<bool/*isOk*/,QString/*err*/> render(const QtTIProgram &program,
+                                                   QtTIRenderContext &context,
+                                                   QtTIRenderWriter &writer);
+
+    QtTIExpression compileExpression(const QString &expr) final;
+    int variableSlot(const QString &name) final;
+
+    std::tuple<bool/*isOk*/,std::shared_ptr<QtTICompiledTemplate>/*res*/,QString/*err*/> compileBlockBody(const QMap<int/*lineNum*/,QString/*lineData*/> &data,
+                                                                                                          const int blockLineNum) final;
+    std::tuple<bool/*isOk*/,QString/*err*/> renderBlockBody(const QtTICompiledTemplate &body,
+                                                            QtTIAbstractParserArgs *parserArgs,
+                                                            QtTIRenderWriter &writer) final;
+
+    std::tuple<bool/*isOk*/,QtTICompiledLine/*res*/,QString/*err*/> compileLine(const QString &line,
+                                                                                const int lineNum,
+                                                                                QtTIAbstractParserBlock *&block);
+    std::tuple<bool/*isOk*/,QString/*err*/> renderLine(const QtTICompiledLine &compiledLine,
+                                                       bool &hasDataBeforeBlock,
+                                                       QtTIAbstractParserArgs *parserArgs,
+                                                       QtTIRenderWriter &writer);
 
     std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> parseAndExecBlockData(QtTIAbstractParserBlock *block) final;
     std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> parseAndExecBlockData(const QString &data, const QPair<int, int> &startPos) final;
+    std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> parseAndExecBlockData(const QString &data,
+                                                                                  const QPair<int, int> &startPos,
+                                                                                  QtTIAbstractParserArgs *parserArgs) final;
+    std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> execExpression(const QtTIExpression &expr,
+                                                                           const QPair<int, int> &startPos,
+                                                                           QtTIAbstractParserArgs *parserArgs) final;
 
 private:
+    std::tuple<bool/*isOk*/,std::shared_ptr<QtTICompiledTemplate>/*res*/,QString/*err*/> compileTemplate(const QString &data);
+    std::tuple<bool/*isOk*/,QtTICompiledLine/*res*/,QString/*err*/> compileTokens(const QString &data,
+                                                                                  const QVector<QtTITemplateToken> &tokens,
+                                                                                  const int lineNum,
+                                                                                  const QStringView line,
+                                                                                  const QString &lineEnd,
+                                                                                  QtTIAbstractParserBlock *&block);
+    std::tuple<bool/*isOk*/,QString/*err*/> renderBody(const QtTICompiledTemplate &body,
+                                                       QtTIAbstractParserArgs *parserArgs,
+                                                       QtTIRenderWriter &writer,
+                                                       const bool isTemplate);
+
+    static QString blockBody(const QString &blockData);
+    static QtTIAbstractParserBlock::Type unfinishedBlockType(const QtTIAbstractParserBlock *block);
+    static void appendTextNode(QtTICompiledLine &compiledLine, const QString &source, const int pos, const int size);
+    static bool hasTextData(const QtTICompiledLine &compiledLine);
+    static bool isBlank(QStringView str, const int pos = 0);
+
+    QtTIScope *compileScope() const;
+
     QString evalHelpParam(const QString& paramName);
     QString evalHelpTmpParam(const QString& paramName);
 
@@ -35,6 +104,9 @@ private:
     QtTIParserArgs _parserArgs; //!< parser args object
     QtTIParserFunc _parserFunc; //!< parser func object
     QtTIControlBlockFabric _blockFabric {this}; //!< control blocks fabric
+    QtTIScope *_compileScope {nullptr};         //!< variable slots of the template being compiled
+    std::atomic<QThread *> _compileThread {nullptr};    //!< thread compiling the template (the owner of '_compileScope')
+    QMutex _compileMutex;                       //!< compile mutex (one template is compiled at a time)
 };
 
 #endif // QTTIPARSER_H
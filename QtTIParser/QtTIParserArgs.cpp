@@ -1,6 +1,6 @@
 #include "QtTIParserArgs.h"
 #include "../QtTIDefines/QtTIDefines.h"
-#include "../QtTIDefines/QtTIRegExpDefines.h"
+#include "RegExpRegistry/QtTIRegExpRegistry.h"
 #include "../QtTIHelperFunction/QtTIAbstractHelperFunction.h"
 
 #include <QDebug>
@@ -43,8 +43,7 @@ QtTIParserArgs::~QtTIParserArgs()
 void QtTIParserArgs::appendParam(const QString &paramName, const QVariant &value)
 {
     Q_ASSERT_WITH_MSG(paramName.isEmpty() != true, "Param key is Empty!");
-    QRegExp rxStr(RX_STRING);
-    if (rxStr.indexIn(paramName) == -1) {
+    if (!QtTIRegExpRegistry::match(QtTIRegExpRegistry::String, paramName).hasMatch()) {
         qWarning() << qPrintable(QString("[QtTIParserArgs][appendParam] Invalid help param key (key: \"%1\")!")
                                  .arg(paramName));
         return;
@@ -69,8 +68,7 @@ void QtTIParserArgs::appendParam(const QString &paramName, const QVariant &value
 void QtTIParserArgs::removeParam(const QString &paramName)
 {
     Q_ASSERT_WITH_MSG(paramName.isEmpty() != true, "Param key is Empty!");
-    QRegExp rxStr(RX_STRING);
-    if (rxStr.indexIn(paramName) == -1) {
+    if (!QtTIRegExpRegistry::match(QtTIRegExpRegistry::String, paramName).hasMatch()) {
         qWarning() << qPrintable(QString("[QtTIParserArgs][removeParam] Invalid help param key (key: \"%1\")!")
                                  .arg(paramName));
         return;
@@ -85,10 +83,7 @@ void QtTIParserArgs::removeParam(const QString &paramName)
 //!
 bool QtTIParserArgs::hasParam(const QString &paramName)
 {
-    const QVariant p = param(paramName);    
-    if (p.type() == QVariant::Type::String)
-        return true;
-    return !p.isNull();
+    return std::get<0>(findParam(QtTIParamPath(paramName)));
 }
 
 //!
@@ -96,13 +91,34 @@ bool QtTIParserArgs::hasParam(const QString &paramName)
 //! \param paramName Parameter name
 //! \return
 //!
+//! NOTE: If the parameter is not found, it is searched in the shared args (see QtTIRenderContext).
+//!
 QVariant QtTIParserArgs::param(const QString &paramName)
 {
-    QString tmpArgName = paramName.split(".")[0];
-    if (_params.contains(tmpArgName))
-        return paramValueRecursive(paramName, _params);
+    return std::get<1>(findParam(QtTIParamPath(paramName)));
+}
 
-    return QVariant();
+//!
+//! \brief Find global help parameter value (the parameter is resolved once)
+//! \param path Compiled parameter path
+//! \return
+//!
+//! NOTE: If the parameter is not found, it is searched in the shared args (see QtTIRenderContext).
+//!
+std::tuple<bool, QVariant> QtTIParserArgs::findParam(const QtTIParamPath &path)
+{
+    if (path.isEmpty() || path.segments().first().isMethod)
+        return std::make_tuple(false, QVariant());
+
+    QHash<QString, QVariant>::const_iterator it = _params.constFind(path.name());
+    if (it == _params.constEnd()) {
+        if (!_sharedArgs)
+            return std::make_tuple(false, QVariant());
+        it = _sharedArgs->_params.constFind(path.name());
+        if (it == _sharedArgs->_params.constEnd())
+            return std::make_tuple(false, QVariant());
+    }
+    return foundValue(childParam(it.value(), path));
 }
 
 //!
@@ -122,6 +138,11 @@ void QtTIParserArgs::clearParams()
 //!
 void QtTIParserArgs::appendTmpParam(const QString &paramName, const QVariant &paramValue)
 {
+    const int slot = tmpParamSlot(paramName);
+    if (slot != -1) {
+        setSlotValue(slot, paramValue);
+        return;
+    }
     _tmpParams.insert(paramName, paramValue);
 }
 
@@ -131,6 +152,11 @@ void QtTIParserArgs::appendTmpParam(const QString &paramName, const QVariant &pa
 //!
 void QtTIParserArgs::removeTmpParam(const QString &paramName)
 {
+    const int slot = tmpParamSlot(paramName);
+    if (slot != -1) {
+        setSlotValue(slot, QVariant());
+        return;
+    }
     _tmpParams.remove(paramName);
 }
 
@@ -141,10 +167,7 @@ void QtTIParserArgs::removeTmpParam(const QString &paramName)
 //!
 bool QtTIParserArgs::hasTmpParam(const QString &paramName)
 {
-    const QVariant p = tmpParam(paramName);
-    if (p.type() == QVariant::Type::String)
-        return true;
-    return !p.isNull();
+    return std::get<0>(findTmpParam(QtTIParamPath(paramName)));
 }
 
 //!
@@ -154,11 +177,29 @@ bool QtTIParserArgs::hasTmpParam(const QString &paramName)
 //!
 QVariant QtTIParserArgs::tmpParam(const QString &paramName)
 {
-    QString tmpArgName = paramName.split(".")[0];
-    if (_tmpParams.contains(tmpArgName))
-        return paramValueRecursive(paramName, _tmpParams);
+    return std::get<1>(findTmpParam(QtTIParamPath(paramName)));
+}
 
-    return QVariant();
+//!
+//! \brief Find help tmp parameter value (the parameter is resolved once)
+//! \param path Compiled parameter path
+//! \return
+//!
+std::tuple<bool, QVariant> QtTIParserArgs::findTmpParam(const QtTIParamPath &path)
+{
+    if (path.isEmpty() || path.segments().first().isMethod)
+        return std::make_tuple(false, QVariant());
+
+    const int slot = tmpParamSlot(path.name());
+    if (slot != -1) {
+        const QVariant &value = slotValue(slot);
+        if (value.isValid())
+            return foundValue(childParam(value, path));
+    }
+    QHash<QString, QVariant>::const_iterator it = _tmpParams.constFind(path.name());
+    if (it == _tmpParams.constEnd())
+        return std::make_tuple(false, QVariant());
+    return foundValue(childParam(it.value(), path));
 }
 
 //!
@@ -169,6 +210,70 @@ QVariant QtTIParserArgs::tmpParam(const QString &paramName)
 void QtTIParserArgs::clearTmpParams()
 {
     _tmpParams.clear();
+    _slots.clear();
+}
+
+//!
+//! \brief Set value of the variable slot (see QtTIScope)
+//! \param slot Slot index
+//! \param value Variable value (invalid QVariant - the slot is not set)
+//!
+void QtTIParserArgs::setSlotValue(const int slot, const QVariant &value)
+{
+    Q_ASSERT_WITH_MSG(slot >= 0, "Invalid slot index!");
+    if (slot >= _slots.size()) {
+        if (!value.isValid())
+            return;
+        _slots.resize(_scope ? qMax(_scope->slotCount(), slot + 1) : slot + 1);
+    }
+    _slots[slot] = value;
+}
+
+//!
+//! \brief Get value of the variable slot (see QtTIScope)
+//! \param slot Slot index
+//! \return Invalid QVariant if the slot is not set
+//!
+const QVariant &QtTIParserArgs::slotValue(const int slot) const
+{
+    static const QVariant invalid;
+    if (slot < 0 || slot >= _slots.size())
+        return invalid;
+    return _slots.at(slot);
+}
+
+//!
+//! \brief Get child value of the parameter value
+//! \param value Parameter value (value of the first path segment)
+//! \param path Compiled parameter path (the segments after the first one are evaluated)
+//! \return
+//!
+//! === Example
+//!     {% set test_my_key = { a => 'hi', b => 'hellow', c => 123 } %}{{ image_path (test_my_key.a) }}{% unset test_my_key %}
+//!
+//!     Result: "hellow there: hi"
+//!
+//! === Example 2:
+//!     a - class Test with public methods:
+//!         Q_INVOKABLE int index() const { return 123; }
+//!         Q_INVOKABLE int index(const int i) const { return 123 + i; }
+//!
+//!     {{ a.index() }}
+//!     {{ a.index(1) }}
+//!
+//!     Result:
+//!         a.index() = 123
+//!         a.index(1) = 124
+//!
+QVariant QtTIParserArgs::childParam(const QVariant &value, const QtTIParamPath &path)
+{
+    const QVector<QtTIParamPath::Segment> &segments = path.segments();
+    if (segments.size() <= 1)
+        return value;
+    QVariant tmpValue = segmentValue(segments[1], value);
+    for (int i = 2; i < segments.size(); i++)
+        tmpValue = segmentValue(segments[i], tmpValue);
+    return tmpValue;
 }
 
 //!
@@ -285,22 +390,18 @@ QVariant QtTIParserArgs::prepareHelpFunctionArg(const QString &arg)
     QString tmpArg = arg.trimmed();
     if (tmpArg.isEmpty())
         return QVariant();
-    QRegExp rxStr(RX_TYPE_STR);
-    QRegExp rxInt(RX_TYPE_INT);
-    QRegExp rxDouble(RX_TYPE_DOUBLE);
-    QRegExp rxBool(RX_TYPE_BOOL);
-    QRegExp rxArray(RX_TYPE_ARRAY);
-    QRegExp rxHash(RX_TYPE_HASH);
-    QRegExp rxFunc(RX_FUNC);
-    if (rxStr.indexIn(tmpArg) == 0) {
-        QString type = rxStr.cap(1);
-        QString value = rxStr.cap(2);
+    QRegularExpressionMatch m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::TypeStr, tmpArg);
+    if (m.capturedStart() == 0) {
+        QString type = m.captured(1);
+        QString value = m.captured(2);
         if (type == "b")
             return QVariant(this->unescapeStr(value).toUtf8());
         return QVariant(this->unescapeStr(value));
-    } else if (rxInt.indexIn(tmpArg) == 0) {
-        QString type = rxInt.cap(2);
-        QString value = QString("%1%2").arg(rxInt.cap(1), rxInt.cap(3)).trimmed();
+    }
+    m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::TypeInt, tmpArg);
+    if (m.capturedStart() == 0) {
+        QString type = m.captured(2);
+        QString value = QString("%1%2").arg(m.captured(1), m.captured(3)).trimmed();
         if (type == "l")
             return QVariant(value.toLongLong());
         else if (type == "ul")
@@ -308,28 +409,35 @@ QVariant QtTIParserArgs::prepareHelpFunctionArg(const QString &arg)
         else if (type == "ui")
             return QVariant(value.toUInt());
         return QVariant(value.toInt());
-    } else if (rxDouble.indexIn(tmpArg) == 0) {
-        QString type = rxDouble.cap(2);
-        QString value = QString("%1%2").arg(rxDouble.cap(1), rxDouble.cap(3)).trimmed();
+    }
+    m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::TypeDouble, tmpArg);
+    if (m.capturedStart() == 0) {
+        QString type = m.captured(2);
+        QString value = QString("%1%2").arg(m.captured(1), m.captured(3)).trimmed();
         if (type == "f")
             return QVariant(value.toFloat());
         return QVariant(value.toDouble());
-    } else if (rxBool.indexIn(tmpArg) == 0) {
+    }
+    if (QtTIRegExpRegistry::match(QtTIRegExpRegistry::TypeBool, tmpArg).capturedStart() == 0) {
         bool tmpV = false;
         if (arg.toLower() == "true")
             tmpV = true;
         return QVariant(tmpV);
-    } else if (rxArray.indexIn(tmpArg) == 0) {
+    }
+    m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::TypeArray, tmpArg);
+    if (m.capturedStart() == 0) {
         QVariantList vList;
-        const QStringList arrayValues = prepareArrayValues(rxArray.cap(1).trimmed(), ',', true);
+        const QStringList arrayValues = prepareArrayValues(m.captured(1).trimmed(), ',', true);
         for (const QString &v : arrayValues)
             vList.append(prepareHelpFunctionArg(v.trimmed()));
         return vList;
-    } else if (rxHash.indexIn(tmpArg) == 0) {
-        QString type = rxHash.cap(1);
+    }
+    m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::TypeHash, tmpArg);
+    if (m.capturedStart() == 0) {
+        QString type = m.captured(1);
         QVariantMap vMap;
         QVariantHash vHash;
-        const QMap<QString, QString> map = prepareMapKeysValues(rxHash.cap(2).trimmed());
+        const QMap<QString, QString> map = prepareMapKeysValues(m.captured(2).trimmed());
         QMapIterator<QString, QString> mIt (map);
         while (mIt.hasNext()) {
             mIt.next();
@@ -342,9 +450,11 @@ QVariant QtTIParserArgs::prepareHelpFunctionArg(const QString &arg)
         if (type == "h")
             return vHash;
         return vMap;
-    } else if (rxFunc.indexIn(tmpArg) != -1 && _parserFunc) {
-        QString funcName = rxFunc.cap(2).trimmed();
-        QVariantList funcArgs = parseHelpFunctionArgs(rxFunc.cap(3).trimmed());
+    }
+    m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::Func, tmpArg);
+    if (m.hasMatch() && _parserFunc) {
+        QString funcName = m.captured(2).trimmed();
+        QVariantList funcArgs = parseHelpFunctionArgs(m.captured(3).trimmed());
         bool isOk = false;
         QString error;
         QVariant result;
@@ -355,10 +465,15 @@ QVariant QtTIParserArgs::prepareHelpFunctionArg(const QString &arg)
         return result;
     }
     // check is param
-    if (hasParam(tmpArg))
-        return param(tmpArg);
-    else if (hasTmpParam(tmpArg))
-        return tmpParam(tmpArg);
+    const QtTIParamPath path(tmpArg);
+    bool isFound = false;
+    QVariant value;
+    std::tie(isFound, value) = findParam(path);
+    if (isFound)
+        return value;
+    std::tie(isFound, value) = findTmpParam(path);
+    if (isFound)
+        return value;
 
     // not found -> invalid
     return QVariant();
@@ -367,6 +482,28 @@ QVariant QtTIParserArgs::prepareHelpFunctionArg(const QString &arg)
 
 // --- Private methods ---
 
+//!
+//! \brief Set variable slots of the rendered template (the slot values are cleared)
+//! \param scope Variable slots
+//!
+void QtTIParserArgs::setScope(const std::shared_ptr<const QtTIScope> &scope)
+{
+    _scope = scope;
+    _slots.clear();
+}
+
+//!
+//! \brief Get slot index of the tmp parameter
+//! \param paramName Tmp parameter name (not a path)
+//! \return -1 if the parameter has no slot
+//!
+int QtTIParserArgs::tmpParamSlot(const QString &paramName) const
+{
+    if (!_scope)
+        return -1;
+    return _scope->findSlot(paramName);
+}
+
 //!
 //! \brief Parse array
 //! \param arrayStr String representation of array
@@ -429,13 +566,13 @@ QStringList QtTIParserArgs::prepareArrayValues(const QString &arrayStr, const QC
 //!
 QMap<QString, QString> QtTIParserArgs::prepareMapKeysValues(const QString &mapStr, const QChar &delimiter)
 {
-    QRegExp rxHash(RX_TYPE_HASH_DELIMITER);
     const QStringList tmpList = prepareArrayValues(mapStr, delimiter, true);
     QMap<QString, QString> tmpMap;
     for (const QString &v : tmpList) {
-        if (rxHash.indexIn(v) == -1)
+        const QRegularExpressionMatch m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::TypeHashDelimiter, v);
+        if (!m.hasMatch())
             continue;
-        QPair<QString, QString> keyValue = prepareMapKeyValue(v.trimmed(), rxHash.cap(1));
+        QPair<QString, QString> keyValue = prepareMapKeyValue(v.trimmed(), m.captured(1));
         tmpMap.insert(keyValue.first, keyValue.second);
     }
     return tmpMap;
@@ -492,297 +629,284 @@ QString QtTIParserArgs::unescapeStr(const QString &value)
 {
     // string
     // check is escaped
-    QRegExp rxEscape1(RX_STR_ESCAPE_v1);
-    QRegExp rxEscape2(RX_STR_ESCAPE_v2);
-    if (rxEscape1.indexIn(value) == 0)
-        return rxEscape1.cap(1);
-    else if (rxEscape2.indexIn(value) == 0)
-        return rxEscape2.cap(1);
+    QRegularExpressionMatch m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::StrEscape_v1, value);
+    if (m.capturedStart() == 0)
+        return m.captured(1);
+    m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::StrEscape_v2, value);
+    if (m.capturedStart() == 0)
+        return m.captured(1);
 
     return value;
 }
 
 //!
-//! \brief Select parameter value (recursive)
-//! \param key Parameter name
-//! \param parent Parameter container
+//! \brief Check the parameter value is found (string or not NULL)
+//! \param value Parameter value
 //! \return
 //!
-//! === Example
-//!     {% set test_my_key = { a => 'hi', b => 'hellow', c => 123 } %}{{ image_path (test_my_key.a) }}{% unset test_my_key %}
-//!
-//!     Result: "hellow there: hi"
-//!
-//! === Example 2:
-//!     a - class Test with public methods:
-//!         Q_INVOKABLE int index() const { return 123; }
-//!         Q_INVOKABLE int index(const int i) const { return 123 + i; }
-//!
-//!     {{ a.index() }}
-//!     {{ a.index(1) }}
+std::tuple<bool, QVariant> QtTIParserArgs::foundValue(const QVariant &value)
+{
+    if (value.type() == QVariant::Type::String
+        || !value.isNull())
+        return std::make_tuple(true, value);
+    return std::make_tuple(false, QVariant());
+}
+
 //!
-//!     Result:
-//!         a.index() = 123
-//!         a.index(1) = 124
+//! \brief Select value of the path segment
+//! \param segment Path segment (key, property or method call)
+//! \param parent Parameter container
+//! \return
 //!
-QVariant QtTIParserArgs::paramValueRecursive(const QString &key, const QVariant &parent)
+QVariant QtTIParserArgs::segmentValue(const QtTIParamPath::Segment &segment, const QVariant &parent)
 {
-    if (key.isEmpty() || parent.isNull())
+    if (parent.isNull())
         return QVariant();
-    QStringList tmpKeys = key.split(".");
-    const QString tmpKey = tmpKeys[0];
-    tmpKeys.removeAt(0);
+
+    // containers are read through the QVariant storage (without copy)
+    switch (parent.userType()) {
+        case QMetaType::QVariantMap: {
+            if (segment.isMethod)
+                return QVariant();
+            const QVariantMap *map = static_cast<const QVariantMap*>(parent.constData());
+            const QVariantMap::const_iterator it = map->constFind(segment.name);
+            return (it != map->constEnd()) ? it.value() : QVariant();
+        }
+        case QMetaType::QVariantHash: {
+            if (segment.isMethod)
+                return QVariant();
+            const QVariantHash *hash = static_cast<const QVariantHash*>(parent.constData());
+            const QVariantHash::const_iterator it = hash->constFind(segment.name);
+            return (it != hash->constEnd()) ? it.value() : QVariant();
+        }
+        case QMetaType::QVariantList: {
+            const QVariantList *list = static_cast<const QVariantList*>(parent.constData());
+            if (segment.index < 0 || segment.index >= list->size())
+                return QVariant();
+            return list->at(segment.index);
+        }
+        case QMetaType::QStringList: {
+            const QStringList *list = static_cast<const QStringList*>(parent.constData());
+            if (segment.index < 0 || segment.index >= list->size())
+                return QVariant();
+            return QVariant(list->at(segment.index));
+        }
+        default:
+            break;
+    }
+
     QVariant tmpValue;
-    if (parent.type() == QVariant::Map) {
-        tmpValue = parent.toMap().value(tmpKey, QVariant());
-    } else if (parent.type() == QVariant::Hash) {
-        tmpValue = parent.toHash().value(tmpKey, QVariant());
-    } else if (parent.type() == QVariant::UserType) {
+    if (parent.type() == QVariant::UserType) {
         QObject *objPtr = qvariant_cast<QObject*>(parent);
         if (objPtr) {
             const QMetaObject *mObj = objPtr->metaObject();
             if (!mObj)
                 return QVariant();
-            QRegExp rxFunc(RX_FUNC);
-            if (rxFunc.indexIn(key) != -1) {
+            if (segment.isMethod) {
                 // eval needed method
-                QString funcName = rxFunc.cap(2).trimmed();
-                QVariantList funcArgs = parseHelpFunctionArgs(rxFunc.cap(3).trimmed());
-                tmpValue = evalParamMethod(objPtr, mObj, funcName, funcArgs);
+                const QVariantList funcArgs = segment.isConstArgs ? segment.constArgs : parseHelpFunctionArgs(segment.methodArgs);
+                tmpValue = evalParamMethod(objPtr, mObj, segment, funcArgs);
             } else {
                 // search needed property
-                for (int i = mObj->propertyOffset(); i < mObj->propertyCount(); ++i) {
-                    const QMetaProperty mProp = mObj->property(i);
-                    if (mProp.name() == key) {
-                        if (!mProp.isReadable()) {
-                            qWarning() << qPrintable(QString("[QtTIParserArgs][paramValueRecursive] Class property '%1::%2' is not readable!")
-                                                     .arg(mObj->className(),
-                                                          key));
-                            return QVariant();
-                        }
-                        tmpValue = mProp.read(objPtr);
-                        break;
+                const int propIndex = propertyIndex(segment, mObj);
+                if (propIndex != -1) {
+                    const QMetaProperty mProp = mObj->property(propIndex);
+                    if (!mProp.isReadable()) {
+                        qWarning() << qPrintable(QString("[QtTIParserArgs][segmentValue] Class property '%1::%2' is not readable!")
+                                                 .arg(mObj->className(),
+                                                      segment.name));
+                        return QVariant();
                     }
+                    tmpValue = mProp.read(objPtr);
                 }
             }
         } else {
-            const QString t = parent.typeName(); // user class name
-            const int tId = QMetaType::type(t.toStdString().c_str()); // id of the derived class
-            const QMetaObject *mObj = QMetaType::metaObjectForType(tId);
+            const QMetaObject *mObj = QMetaType::metaObjectForType(parent.userType());
             if (!mObj)
                 return QVariant();
 
-            QRegExp rxFunc(RX_FUNC);
-            if (rxFunc.indexIn(key) != -1) {
+            if (segment.isMethod) {
                 // eval needed method
-                QString funcName = rxFunc.cap(2).trimmed();
-                QVariantList funcArgs = parseHelpFunctionArgs(rxFunc.cap(3).trimmed());
-                tmpValue = evalParamMethod(const_cast<void*>(parent.constData()), mObj, funcName, funcArgs);
+                const QVariantList funcArgs = segment.isConstArgs ? segment.constArgs : parseHelpFunctionArgs(segment.methodArgs);
+                tmpValue = evalParamMethod(const_cast<void*>(parent.constData()), mObj, segment, funcArgs);
             } else {
                 // search needed property
-                for (int i = mObj->propertyOffset(); i < mObj->propertyCount(); ++i) {
-                    const QMetaProperty mProp = mObj->property(i);
-                    if (mProp.name() == key) {
-                        if (!mProp.isReadable()) {
-                            qWarning() << qPrintable(QString("[QtTIParserArgs][paramValueRecursive] Class property '%1::%2' is not readable!")
-                                                     .arg(mObj->className(),
-                                                          key));
-                            return QVariant();
-                        }
-                        tmpValue = mProp.readOnGadget(parent.constData());
-                        break;
+                const int propIndex = propertyIndex(segment, mObj);
+                if (propIndex != -1) {
+                    const QMetaProperty mProp = mObj->property(propIndex);
+                    if (!mProp.isReadable()) {
+                        qWarning() << qPrintable(QString("[QtTIParserArgs][segmentValue] Class property '%1::%2' is not readable!")
+                                                 .arg(mObj->className(),
+                                                      segment.name));
+                        return QVariant();
                     }
+                    tmpValue = mProp.readOnGadget(parent.constData());
                 }
             }
         }
     }
 
-    if (tmpKeys.isEmpty())
-        return tmpValue;
-    return paramValueRecursive(tmpKeys.join("."), tmpValue);
+    return tmpValue;
 }
 
-QVariant QtTIParserArgs::evalParamMethod(QObject *object, const QMetaObject *mObj, const QString &funcName, const QVariantList &funcArgs)
+//!
+//! \brief Get index of the class property of the path segment
+//! \param segment Path segment
+//! \param mObj Class meta object
+//! \return -1 if the property is not found
+//!
+//! NOTE: The index is cached in the segment (see QtTIPropertyCache).
+//!
+int QtTIParserArgs::propertyIndex(const QtTIParamPath::Segment &segment, const QMetaObject *mObj)
 {
-    const QString funcArgsTypes = QtTIAbstractHelperFunction::typesToStr(QtTIAbstractHelperFunction::vListArgsTypes(funcArgs));
-    const QByteArray mNorSignature = QMetaObject::normalizedSignature(QString("%1(%2)").arg(funcName, funcArgsTypes).toStdString().c_str());
-    const int mIndex = mObj->indexOfMethod(mNorSignature);
-    if (mIndex == -1) {
-        qWarning() << qPrintable(QString("[QtTIParserArgs][evalParamMethod] Class method '%1::%2(%3)' not found!")
-                                 .arg(mObj->className(),
-                                      funcName,
-                                      funcArgsTypes));
-        return QVariant();
-    }
-    const QMetaMethod mMethod = mObj->method(mIndex);
-    if (mMethod.access() != QMetaMethod::Public) {
-        qWarning() << qPrintable(QString("[QtTIParserArgs][evalParamMethod] Class method '%1::%2(%3)' is not public!")
-                                 .arg(mObj->className(),
-                                      funcName,
-                                      funcArgsTypes));
-        return QVariant();
-    }
+    if (segment.propertyCache)
+        return segment.propertyCache->propertyIndex(mObj, segment.name);
+    return QtTIPropertyCache::findPropertyIndex(mObj, segment.name);
+}
 
-    const QList<QByteArray> mTypes = mMethod.parameterTypes();
-    if (mTypes.size() != funcArgs.size()) {
-        qWarning() << qPrintable(QString("[QtTIParserArgs][evalParamMethod] Invalid arguments count for class method '%1::%2(%3)'!")
-                                 .arg(mObj->className(),
-                                      funcName,
-                                      funcArgsTypes));
+//!
+//! \brief Call method of the QObject class
+//! \param object Class object
+//! \param mObj Class meta object
+//! \param segment Path segment (method name and the invocation plans cache)
+//! \param funcArgs Method arguments
+//! \return
+//!
+QVariant QtTIParserArgs::evalParamMethod(QObject *object, const QMetaObject *mObj, const QtTIParamPath::Segment &segment, const QVariantList &funcArgs)
+{
+    const std::shared_ptr<const QtTIMethodPlan> plan = methodPlan(segment, mObj, funcArgs);
+    QVariant convertedArgs[MaxMethodArgs];
+    QGenericArgument genericArgs[MaxMethodArgs];
+    if (!prepareMethodArgs(*plan, segment.name, funcArgs, convertedArgs, genericArgs))
         return QVariant();
-    }
 
-    QVariantList funcArgsConverted;
-    for (int i = 0; i < mTypes.size(); i++) {
-        const QVariant& arg = funcArgs.at(i);
-
-        const QByteArray methodTypeName = mTypes.at(i);
-        const QByteArray argTypeName = arg.typeName();
-        Q_UNUSED(argTypeName)
-
-        const QVariant::Type methodType = QVariant::nameToType(methodTypeName);
-        QVariant copy = QVariant(arg);
-
-        if (copy.type() != methodType) {
-            if (!copy.canConvert(methodType)
-                || !copy.convert(methodType)) {
-                qWarning() << qPrintable(QString("[QtTIParserArgs][evalParamMethod] Convert argument at index '%1' for class method '%2::%3(%4)' failed!")
-                                         .arg(i)
-                                         .arg(mObj->className(),
-                                              funcName,
-                                              funcArgsTypes));
-                return QVariant();
-            }
-        }
-        funcArgsConverted << copy;
-    }
-
-    QList<QGenericArgument> funcArgsGeneric;
-    for (int i = 0; i < funcArgsConverted.size(); i++) {
-        const QVariant& argument = funcArgsConverted[i];
-
-        // A const_cast is needed because calling data() would detach
-        // the QVariant.
-        QGenericArgument genericArgument(QMetaType::typeName(argument.userType()),
-                                         const_cast<void*>(argument.constData()));
-
-        funcArgsGeneric << genericArgument;
-    }
-
-    QVariant returnValue(QMetaType::type(mMethod.typeName()), static_cast<void*>(NULL));
-    QGenericReturnArgument returnArgument(mMethod.typeName(), const_cast<void*>(returnValue.constData()));
-    bool ok = mMethod.invoke(object,
-                             Qt::DirectConnection,
-                             returnArgument,
-                             funcArgsGeneric.value(0),
-                             funcArgsGeneric.value(1),
-                             funcArgsGeneric.value(2),
-                             funcArgsGeneric.value(3),
-                             funcArgsGeneric.value(4),
-                             funcArgsGeneric.value(5),
-                             funcArgsGeneric.value(6),
-                             funcArgsGeneric.value(7),
-                             funcArgsGeneric.value(8),
-                             funcArgsGeneric.value(9));
+    QVariant returnValue(plan->returnType, static_cast<void*>(NULL));
+    QGenericReturnArgument returnArgument(plan->returnTypeName, const_cast<void*>(returnValue.constData()));
+    bool ok = plan->method.invoke(object,
+                                  Qt::DirectConnection,
+                                  returnArgument,
+                                  genericArgs[0],
+                                  genericArgs[1],
+                                  genericArgs[2],
+                                  genericArgs[3],
+                                  genericArgs[4],
+                                  genericArgs[5],
+                                  genericArgs[6],
+                                  genericArgs[7],
+                                  genericArgs[8],
+                                  genericArgs[9]);
 
     if (!ok) {
-        qWarning() << qPrintable(QString("[QtTIParserArgs][paramValueRecursive] Call class method '%2::%3(%4)' failed!")
+        qWarning() << qPrintable(QString("[QtTIParserArgs][evalParamMethod] Call class method '%2::%3(%4)' failed!")
                                  .arg(mObj->className(),
-                                      funcName,
-                                      funcArgsTypes));
+                                      segment.name,
+                                      plan->argTypesStr));
         return QVariant();
     }
     return returnValue;
 }
 
-QVariant QtTIParserArgs::evalParamMethod(void *object, const QMetaObject *mObj, const QString &funcName, const QVariantList &funcArgs)
+//!
+//! \brief Call method of the gadget class
+//! \param object Class object
+//! \param mObj Class meta object
+//! \param segment Path segment (method name and the invocation plans cache)
+//! \param funcArgs Method arguments
+//! \return
+//!
+QVariant QtTIParserArgs::evalParamMethod(void *object, const QMetaObject *mObj, const QtTIParamPath::Segment &segment, const QVariantList &funcArgs)
 {
-    const QString funcArgsTypes = QtTIAbstractHelperFunction::typesToStr(QtTIAbstractHelperFunction::vListArgsTypes(funcArgs));
-    const QByteArray mNorSignature = QMetaObject::normalizedSignature(QString("%1(%2)").arg(funcName, funcArgsTypes).toStdString().c_str());
-    const int mIndex = mObj->indexOfMethod(mNorSignature);
-    if (mIndex == -1) {
-        qWarning() << qPrintable(QString("[QtTIParserArgs][evalParamMethod] Class method '%1::%2(%3)' not found!")
-                                 .arg(mObj->className(),
-                                      funcName,
-                                      funcArgsTypes));
+    const std::shared_ptr<const QtTIMethodPlan> plan = methodPlan(segment, mObj, funcArgs);
+    QVariant convertedArgs[MaxMethodArgs];
+    QGenericArgument genericArgs[MaxMethodArgs];
+    if (!prepareMethodArgs(*plan, segment.name, funcArgs, convertedArgs, genericArgs))
         return QVariant();
-    }
-    const QMetaMethod mMethod = mObj->method(mIndex);
-    if (mMethod.access() != QMetaMethod::Public) {
-        qWarning() << qPrintable(QString("[QtTIParserArgs][evalParamMethod] Class method '%1::%2(%3)' is not public!")
-                                 .arg(mObj->className(),
-                                      funcName,
-                                      funcArgsTypes));
-        return QVariant();
-    }
 
-    const QList<QByteArray> mTypes = mMethod.parameterTypes();
-    if (mTypes.size() != funcArgs.size()) {
-        qWarning() << qPrintable(QString("[QtTIParserArgs][evalParamMethod] Invalid arguments count for class method '%1::%2(%3)'!")
+    QVariant returnValue(plan->returnType, static_cast<void*>(NULL));
+    QGenericReturnArgument returnArgument(plan->returnTypeName, const_cast<void*>(returnValue.constData()));
+    bool ok = plan->method.invokeOnGadget(object,
+                                          returnArgument,
+                                          genericArgs[0],
+                                          genericArgs[1],
+                                          genericArgs[2],
+                                          genericArgs[3],
+                                          genericArgs[4],
+                                          genericArgs[5],
+                                          genericArgs[6],
+                                          genericArgs[7],
+                                          genericArgs[8],
+                                          genericArgs[9]);
+
+    if (!ok) {
+        qWarning() << qPrintable(QString("[QtTIParserArgs][evalParamMethod] Call class method '%2::%3(%4)' failed!")
                                  .arg(mObj->className(),
-                                      funcName,
-                                      funcArgsTypes));
+                                      segment.name,
+                                      plan->argTypesStr));
         return QVariant();
     }
+    return returnValue;
+}
 
-    QVariantList funcArgsConverted;
-    for (int i = 0; i < mTypes.size(); i++) {
-        const QVariant& arg = funcArgs.at(i);
-
-        const QByteArray methodTypeName = mTypes.at(i);
-        const QByteArray argTypeName = arg.typeName();
-        Q_UNUSED(argTypeName)
+//!
+//! \brief Get invocation plan of the class method of the path segment
+//! \param segment Path segment
+//! \param mObj Class meta object
+//! \param funcArgs Method arguments
+//! \return
+//!
+//! NOTE: The plan is cached in the segment (see QtTIMethodCache).
+//!
+std::shared_ptr<const QtTIMethodPlan> QtTIParserArgs::methodPlan(const QtTIParamPath::Segment &segment,
+                                                                  const QMetaObject *mObj,
+                                                                  const QVariantList &funcArgs)
+{
+    if (segment.methodCache)
+        return segment.methodCache->plan(mObj, segment.name, funcArgs);
+    return QtTIMethodCache::makePlan(mObj, segment.name, funcArgs);
+}
 
-        const QVariant::Type methodType = QVariant::nameToType(methodTypeName);
-        QVariant copy = QVariant(arg);
+//!
+//! \brief Convert method arguments by the invocation plan
+//! \param plan Invocation plan
+//! \param funcName Method name
+//! \param funcArgs Method arguments
+//! \param convertedArgs Converted arguments (only the arguments that need conversion)
+//! \param genericArgs Result arguments of the call
+//! \return
+//!
+bool QtTIParserArgs::prepareMethodArgs(const QtTIMethodPlan &plan,
+                                       const QString &funcName,
+                                       const QVariantList &funcArgs,
+                                       QVariant (&convertedArgs)[MaxMethodArgs],
+                                       QGenericArgument (&genericArgs)[MaxMethodArgs])
+{
+    if (!plan.error.isEmpty()) {
+        qWarning() << qPrintable(QString("[QtTIParserArgs][evalParamMethod] %1").arg(plan.error));
+        return false;
+    }
 
-        if (copy.type() != methodType) {
-            if (!copy.canConvert(methodType)
-                || !copy.convert(methodType)) {
+    const int argsCount = qMin(funcArgs.size(), static_cast<int>(MaxMethodArgs));
+    for (int i = 0; i < argsCount; i++) {
+        const QVariant *argument = &funcArgs.at(i);
+        const int convertType = plan.convertTypes.at(i);
+        if (convertType != QVariant::Invalid) {
+            convertedArgs[i] = funcArgs.at(i);
+            if (!convertedArgs[i].canConvert(convertType)
+                || !convertedArgs[i].convert(convertType)) {
                 qWarning() << qPrintable(QString("[QtTIParserArgs][evalParamMethod] Convert argument at index '%1' for class method '%2::%3(%4)' failed!")
                                          .arg(i)
-                                         .arg(mObj->className(),
+                                         .arg(plan.metaObject->className(),
                                               funcName,
-                                              funcArgsTypes));
-                return QVariant();
+                                              plan.argTypesStr));
+                return false;
             }
+            argument = &convertedArgs[i];
         }
-        funcArgsConverted << copy;
-    }
-
-    QList<QGenericArgument> funcArgsGeneric;
-    for (int i = 0; i < funcArgsConverted.size(); i++) {
-        const QVariant& argument = funcArgsConverted[i];
 
         // A const_cast is needed because calling data() would detach
         // the QVariant.
-        QGenericArgument genericArgument(QMetaType::typeName(argument.userType()),
-                                         const_cast<void*>(argument.constData()));
-
-        funcArgsGeneric << genericArgument;
-    }
-
-    QVariant returnValue(QMetaType::type(mMethod.typeName()), static_cast<void*>(NULL));
-    QGenericReturnArgument returnArgument(mMethod.typeName(), const_cast<void*>(returnValue.constData()));
-    bool ok = mMethod.invokeOnGadget(object,
-                                     returnArgument,
-                                     funcArgsGeneric.value(0),
-                                     funcArgsGeneric.value(1),
-                                     funcArgsGeneric.value(2),
-                                     funcArgsGeneric.value(3),
-                                     funcArgsGeneric.value(4),
-                                     funcArgsGeneric.value(5),
-                                     funcArgsGeneric.value(6),
-                                     funcArgsGeneric.value(7),
-                                     funcArgsGeneric.value(8),
-                                     funcArgsGeneric.value(9));
-
-    if (!ok) {
-        qWarning() << qPrintable(QString("[QtTIParserArgs][paramValueRecursive] Call class method '%2::%3(%4)' failed!")
-                                 .arg(mObj->className(),
-                                      funcName,
-                                      funcArgsTypes));
-        return QVariant();
+        genericArgs[i] = QGenericArgument(plan.paramTypeNames.at(i),
+                                          const_cast<void*>(argument->constData()));
     }
-    return returnValue;
+    return true;
 }
@@ -2,13 +2,17 @@
 #define QTTIPARSERARGS_H
 
 #include <QHash>
+#include <QVector>
+#include <memory>
 
 #include "Abstract/QtTIAbstractParserArgs.h"
 #include "Abstract/QtTIAbstractParserFunc.h"
+#include "Scope/QtTIScope.h"
 
 class QtTIParserArgs : public QtTIAbstractParserArgs
 {
     friend class QtTIParser;
+    friend class QtTIRenderContext;
 
 public:
     QtTIParserArgs();
@@ -19,14 +23,20 @@ public:
     void removeParam(const QString &paramName) final;
     bool hasParam(const QString& paramName) final;
     QVariant param(const QString& paramName) final;
+    std::tuple<bool/*isFound*/,QVariant/*res*/> findParam(const QtTIParamPath &path) final;
     void clearParams() final;
 
     void appendTmpParam(const QString& paramName, const QVariant &paramValue) final;
     void removeTmpParam(const QString& paramName) final;
     bool hasTmpParam(const QString& paramName) final;
     QVariant tmpParam(const QString& paramName) final;
+    std::tuple<bool/*isFound*/,QVariant/*res*/> findTmpParam(const QtTIParamPath &path) final;
     void clearTmpParams() final;
 
+    void setSlotValue(const int slot, const QVariant &value) final;
+    const QVariant &slotValue(const int slot) const final;
+    QVariant childParam(const QVariant &value, const QtTIParamPath &path) final;
+
     QVariantList parseHelpFunctionArgs(const QString &args, const QChar &delimiter = QChar(',')) final;
     QVariant prepareHelpFunctionArg(const QString &arg) final;
 
@@ -36,19 +46,37 @@ protected:
     }
 
 private:
+    static const int MaxMethodArgs = 10;    //!< max number of class method arguments (see QMetaMethod::invoke)
+
+    void setScope(const std::shared_ptr<const QtTIScope> &scope);
+    int tmpParamSlot(const QString &paramName) const;
+
     QStringList prepareArrayValues(const QString &arrayStr, const QChar &delimiter = QChar(','), const bool addQuotes = false);
     QMap<QString, QString> prepareMapKeysValues(const QString &mapStr, const QChar &delimiter = QChar(','));
     QPair<QString, QString> prepareMapKeyValue(const QString &mapKeyValueStr, const QString &delimiter = QString(":"));
     QString unescapeStr(const QString &value);
 
-    QVariant paramValueRecursive(const QString &key, const QVariant &parent);
-    QVariant evalParamMethod(QObject *object, const QMetaObject *mObj, const QString &funcName, const QVariantList &funcArgs);
-    QVariant evalParamMethod(void *object, const QMetaObject *mObj, const QString &funcName, const QVariantList &funcArgs);
+    static std::tuple<bool/*isFound*/,QVariant/*res*/> foundValue(const QVariant &value);
+    QVariant segmentValue(const QtTIParamPath::Segment &segment, const QVariant &parent);
+    static int propertyIndex(const QtTIParamPath::Segment &segment, const QMetaObject *mObj);
+    QVariant evalParamMethod(QObject *object, const QMetaObject *mObj, const QtTIParamPath::Segment &segment, const QVariantList &funcArgs);
+    QVariant evalParamMethod(void *object, const QMetaObject *mObj, const QtTIParamPath::Segment &segment, const QVariantList &funcArgs);
+    static std::shared_ptr<const QtTIMethodPlan> methodPlan(const QtTIParamPath::Segment &segment,
+                                                            const QMetaObject *mObj,
+                                                            const QVariantList &funcArgs);
+    static bool prepareMethodArgs(const QtTIMethodPlan &plan,
+                                  const QString &funcName,
+                                  const QVariantList &funcArgs,
+                                  QVariant (&convertedArgs)[MaxMethodArgs],
+                                  QGenericArgument (&genericArgs)[MaxMethodArgs]);
 
 private:
     QtTIAbstractParserFunc *_parserFunc {nullptr};  //!< parser func object pointer
+    const QtTIParserArgs *_sharedArgs {nullptr};    //!< shared args object pointer (read only params)
     QHash<QString, QVariant> _params;       //!< params array
     QHash<QString, QVariant> _tmpParams;    //!< tmp params array
+    std::shared_ptr<const QtTIScope> _scope;  //!< variable slots of the rendered template
+    QVector<QVariant> _slots;               //!< tmp params by slot index (see QtTIScope)
 };
 
 #endif // QTTIPARSERARGS_H
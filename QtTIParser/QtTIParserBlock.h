@@ -1,13 +1,13 @@
 #ifndef QTTIPARSERBLOCK_H
 #define QTTIPARSERBLOCK_H
 
-#include "../QtTIDefines/QtTIRegExpDefines.h"
+#include "RegExpRegistry/QtTIRegExpRegistry.h"
 #include "Abstract/QtTIAbstractParserBlock.h"
 #include "ControlBlockFabric/ControlBlocks/QtTIAbstractControlBlock.h"
 
 #include <QString>
 #include <QPair>
-#include <QRegExp>
+#include <QStringRef>
 #include <tuple>
 #include <memory>
 
@@ -98,14 +98,14 @@ public:
     //! \return
     //!
     bool isValidExpr() const final {
-        QRegExp rx(RX_BLOCK);
-        if (rx.indexIn(_data) != 0)
+        const QRegularExpressionMatch m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::Block, _data);
+        if (m.capturedStart() != 0)
             return false;
-        if (rx.captureCount() < 3)
+        if (m.lastCapturedIndex() < 3)
             return false;
-        if (rx.cap(1) == "{" && rx.cap(3) == "}")
+        if (m.capturedRef(1) == QLatin1String("{") && m.capturedRef(3) == QLatin1String("}"))
             return true;
-        return (rx.cap(1) == rx.cap(3));
+        return (m.capturedRef(1) == m.capturedRef(3));
     }
 
     //!
@@ -113,18 +113,20 @@ public:
     //! \return
     //!
     Type type() const final {
-        QRegExp rx(RX_BLOCK);
-        if (rx.indexIn(_data) != 0)
+        const QRegularExpressionMatch m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::Block, _data);
+        if (m.capturedStart() != 0)
             return Type::Invalid;
-        if (rx.captureCount() < 3)
+        if (m.lastCapturedIndex() < 3)
             return Type::Invalid;
-        if (rx.cap(1) == "{" && rx.cap(3) == "}")
+        const QStringRef open = m.capturedRef(1);
+        const QStringRef close = m.capturedRef(3);
+        if (open == QLatin1String("{") && close == QLatin1String("}"))
             return Type::Base;
-        else if (rx.cap(1) == "%"
-        && rx.cap(1) == rx.cap(3))
+        else if (open == QLatin1String("%")
+        && open == close)
             return Type::Control;
-        else if (rx.cap(1) == "#"
-        && rx.cap(1) == rx.cap(3))
+        else if (open == QLatin1String("#")
+        && open == close)
             return Type::Comment;
         return Type::Invalid;
     }
@@ -134,16 +136,17 @@ public:
     //! \return
     //!
     Type potentialType() const final {
-        QRegExp rx(RX_BLOCK_START);
-        if (rx.indexIn(_data) != 0)
+        const QRegularExpressionMatch m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::BlockStart, _data);
+        if (m.capturedStart() != 0)
             return Type::Invalid;
-        if (rx.captureCount() < 2)
+        if (m.lastCapturedIndex() < 2)
             return Type::Invalid;
-        if (rx.cap(1) == "{")
+        const QStringRef open = m.capturedRef(1);
+        if (open == QLatin1String("{"))
             return Type::Base;
-        else if (rx.cap(1) == "%")
+        else if (open == QLatin1String("%"))
             return Type::Control;
-        else if (rx.cap(1) == "#")
+        else if (open == QLatin1String("#"))
             return Type::Comment;
         return Type::Invalid;
     }
@@ -178,12 +181,12 @@ public:
     //! \return
     //!
     QString body() const final {
-        QRegExp rx(RX_BLOCK);
-        if (rx.indexIn(_data) != 0)
+        const QRegularExpressionMatch m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::Block, _data);
+        if (m.capturedStart() != 0)
             return QString();
-        if (rx.captureCount() < 3)
+        if (m.lastCapturedIndex() < 3)
             return QString();
-        return rx.cap(2);
+        return m.captured(2);
     }
 
     //!
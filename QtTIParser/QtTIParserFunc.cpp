@@ -8,6 +8,12 @@
 
 QtTIParserFunc::QtTIParserFunc()
 {
+    // the default functions have no side effects (see QtTIAbstractHelperFunction::isPure)
+    auto appendPureFunction = [this](QtTIAbstractHelperFunction *f) {
+        f->setPure(true);
+        appendHelpFunction(f);
+    };
+
     // add default functions
 
     //
@@ -17,7 +23,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // === Supported object: All
     //
-    appendHelpFunction(new QtTIHelperFunction<QVariant>("is_null", [](const QVariant &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariant>("is_null", [](const QVariant &d) {
         return d.isNull();
     }));
 
@@ -34,22 +40,22 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QVariantMap
     //      - QVariantHash
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray>("is_empty", [](const QByteArray &d) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray>("is_empty", [](const QByteArray &d) {
         return d.isEmpty();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString>("is_empty", [](const QString &d) {
+    appendPureFunction(new QtTIHelperFunction<QString>("is_empty", [](const QString &d) {
         return d.isEmpty();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QStringList>("is_empty", [](const QStringList &d) {
+    appendPureFunction(new QtTIHelperFunction<QStringList>("is_empty", [](const QStringList &d) {
         return d.isEmpty();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantList>("is_empty", [](const QVariantList &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantList>("is_empty", [](const QVariantList &d) {
         return d.isEmpty();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantMap>("is_empty", [](const QVariantMap &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantMap>("is_empty", [](const QVariantMap &d) {
         return d.isEmpty();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantHash>("is_empty", [](const QVariantHash &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantHash>("is_empty", [](const QVariantHash &d) {
         return d.isEmpty();
     }));
 
@@ -66,22 +72,22 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QVariantMap
     //      - QVariantHash
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray>("size", [](const QByteArray &d) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray>("size", [](const QByteArray &d) {
         return d.size();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString>("size", [](const QString &d) {
+    appendPureFunction(new QtTIHelperFunction<QString>("size", [](const QString &d) {
         return d.size();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QStringList>("size", [](const QStringList &d) {
+    appendPureFunction(new QtTIHelperFunction<QStringList>("size", [](const QStringList &d) {
         return d.size();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantList>("size", [](const QVariantList &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantList>("size", [](const QVariantList &d) {
         return d.size();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantMap>("size", [](const QVariantMap &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantMap>("size", [](const QVariantMap &d) {
         return d.size();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantHash>("size", [](const QVariantHash &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantHash>("size", [](const QVariantHash &d) {
         return d.size();
     }));
 
@@ -98,22 +104,22 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QVariantMap
     //      - QVariantHash
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray,QByteArray>("contains", [](const QByteArray &d, const QByteArray &key) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray,QByteArray>("contains", [](const QByteArray &d, const QByteArray &key) {
         return d.contains(key);
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString,QString>("contains", [](const QString &d, const QString &key) {
+    appendPureFunction(new QtTIHelperFunction<QString,QString>("contains", [](const QString &d, const QString &key) {
         return d.contains(key);
     }));
-    appendHelpFunction(new QtTIHelperFunction<QStringList,QString>("contains", [](const QStringList &d, const QString &key) {
+    appendPureFunction(new QtTIHelperFunction<QStringList,QString>("contains", [](const QStringList &d, const QString &key) {
         return d.contains(key);
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantList,QString>("contains", [](const QVariantList &d, const QString &key) {
+    appendPureFunction(new QtTIHelperFunction<QVariantList,QString>("contains", [](const QVariantList &d, const QString &key) {
         return d.contains(key);
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantMap,QString>("contains", [](const QVariantMap &d, const QString &key) {
+    appendPureFunction(new QtTIHelperFunction<QVariantMap,QString>("contains", [](const QVariantMap &d, const QString &key) {
         return d.contains(key);
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantHash,QString>("contains", [](const QVariantHash &d, const QString &key) {
+    appendPureFunction(new QtTIHelperFunction<QVariantHash,QString>("contains", [](const QVariantHash &d, const QString &key) {
         return d.contains(key);
     }));
 
@@ -126,11 +132,11 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QByteArray
     //      - QString
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray,QString>("reg_exp_match", [](const QByteArray &d, const QString &reg_exp) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray,QString>("reg_exp_match", [](const QByteArray &d, const QString &reg_exp) {
         QRegExp rx(reg_exp);
         return rx.exactMatch(QString::fromUtf8(d));
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString,QString>("reg_exp_match", [](const QString &d, const QString &reg_exp) {
+    appendPureFunction(new QtTIHelperFunction<QString,QString>("reg_exp_match", [](const QString &d, const QString &reg_exp) {
         QRegExp rx(reg_exp);
         return rx.exactMatch(d);
     }));
@@ -144,10 +150,10 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QByteArray
     //      - QString
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray,QByteArray>("starts_with", [](const QByteArray &d, const QByteArray &str) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray,QByteArray>("starts_with", [](const QByteArray &d, const QByteArray &str) {
         return d.startsWith(str);
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString,QString>("starts_with", [](const QString &d, const QString &str) {
+    appendPureFunction(new QtTIHelperFunction<QString,QString>("starts_with", [](const QString &d, const QString &str) {
         return d.startsWith(str);
     }));
 
@@ -160,10 +166,10 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QByteArray
     //      - QString
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray,QByteArray>("ends_with", [](const QByteArray &d, const QByteArray &str) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray,QByteArray>("ends_with", [](const QByteArray &d, const QByteArray &str) {
         return d.endsWith(str);
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString,QString>("ends_with", [](const QString &d, const QString &str) {
+    appendPureFunction(new QtTIHelperFunction<QString,QString>("ends_with", [](const QString &d, const QString &str) {
         return d.endsWith(str);
     }));
 
@@ -176,10 +182,10 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QByteArray
     //      - QString
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray,QByteArray>("index_of", [](const QByteArray &d, const QByteArray &str) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray,QByteArray>("index_of", [](const QByteArray &d, const QByteArray &str) {
         return d.indexOf(str);
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString,QString>("index_of", [](const QString &d, const QString &str) {
+    appendPureFunction(new QtTIHelperFunction<QString,QString>("index_of", [](const QString &d, const QString &str) {
         return d.indexOf(str);
     }));
 
@@ -192,10 +198,10 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QByteArray
     //      - QString
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray,QByteArray>("last_index_of", [](const QByteArray &d, const QByteArray &str) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray,QByteArray>("last_index_of", [](const QByteArray &d, const QByteArray &str) {
         return d.lastIndexOf(str);
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString,QString>("last_index_of", [](const QString &d, const QString &str) {
+    appendPureFunction(new QtTIHelperFunction<QString,QString>("last_index_of", [](const QString &d, const QString &str) {
         return d.lastIndexOf(str);
     }));
 
@@ -208,10 +214,10 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QByteArray
     //      - QString
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray,int>("left", [](const QByteArray &d, const int &size) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray,int>("left", [](const QByteArray &d, const int &size) {
         return d.left(size);
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString,int>("left", [](const QString &d, const int &size) {
+    appendPureFunction(new QtTIHelperFunction<QString,int>("left", [](const QString &d, const int &size) {
         return d.left(size);
     }));
 
@@ -224,10 +230,10 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QByteArray
     //      - QString
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray,int>("right", [](const QByteArray &d, const int &size) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray,int>("right", [](const QByteArray &d, const int &size) {
         return d.right(size);
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString,int>("right", [](const QString &d, const int &size) {
+    appendPureFunction(new QtTIHelperFunction<QString,int>("right", [](const QString &d, const int &size) {
         return d.right(size);
     }));
 
@@ -240,10 +246,10 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QVariantMap
     //      - QVariantHash
     //
-    appendHelpFunction(new QtTIHelperFunction<QVariantMap>("keys", [](const QVariantMap &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantMap>("keys", [](const QVariantMap &d) {
         return QVariant(d.keys());
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantHash>("keys", [](const QVariantHash &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantHash>("keys", [](const QVariantHash &d) {
         return QVariant(d.keys());
     }));
 
@@ -256,10 +262,10 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QVariantMap
     //      - QVariantHash
     //
-    appendHelpFunction(new QtTIHelperFunction<QVariantMap>("values", [](const QVariantMap &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantMap>("values", [](const QVariantMap &d) {
         return QVariant(d.values());
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantHash>("values", [](const QVariantHash &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantHash>("values", [](const QVariantHash &d) {
         return QVariant(d.values());
     }));
 
@@ -272,10 +278,10 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QVariantMap
     //      - QVariantHash
     //
-    appendHelpFunction(new QtTIHelperFunction<QVariantMap,QString>("value", [](const QVariantMap &d, const QString &key) {
+    appendPureFunction(new QtTIHelperFunction<QVariantMap,QString>("value", [](const QVariantMap &d, const QString &key) {
         return d.value(key, QVariant());
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantHash,QString>("value", [](const QVariantHash &d, const QString &key) {
+    appendPureFunction(new QtTIHelperFunction<QVariantHash,QString>("value", [](const QVariantHash &d, const QString &key) {
         return d.value(key, QVariant());
     }));
 
@@ -290,22 +296,22 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QStringList
     //      - QVariantList
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray,int>("value_at", [](const QByteArray &d, const int &pos) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray,int>("value_at", [](const QByteArray &d, const int &pos) {
         if (pos < 0 || pos >= d.size())
             return std::make_tuple(false, QChar(), "Invalid index!");
         return std::make_tuple(true, QChar::fromLatin1(d[pos]), "");
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString,int>("value_at", [](const QString &d, const int &pos) {
+    appendPureFunction(new QtTIHelperFunction<QString,int>("value_at", [](const QString &d, const int &pos) {
         if (pos < 0 || pos >= d.size())
             return std::make_tuple(false, QChar(), "Invalid index!");
         return std::make_tuple(true, d[pos], "");
     }));
-    appendHelpFunction(new QtTIHelperFunction<QStringList,int>("value_at", [](const QStringList &d, const int &pos) {
+    appendPureFunction(new QtTIHelperFunction<QStringList,int>("value_at", [](const QStringList &d, const int &pos) {
         if (pos < 0 || pos >= d.size())
             return std::make_tuple(false, QString(), "Invalid index!");
         return std::make_tuple(true, d[pos], "");
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantList,int>("value_at", [](const QVariantList &d, const int &pos) {
+    appendPureFunction(new QtTIHelperFunction<QVariantList,int>("value_at", [](const QVariantList &d, const int &pos) {
         if (pos < 0 || pos >= d.size())
             return std::make_tuple(false, QVariant(), "Invalid index!");
         return std::make_tuple(true, d[pos], "");
@@ -330,47 +336,47 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QVariantMap
     //      - QVariantHash
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray>("to_str", [](const QByteArray &d) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray>("to_str", [](const QByteArray &d) {
         return QString::fromUtf8(d);
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString>("to_str", [](const QString &d) {
+    appendPureFunction(new QtTIHelperFunction<QString>("to_str", [](const QString &d) {
         return d;
     }));
-    appendHelpFunction(new QtTIHelperFunction<int>("to_str", [](const int &d) {
+    appendPureFunction(new QtTIHelperFunction<int>("to_str", [](const int &d) {
         return QString::number(d);
     }));
-    appendHelpFunction(new QtTIHelperFunction<uint>("to_str", [](const uint &d) {
+    appendPureFunction(new QtTIHelperFunction<uint>("to_str", [](const uint &d) {
         return QString::number(d);
     }));
-    appendHelpFunction(new QtTIHelperFunction<double>("to_str", [](const double &d) {
+    appendPureFunction(new QtTIHelperFunction<double>("to_str", [](const double &d) {
         return QString::number(d);
     }));
-    appendHelpFunction(new QtTIHelperFunction<float>("to_str", [](const float &d) {
+    appendPureFunction(new QtTIHelperFunction<float>("to_str", [](const float &d) {
         return QString::number(d);
     }));
-    appendHelpFunction(new QtTIHelperFunction<qlonglong>("to_str", [](const qlonglong &d) {
+    appendPureFunction(new QtTIHelperFunction<qlonglong>("to_str", [](const qlonglong &d) {
         return QString::number(d);
     }));
-    appendHelpFunction(new QtTIHelperFunction<qulonglong>("to_str", [](const qulonglong &d) {
+    appendPureFunction(new QtTIHelperFunction<qulonglong>("to_str", [](const qulonglong &d) {
         return QString::number(d);
     }));
-    appendHelpFunction(new QtTIHelperFunction<QStringList>("to_str", [](const QStringList &d) {
+    appendPureFunction(new QtTIHelperFunction<QStringList>("to_str", [](const QStringList &d) {
         QJsonDocument jDoc = QJsonDocument::fromVariant(d);
         return QString::fromUtf8(jDoc.toJson(QJsonDocument::Compact));
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantList>("to_str", [](const QVariantList &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantList>("to_str", [](const QVariantList &d) {
         QJsonDocument jDoc = QJsonDocument::fromVariant(d);
         return QString::fromUtf8(jDoc.toJson(QJsonDocument::Compact));
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantMap>("to_str", [](const QVariantMap &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantMap>("to_str", [](const QVariantMap &d) {
         QJsonDocument jDoc = QJsonDocument::fromVariant(d);
         return QString::fromUtf8(jDoc.toJson(QJsonDocument::Compact));
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantHash>("to_str", [](const QVariantHash &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantHash>("to_str", [](const QVariantHash &d) {
         QJsonDocument jDoc = QJsonDocument::fromVariant(d);
         return QString::fromUtf8(jDoc.toJson(QJsonDocument::Compact));
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariant>("to_str", [](const QVariant &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariant>("to_str", [](const QVariant &d) {
         QJsonDocument jDoc = QJsonDocument::fromVariant(d);
         return QString::fromUtf8(jDoc.toJson(QJsonDocument::Compact));
     }));
@@ -386,22 +392,22 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QVariantMap
     //      - QVariantHash
     //
-    appendHelpFunction(new QtTIHelperFunction<QStringList>("first", [](const QStringList &d) {
+    appendPureFunction(new QtTIHelperFunction<QStringList>("first", [](const QStringList &d) {
         if (d.isEmpty())
             return QString();
         return d.first();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantList>("first", [](const QVariantList &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantList>("first", [](const QVariantList &d) {
         if (d.isEmpty())
             return QVariant();
         return d.first();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantMap>("first", [](const QVariantMap &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantMap>("first", [](const QVariantMap &d) {
         if (d.isEmpty())
             return QVariant();
         return d.first();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantHash>("first", [](const QVariantHash &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantHash>("first", [](const QVariantHash &d) {
         if (d.isEmpty())
             return QVariant();
         return d.values().first();
@@ -418,22 +424,22 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QVariantMap
     //      - QVariantHash
     //
-    appendHelpFunction(new QtTIHelperFunction<QStringList>("last", [](const QStringList &d) {
+    appendPureFunction(new QtTIHelperFunction<QStringList>("last", [](const QStringList &d) {
         if (d.isEmpty())
             return QString();
         return d.last();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantList>("last", [](const QVariantList &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantList>("last", [](const QVariantList &d) {
         if (d.isEmpty())
             return QVariant();
         return d.last();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantMap>("last", [](const QVariantMap &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantMap>("last", [](const QVariantMap &d) {
         if (d.isEmpty())
             return QVariant();
         return d.last();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantHash>("last", [](const QVariantHash &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantHash>("last", [](const QVariantHash &d) {
         if (d.isEmpty())
             return QVariant();
         return d.values().last();
@@ -448,12 +454,12 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QVariantMap
     //      - QVariantHash
     //
-    appendHelpFunction(new QtTIHelperFunction<QVariantMap>("first_key", [](const QVariantMap &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantMap>("first_key", [](const QVariantMap &d) {
         if (d.isEmpty())
             return QString();
         return d.keys().first();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantHash>("first_key", [](const QVariantHash &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantHash>("first_key", [](const QVariantHash &d) {
         if (d.isEmpty())
             return QString();
         return d.keys().first();
@@ -468,12 +474,12 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QVariantMap
     //      - QVariantHash
     //
-    appendHelpFunction(new QtTIHelperFunction<QVariantMap>("last_key", [](const QVariantMap &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantMap>("last_key", [](const QVariantMap &d) {
         if (d.isEmpty())
             return QString();
         return d.keys().last();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantHash>("last_key", [](const QVariantHash &d) {
+    appendPureFunction(new QtTIHelperFunction<QVariantHash>("last_key", [](const QVariantHash &d) {
         if (d.isEmpty())
             return QString();
         return d.keys().last();
@@ -488,10 +494,10 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QByteArray
     //      - QString
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray>("trim", [](const QByteArray &d) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray>("trim", [](const QByteArray &d) {
         return d.trimmed();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString>("trim", [](const QString &d) {
+    appendPureFunction(new QtTIHelperFunction<QString>("trim", [](const QString &d) {
         return d.trimmed();
     }));
 
@@ -504,12 +510,12 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QByteArray
     //      - QString
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray,QString>("split", [](const QByteArray &d, const QString &sep) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray,QString>("split", [](const QByteArray &d, const QString &sep) {
         if (sep.isEmpty() || sep.size() > 1)
             return std::make_tuple(false, QVariant(), "Invalid separator!");
         return std::make_tuple(true, QVariant::fromValue(d.split(sep[0].toLatin1())), "");
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString,QString>("split", [](const QString &d, const QString &sep) {
+    appendPureFunction(new QtTIHelperFunction<QString,QString>("split", [](const QString &d, const QString &sep) {
         if (sep.isEmpty())
             return std::make_tuple(false, QVariant(), "Invalid separator!");
         return std::make_tuple(true, QVariant::fromValue(d.split(sep)), "");
@@ -524,10 +530,10 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QByteArray
     //      - QString
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray>("to_lower", [](const QByteArray &d) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray>("to_lower", [](const QByteArray &d) {
         return d.toLower();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString>("to_lower", [](const QString &d) {
+    appendPureFunction(new QtTIHelperFunction<QString>("to_lower", [](const QString &d) {
         return d.toLower();
     }));
 
@@ -540,10 +546,10 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QByteArray
     //      - QString
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray>("to_upper", [](const QByteArray &d) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray>("to_upper", [](const QByteArray &d) {
         return d.toUpper();
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString>("to_upper", [](const QString &d) {
+    appendPureFunction(new QtTIHelperFunction<QString>("to_upper", [](const QString &d) {
         return d.toUpper();
     }));
 
@@ -556,12 +562,12 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QByteArrayList
     //      - QStringList
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArrayList,QByteArray>("join", [](const QByteArrayList &d, const QByteArray &sep) {
+    appendPureFunction(new QtTIHelperFunction<QByteArrayList,QByteArray>("join", [](const QByteArrayList &d, const QByteArray &sep) {
         if (sep.isEmpty())
             return std::make_tuple(false, QByteArray(), "Invalid separator!");
         return std::make_tuple(true, d.join(sep), "");
     }));
-    appendHelpFunction(new QtTIHelperFunction<QStringList,QString>("join", [](const QStringList &d, const QString &sep) {
+    appendPureFunction(new QtTIHelperFunction<QStringList,QString>("join", [](const QStringList &d, const QString &sep) {
         if (sep.isEmpty())
             return std::make_tuple(false, QString(), "Invalid separator!");
         return std::make_tuple(true, d.join(sep), "");
@@ -576,12 +582,12 @@ QtTIParserFunc::QtTIParserFunc()
     //      - int
     //      - uint
     //
-    appendHelpFunction(new QtTIHelperFunction<int,QString>("from_utc_time", [](const int &d, const QString &str_format) {
+    appendPureFunction(new QtTIHelperFunction<int,QString>("from_utc_time", [](const int &d, const QString &str_format) {
         if (str_format.isEmpty())
             return std::make_tuple(false, QString(), "Invalid string format!");
         return std::make_tuple(true, QDateTime::fromTime_t(d).toString(str_format), "");
     }));
-    appendHelpFunction(new QtTIHelperFunction<uint,QString>("from_utc_time", [](const uint &d, const QString &str_format) {
+    appendPureFunction(new QtTIHelperFunction<uint,QString>("from_utc_time", [](const uint &d, const QString &str_format) {
         if (str_format.isEmpty())
             return std::make_tuple(false, QString(), "Invalid string format!");
         return std::make_tuple(true, QDateTime::fromTime_t(d).toString(str_format), "");
@@ -600,15 +606,15 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QVariantMap
     //      - QVariantHash
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray,QByteArray,QByteArray>("replace", [](const QByteArray &d, const QByteArray &before, const QByteArray &after) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray,QByteArray,QByteArray>("replace", [](const QByteArray &d, const QByteArray &before, const QByteArray &after) {
         if (before == after)
             return d;
         return QByteArray(d).replace(before, after);
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString,QString,QString>("replace", [](const QString &d, const QString &before, const QString &after) {
+    appendPureFunction(new QtTIHelperFunction<QString,QString,QString>("replace", [](const QString &d, const QString &before, const QString &after) {
         return QString(d).replace(before, after);
     }));
-    appendHelpFunction(new QtTIHelperFunction<QStringList,QString,QString>("replace", [](const QStringList &d, const QString &before, const QString &after) {
+    appendPureFunction(new QtTIHelperFunction<QStringList,QString,QString>("replace", [](const QStringList &d, const QString &before, const QString &after) {
         if (before == after)
             return d;
         QStringList tmpLst(d);
@@ -620,7 +626,7 @@ QtTIParserFunc::QtTIParserFunc()
             tmpLst.replace(pos, after);
         }
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantList,QVariant,QVariant>("replace", [](const QVariantList &d, const QVariant &before, const QVariant &after) {
+    appendPureFunction(new QtTIHelperFunction<QVariantList,QVariant,QVariant>("replace", [](const QVariantList &d, const QVariant &before, const QVariant &after) {
         if (before == after)
             return d;
         QVariantList tmpLst(d);
@@ -632,7 +638,7 @@ QtTIParserFunc::QtTIParserFunc()
             tmpLst.replace(pos, after);
         }
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantMap,QVariant,QVariant>("replace", [](const QVariantMap &d, const QVariant &before, const QVariant &after) {
+    appendPureFunction(new QtTIHelperFunction<QVariantMap,QVariant,QVariant>("replace", [](const QVariantMap &d, const QVariant &before, const QVariant &after) {
         if (before == after)
             return d;
         QVariantMap tmpMap(d);
@@ -644,7 +650,7 @@ QtTIParserFunc::QtTIParserFunc()
             tmpMap.insert(key, after);
         }
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantHash,QVariant,QVariant>("replace", [](const QVariantHash &d, const QVariant &before, const QVariant &after) {
+    appendPureFunction(new QtTIHelperFunction<QVariantHash,QVariant,QVariant>("replace", [](const QVariantHash &d, const QVariant &before, const QVariant &after) {
         if (before == after)
             return d;
         QVariantHash tmpMap(d);
@@ -670,7 +676,7 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QVariantMap
     //      - QVariantHash
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray,QByteArray>("remove", [](const QByteArray &d, const QByteArray &str) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray,QByteArray>("remove", [](const QByteArray &d, const QByteArray &str) {
         QByteArray tmpBa(d);
         int pos = 0;
         while ((pos = tmpBa.indexOf(str)) != -1) {
@@ -678,10 +684,10 @@ QtTIParserFunc::QtTIParserFunc()
         }
         return tmpBa;
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString,QString>("remove", [](const QString &d, const QString &str) {
+    appendPureFunction(new QtTIHelperFunction<QString,QString>("remove", [](const QString &d, const QString &str) {
         return QString(d).remove(str);
     }));
-    appendHelpFunction(new QtTIHelperFunction<QStringList,QString>("remove", [](const QStringList &d, const QString &value) {
+    appendPureFunction(new QtTIHelperFunction<QStringList,QString>("remove", [](const QStringList &d, const QString &value) {
         QStringList tmpLst(d);
         int pos = 0;
         while (true) {
@@ -691,7 +697,7 @@ QtTIParserFunc::QtTIParserFunc()
             tmpLst.removeAt(pos);
         }
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantList,QVariant>("remove", [](const QVariantList &d, const QVariant &value) {
+    appendPureFunction(new QtTIHelperFunction<QVariantList,QVariant>("remove", [](const QVariantList &d, const QVariant &value) {
         QVariantList tmpLst(d);
         int pos = 0;
         while (true) {
@@ -701,7 +707,7 @@ QtTIParserFunc::QtTIParserFunc()
             tmpLst.removeAt(pos);
         }
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantMap,QString>("remove", [](const QVariantMap &d, const QVariant &value) {
+    appendPureFunction(new QtTIHelperFunction<QVariantMap,QString>("remove", [](const QVariantMap &d, const QVariant &value) {
         QVariantMap tmpMap(d);
         while (true) {
             const QString key = tmpMap.key(value, QString());
@@ -710,7 +716,7 @@ QtTIParserFunc::QtTIParserFunc()
             tmpMap.remove(key);
         }
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantHash,QString>("remove", [](const QVariantHash &d, const QVariant &value) {
+    appendPureFunction(new QtTIHelperFunction<QVariantHash,QString>("remove", [](const QVariantHash &d, const QVariant &value) {
         QVariantHash tmpMap(d);
         while (true) {
             const QString key = tmpMap.key(value, QString());
@@ -729,14 +735,14 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QVariantMap
     //      - QVariantHash
     //
-    appendHelpFunction(new QtTIHelperFunction<QVariantMap,QString>("remove_key", [](const QVariantMap &d, const QString &key) {
+    appendPureFunction(new QtTIHelperFunction<QVariantMap,QString>("remove_key", [](const QVariantMap &d, const QString &key) {
         if (!d.contains(key))
             return d;
         QVariantMap tmpMap(d);
         tmpMap.remove(key);
         return tmpMap;
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantHash,QString>("remove_key", [](const QVariantHash &d, const QString &key) {
+    appendPureFunction(new QtTIHelperFunction<QVariantHash,QString>("remove_key", [](const QVariantHash &d, const QString &key) {
         if (!d.contains(key))
             return d;
         QVariantHash tmpMap(d);
@@ -755,18 +761,18 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QStringList
     //      - QVariantList
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray,QByteArray>("append", [](const QByteArray &d, const QByteArray &str) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray,QByteArray>("append", [](const QByteArray &d, const QByteArray &str) {
         return QByteArray(d).append(str);
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString,QString>("append", [](const QString &d, const QString &str) {
+    appendPureFunction(new QtTIHelperFunction<QString,QString>("append", [](const QString &d, const QString &str) {
         return QString(d).append(str);
     }));
-    appendHelpFunction(new QtTIHelperFunction<QStringList,QString>("append", [](const QStringList &d, const QString &value) {
+    appendPureFunction(new QtTIHelperFunction<QStringList,QString>("append", [](const QStringList &d, const QString &value) {
         QStringList tmpLst(d);
         tmpLst.append(value);
         return tmpLst;
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantList,QVariant>("append", [](const QVariantList &d, const QVariant &value) {
+    appendPureFunction(new QtTIHelperFunction<QVariantList,QVariant>("append", [](const QVariantList &d, const QVariant &value) {
         QVariantList tmpLst(d);
         tmpLst.append(value);
         return tmpLst;
@@ -781,12 +787,12 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QVariantMap
     //      - QVariantHash
     //
-    appendHelpFunction(new QtTIHelperFunction<QVariantMap,QString,QVariant>("append", [](const QVariantMap &d, const QString &key, const QVariant &value) {
+    appendPureFunction(new QtTIHelperFunction<QVariantMap,QString,QVariant>("append", [](const QVariantMap &d, const QString &key, const QVariant &value) {
         QVariantMap tmpMap(d);
         tmpMap.insert(key, value);
         return tmpMap;
     }));
-    appendHelpFunction(new QtTIHelperFunction<QVariantHash,QString,QVariant>("append", [](const QVariantHash &d, const QString &key, const QVariant &value) {
+    appendPureFunction(new QtTIHelperFunction<QVariantHash,QString,QVariant>("append", [](const QVariantHash &d, const QString &key, const QVariant &value) {
         QVariantHash tmpHash(d);
         tmpHash.insert(key, value);
         return tmpHash;
@@ -797,7 +803,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [QString] str_concat(str_1, str_2)
     //
-    appendHelpFunction(new QtTIHelperFunction<QString,QString>("str_concat", [](const QString &str_1, const QString &str_2) {
+    appendPureFunction(new QtTIHelperFunction<QString,QString>("str_concat", [](const QString &str_1, const QString &str_2) {
         return str_1 + str_2;
     }));
 
@@ -806,7 +812,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [bool] str_compare(str_1, str_2)
     //
-    appendHelpFunction(new QtTIHelperFunction<QString,QString>("str_compare", [](const QString &str_1, const QString &str_2) {
+    appendPureFunction(new QtTIHelperFunction<QString,QString>("str_compare", [](const QString &str_1, const QString &str_2) {
         return str_1 == str_2;
     }));
 
@@ -815,7 +821,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [double] round(value)
     //
-    appendHelpFunction(new QtTIHelperFunction<double>("round", [](const double &value) {
+    appendPureFunction(new QtTIHelperFunction<double>("round", [](const double &value) {
         return round(value);
     }));
 
@@ -824,7 +830,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [float] round(value)
     //
-    appendHelpFunction(new QtTIHelperFunction<float>("round", [](const float &value) {
+    appendPureFunction(new QtTIHelperFunction<float>("round", [](const float &value) {
         return roundf(value);
     }));
 
@@ -833,7 +839,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [double] floor(value)
     //
-    appendHelpFunction(new QtTIHelperFunction<double>("floor", [](const double &value) {
+    appendPureFunction(new QtTIHelperFunction<double>("floor", [](const double &value) {
         return floor(value);
     }));
 
@@ -842,7 +848,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [float] floor(value)
     //
-    appendHelpFunction(new QtTIHelperFunction<float>("floor", [](const float &value) {
+    appendPureFunction(new QtTIHelperFunction<float>("floor", [](const float &value) {
         return floorf(value);
     }));
 
@@ -851,7 +857,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [double] ceil(value)
     //
-    appendHelpFunction(new QtTIHelperFunction<double>("ceil", [](const double &value) {
+    appendPureFunction(new QtTIHelperFunction<double>("ceil", [](const double &value) {
         return ceil(value);
     }));
 
@@ -860,7 +866,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [float] ceil(value)
     //
-    appendHelpFunction(new QtTIHelperFunction<float>("ceil", [](const float &value) {
+    appendPureFunction(new QtTIHelperFunction<float>("ceil", [](const float &value) {
         return ceilf(value);
     }));
 
@@ -869,7 +875,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [int] to_int(value)
     //
-    appendHelpFunction(new QtTIHelperFunction<QVariant>("to_int", [](const QVariant &value) {
+    appendPureFunction(new QtTIHelperFunction<QVariant>("to_int", [](const QVariant &value) {
         return value.toInt();
     }));
 
@@ -878,7 +884,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [uint] to_uint(value)
     //
-    appendHelpFunction(new QtTIHelperFunction<QVariant>("to_uint", [](const QVariant &value) {
+    appendPureFunction(new QtTIHelperFunction<QVariant>("to_uint", [](const QVariant &value) {
         return value.toUInt();
     }));
 
@@ -887,7 +893,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [double] to_double(value)
     //
-    appendHelpFunction(new QtTIHelperFunction<QVariant>("to_double", [](const QVariant &value) {
+    appendPureFunction(new QtTIHelperFunction<QVariant>("to_double", [](const QVariant &value) {
         return value.toDouble();
     }));
 
@@ -896,7 +902,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [float] to_float(value)
     //
-    appendHelpFunction(new QtTIHelperFunction<QVariant>("to_float", [](const QVariant &value) {
+    appendPureFunction(new QtTIHelperFunction<QVariant>("to_float", [](const QVariant &value) {
         return value.toFloat();
     }));
 
@@ -905,7 +911,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [longlong] to_long_long(value)
     //
-    appendHelpFunction(new QtTIHelperFunction<QVariant>("to_long_long", [](const QVariant &value) {
+    appendPureFunction(new QtTIHelperFunction<QVariant>("to_long_long", [](const QVariant &value) {
         return value.toLongLong();
     }));
 
@@ -914,7 +920,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [ulonglong] to_ulong_long(value)
     //
-    appendHelpFunction(new QtTIHelperFunction<QVariant>("to_ulong_long", [](const QVariant &value) {
+    appendPureFunction(new QtTIHelperFunction<QVariant>("to_ulong_long", [](const QVariant &value) {
         return value.toULongLong();
     }));
 
@@ -923,7 +929,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [RegExp] make_reg_exp(pattern)
     //
-    appendHelpFunction(new QtTIHelperFunction<QString>("make_reg_exp", [](const QString &pattern) {
+    appendPureFunction(new QtTIHelperFunction<QString>("make_reg_exp", [](const QString &pattern) {
         return QVariant::fromValue(RegExp(pattern));
     }));
 
@@ -932,7 +938,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [int] str_to_int(value, base)
     //
-    appendHelpFunction(new QtTIHelperFunction<QString,int>("str_to_int", [](const QString &value, const int base) {
+    appendPureFunction(new QtTIHelperFunction<QString,int>("str_to_int", [](const QString &value, const int base) {
         return value.toInt(nullptr, base);
     }));
 
@@ -941,7 +947,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [uint] str_to_uint(value, base)
     //
-    appendHelpFunction(new QtTIHelperFunction<QString,int>("str_to_uint", [](const QString &value, const int base) {
+    appendPureFunction(new QtTIHelperFunction<QString,int>("str_to_uint", [](const QString &value, const int base) {
         return value.toUInt(nullptr, base);
     }));
 
@@ -950,7 +956,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [long] str_to_long(value, base)
     //
-    appendHelpFunction(new QtTIHelperFunction<QString,int>("str_to_long", [](const QString &value, const int base) {
+    appendPureFunction(new QtTIHelperFunction<QString,int>("str_to_long", [](const QString &value, const int base) {
         return QVariant::fromValue(value.toLong(nullptr, base));
     }));
 
@@ -959,7 +965,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [ulong] str_to_ulong(value, base)
     //
-    appendHelpFunction(new QtTIHelperFunction<QString,int>("str_to_ulong", [](const QString &value, const int base) {
+    appendPureFunction(new QtTIHelperFunction<QString,int>("str_to_ulong", [](const QString &value, const int base) {
         return QVariant::fromValue(value.toULong(nullptr, base));
     }));
 
@@ -968,7 +974,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [longlong] str_to_long_long(value, base)
     //
-    appendHelpFunction(new QtTIHelperFunction<QString,int>("str_to_long_long", [](const QString &value, const int base) {
+    appendPureFunction(new QtTIHelperFunction<QString,int>("str_to_long_long", [](const QString &value, const int base) {
         return value.toLongLong(nullptr, base);
     }));
 
@@ -977,7 +983,7 @@ QtTIParserFunc::QtTIParserFunc()
     //
     // [ulonglong] str_to_ulong_long(value, base)
     //
-    appendHelpFunction(new QtTIHelperFunction<QString,int>("str_to_ulong_long", [](const QString &value, const int base) {
+    appendPureFunction(new QtTIHelperFunction<QString,int>("str_to_ulong_long", [](const QString &value, const int base) {
         return value.toULongLong(nullptr, base);
     }));
 
@@ -994,7 +1000,7 @@ QtTIParserFunc::QtTIParserFunc()
     //      - QByteArray
     //      - QString
     //
-    appendHelpFunction(new QtTIHelperFunction<QByteArray>("escape_special_block", [](const QByteArray &d) {
+    appendPureFunction(new QtTIHelperFunction<QByteArray>("escape_special_block", [](const QByteArray &d) {
         QByteArray tmp(d);
         return tmp.replace("{{", "\\{\\{")
                   .replace("}}", "\\}\\}")
@@ -1003,7 +1009,7 @@ QtTIParserFunc::QtTIParserFunc()
                   .replace("{#", "\\{\\#")
                   .replace("#}", "\\#\\}");
     }));
-    appendHelpFunction(new QtTIHelperFunction<QString>("escape_special_block", [](const QString &d) {
+    appendPureFunction(new QtTIHelperFunction<QString>("escape_special_block", [](const QString &d) {
         QString tmp(d);
         return tmp.replace("{{", "\\{\\{")
                   .replace("}}", "\\}\\}")
@@ -1048,7 +1054,7 @@ void QtTIParserFunc::appendHelpFunction(const QtTIAbstractHelperFunction *func)
     if (_functions.contains(func->name())) {
         const QList<const QtTIAbstractHelperFunction *> funcLst = _functions.values(func->name());
         for (const QtTIAbstractHelperFunction *f : funcLst) {
-            if (f->neededArgsTypes() == func->neededArgsTypes()) {
+            if (f->neededArgsTypeIds() == func->neededArgsTypeIds()) {
                 qWarning() << qPrintable(QString("[QtTIParserFunc][appendHelpFunction] Help function already added (func: \"%1\")!")
                                          .arg(func->fullName()));
                 delete func;
@@ -1057,6 +1063,7 @@ void QtTIParserFunc::appendHelpFunction(const QtTIAbstractHelperFunction *func)
         }
     }
     _functions.insert(func->name(), func);
+    _revision++;
 }
 
 //!
@@ -1080,6 +1087,7 @@ void QtTIParserFunc::removeHelpFunction(const QString &funcName, const QVariantL
     if (!f)
         return;
     _functions.remove(funcName, f);
+    _revision++;
     delete f;
 }
 
@@ -1104,20 +1112,22 @@ bool QtTIParserFunc::hasHelpFunction(const QString &funcName, const QVariantList
 //!
 const QtTIAbstractHelperFunction *QtTIParserFunc::findHelpFunction(const QString &funcName, const QVariantList &args, const bool strictArgs) const
 {
-    if (!_functions.contains(funcName))
+    QMultiHash<QString, const QtTIAbstractHelperFunction *>::const_iterator it = _functions.constFind(funcName);
+    if (it == _functions.constEnd())
         return nullptr;
-    const QStringList argsTypes = QtTIAbstractHelperFunction::vListArgsTypes(args);
-    const QList<const QtTIAbstractHelperFunction *> funcLst = _functions.values(funcName);
+    const QVector<int> argsTypeIds = QtTIAbstractHelperFunction::vListArgsTypeIds(args);
     // search strict args
-    for (const QtTIAbstractHelperFunction *f : funcLst) {
-        if (f->neededArgsTypes() == argsTypes)
-            return f;
+    for (QMultiHash<QString, const QtTIAbstractHelperFunction *>::const_iterator f = it;
+         f != _functions.constEnd() && f.key() == funcName; ++f) {
+        if (f.value()->neededArgsTypeIds() == argsTypeIds)
+            return f.value();
     }
     // search can convert args
     if (!strictArgs) {
-        for (const QtTIAbstractHelperFunction *f : funcLst) {
-            if (f->canConvertArgsTypes(args))
-                return f;
+        for (QMultiHash<QString, const QtTIAbstractHelperFunction *>::const_iterator f = it;
+             f != _functions.constEnd() && f.key() == funcName; ++f) {
+            if (f.value()->canConvertArgsTypes(args))
+                return f.value();
         }
     }
     return nullptr;
@@ -1140,7 +1150,7 @@ std::tuple<bool, QVariant, QString> QtTIParserFunc::evalHelpFunction(const QStri
                                .arg(funcName,
                                     QtTIAbstractHelperFunction::typesToStr(QtTIAbstractHelperFunction::vListArgsTypes(args))));
 
-    return f->evalFunction(args);
+    return f->callFunction(args);
 }
 
 //!
@@ -1150,4 +1160,5 @@ void QtTIParserFunc::clearFunctions()
 {
     qDeleteAll(_functions);
     _functions.clear();
+    _revision++;
 }
@@ -21,8 +21,15 @@ public:
 
     void clearFunctions() final;
 
+    //!
+    //! \brief Get revision of the functions list
+    //! \return
+    //!
+    int revision() const final { return _revision; }
+
 private:
     QMultiHash<QString, const QtTIAbstractHelperFunction *> _functions; //!< functions array
+    int _revision {0};                                                  //!< revision of the functions list
 };
 
 #endif // QTTIPARSERFUNC_H
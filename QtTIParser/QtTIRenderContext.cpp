@@ -0,0 +1,24 @@
+#include "QtTIRenderContext.h"
+
+QtTIRenderContext::QtTIRenderContext(const QtTIParserArgs *sharedArgs)
+    : QtTIParserArgs()
+{
+    if (sharedArgs) {
+        setTIParserFunc(sharedArgs->_parserFunc);
+        _sharedArgs = sharedArgs;
+    }
+}
+
+QtTIRenderContext::~QtTIRenderContext()
+{
+    _sharedArgs = nullptr;
+}
+
+//!
+//! \brief Get shared (interpreter) args object pointer
+//! \return
+//!
+const QtTIParserArgs *QtTIRenderContext::sharedArgs() const
+{
+    return _sharedArgs;
+}
@@ -0,0 +1,33 @@
+#ifndef QTTIRENDERCONTEXT_H
+#define QTTIRENDERCONTEXT_H
+
+#include "QtTIParserArgs.h"
+
+//!
+//! \brief The QtTIRenderContext class
+//!
+//! Variables of one render: parameters passed for this render, loop and 'set' variables
+//! and intermediate values of expressions. The global parameters and the help functions
+//! of the interpreter are only read (not copied), so the context is lightweight and one
+//! interpreter can render in several threads at once, each thread with its own context.
+//!
+//! Parameters of the context hide the global parameters with the same name.
+//!
+//! NOTE: Do not use one context in several threads at the same time and do not change
+//! the global parameters and the help functions of the interpreter while rendering.
+//!
+//! === Example:
+//!     QtTIRenderContext context = QtTemplateBuilder.createRenderContext();
+//!     context.appendParam("user_name", "John");
+//!     QString res = QtTemplateBuilder.renderRes(tmpl, context);
+//!
+class QtTIRenderContext : public QtTIParserArgs
+{
+public:
+    explicit QtTIRenderContext(const QtTIParserArgs *sharedArgs = nullptr);
+    virtual ~QtTIRenderContext();
+
+    const QtTIParserArgs *sharedArgs() const;
+};
+
+#endif // QTTIRENDERCONTEXT_H
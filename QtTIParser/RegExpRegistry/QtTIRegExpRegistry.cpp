@@ -0,0 +1,90 @@
+#include "QtTIRegExpRegistry.h"
+#include "../../QtTIDefines/QtTIRegExpDefines.h"
+
+QtTIRegExpRegistry::QtTIRegExpRegistry()
+{
+    const char *patterns[Count] = {
+        RX_BLOCK,
+        RX_BLOCK_START,
+        RX_FUNC,
+        RX_PARAM,
+        RX_STRING,
+        RX_TYPE_STR,
+        RX_TYPE_INT,
+        RX_TYPE_DOUBLE,
+        RX_TYPE_BOOL,
+        RX_TYPE_ARRAY,
+        RX_TYPE_HASH,
+        RX_TYPE_HASH_DELIMITER,
+        RX_STR_ESCAPE_v1,
+        RX_STR_ESCAPE_v2,
+        RX_TERNARY_v1,
+        RX_TERNARY_v2,
+        RX_TERNARY_v3,
+        RX_NULL_COALESCING,
+        RX_MATH_OP,
+        RX_LOGIC_v1,
+        RX_LOGIC_v2,
+        RX_CONTROL_BLOCK_FOR_START,
+        RX_CONTROL_BLOCK_FOR_END,
+        RX_CONTROL_BLOCK_IF_START,
+        RX_CONTROL_BLOCK_ELSE_IF_START,
+        RX_CONTROL_BLOCK_ELSE,
+        RX_CONTROL_BLOCK_IF_END,
+        RX_CONTROL_BLOCK_SET,
+        RX_CONTROL_BLOCK_UNSET
+    };
+
+    const QRegularExpression::PatternOptions options = QRegularExpression::DotMatchesEverythingOption
+                                                       | QRegularExpression::UseUnicodePropertiesOption;
+    for (int i = 0; i < Count; ++i) {
+        _rx[i] = QRegularExpression(QString::fromLatin1(patterns[i]), options);
+        Q_ASSERT_X(_rx[i].isValid(), "QtTIRegExpRegistry", qPrintable(_rx[i].errorString()));
+        _rx[i].optimize();
+    }
+}
+
+//!
+//! \brief Compile all regular expressions (if not compiled yet)
+//!
+//! NOTE: Call it at startup to avoid the compilation delay on the first render.
+//!
+void QtTIRegExpRegistry::init()
+{
+    instance();
+}
+
+//!
+//! \brief Get precompiled regular expression
+//! \param id Regular expression id
+//! \return
+//!
+const QRegularExpression &QtTIRegExpRegistry::get(const Id id)
+{
+    Q_ASSERT(id >= 0 && id < Count);
+    return instance()._rx[id];
+}
+
+//!
+//! \brief Match string with precompiled regular expression
+//! \param id Regular expression id
+//! \param str String
+//! \param offset Start position in string
+//! \return
+//!
+//! NOTE: 'capturedStart()' of the result is equal to 'QRegExp::indexIn' (-1 if not matched).
+//!
+QRegularExpressionMatch QtTIRegExpRegistry::match(const Id id, const QString &str, const int offset)
+{
+    return get(id).match(str, offset);
+}
+
+//!
+//! \brief Get registry object (created on the first call, the initialization is thread-safe)
+//! \return
+//!
+const QtTIRegExpRegistry &QtTIRegExpRegistry::instance()
+{
+    static const QtTIRegExpRegistry registry;
+    return registry;
+}
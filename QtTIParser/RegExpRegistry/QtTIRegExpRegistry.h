@@ -0,0 +1,77 @@
+#ifndef QTTIREGEXPREGISTRY_H
+#define QTTIREGEXPREGISTRY_H
+
+#include <QString>
+#include <QRegularExpression>
+#include <QRegularExpressionMatch>
+
+//!
+//! \brief The QtTIRegExpRegistry class
+//!
+//! Precompiled regular expressions of the interpreter (see QtTIRegExpDefines.h).
+//! All expressions are compiled and optimized (JIT) once, on the first use of the registry
+//! (QtTemplateInterpreter calls 'init' in the constructor), and then shared by all parsers
+//! and threads. QRegularExpression is reentrant and 'match' does not change the expression,
+//! the match state is returned in QRegularExpressionMatch.
+//!
+//! The expressions are compiled with the options compatible with QRegExp: '.' matches
+//! any character (including newline) and '\w', '\s', '\d' match unicode characters.
+//!
+//! === Example:
+//!     const QRegularExpressionMatch m = QtTIRegExpRegistry::match(QtTIRegExpRegistry::Func, str);
+//!     if (m.hasMatch())
+//!         funcName = m.captured(2).trimmed();
+//!
+class QtTIRegExpRegistry
+{
+public:
+    //!
+    //! \brief Regular expression id (RX_* define)
+    //!
+    enum Id {
+        Block = 0,
+        BlockStart,
+        Func,
+        Param,
+        String,
+        TypeStr,
+        TypeInt,
+        TypeDouble,
+        TypeBool,
+        TypeArray,
+        TypeHash,
+        TypeHashDelimiter,
+        StrEscape_v1,
+        StrEscape_v2,
+        Ternary_v1,
+        Ternary_v2,
+        Ternary_v3,
+        NullCoalescing,
+        MathOp,
+        Logic_v1,
+        Logic_v2,
+        ControlBlockForStart,
+        ControlBlockForEnd,
+        ControlBlockIfStart,
+        ControlBlockElseIfStart,
+        ControlBlockElse,
+        ControlBlockIfEnd,
+        ControlBlockSet,
+        ControlBlockUnset,
+        Count
+    };
+
+    static void init();
+    static const QRegularExpression &get(const Id id);
+    static QRegularExpressionMatch match(const Id id, const QString &str, const int offset = 0);
+
+private:
+    QtTIRegExpRegistry();
+    ~QtTIRegExpRegistry() = default;
+
+    static const QtTIRegExpRegistry &instance();
+
+    QRegularExpression _rx[Count];  //!< precompiled expressions by id
+};
+
+#endif // QTTIREGEXPREGISTRY_H
@@ -0,0 +1,111 @@
+#include "QtTIFunctionCache.h"
+
+#include <QMutexLocker>
+
+//!
+//! \brief Get help function overload for the arguments (cached)
+//! \param parserFunc Help functions
+//! \param funcName Function name
+//! \param args Function arguments
+//! \return NULL if the function is not found
+//!
+const QtTIAbstractHelperFunction *QtTIFunctionCache::function(const QtTIAbstractParserFunc *parserFunc,
+                                                              const QString &funcName,
+                                                              const QVariantList &args) const
+{
+    const QVector<int> argsTypeIds = QtTIAbstractHelperFunction::vListArgsTypeIds(args);
+    const int revision = parserFunc->revision();
+    const int entryCount = _entryCount.load(std::memory_order_acquire);
+    bool hasStaleEntry = false;
+    for (int i = 0; i < entryCount; i++) {
+        const std::shared_ptr<const Entry> entry = std::atomic_load(&_entries[i]);
+        if (entry->parserFunc != parserFunc)
+            continue;
+        if (entry->revision != revision) {
+            hasStaleEntry = true;
+            continue;
+        }
+        if (entry->argsTypeIds == argsTypeIds) {
+            if (entry->isStrict
+                || entry->function->canConvertArgsTypes(args))
+                return entry->function;
+            break;
+        }
+    }
+
+    const QtTIAbstractHelperFunction *f = parserFunc->findHelpFunction(funcName, args);
+    if (!f || (entryCount >= MaxEntries && !hasStaleEntry))
+        return f;
+
+    QMutexLocker locker(&_mutex);
+    const int n = _entryCount.load(std::memory_order_relaxed);
+    int index = -1;
+    for (int i = 0; i < n; i++) {
+        // the entries are replaced only under the mutex
+        const Entry *entry = _entries[i].get();
+        if (entry->parserFunc != parserFunc)
+            continue;
+        if (entry->revision == revision) {
+            if (entry->argsTypeIds == argsTypeIds)
+                return f;
+        } else if (index == -1) {
+            // the entry of the previous revision of the functions list is replaced
+            index = i;
+        }
+    }
+    if (index == -1) {
+        if (n >= MaxEntries)
+            return f;
+        index = n;
+    }
+
+    std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+    entry->parserFunc = parserFunc;
+    entry->revision = revision;
+    entry->argsTypeIds = argsTypeIds;
+    entry->function = f;
+    entry->isStrict = (f->neededArgsTypeIds() == argsTypeIds);
+    // the replaced entry is released by the last reader
+    std::atomic_store(&_entries[index], std::shared_ptr<const Entry>(entry));
+    if (index == n)
+        _entryCount.store(n + 1, std::memory_order_release);
+    return f;
+}
+
+//!
+//! \brief Get cached result of the call with constant arguments
+//! \param parserFunc Help functions
+//! \param[out] result Cached result
+//! \return False if the result is not cached (or the functions list is changed)
+//!
+bool QtTIFunctionCache::constantResult(const QtTIAbstractParserFunc *parserFunc, QVariant &result) const
+{
+    std::shared_ptr<const ConstantResult> constant = std::atomic_load(&_constantResult);
+    if (!constant)
+        return false;
+    if (constant->parserFunc != parserFunc
+        || constant->revision != parserFunc->revision()) {
+        // the result of the changed functions list is not needed anymore (unless another result was published)
+        std::atomic_compare_exchange_strong(&_constantResult, &constant, std::shared_ptr<const ConstantResult>());
+        return false;
+    }
+    result = constant->result;
+    return true;
+}
+
+//!
+//! \brief Cache result of the call with constant arguments
+//! \param parserFunc Help functions
+//! \param result Result of the pure help function
+//!
+//! NOTE: The result of the other help functions (or of the changed functions list) is replaced
+//!       and released by the last reader.
+//!
+void QtTIFunctionCache::setConstantResult(const QtTIAbstractParserFunc *parserFunc, const QVariant &result) const
+{
+    std::shared_ptr<ConstantResult> constant = std::make_shared<ConstantResult>();
+    constant->parserFunc = parserFunc;
+    constant->revision = parserFunc->revision();
+    constant->result = result;
+    std::atomic_store(&_constantResult, std::shared_ptr<const ConstantResult>(constant));
+}
@@ -0,0 +1,77 @@
+#ifndef QTTIFUNCTIONCACHE_H
+#define QTTIFUNCTIONCACHE_H
+
+#include <QString>
+#include <QVector>
+#include <QVariantList>
+#include <QMutex>
+#include <atomic>
+#include <memory>
+
+#include "../Abstract/QtTIAbstractParserFunc.h"
+
+//!
+//! \brief The QtTIFunctionCache class
+//!
+//! Inline cache of one help function call (see QtTIExprCallNode): argument type ids => help
+//! function overload. A repeated call with the same argument types does not search the overload
+//! (by name and by the argument types). The cache keeps up to 'MaxEntries' overloads.
+//!
+//! NOTE: The cached overload is valid while the functions list is not changed (see
+//!       QtTIAbstractParserFunc::revision), the entry of the previous revision is replaced by the
+//!       entry of the current one. The overload selected by the argument conversion is checked
+//!       again on each call (the conversion can depend on the argument value).
+//! NOTE: The cache is filled on render and can be used from several threads at once: the entries
+//!       are not changed after they are published (appended or replaced under the mutex), the
+//!       read does not take the mutex. The replaced entry is released by the last reader.
+//! NOTE: The call with constant arguments keeps the result of the pure help function (see
+//!       constantResult), the function is called once while the functions list is not changed
+//!       (the result of the previous revision is released when it is read or replaced).
+//!
+class QtTIFunctionCache
+{
+public:
+    QtTIFunctionCache() = default;
+    ~QtTIFunctionCache() = default;
+
+    QtTIFunctionCache(const QtTIFunctionCache &) = delete;
+    QtTIFunctionCache &operator=(const QtTIFunctionCache &) = delete;
+
+    const QtTIAbstractHelperFunction *function(const QtTIAbstractParserFunc *parserFunc,
+                                               const QString &funcName,
+                                               const QVariantList &args) const;
+
+    bool constantResult(const QtTIAbstractParserFunc *parserFunc, QVariant &result) const;
+    void setConstantResult(const QtTIAbstractParserFunc *parserFunc, const QVariant &result) const;
+
+private:
+    //!
+    //! \brief The Entry struct
+    //!
+    struct Entry {
+        const QtTIAbstractParserFunc *parserFunc {nullptr};     //!< help functions
+        int revision {-1};                                      //!< revision of the functions list
+        QVector<int> argsTypeIds;                               //!< argument type ids
+        const QtTIAbstractHelperFunction *function {nullptr};   //!< help function overload
+        bool isStrict {false};                                  //!< argument types are equal to the needed ones
+    };
+
+    //!
+    //! \brief The ConstantResult struct
+    //!
+    struct ConstantResult {
+        const QtTIAbstractParserFunc *parserFunc {nullptr};     //!< help functions
+        int revision {-1};                                      //!< revision of the functions list
+        QVariant result;                                        //!< result of the help function
+    };
+
+    static const int MaxEntries = 4;            //!< max number of cached overloads
+
+    mutable std::shared_ptr<const Entry> _entries[MaxEntries];  //!< cached overloads (atomic access)
+    mutable std::atomic<int> _entryCount {0};                   //!< number of published entries
+    mutable QMutex _mutex;                                      //!< append entry mutex
+
+    mutable std::shared_ptr<const ConstantResult> _constantResult;  //!< result of the call with constant arguments (atomic access)
+};
+
+#endif // QTTIFUNCTIONCACHE_H
@@ -0,0 +1,95 @@
+#include "QtTIMethodCache.h"
+#include "../../QtTIHelperFunction/QtTIAbstractHelperFunction.h"
+
+#include <QMutexLocker>
+
+//!
+//! \brief Get argument type ids (key of the invocation plan)
+//! \param args Arguments
+//! \return
+//!
+QVector<int> QtTIMethodPlan::typesOf(const QVariantList &args)
+{
+    return QtTIAbstractHelperFunction::vListArgsTypeIds(args);
+}
+
+//!
+//! \brief Get invocation plan of the class method (cached)
+//! \param mObj Class meta object
+//! \param name Method name
+//! \param args Method arguments
+//! \return
+//!
+std::shared_ptr<const QtTIMethodPlan> QtTIMethodCache::plan(const QMetaObject *mObj, const QString &name, const QVariantList &args) const
+{
+    const QVector<int> argTypes = QtTIMethodPlan::typesOf(args);
+    const int entryCount = _entryCount.load(std::memory_order_acquire);
+    for (int i = 0; i < entryCount; i++) {
+        if (_entries[i]->metaObject == mObj
+            && _entries[i]->argTypes == argTypes)
+            return _entries[i];
+    }
+
+    std::shared_ptr<const QtTIMethodPlan> result = makePlan(mObj, name, args);
+    if (entryCount < MaxEntries) {
+        QMutexLocker locker(&_mutex);
+        const int n = _entryCount.load(std::memory_order_relaxed);
+        for (int i = entryCount; i < n; i++) {
+            if (_entries[i]->metaObject == mObj
+                && _entries[i]->argTypes == argTypes)
+                return _entries[i];
+        }
+        if (n < MaxEntries) {
+            _entries[n] = result;
+            _entryCount.store(n + 1, std::memory_order_release);
+        }
+    }
+    return result;
+}
+
+//!
+//! \brief Resolve invocation plan of the class method (not cached)
+//! \param mObj Class meta object
+//! \param name Method name
+//! \param args Method arguments
+//! \return
+//!
+std::shared_ptr<const QtTIMethodPlan> QtTIMethodCache::makePlan(const QMetaObject *mObj, const QString &name, const QVariantList &args)
+{
+    std::shared_ptr<QtTIMethodPlan> result = std::make_shared<QtTIMethodPlan>();
+    result->metaObject = mObj;
+    result->argTypes = QtTIMethodPlan::typesOf(args);
+    result->argTypesStr = QtTIAbstractHelperFunction::typesToStr(QtTIAbstractHelperFunction::vListArgsTypes(args));
+
+    const QByteArray mNorSignature = QMetaObject::normalizedSignature(QString("%1(%2)").arg(name, result->argTypesStr).toStdString().c_str());
+    const int mIndex = mObj->indexOfMethod(mNorSignature);
+    if (mIndex == -1) {
+        result->error = QString("Class method '%1::%2(%3)' not found!").arg(mObj->className(), name, result->argTypesStr);
+        return result;
+    }
+    result->method = mObj->method(mIndex);
+    if (result->method.access() != QMetaMethod::Public) {
+        result->error = QString("Class method '%1::%2(%3)' is not public!").arg(mObj->className(), name, result->argTypesStr);
+        return result;
+    }
+
+    const QList<QByteArray> mTypes = result->method.parameterTypes();
+    if (mTypes.size() != args.size()) {
+        result->error = QString("Invalid arguments count for class method '%1::%2(%3)'!").arg(mObj->className(), name, result->argTypesStr);
+        return result;
+    }
+    for (int i = 0; i < mTypes.size(); i++) {
+        const QVariant::Type methodType = QVariant::nameToType(mTypes.at(i));
+        if (args.at(i).type() != methodType) {
+            result->convertTypes << static_cast<int>(methodType);
+            result->paramTypeNames << QMetaType::typeName(static_cast<int>(methodType));
+        } else {
+            result->convertTypes << static_cast<int>(QVariant::Invalid);
+            result->paramTypeNames << QMetaType::typeName(args.at(i).userType());
+        }
+    }
+
+    result->returnTypeName = result->method.typeName();
+    result->returnType = QMetaType::type(result->returnTypeName);
+    return result;
+}
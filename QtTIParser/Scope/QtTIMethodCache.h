@@ -0,0 +1,66 @@
+#ifndef QTTIMETHODCACHE_H
+#define QTTIMETHODCACHE_H
+
+#include <QString>
+#include <QVector>
+#include <QVariant>
+#include <QMetaObject>
+#include <QMetaMethod>
+#include <QMutex>
+#include <atomic>
+#include <memory>
+
+//!
+//! \brief The QtTIMethodPlan struct
+//!
+//! Invocation plan of the class method for the argument types: the method, the conversion
+//! of the arguments to the parameter types and the return type. The plan is resolved once,
+//! the call does not build and normalize the method signature.
+//!
+struct QtTIMethodPlan
+{
+    const QMetaObject *metaObject {nullptr};    //!< class meta object
+    QVector<int> argTypes;                      //!< argument type ids (-1 - Null)
+    QString argTypesStr;                        //!< argument type names (for messages)
+    QString error;                              //!< resolve error (the method can not be called)
+    QMetaMethod method;                         //!< class method
+    QVector<int> convertTypes;                  //!< parameter types (QVariant::Invalid - without conversion)
+    QVector<const char*> paramTypeNames;        //!< type names of the converted arguments
+    int returnType {QMetaType::UnknownType};    //!< return type id
+    const char *returnTypeName {nullptr};       //!< return type name
+
+    static QVector<int> typesOf(const QVariantList &args);
+};
+
+//!
+//! \brief The QtTIMethodCache class
+//!
+//! Inline cache of one method call (one segment of the parameter path, see QtTIParamPath):
+//! (meta object of the class, argument types) => invocation plan. The cache keeps up to
+//! 'MaxEntries' plans, the plans of other classes are resolved on each call.
+//!
+//! NOTE: The cache is filled on render and can be used from several threads at once: the entries
+//!       are appended under the mutex and published by the entry counter, the read is lock-free.
+//!
+class QtTIMethodCache
+{
+public:
+    QtTIMethodCache() = default;
+    ~QtTIMethodCache() = default;
+
+    QtTIMethodCache(const QtTIMethodCache &) = delete;
+    QtTIMethodCache &operator=(const QtTIMethodCache &) = delete;
+
+    std::shared_ptr<const QtTIMethodPlan> plan(const QMetaObject *mObj, const QString &name, const QVariantList &args) const;
+
+    static std::shared_ptr<const QtTIMethodPlan> makePlan(const QMetaObject *mObj, const QString &name, const QVariantList &args);
+
+private:
+    static const int MaxEntries = 4;                                //!< max number of cached plans
+
+    mutable std::shared_ptr<const QtTIMethodPlan> _entries[MaxEntries]; //!< cached plans
+    mutable std::atomic<int> _entryCount {0};                       //!< number of published entries
+    mutable QMutex _mutex;                                          //!< append entry mutex
+};
+
+#endif // QTTIMETHODCACHE_H
@@ -0,0 +1,131 @@
+#include "QtTIParamPath.h"
+#include "QtTIScope.h"
+#include "../Expression/QtTIExprParser.h"
+
+#include <functional>
+
+//!
+//! \brief Constructor
+//! \param path Parameter path (segments are separated by '.')
+//! \param scope Scope for interning of the segment names (can be NULL)
+//!
+QtTIParamPath::QtTIParamPath(const QString &path, QtTIScope *scope)
+    : _path(path)
+{
+    QChar quote;
+    int openBrackets = 0;
+    int segmentStart = 0;
+    for (int i = 0; i < _path.size(); i++) {
+        const QChar ch = _path.at(i);
+        if (!quote.isNull()) {
+            if (ch == quote && _path.at(i - 1) != QChar('\\'))
+                quote = QChar();
+            continue;
+        }
+        if (ch == QChar('\'') || ch == QChar('"')) {
+            quote = ch;
+        } else if (ch == QChar('(') || ch == QChar('[') || ch == QChar('{')) {
+            openBrackets++;
+        } else if (ch == QChar(')') || ch == QChar(']') || ch == QChar('}')) {
+            openBrackets--;
+        } else if (ch == QChar('.') && openBrackets == 0) {
+            if (!appendSegment(_path.mid(segmentStart, i - segmentStart), scope)) {
+                _segments.clear();
+                return;
+            }
+            segmentStart = i + 1;
+        }
+    }
+    if (!appendSegment(_path.mid(segmentStart), scope))
+        _segments.clear();
+}
+
+//!
+//! \brief Append path segment
+//! \param data Segment data: name or method call 'name(args)'
+//! \param scope Scope for interning of the segment names (can be NULL)
+//! \return False if the segment is invalid (no name)
+//!
+bool QtTIParamPath::appendSegment(const QString &data, QtTIScope *scope)
+{
+    Segment segment;
+    const int argsStart = data.indexOf(QChar('('));
+    const int argsEnd = data.lastIndexOf(QChar(')'));
+    if (argsStart != -1 && argsEnd > argsStart) {
+        segment.name = data.left(argsStart).trimmed();
+        segment.isMethod = true;
+        segment.methodArgs = data.mid(argsStart + 1, argsEnd - argsStart - 1).trimmed();
+        segment.methodCache = std::make_shared<QtTIMethodCache>();
+        prepareMethodArgs(segment);
+    } else {
+        segment.name = data.trimmed();
+        segment.propertyCache = std::make_shared<QtTIPropertyCache>();
+        bool isIndex = false;
+        const int index = segment.name.toInt(&isIndex);
+        if (isIndex && index >= 0)
+            segment.index = index;
+    }
+    if (segment.name.isEmpty())
+        return false;
+    if (scope)
+        segment.name = scope->symbol(segment.name);
+    _segments.append(segment);
+    return true;
+}
+
+//!
+//! \brief Parse method arguments of literals only (numbers, strings, bool, arrays and maps of them)
+//! \param segment Method segment
+//!
+//! NOTE: The arguments with parameters, help functions, operations or escaped characters
+//!       are not parsed (the arguments are parsed on each call as before).
+//!
+void QtTIParamPath::prepareMethodArgs(Segment &segment)
+{
+    if (segment.methodArgs.isEmpty()) {
+        segment.isConstArgs = true;
+        return;
+    }
+    if (segment.methodArgs.contains(QChar('\\')))
+        return;
+
+    bool isOk = false;
+    QtTIExprNodePtr root;
+    QString error;
+    std::tie(isOk, root, error) = QtTIExprParser::parse(QString("[%1]").arg(segment.methodArgs));
+    if (!isOk || root->kind() != QtTIExprNode::Kind::Array)
+        return;
+
+    std::function<bool(const QtTIExprNodePtr &)> isLiteral = [&isLiteral](const QtTIExprNodePtr &node) {
+        switch (node->kind()) {
+            case QtTIExprNode::Kind::Literal:
+                return true;
+            case QtTIExprNode::Kind::Array: {
+                for (const QtTIExprNodePtr &item : static_cast<const QtTIExprArrayNode &>(*node).items()) {
+                    if (!isLiteral(item))
+                        return false;
+                }
+                return true;
+            }
+            case QtTIExprNode::Kind::Map: {
+                for (const QPair<QString, QtTIExprNodePtr> &item : static_cast<const QtTIExprMapNode &>(*node).items()) {
+                    if (!isLiteral(item.second))
+                        return false;
+                }
+                return true;
+            }
+            default:
+                break;
+        }
+        return false;
+    };
+    if (!isLiteral(root))
+        return;
+
+    QVariant args;
+    std::tie(isOk, args, error) = root->eval(nullptr, nullptr);
+    if (!isOk)
+        return;
+    segment.isConstArgs = true;
+    segment.constArgs = args.toList();
+}
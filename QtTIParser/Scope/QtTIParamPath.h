@@ -0,0 +1,92 @@
+#ifndef QTTIPARAMPATH_H
+#define QTTIPARAMPATH_H
+
+#include <QString>
+#include <QVector>
+#include <QVariantList>
+#include <memory>
+
+#include "QtTIPropertyCache.h"
+#include "QtTIMethodCache.h"
+
+class QtTIScope;
+
+//!
+//! \brief The QtTIParamPath class
+//!
+//! Parameter path split into segments once (when the expression is compiled), the lookup
+//! of the parameter walks the segments without splitting and joining the path strings.
+//! A segment is a key of the map/hash, an index of the list, a property of the class or a call
+//! of the class method (the dots inside the method arguments and strings do not split the path).
+//!
+//! NOTE: If the scope is set, the segment names are interned in the scope (see QtTIScope::symbol),
+//!       the same names of the compiled template share one string data.
+//!
+//! NOTE: The method arguments of literals only (numbers, strings, bool, arrays and maps of them)
+//!       are parsed once (see Segment::constArgs), other arguments are parsed on each call
+//!       (see QtTIAbstractParserArgs::parseHelpFunctionArgs).
+//!
+//! === Example:
+//!     a.b.index(1.5, 'x.y').c
+//!
+//!     segments: a / b / index (method, args: "1.5, 'x.y'") / c
+//!
+//!     items.0.name
+//!
+//!     segments: items / 0 (list index) / name
+//!
+class QtTIParamPath
+{
+public:
+    //!
+    //! \brief The Segment struct
+    //!
+    struct Segment {
+        QString name;           //!< key, property or method name
+        bool isMethod {false};  //!< call of the class method
+        QString methodArgs;     //!< string representation of the method arguments
+        bool isConstArgs {false};   //!< method arguments are literals (parsed to 'constArgs')
+        QVariantList constArgs;     //!< parsed method arguments (if 'isConstArgs')
+        int index {-1};         //!< list index (if the name is a number)
+        std::shared_ptr<QtTIPropertyCache> propertyCache;   //!< property access cache (shared by the copies of the path)
+        std::shared_ptr<QtTIMethodCache> methodCache;       //!< method invocation plans cache (shared by the copies of the path)
+    };
+
+    QtTIParamPath() = default;
+    explicit QtTIParamPath(const QString &path, QtTIScope *scope = nullptr);
+    ~QtTIParamPath() = default;
+
+    //!
+    //! \brief Check path is empty (no segments)
+    //! \return
+    //!
+    bool isEmpty() const { return _segments.isEmpty(); }
+
+    //!
+    //! \brief Get path string
+    //! \return
+    //!
+    const QString &path() const { return _path; }
+
+    //!
+    //! \brief Get parameter name (first segment)
+    //! \return
+    //!
+    const QString &name() const { return _segments.first().name; }
+
+    //!
+    //! \brief Get path segments
+    //! \return
+    //!
+    const QVector<Segment> &segments() const { return _segments; }
+
+private:
+    bool appendSegment(const QString &data, QtTIScope *scope);
+    static void prepareMethodArgs(Segment &segment);
+
+private:
+    QString _path;              //!< path string
+    QVector<Segment> _segments; //!< path segments
+};
+
+#endif // QTTIPARAMPATH_H
@@ -0,0 +1,52 @@
+#include "QtTIPropertyCache.h"
+
+#include <QMetaProperty>
+#include <QMutexLocker>
+
+//!
+//! \brief Get index of the class property (cached)
+//! \param mObj Class meta object
+//! \param name Property name
+//! \return -1 if the property is not found
+//!
+int QtTIPropertyCache::propertyIndex(const QMetaObject *mObj, const QString &name) const
+{
+    const int entryCount = _entryCount.load(std::memory_order_acquire);
+    for (int i = 0; i < entryCount; i++) {
+        if (_entries[i].metaObject == mObj)
+            return _entries[i].propertyIndex;
+    }
+
+    const int index = findPropertyIndex(mObj, name);
+    if (entryCount < MaxEntries) {
+        QMutexLocker locker(&_mutex);
+        const int n = _entryCount.load(std::memory_order_relaxed);
+        for (int i = entryCount; i < n; i++) {
+            if (_entries[i].metaObject == mObj)
+                return index;
+        }
+        if (n < MaxEntries) {
+            _entries[n].metaObject = mObj;
+            _entries[n].propertyIndex = index;
+            _entryCount.store(n + 1, std::memory_order_release);
+        }
+    }
+    return index;
+}
+
+//!
+//! \brief Search index of the class property by name (not cached)
+//! \param mObj Class meta object
+//! \param name Property name
+//! \return -1 if the property is not found
+//!
+//! NOTE: Only the properties declared in the class are searched (not in the base classes).
+//!
+int QtTIPropertyCache::findPropertyIndex(const QMetaObject *mObj, const QString &name)
+{
+    for (int i = mObj->propertyOffset(); i < mObj->propertyCount(); ++i) {
+        if (mObj->property(i).name() == name)
+            return i;
+    }
+    return -1;
+}
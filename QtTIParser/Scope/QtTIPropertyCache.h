@@ -0,0 +1,51 @@
+#ifndef QTTIPROPERTYCACHE_H
+#define QTTIPROPERTYCACHE_H
+
+#include <QString>
+#include <QMetaObject>
+#include <QMutex>
+#include <atomic>
+
+//!
+//! \brief The QtTIPropertyCache class
+//!
+//! Inline cache of one property access (one segment of the parameter path, see QtTIParamPath):
+//! the meta object of the class => index of the property. A repeated access to the property of
+//! the same class is a pointer compare, the properties are searched by name only on a cache miss.
+//!
+//! The cache keeps up to 'MaxEntries' classes (polymorphic access), other classes are searched
+//! by name on each access.
+//!
+//! NOTE: The cache is filled on render and can be used from several threads at once: the entries
+//!       are appended under the mutex and published by the entry counter, the read is lock-free.
+//!
+class QtTIPropertyCache
+{
+public:
+    QtTIPropertyCache() = default;
+    ~QtTIPropertyCache() = default;
+
+    QtTIPropertyCache(const QtTIPropertyCache &) = delete;
+    QtTIPropertyCache &operator=(const QtTIPropertyCache &) = delete;
+
+    int propertyIndex(const QMetaObject *mObj, const QString &name) const;
+
+    static int findPropertyIndex(const QMetaObject *mObj, const QString &name);
+
+private:
+    //!
+    //! \brief The Entry struct
+    //!
+    struct Entry {
+        const QMetaObject *metaObject {nullptr};    //!< class meta object
+        int propertyIndex {-1};                     //!< property index (-1 - not found)
+    };
+
+    static const int MaxEntries = 4;            //!< max number of cached classes
+
+    mutable Entry _entries[MaxEntries];         //!< cached classes
+    mutable std::atomic<int> _entryCount {0};   //!< number of published entries
+    mutable QMutex _mutex;                      //!< append entry mutex
+};
+
+#endif // QTTIPROPERTYCACHE_H
@@ -0,0 +1,56 @@
+#include "QtTIScope.h"
+
+//!
+//! \brief Get slot index of variable (a new slot is added for the unknown name)
+//! \param name Variable name
+//! \return
+//!
+int QtTIScope::slot(const QString &name)
+{
+    QHash<QString, int>::const_iterator it = _slots.constFind(name);
+    if (it != _slots.constEnd())
+        return it.value();
+
+    const int index = _slots.size();
+    _slots.insert(name, index);
+    return index;
+}
+
+//!
+//! \brief Find slot index of variable
+//! \param name Variable name
+//! \return Slot index or -1 if the name is not a variable of the scope
+//!
+int QtTIScope::findSlot(const QString &name) const
+{
+    return _slots.value(name, -1);
+}
+
+//!
+//! \brief Get variable names in the order of the slot indexes
+//! \return
+//!
+QStringList QtTIScope::slotNames() const
+{
+    QStringList result;
+    result.reserve(_slots.size());
+    for (int i = 0; i < _slots.size(); i++)
+        result.append(QString());
+    QHash<QString, int>::const_iterator it = _slots.constBegin();
+    for ( ; it != _slots.constEnd(); ++it)
+        result[it.value()] = it.key();
+    return result;
+}
+
+//!
+//! \brief Intern name (the same names of the scope share one string data)
+//! \param name Name
+//! \return Interned name
+//!
+QString QtTIScope::symbol(const QString &name)
+{
+    QSet<QString>::const_iterator it = _symbols.constFind(name);
+    if (it != _symbols.constEnd())
+        return *it;
+    return *_symbols.insert(name);
+}
@@ -0,0 +1,54 @@
+#ifndef QTTISCOPE_H
+#define QTTISCOPE_H
+
+#include <QString>
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+
+//!
+//! \brief The QtTIScope class
+//!
+//! Variable slots of a compiled template. Every variable name of the template (parameters of
+//! the expressions, 'for' and 'set' variables) gets a slot index when the template is compiled.
+//! On render, the loop and 'set' variables are stored in the slots of the render args by index
+//! (see QtTIAbstractParserArgs::setSlotValue) and the expressions read them by index, without
+//! hashing or splitting the parameter names.
+//!
+//! Template variables are visible till the end of render, so the template has one scope
+//! (nested 'for' blocks restore the shadowed value of the variable after the loop).
+//!
+//! The names of the parameter path segments are interned in the scope (see QtTIParamPath),
+//! the same names share one string data.
+//!
+//! NOTE: The scope is filled only while the template is compiled and then it is read only,
+//! so it is shared by all renders of the compiled template.
+//!
+//! === Example:
+//!     {% for a in list %}     - 'a' => slot 0, 'list' => slot 1
+//!     {{ a.name }}            - 'a' => slot 0 (path 'name' is evaluated on the slot value)
+//!     {% endfor %}
+//!
+class QtTIScope
+{
+public:
+    QtTIScope() = default;
+    ~QtTIScope() = default;
+
+    int slot(const QString &name);
+    int findSlot(const QString &name) const;
+    QString symbol(const QString &name);
+    QStringList slotNames() const;
+
+    //!
+    //! \brief Get number of slots
+    //! \return
+    //!
+    int slotCount() const { return _slots.size(); }
+
+private:
+    QHash<QString, int> _slots; //!< variable name => slot index
+    QSet<QString> _symbols;     //!< interned names of the path segments
+};
+
+#endif // QTTISCOPE_H
@@ -0,0 +1,164 @@
+#include "QtTITemplateLexer.h"
+
+//!
+//! \brief Constructor
+//! \param data Template data
+//! \param splitLines Split data into lines (otherwise line end characters are the part of the text)
+//! \param firstLineNum Number of the first line
+//!
+QtTITemplateLexer::QtTITemplateLexer(const QString &data, const bool splitLines, const int firstLineNum)
+    : _data(data)
+    , _splitLines(splitLines)
+    , _lineNum(firstLineNum)
+{
+}
+
+//!
+//! \brief Split the next line into tokens
+//! \param tokens Result tokens (cleared before)
+//! \param unfinishedBlockType Type of the block unfinished on the previous line (Invalid - no block)
+//! \return Line data without line end characters
+//!
+//! NOTE: The line ends with '\n' ('\r' before it is a part of the line end). If the line ends
+//!       inside a block, the last token is BlockBegin or BlockPart.
+//!
+QStringView QtTITemplateLexer::nextLine(QVector<QtTITemplateToken> &tokens,
+                                        const QtTIAbstractParserBlock::Type unfinishedBlockType)
+{
+    tokens.clear();
+
+    const int lineStart = _pos;
+    const int lineNum = _lineNum;
+    int lineEnd = _data.size();
+    if (_splitLines) {
+        const int lineBreak = _data.indexOf(QChar('\n'), lineStart);
+        if (lineBreak != -1) {
+            lineEnd = lineBreak;
+            _pos = lineBreak + 1;
+            if (lineEnd > lineStart && _data.at(lineEnd - 1) == QChar('\r'))
+                lineEnd--;
+        } else {
+            _pos = _data.size();
+        }
+    } else {
+        _pos = _data.size();
+    }
+    _lineNum++;
+
+    const QChar *chars = _data.constData();
+    bool isString = false;
+    bool isBlock = (unfinishedBlockType != QtTIAbstractParserBlock::Type::Invalid);
+    int textStart = lineStart;
+    // the control characters of the continued block are on the previous lines
+    int blockStart = isBlock ? lineStart - 2 : -1;
+    QtTIAbstractParserBlock::Type blockType = unfinishedBlockType;
+    QChar blockEndControlSymbol = endControlSymbol(blockType);
+    for (int i = lineStart; i < lineEnd; i++) {
+        const QChar ch = chars[i];
+        const QChar chPrev = (i > lineStart) ? chars[i - 1] : QChar();
+
+        // check is string
+        if (isBlock
+            && (ch == '"' || ch == '\'')
+            && chPrev != '\\')
+            isString = !isString;
+        if (isString)
+            continue;
+
+        // check start block
+        if (!isBlock
+            && ch == '{'
+            && i < lineEnd - 1) {
+            blockType = typeByStartControlSymbol(chars[i + 1]);
+            if (blockType == QtTIAbstractParserBlock::Type::Invalid)
+                continue;
+            blockEndControlSymbol = endControlSymbol(blockType);
+            if (i > textStart)
+                tokens.append(QtTITemplateToken(QtTITemplateToken::Type::Text,
+                                                textStart, i - textStart,
+                                                lineNum, textStart - lineStart));
+            blockStart = i;
+            isBlock = true;
+            i++; // skip the second control character
+            continue;
+        }
+
+        // check end block (the control characters of the start and the end do not overlap)
+        if (isBlock
+            && ch == '}'
+            && chPrev == blockEndControlSymbol
+            && i - blockStart >= 3) {
+            const int tokenStart = qMax(blockStart, lineStart);
+            tokens.append(QtTITemplateToken((blockStart < lineStart) ? QtTITemplateToken::Type::BlockEnd
+                                                                     : QtTITemplateToken::Type::Block,
+                                            tokenStart, i - tokenStart + 1,
+                                            lineNum, tokenStart - lineStart,
+                                            blockType));
+            textStart = i + 1;
+            isBlock = false;
+        }
+    }
+
+    if (isBlock) {
+        const int tokenStart = qMax(blockStart, lineStart);
+        tokens.append(QtTITemplateToken((blockStart < lineStart) ? QtTITemplateToken::Type::BlockPart
+                                                                 : QtTITemplateToken::Type::BlockBegin,
+                                        tokenStart, lineEnd - tokenStart,
+                                        lineNum, tokenStart - lineStart,
+                                        blockType));
+    } else if (lineEnd > textStart) {
+        tokens.append(QtTITemplateToken(QtTITemplateToken::Type::Text,
+                                        textStart, lineEnd - textStart,
+                                        lineNum, textStart - lineStart));
+    }
+
+    return QStringView(_data).mid(lineStart, lineEnd - lineStart);
+}
+
+//!
+//! \brief Get block type by block data
+//! \param blockData Block data (can be unfinished)
+//! \return
+//!
+QtTIAbstractParserBlock::Type QtTITemplateLexer::blockType(const QString &blockData)
+{
+    if (blockData.size() < 2 || blockData.at(0) != QChar('{'))
+        return QtTIAbstractParserBlock::Type::Invalid;
+    return typeByStartControlSymbol(blockData.at(1));
+}
+
+//!
+//! \brief Get end control symbol of block ('}' for `{{ }}`, '%' for `{% %}`, '#' for `{# #}`)
+//! \param blockType Block type
+//! \return
+//!
+QChar QtTITemplateLexer::endControlSymbol(const QtTIAbstractParserBlock::Type blockType)
+{
+    switch (blockType) {
+        case QtTIAbstractParserBlock::Type::Base:
+            return QChar('}');
+        case QtTIAbstractParserBlock::Type::Control:
+            return QChar('%');
+        case QtTIAbstractParserBlock::Type::Comment:
+            return QChar('#');
+        default:
+            break;
+    }
+    return QChar();
+}
+
+//!
+//! \brief Get block type by start control symbol (the character after '{')
+//! \param startControlSymbol Start control symbol
+//! \return
+//!
+QtTIAbstractParserBlock::Type QtTITemplateLexer::typeByStartControlSymbol(const QChar &startControlSymbol)
+{
+    if (startControlSymbol == '{')
+        return QtTIAbstractParserBlock::Type::Base;
+    if (startControlSymbol == '%')
+        return QtTIAbstractParserBlock::Type::Control;
+    if (startControlSymbol == '#')
+        return QtTIAbstractParserBlock::Type::Comment;
+    return QtTIAbstractParserBlock::Type::Invalid;
+}
@@ -0,0 +1,63 @@
+#ifndef QTTITEMPLATELEXER_H
+#define QTTITEMPLATELEXER_H
+
+#include <QString>
+#include <QStringView>
+#include <QVector>
+
+#include "QtTITemplateToken.h"
+
+//!
+//! \brief The QtTITemplateLexer class
+//!
+//! Splits the template data into lines and the lines into text and blocks in one pass
+//! over the data (see QtTITemplateToken). The tokens refer to the data by position and
+//! length, the data is not copied.
+//!
+//! A block can continue on the next lines, the type of the unfinished block is passed
+//! to 'nextLine' by the caller (the lines of the control block body are not parsed
+//! as a continuation of the block). Block end characters inside strings ('...' or "...")
+//! do not end the block.
+//!
+//! === Example:
+//!     Hello, {{ name }}!{# comment #}\n
+//!     {% if a %}
+//!
+//!     line 1: Text(Hello, ) Block({{ name }}) Text(!) Block({# comment #})
+//!     line 2: Block({% if a %})
+//!
+class QtTITemplateLexer
+{
+public:
+    explicit QtTITemplateLexer(const QString &data, const bool splitLines = true, const int firstLineNum = 1);
+    ~QtTITemplateLexer() = default;
+
+    //!
+    //! \brief Check all lines are read
+    //! \return
+    //!
+    bool atEnd() const { return (_pos >= _data.size()); }
+
+    //!
+    //! \brief Get number of the next line
+    //! \return
+    //!
+    int lineNum() const { return _lineNum; }
+
+    QStringView nextLine(QVector<QtTITemplateToken> &tokens,
+                         const QtTIAbstractParserBlock::Type unfinishedBlockType = QtTIAbstractParserBlock::Type::Invalid);
+
+    static QtTIAbstractParserBlock::Type blockType(const QString &blockData);
+    static QChar endControlSymbol(const QtTIAbstractParserBlock::Type blockType);
+
+private:
+    static QtTIAbstractParserBlock::Type typeByStartControlSymbol(const QChar &startControlSymbol);
+
+private:
+    const QString &_data;      //!< template data
+    const bool _splitLines;     //!< split data into lines
+    int _pos {0};               //!< next line position in data
+    int _lineNum;               //!< next line number
+};
+
+#endif // QTTITEMPLATELEXER_H
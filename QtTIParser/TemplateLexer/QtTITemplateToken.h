@@ -0,0 +1,112 @@
+#ifndef QTTITEMPLATETOKEN_H
+#define QTTITEMPLATETOKEN_H
+
+#include <QString>
+#include <QStringView>
+
+#include "../Abstract/QtTIAbstractParserBlock.h"
+
+//!
+//! \brief The QtTITemplateToken class
+//!
+//! One token of the template data (see QtTITemplateLexer). The token does not keep
+//! the data, only the position and the length in the template data:
+//!  - Text       : static text (never contains line end)
+//!  - Block      : block `{{ ... }}`, `{% ... %}` or `{# ... #}` ('blockType' - block type)
+//!  - BlockBegin : block start without end till the end of line
+//!  - BlockPart  : whole line inside the block started on the previous lines
+//!  - BlockEnd   : block end, the block is started on the previous lines
+//!
+class QtTITemplateToken
+{
+public:
+    enum class Type {
+        Text = 0,
+        Block,
+        BlockBegin,
+        BlockPart,
+        BlockEnd
+    };
+
+    QtTITemplateToken() = default;
+    QtTITemplateToken(const Type type,
+                      const int pos,
+                      const int length,
+                      const int lineNum,
+                      const int linePos,
+                      const QtTIAbstractParserBlock::Type blockType = QtTIAbstractParserBlock::Type::Invalid)
+        : _type(type)
+        , _blockType(blockType)
+        , _pos(pos)
+        , _length(length)
+        , _lineNum(lineNum)
+        , _linePos(linePos)
+    {}
+    ~QtTITemplateToken() = default;
+
+    //!
+    //! \brief Get token type
+    //! \return
+    //!
+    Type type() const { return _type; }
+
+    //!
+    //! \brief Get block type (Block, BlockBegin, BlockPart, BlockEnd)
+    //! \return
+    //!
+    QtTIAbstractParserBlock::Type blockType() const { return _blockType; }
+
+    //!
+    //! \brief Get token position in template data
+    //! \return
+    //!
+    int pos() const { return _pos; }
+
+    //!
+    //! \brief Get token length in template data
+    //! \return
+    //!
+    int length() const { return _length; }
+
+    //!
+    //! \brief Get token line number
+    //! \return
+    //!
+    int lineNum() const { return _lineNum; }
+
+    //!
+    //! \brief Get token position number in line
+    //! \return
+    //!
+    int linePos() const { return _linePos; }
+
+    //!
+    //! \brief Get token data (view of the template data)
+    //! \param data Template data
+    //! \return
+    //!
+    QStringView view(const QString &data) const {
+        return QStringView(data).mid(_pos, _length);
+    }
+
+    //!
+    //! \brief Get block body (view of the template data without control characters)
+    //! \param data Template data
+    //! \return
+    //!
+    QStringView bodyView(const QString &data) const {
+        if (_type != Type::Block)
+            return QStringView();
+        return QStringView(data).mid(_pos + 2, _length - 4);
+    }
+
+private:
+    Type _type {Type::Text};                                                        //!< token type
+    QtTIAbstractParserBlock::Type _blockType {QtTIAbstractParserBlock::Type::Invalid}; //!< block type
+    int _pos {-1};                                                                  //!< position in template data
+    int _length {0};                                                                //!< length in template data
+    int _lineNum {-1};                                                              //!< line number
+    int _linePos {-1};                                                              //!< position number in line
+};
+
+#endif // QTTITEMPLATETOKEN_H
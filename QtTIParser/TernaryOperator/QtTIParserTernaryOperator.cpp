@@ -1,9 +1,5 @@
 #include "QtTIParserTernaryOperator.h"
-#include "../BracketsExpr/QtTIParserBracketsExpr.h"
-#include "../Logic/QtTIParserLogic.h"
-#include "../Math/QtTIParserMath.h"
-#include "../../QtTIDefines/QtTIRegExpDefines.h"
-#include <QRegExp>
+#include "../Expression/QtTIExpression.h"
 
 //!
 //! \brief Check is ternary operator expression
@@ -12,12 +8,18 @@
 //!
 bool QtTIParserTernaryOperator::isTernaryOperatorExpr(const QString &expr)
 {
-    QRegExp rx(RX_TERNARY_v1);
-    QRegExp rx_2(RX_TERNARY_v2);
-    QRegExp rx_3(RX_TERNARY_v3);
-    return ((rx.indexIn(expr) != -1)
-            || (rx_2.indexIn(expr) != -1)
-            || (rx_3.indexIn(expr) != -1));
+    return isTernaryOperatorExpr(QtTIExpression::compile(expr));
+}
+
+//!
+//! \brief Check is ternary operator expression (the root of the expression tree is the ternary operator)
+//! \param expr Compiled expression
+//! \return
+//!
+bool QtTIParserTernaryOperator::isTernaryOperatorExpr(const QtTIExpression &expr)
+{
+    return (expr.isValid()
+            && expr.kind() == QtTIExprNode::Kind::Ternary);
 }
 
 //!
@@ -35,7 +37,9 @@ bool QtTIParserTernaryOperator::isTernaryOperatorExpr(const QString &expr)
 //!         {{ foo ? 'yes' }} is the same as {{ foo ? 'yes' : '' }}
 //!
 //! === Brackets support:
-//!     Supported grouping expressions with brackets '(...expr...)':
+//!     Supported grouping expressions with brackets '(...expr...)', the expression is evaluated
+//!     as an expression tree (see QtTIExprParser), only the selected branch is evaluated
+//!     (the branches are split by the expression parser, not by regular expressions):
 //!         {% set a = 10.5 %}
 //!         {% set b = 2 %}
 //!         {% set aa = { a:1, b:2, c:3 } %}
@@ -66,236 +70,16 @@ QVariant QtTIParserTernaryOperator::parseTernaryOperator(const QString &expr,
         error = QString("QtTIParserFunc is NULL");
         return QVariant();
     }
-    if (!QtTIParserTernaryOperator::isTernaryOperatorExpr(expr)) {
+    const QtTIExpression compiledExpr = QtTIExpression::compile(expr);
+    if (!QtTIParserTernaryOperator::isTernaryOperatorExpr(compiledExpr)) {
         error = QString("Incorrect ternary operator expression '%1'").arg(expr);
         return QVariant();
     }
 
-    QRegExp rx(RX_TERNARY_v1);
-    QRegExp rx_2(RX_TERNARY_v2);
-    QRegExp rx_3(RX_TERNARY_v3);
-
-    // check conditions
-    if (rx.indexIn(expr) != -1) {
-        QString ternCond = rx.cap(1).trimmed();
-        QPair<QString, QString> ternResults = QtTIParserTernaryOperator::parseLeftRight(rx.cap(2).trimmed());
-
-        bool calcIsOk = false;
-        QVariant ternCondVal;
-        std::tie(calcIsOk, ternCondVal, error) = QtTIParserTernaryOperator::evalCond(ternCond, parserArgs, parserFunc);
-        if (!calcIsOk) {
-            if (isOk)
-                *isOk = false;
-            return QVariant();
-        }
-
-        QVariant ternResultTrue;
-        std::tie(calcIsOk, ternResultTrue, error) = QtTIParserTernaryOperator::evalCond(ternResults.first, parserArgs, parserFunc);
-        if (!calcIsOk) {
-            if (isOk)
-                *isOk = false;
-            return QVariant();
-        }
-
-        QVariant ternResultFalse;
-        std::tie(calcIsOk, ternResultFalse, error) = QtTIParserTernaryOperator::evalCond(ternResults.second, parserArgs, parserFunc);
-        if (!calcIsOk) {
-            if (isOk)
-                *isOk = false;
-            return QVariant();
-        }
-        if (isOk)
-            *isOk = true;
-
-        if (ternCondVal.type() == QVariant::Bool)
-            return (ternCondVal.toBool() ? ternResultTrue : ternResultFalse);
-
-        return (!ternCondVal.isNull() ? ternResultTrue : ternResultFalse);
-
-    } else if (rx_2.indexIn(expr) != -1) {
-        QString ternCond = rx_2.cap(1).trimmed();
-        QString ternCondFalse = rx_2.cap(2).trimmed();
-
-        bool calcIsOk = false;
-        QVariant ternCondVal;
-        std::tie(calcIsOk, ternCondVal, error) = QtTIParserTernaryOperator::evalCond(ternCond, parserArgs, parserFunc);
-        if (!calcIsOk) {
-            if (isOk)
-                *isOk = false;
-            return QVariant();
-        }
-
-        QVariant ternResultFalse;
-        std::tie(calcIsOk, ternResultFalse, error) = QtTIParserTernaryOperator::evalCond(ternCondFalse, parserArgs, parserFunc);
-        if (!calcIsOk) {
-            if (isOk)
-                *isOk = false;
-            return QVariant();
-        }
-        if (isOk)
-            *isOk = true;
-
-        if (ternCondVal.type() == QVariant::Bool)
-            return (ternCondVal.toBool() ? ternCondVal : ternResultFalse);
-
-        return (!ternCondVal.isNull() ? ternCondVal : ternResultFalse);
-
-    } else if (rx_3.indexIn(expr) != -1) {
-        QString ternCond = rx_3.cap(1).trimmed();
-        QString ternCondTrue = rx_3.cap(2).trimmed();
-
-        bool calcIsOk = false;
-        QVariant ternCondVal;
-        std::tie(calcIsOk, ternCondVal, error) = QtTIParserTernaryOperator::evalCond(ternCond, parserArgs, parserFunc);
-        if (!calcIsOk) {
-            if (isOk)
-                *isOk = false;
-            return QVariant();
-        }
-
-        QVariant ternResultTrue;
-        std::tie(calcIsOk, ternResultTrue, error) = QtTIParserTernaryOperator::evalCond(ternCondTrue, parserArgs, parserFunc);
-        if (!calcIsOk) {
-            if (isOk)
-                *isOk = false;
-            return QVariant();
-        }
-        if (isOk)
-            *isOk = true;
-
-        if (ternCondVal.type() == QVariant::Bool)
-            return (ternCondVal.toBool() ? ternResultTrue : QVariant());
-
-        return (!ternCondVal.isNull() ? ternResultTrue : QVariant());
-    }
-
-    error = QString("Could not recognize ternary operator for expression '%1'").arg(expr);
-    return QVariant();
-}
-
-//!
-//! \brief Parse left and right expressions for view: {{ foo ? 'yes' : 'no' }}
-//! \param str
-//! \return
-//!
-QPair<QString, QString> QtTIParserTernaryOperator::parseLeftRight(const QString &str)
-{
-    if (str.isEmpty())
-        return QPair<QString, QString>();
-    QPair<QString, QString> tmpResult;
-    QString tmpValue;
-    bool isEescaping = false;
-    int openBrackets = 0;
-    for (int i = 0; i < str.size(); i++) {
-        const QChar ch = str[i];
-        QChar chPrev;
-        if (i > 0)
-            chPrev = str[i - 1];
-
-        if (ch == ":" && !isEescaping && openBrackets == 0) {
-            tmpResult.first = tmpValue.trimmed();
-            tmpValue.clear();
-            continue;
-        }
-        if (ch == "'" || ch == "\"") {
-            if (chPrev == "\\") {
-                tmpValue += ch;
-                continue;
-            }
-            tmpValue += ch;
-            isEescaping = !isEescaping;
-            continue;
-        }
-        if (ch == "{" && !isEescaping) {
-            openBrackets++;
-            tmpValue += ch;
-            continue;
-        }
-        if (ch == "}" && !isEescaping) {
-            openBrackets--;
-            tmpValue += ch;
-            continue;
-        }
-        tmpValue += ch;
-    }
-    tmpResult.second = tmpValue.trimmed();
-    return tmpResult;
-}
-
-//!
-//! \brief Evaluate condition
-//! \param str
-//! \param parserArgs
-//! \param parserFunc
-//! \return
-//!
-std::tuple<bool, QVariant, QString> QtTIParserTernaryOperator::evalCond(const QString &str,
-                                                                        QtTIAbstractParserArgs *parserArgs,
-                                                                        QtTIAbstractParserFunc *parserFunc)
-{
-    if (str.isEmpty())
-        return std::make_tuple(false, QVariant(), "Eval condition failed (empty string passed)");
-
-    QStringList validStringsBeforeBracket({ "+", "-", "/", "%", "//", "*", "**", "and", "or", "not", "&&", "||" });
-    QtTIBracketsNode brNode = QtTIParserBracketsExpr::parseBracketsExpression(str, validStringsBeforeBracket, parserArgs, [parserArgs, parserFunc](const QString &nodeBody) {
-        return QtTIParserTernaryOperator::parseParamValue(nodeBody, parserArgs, parserFunc);
-    });
-    if (!brNode.isValid())
-        return std::make_tuple(false, QVariant(), QString("Invalid brackets node for expression '%1'").arg(str));
-
-    return brNode.evalNodeBody();
-}
-
-//!
-//! \brief Parse parameter value from string
-//! \param str Parameter value string view
-//! \param parserArgs
-//! \param parserFunc
-//! \return
-//!
-std::tuple<bool, QVariant, QString> QtTIParserTernaryOperator::parseParamValue(const QString &str,
-                                                                               QtTIAbstractParserArgs *parserArgs,
-                                                                               QtTIAbstractParserFunc *parserFunc)
-{
-    if (str.isEmpty())
-        return std::make_tuple(false, QVariant(), "Parse value failed (empty string passed)");
-
-    // logic
-    if (QtTIParserLogic::isLogicExpr(str)) {
-        bool isOk = false;
-        QString error;
-        QVariant result = QtTIParserLogic::parseLogic(str, parserArgs, parserFunc, &isOk, error);
-        if (!isOk)
-            return std::make_tuple(false, QVariant(), error);
-
-        return std::make_tuple(true, result, "");
-    }
-
-    // math
-    if (QtTIParserMath::isMathExpr(str)) {
-        bool isOk = false;
-        QString error;
-        QVariant result = QtTIParserMath::parseMath(str, parserArgs, parserFunc, &isOk, error);
-        if (!isOk)
-            return std::make_tuple(false, QVariant(), error);
-
-        return std::make_tuple(true, result, "");
-    }
-
-    // function
-    QRegExp rxFunc(RX_FUNC);
-    if (rxFunc.indexIn(str) != -1) {
-        QString funcName = rxFunc.cap(2).trimmed();
-        QVariantList funcArgs = parserArgs->parseHelpFunctionArgs(rxFunc.cap(3).trimmed());
-        return parserFunc->evalHelpFunction(funcName, funcArgs);
-    }
-
-    // arg
-    QVariantList tmp = parserArgs->parseHelpFunctionArgs(str);
-    if (tmp.isEmpty())
-        return std::make_tuple(false, QVariant(), "Parse value failed");
-    if (tmp.size() > 1)
-        return std::make_tuple(false, QVariant(), "Parse value failed (more than one argument is given)");
-
-    return std::make_tuple(true, tmp[0], "");
+    bool isOkLocal = false;
+    QVariant result;
+    std::tie(isOkLocal, result, error) = compiledExpr.eval(parserArgs, parserFunc);
+    if (isOk)
+        *isOk = isOkLocal;
+    return result;
 }
@@ -3,11 +3,12 @@
 
 #include <QString>
 #include <QVariant>
-#include <QPair>
 
 #include "../Abstract/QtTIAbstractParserArgs.h"
 #include "../Abstract/QtTIAbstractParserFunc.h"
 
+class QtTIExpression;
+
 class QtTIParserTernaryOperator
 {
 public:
@@ -15,22 +16,12 @@ public:
     ~QtTIParserTernaryOperator() = default;
 
     static bool isTernaryOperatorExpr(const QString &expr);
+    static bool isTernaryOperatorExpr(const QtTIExpression &expr);
     static QVariant parseTernaryOperator(const QString &expr,
                                          QtTIAbstractParserArgs *parserArgs,
                                          QtTIAbstractParserFunc *parserFunc,
                                          bool *isOk,
                                          QString &error);
-
-private:
-    static QPair<QString, QString> parseLeftRight(const QString &str);
-
-    static std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> evalCond(const QString &str,
-                                                                            QtTIAbstractParserArgs *parserArgs,
-                                                                            QtTIAbstractParserFunc *parserFunc);
-
-    static std::tuple<bool/*isOk*/,QVariant/*res*/,QString/*err*/> parseParamValue(const QString &str,
-                                                                                   QtTIAbstractParserArgs *parserArgs,
-                                                                                   QtTIAbstractParserFunc *parserFunc);
 };
 
 #endif // QTTIPARSERTERNARYOPERATOR_H
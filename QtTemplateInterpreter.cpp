@@ -1,10 +1,18 @@
 #include "QtTemplateInterpreter.h"
 
-#include <QTextStream>
 #include <QFile>
+#include <QFileInfo>
+#include <QSemaphore>
+#include <QAtomicInt>
+#include <vector>
+
+#include "QtTIParser/CompiledTemplate/QtTIRenderBatchTask.h"
+#include "QtTIParser/Program/QtTIProgramCompiler.h"
+#include "QtTIParser/RegExpRegistry/QtTIRegExpRegistry.h"
 
 QtTemplateInterpreter::QtTemplateInterpreter()
 {
+    QtTIRegExpRegistry::init();
     _parser = new QtTIParser();
 }
 
@@ -90,6 +98,44 @@ void QtTemplateInterpreter::removeHelpParam(const QString &paramName)
     _parser->parserArgs()->removeParam(paramName);
 }
 
+//!
+//! \brief Mark global help parameters as frozen (the values are not changed between renders)
+//! \param paramNames Global parameter names
+//!
+//! The compiled template is specialized against the current values of the frozen parameters
+//! by the method 'specialize'.
+//!
+//! === Example:
+//!     QtTemplateBuilder.appendHelpParam("feature_x", true);
+//!     QtTemplateBuilder.freezeHelpParams(QStringList({ "feature_x" }));
+//!
+void QtTemplateInterpreter::freezeHelpParams(const QStringList &paramNames)
+{
+    for (const QString &paramName : paramNames) {
+        if (!_frozenParams.contains(paramName))
+            _frozenParams.append(paramName);
+    }
+}
+
+//!
+//! \brief Remove the frozen mark of global help parameters
+//! \param paramNames Global parameter names
+//!
+void QtTemplateInterpreter::unfreezeHelpParams(const QStringList &paramNames)
+{
+    for (const QString &paramName : paramNames)
+        _frozenParams.removeAll(paramName);
+}
+
+//!
+//! \brief Get names of the frozen global help parameters
+//! \return
+//!
+QStringList QtTemplateInterpreter::frozenHelpParams() const
+{
+    return _frozenParams;
+}
+
 //!
 //! \brief Delete all added functions
 //!
@@ -109,48 +155,514 @@ void QtTemplateInterpreter::clearParams()
 }
 
 //!
-//! \brief Interpret the template data
+//! \brief Compile the template data (the compiled template can be rendered many times)
 //! \param data Template data
 //! \return
 //!
-std::tuple<bool, QString, QString> QtTemplateInterpreter::interpret(QString data)
+//! NOTE: The compiled template is bound to this interpreter, render it only with the same interpreter.
+//!
+//! === Example:
+//!     bool isOk = false;
+//!     std::shared_ptr<const QtTICompiledTemplate> tmpl;
+//!     QString error;
+//!     std::tie(isOk, tmpl, error) = QtTemplateBuilder.compile("--- {{ test_key }} ---");
+//!     ...
+//!     QtTemplateBuilder.appendHelpParam("test_key", "This is test key");
+//!     QString res = QtTemplateBuilder.renderRes(tmpl);
+//!
+std::tuple<bool, std::shared_ptr<const QtTICompiledTemplate>, QString> QtTemplateInterpreter::compile(QString data)
 {
-    QString lineEndAppender;
-    if (data.indexOf("\n") != -1)
-        lineEndAppender = QString("\r\n");
-
-    QTextStream in(&data);
-    int lineNum = 0;
-    QtTIAbstractParserBlock *block = nullptr;
-    QString tmpData;
-    while (!in.atEnd()) {
-        if (!tmpData.isEmpty()
-            && tmpData[tmpData.size() - 1] != '\n')
-            tmpData += "\r\n";
-
-        lineNum++;
-        QString line = in.readLine() + lineEndAppender;
-        bool isOk = false;
-        QString error;
-        std::tie(isOk, line, error) = _parser->parseLine(line, lineNum, block);
-        if (!isOk) {
-            clear(block);
-            return std::make_tuple(false, "", error);
-        }
-        tmpData += line;
-    }
+    bool isOk = false;
+    std::shared_ptr<QtTICompiledTemplate> compiledTemplate;
+    QString error;
+    std::tie(isOk, compiledTemplate, error) = _parser->compile(data);
+    if (!isOk)
+        return std::make_tuple(false, nullptr, error);
+    return std::make_tuple(true, compiledTemplate, "");
+}
+
+//!
+//! \brief Compile the template data and return result
+//! \param data Template data
+//! \return
+//!
+//! NOTE: This method only displays a critical message to the console in case of errors.
+//!
+std::shared_ptr<const QtTICompiledTemplate> QtTemplateInterpreter::compileRes(QString data)
+{
+    bool isOk = false;
+    std::shared_ptr<const QtTICompiledTemplate> result;
+    QString error;
+    std::tie(isOk, result, error) = compile(data);
+    if (!isOk)
+        qCritical() << qPrintable(QString("[QtTemplateInterpreter][compileRes] %1").arg(error));
+    return result;
+}
+
+//!
+//! \brief Render the compiled template (only evaluation, no parsing)
+//! \param compiledTemplate Compiled template
+//! \return
+//!
+std::tuple<bool, QString, QString> QtTemplateInterpreter::render(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate) const
+{
+    QtTIRenderContext context = createRenderContext();
+    return render(compiledTemplate, context);
+}
+
+//!
+//! \brief Render the compiled template to device (the result is written in chunks, not collected in memory)
+//! \param compiledTemplate Compiled template
+//! \param device Output device (must be opened for writing)
+//! \param flushThreshold Size of the data (in characters) buffered before writing to the device
+//! \return
+//!
+//! NOTE: In case of error, part of the result may have already been written to the device.
+//!
+//! === Example:
+//!     QFile f("/path/to/export.csv");
+//!     f.open(QIODevice::WriteOnly);
+//!     bool isOk = false;
+//!     QString error;
+//!     std::tie(isOk, error) = QtTemplateBuilder.render(tmpl, &f, 64 * 1024);
+//!
+std::tuple<bool, QString> QtTemplateInterpreter::render(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate,
+                                                        QIODevice *device,
+                                                        const int flushThreshold) const
+{
+    QtTIRenderContext context = createRenderContext();
+    return render(compiledTemplate, context, device, flushThreshold);
+}
+
+//!
+//! \brief Render the compiled template to callback (the result is passed in chunks, not collected in memory)
+//! \param compiledTemplate Compiled template
+//! \param sink Output callback
+//! \param flushThreshold Size of the data (in characters) buffered before calling the callback
+//! \return
+//!
+//! NOTE: In case of error, part of the result may have already been passed to the callback.
+//! NOTE: The chunk is valid only during the callback call.
+//!
+//! === Example:
+//!     QtTemplateBuilder.render(tmpl, [&socket](QStringView chunk) {
+//!         socket.write(chunk.toUtf8());
+//!     });
+//!
+std::tuple<bool, QString> QtTemplateInterpreter::render(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate,
+                                                        const QtTIRenderWriter::Sink &sink,
+                                                        const int flushThreshold) const
+{
+    QtTIRenderContext context = createRenderContext();
+    return render(compiledTemplate, context, sink, flushThreshold);
+}
+
+//!
+//! \brief Render the compiled template and return result
+//! \param compiledTemplate Compiled template
+//! \return
+//!
+//! NOTE: This method only displays a critical message to the console in case of errors.
+//!
+QString QtTemplateInterpreter::renderRes(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate) const
+{
+    bool isOk = false;
+    QString result, error;
+    std::tie(isOk, result, error) = render(compiledTemplate);
+    if (!isOk)
+        qCritical() << qPrintable(QString("[QtTemplateInterpreter][renderRes] %1").arg(error));
+    return result;
+}
+
+//!
+//! \brief Create render context (variables of one render)
+//! \return
+//!
+//! The context keeps the parameters passed for one render and the template variables ('set', 'for'),
+//! the global parameters and the help functions of the interpreter are shared (not copied).
+//! Rendering with different contexts does not change the interpreter, so one interpreter can render
+//! in several threads at once, each thread with its own context.
+//!
+//! NOTE: Do not change the global parameters and the help functions while rendering.
+//!
+//! === Example:
+//!     // thread 1
+//!     QtTIRenderContext context1 = QtTemplateBuilder.createRenderContext();
+//!     context1.appendParam("user_name", "John");
+//!     QString res1 = QtTemplateBuilder.renderRes(tmpl, context1);
+//!     // thread 2
+//!     QtTIRenderContext context2 = QtTemplateBuilder.createRenderContext();
+//!     context2.appendParam("user_name", "Jane");
+//!     QString res2 = QtTemplateBuilder.renderRes(tmpl, context2);
+//!
+QtTIRenderContext QtTemplateInterpreter::createRenderContext() const
+{
+    return _parser->createRenderContext();
+}
+
+//!
+//! \brief Render the compiled template with render context
+//! \param compiledTemplate Compiled template
+//! \param context Render context (see createRenderContext)
+//! \return
+//!
+std::tuple<bool, QString, QString> QtTemplateInterpreter::render(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate,
+                                                                 QtTIRenderContext &context) const
+{
+    if (!compiledTemplate)
+        return std::make_tuple(false, "", "Compiled template is NULL");
 
-    // check block
-    if (block && block->isUnfinished()) {
-        QString error = QString("Unfinished block in line %1 (position %2)!")
-                        .arg(block->startPos().first)
-                        .arg(block->startPos().second);
-        clear(block);
+    QtTIRenderWriter writer;
+    bool isOk = false;
+    QString error;
+    std::tie(isOk, error) = _parser->render(*compiledTemplate, context, writer);
+    if (!isOk)
         return std::make_tuple(false, "", error);
-    }
+    return std::make_tuple(true, writer.result(), "");
+}
+
+//!
+//! \brief Render the compiled template with render context to device
+//! \param compiledTemplate Compiled template
+//! \param context Render context (see createRenderContext)
+//! \param device Output device (must be opened for writing)
+//! \param flushThreshold Size of the data (in characters) buffered before writing to the device
+//! \return
+//!
+std::tuple<bool, QString> QtTemplateInterpreter::render(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate,
+                                                        QtTIRenderContext &context,
+                                                        QIODevice *device,
+                                                        const int flushThreshold) const
+{
+    if (!compiledTemplate)
+        return std::make_tuple(false, "Compiled template is NULL");
+    if (!device || !device->isWritable())
+        return std::make_tuple(false, "Output device is not writable");
+
+    QtTIRenderWriter writer(device, flushThreshold);
+    return _parser->render(*compiledTemplate, context, writer);
+}
+
+//!
+//! \brief Render the compiled template with render context to callback
+//! \param compiledTemplate Compiled template
+//! \param context Render context (see createRenderContext)
+//! \param sink Output callback
+//! \param flushThreshold Size of the data (in characters) buffered before calling the callback
+//! \return
+//!
+std::tuple<bool, QString> QtTemplateInterpreter::render(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate,
+                                                        QtTIRenderContext &context,
+                                                        const QtTIRenderWriter::Sink &sink,
+                                                        const int flushThreshold) const
+{
+    if (!compiledTemplate)
+        return std::make_tuple(false, "Compiled template is NULL");
+    if (!sink)
+        return std::make_tuple(false, "Output callback is NULL");
+
+    QtTIRenderWriter writer(sink, flushThreshold);
+    return _parser->render(*compiledTemplate, context, writer);
+}
+
+//!
+//! \brief Render the compiled template with render context and return result
+//! \param compiledTemplate Compiled template
+//! \param context Render context (see createRenderContext)
+//! \return
+//!
+//! NOTE: This method only displays a critical message to the console in case of errors.
+//!
+QString QtTemplateInterpreter::renderRes(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate,
+                                         QtTIRenderContext &context) const
+{
+    bool isOk = false;
+    QString result, error;
+    std::tie(isOk, result, error) = render(compiledTemplate, context);
+    if (!isOk)
+        qCritical() << qPrintable(QString("[QtTemplateInterpreter][renderRes] %1").arg(error));
+    return result;
+}
+
+//!
+//! \brief Compile the compiled template to the program (flat list of instructions)
+//! \param compiledTemplate Compiled template
+//! \return
+//!
+//! The program is rendered by one dispatch loop instead of walking the template nodes, the result
+//! and the errors are the same. The program can be saved and restored (see QtTIProgram::serialize),
+//! unless the template has custom control blocks.
+//!
+//! NOTE: Only the program reuses the values of the pure help function calls and the parameter fields
+//! within one render (see QtTIProgramCompiler), the compiled template evaluates them on every use.
+//!
+//! === Example:
+//!     std::shared_ptr<const QtTIProgram> program;
+//!     std::tie(isOk, program, error) = QtTemplateBuilder.compileProgram(QtTemplateBuilder.compileRes(data));
+//!     ...
+//!     QString res = QtTemplateBuilder.renderRes(program);
+//!
+std::tuple<bool, std::shared_ptr<const QtTIProgram>, QString> QtTemplateInterpreter::compileProgram(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate) const
+{
+    if (!compiledTemplate)
+        return std::make_tuple(false, nullptr, "Compiled template is NULL");
+    return std::make_tuple(true, QtTIProgramCompiler::compile(*compiledTemplate), "");
+}
+
+//!
+//! \brief Compile the compiled template to the program specialized against the frozen global parameters
+//! \param compiledTemplate Compiled template
+//! \return
+//!
+//! The frozen parameters (see freezeHelpParams) are replaced by their current values: the 'if'
+//! branches with constant conditions are selected, the lookups of the frozen parameters are
+//! inlined and the static sections are written as text. The program evaluates only other data.
+//!
+//! NOTE: Specialize the template again after the frozen parameters are changed.
+//!
+//! === Example:
+//!     QtTemplateBuilder.appendHelpParam("feature_x", true);
+//!     QtTemplateBuilder.freezeHelpParams(QStringList({ "feature_x" }));
+//!     std::shared_ptr<const QtTIProgram> program;
+//!     std::tie(isOk, program, error) = QtTemplateBuilder.specialize(QtTemplateBuilder.compileRes(data));
+//!     ...
+//!     QtTIRenderContext context = QtTemplateBuilder.createRenderContext();
+//!     context.appendParam("user_name", "John");
+//!     std::tie(isOk, result, error) = QtTemplateBuilder.render(program, context);
+//!
+std::tuple<bool, std::shared_ptr<const QtTIProgram>, QString> QtTemplateInterpreter::specialize(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate) const
+{
+    if (!compiledTemplate)
+        return std::make_tuple(false, nullptr, "Compiled template is NULL");
+    return std::make_tuple(true, QtTIProgramCompiler::specialize(*compiledTemplate, _parser->parserArgs(), _frozenParams), "");
+}
+
+//!
+//! \brief Render the program
+//! \param program Compiled template program (see compileProgram)
+//! \return
+//!
+std::tuple<bool, QString, QString> QtTemplateInterpreter::render(const std::shared_ptr<const QtTIProgram> &program) const
+{
+    QtTIRenderContext context = createRenderContext();
+    return render(program, context);
+}
+
+//!
+//! \brief Render the program to device (the result is written in chunks, not collected in memory)
+//! \param program Compiled template program (see compileProgram)
+//! \param device Output device (must be opened for writing)
+//! \param flushThreshold Size of the data (in characters) buffered before writing to the device
+//! \return
+//!
+//! NOTE: In case of error, part of the result may have already been written to the device.
+//!
+std::tuple<bool, QString> QtTemplateInterpreter::render(const std::shared_ptr<const QtTIProgram> &program,
+                                                        QIODevice *device,
+                                                        const int flushThreshold) const
+{
+    QtTIRenderContext context = createRenderContext();
+    return render(program, context, device, flushThreshold);
+}
+
+//!
+//! \brief Render the program to callback (the result is passed in chunks, not collected in memory)
+//! \param program Compiled template program (see compileProgram)
+//! \param sink Output callback
+//! \param flushThreshold Size of the data (in characters) buffered before calling the callback
+//! \return
+//!
+//! NOTE: In case of error, part of the result may have already been passed to the callback.
+//! NOTE: The chunk is valid only during the callback call.
+//!
+std::tuple<bool, QString> QtTemplateInterpreter::render(const std::shared_ptr<const QtTIProgram> &program,
+                                                        const QtTIRenderWriter::Sink &sink,
+                                                        const int flushThreshold) const
+{
+    QtTIRenderContext context = createRenderContext();
+    return render(program, context, sink, flushThreshold);
+}
+//!
+//! \brief Render the program with render context
+//! \param program Compiled template program (see compileProgram)
+//! \param context Render context (see createRenderContext)
+//! \return
+//!
+std::tuple<bool, QString, QString> QtTemplateInterpreter::render(const std::shared_ptr<const QtTIProgram> &program,
+                                                                 QtTIRenderContext &context) const
+{
+    if (!program)
+        return std::make_tuple(false, "", "Program is NULL");
+
+    QtTIRenderWriter writer;
+    bool isOk = false;
+    QString error;
+    std::tie(isOk, error) = _parser->render(*program, context, writer);
+    if (!isOk)
+        return std::make_tuple(false, "", error);
+    return std::make_tuple(true, writer.result(), "");
+}
+
+//!
+//! \brief Render the program with render context to device
+//! \param program Compiled template program (see compileProgram)
+//! \param context Render context (see createRenderContext)
+//! \param device Output device (must be opened for writing)
+//! \param flushThreshold Size of the data (in characters) buffered before writing to the device
+//! \return
+//!
+//! === Example:
+//!     QFile f("/path/to/report.csv");
+//!     f.open(QIODevice::WriteOnly);
+//!     QtTIRenderContext context = QtTemplateBuilder.createRenderContext();
+//!     context.appendParam("rows", rows);
+//!     std::tie(isOk, error) = QtTemplateBuilder.render(program, context, &f);
+//!
+std::tuple<bool, QString> QtTemplateInterpreter::render(const std::shared_ptr<const QtTIProgram> &program,
+                                                        QtTIRenderContext &context,
+                                                        QIODevice *device,
+                                                        const int flushThreshold) const
+{
+    if (!program)
+        return std::make_tuple(false, "Program is NULL");
+    if (!device || !device->isWritable())
+        return std::make_tuple(false, "Output device is not writable");
+
+    QtTIRenderWriter writer(device, flushThreshold);
+    return _parser->render(*program, context, writer);
+}
+
+//!
+//! \brief Render the program with render context to callback
+//! \param program Compiled template program (see compileProgram)
+//! \param context Render context (see createRenderContext)
+//! \param sink Output callback
+//! \param flushThreshold Size of the data (in characters) buffered before calling the callback
+//! \return
+//!
+std::tuple<bool, QString> QtTemplateInterpreter::render(const std::shared_ptr<const QtTIProgram> &program,
+                                                        QtTIRenderContext &context,
+                                                        const QtTIRenderWriter::Sink &sink,
+                                                        const int flushThreshold) const
+{
+    if (!program)
+        return std::make_tuple(false, "Program is NULL");
+    if (!sink)
+        return std::make_tuple(false, "Output callback is NULL");
+
+    QtTIRenderWriter writer(sink, flushThreshold);
+    return _parser->render(*program, context, writer);
+}
+
+//!
+//! \brief Render the program and return result
+//! \param program Compiled template program (see compileProgram)
+//! \return
+//!
+//! NOTE: This method only displays a critical message to the console in case of errors.
+//!
+QString QtTemplateInterpreter::renderRes(const std::shared_ptr<const QtTIProgram> &program) const
+{
+    bool isOk = false;
+    QString result, error;
+    std::tie(isOk, result, error) = render(program);
+    if (!isOk)
+        qCritical() << qPrintable(QString("[QtTemplateInterpreter][renderRes] %1").arg(error));
+    return result;
+}
+
+//!
+//! \brief Render the compiled template for each render context in parallel (mail merge)
+//! \param compiledTemplate Compiled template
+//! \param contexts Render contexts (see createRenderContext)
+//! \param pool Thread pool (if NULL, the global thread pool is used)
+//! \return Results in the order of contexts
+//!
+//! The calling thread renders too, the workers take the next not rendered context until all contexts
+//! are rendered. The help functions and the global parameters are shared by all renders.
+//!
+//! === Example:
+//!     QVector<QtTIRenderContext> contexts;
+//!     for (const Customer &c : customers) {
+//!         QtTIRenderContext context = QtTemplateBuilder.createRenderContext();
+//!         context.appendParam("customer", QVariant::fromValue(c));
+//!         contexts.append(context);
+//!     }
+//!     const QStringList letters = QtTemplateBuilder.renderBatchRes(tmpl, contexts);
+//!
+QVector<std::tuple<bool, QString, QString>> QtTemplateInterpreter::renderBatch(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate,
+                                                                               QVector<QtTIRenderContext> &contexts,
+                                                                               QThreadPool *pool) const
+{
+    if (!compiledTemplate && !contexts.isEmpty())
+        return QVector<QtTIRenderBatchTask::Result>(contexts.size(), std::make_tuple(false, "", "Compiled template is NULL"));
+    return renderBatch(compiledTemplate.get(), nullptr, contexts, pool);
+}
+
+//!
+//! \brief Render the compiled template for each render context in parallel and return results
+//! \param compiledTemplate Compiled template
+//! \param contexts Render contexts (see createRenderContext)
+//! \param pool Thread pool (if NULL, the global thread pool is used)
+//! \return Results in the order of contexts
+//!
+//! NOTE: This method only displays a critical message to the console in case of errors (the result of the failed render is empty).
+//!
+QStringList QtTemplateInterpreter::renderBatchRes(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate,
+                                                  QVector<QtTIRenderContext> &contexts,
+                                                  QThreadPool *pool) const
+{
+    return batchResultList(renderBatch(compiledTemplate, contexts, pool));
+}
+
+//!
+//! \brief Render the program for each render context in parallel
+//! \param program Compiled template program (see compileProgram)
+//! \param contexts Render contexts (see createRenderContext)
+//! \param pool Thread pool (if NULL, the global thread pool is used)
+//! \return Results in the order of contexts
+//!
+//! The same as the batch render of the compiled template, but each context is rendered by the program.
+//!
+QVector<std::tuple<bool, QString, QString>> QtTemplateInterpreter::renderBatch(const std::shared_ptr<const QtTIProgram> &program,
+                                                                               QVector<QtTIRenderContext> &contexts,
+                                                                               QThreadPool *pool) const
+{
+    if (!program && !contexts.isEmpty())
+        return QVector<QtTIRenderBatchTask::Result>(contexts.size(), std::make_tuple(false, "", "Program is NULL"));
+    return renderBatch(nullptr, program.get(), contexts, pool);
+}
 
-    clear(block);
-    return std::make_tuple(true, tmpData, "");
+//!
+//! \brief Render the program for each render context in parallel and return results
+//! \param program Compiled template program (see compileProgram)
+//! \param contexts Render contexts (see createRenderContext)
+//! \param pool Thread pool (if NULL, the global thread pool is used)
+//! \return Results in the order of contexts
+//!
+//! NOTE: This method only displays a critical message to the console in case of errors (the result of the failed render is empty).
+//!
+QStringList QtTemplateInterpreter::renderBatchRes(const std::shared_ptr<const QtTIProgram> &program,
+                                                  QVector<QtTIRenderContext> &contexts,
+                                                  QThreadPool *pool) const
+{
+    return batchResultList(renderBatch(program, contexts, pool));
+}
+
+//!
+//! \brief Interpret the template data
+//! \param data Template data
+//! \return
+//!
+std::tuple<bool, QString, QString> QtTemplateInterpreter::interpret(QString data)
+{
+    bool isOk = false;
+    std::shared_ptr<const QtTICompiledTemplate> compiledTemplate;
+    QString error;
+    std::tie(isOk, compiledTemplate, error) = compile(data);
+    if (!isOk)
+        return std::make_tuple(false, "", error);
+    return render(compiledTemplate);
 }
 
 //!
@@ -171,23 +683,81 @@ QString QtTemplateInterpreter::interpretRes(QString data)
 }
 
 //!
-//! \brief Interpret the template data from file
+//! \brief Compile the template data from file
 //! \param path File path
 //! \return
 //!
-std::tuple<bool, QString, QString> QtTemplateInterpreter::interpretFromFile(const QString &path)
+//! NOTE: Compiled templates are cached by canonical file path, the file is read and compiled again
+//! only if its modification time or size has changed.
+//!
+std::tuple<bool, std::shared_ptr<const QtTICompiledTemplate>, QString> QtTemplateInterpreter::compileFromFile(const QString &path)
 {
     if (path.isEmpty())
-        return std::make_tuple(false, "", "Empty file path");
-    if (!QFile::exists(path))
-        return std::make_tuple(false, "", QString("File '%1' is not exist").arg(path));
+        return std::make_tuple(false, nullptr, "Empty file path");
+    const QFileInfo fInfo(path);
+    if (!fInfo.exists())
+        return std::make_tuple(false, nullptr, QString("File '%1' is not exist").arg(path));
+
+    const QString canonicalPath = fInfo.canonicalFilePath();
+    const QDateTime lastModified = fInfo.lastModified();
+    const qint64 fileSize = fInfo.size();
+    std::shared_ptr<const QtTICompiledTemplate> compiledTemplate = _templateCache.object(canonicalPath, lastModified, fileSize);
+    if (compiledTemplate)
+        return std::make_tuple(true, compiledTemplate, "");
+
     QFile f(path);
     if (!f.open(QIODevice::ReadOnly | QIODevice::Text))
-        return std::make_tuple(false, "", QString("Open file '%1' for read failed").arg(path));
+        return std::make_tuple(false, nullptr, QString("Open file '%1' for read failed").arg(path));
 
     const QByteArray fData = f.readAll();
     f.close();
-    return interpret(QString::fromUtf8(fData));
+
+    bool isOk = false;
+    QString error;
+    std::tie(isOk, compiledTemplate, error) = compile(QString::fromUtf8(fData));
+    if (!isOk)
+        return std::make_tuple(false, nullptr, error);
+
+    _templateCache.insert(canonicalPath, lastModified, fileSize, compiledTemplate);
+    return std::make_tuple(true, compiledTemplate, "");
+}
+
+//!
+//! \brief Interpret the template data from file
+//! \param path File path
+//! \return
+//!
+std::tuple<bool, QString, QString> QtTemplateInterpreter::interpretFromFile(const QString &path)
+{
+    bool isOk = false;
+    std::shared_ptr<const QtTICompiledTemplate> compiledTemplate;
+    QString error;
+    std::tie(isOk, compiledTemplate, error) = compileFromFile(path);
+    if (!isOk)
+        return std::make_tuple(false, "", error);
+    return render(compiledTemplate);
+}
+
+//!
+//! \brief Interpret the template data from file and write result to device
+//! \param path File path
+//! \param device Output device (must be opened for writing)
+//! \param flushThreshold Size of the data (in characters) buffered before writing to the device
+//! \return
+//!
+//! NOTE: In case of error, part of the result may have already been written to the device.
+//!
+std::tuple<bool, QString> QtTemplateInterpreter::interpretFromFile(const QString &path,
+                                                                   QIODevice *device,
+                                                                   const int flushThreshold)
+{
+    bool isOk = false;
+    std::shared_ptr<const QtTICompiledTemplate> compiledTemplate;
+    QString error;
+    std::tie(isOk, compiledTemplate, error) = compileFromFile(path);
+    if (!isOk)
+        return std::make_tuple(false, error);
+    return render(compiledTemplate, device, flushThreshold);
 }
 
 //!
@@ -208,13 +778,92 @@ QString QtTemplateInterpreter::interpretResFromFile(const QString &path)
 }
 
 //!
-//! \brief Clear all tmp data
-//! \param block Abstract parser block pointer
-//! \private
+//! \brief Get cache of compiled templates from files
+//! \return
+//!
+//! NOTE: The cache is thread-safe, it can be configured and read while the templates are
+//!       rendered from files by other threads (see QtTICompiledTemplateCache).
+//!
+//! === Example:
+//!     QtTemplateBuilder.templateCache()->setMaxCost(8 * 1024 * 1024);
+//!     ...
+//!     qDebug() << QtTemplateBuilder.templateCache()->hits() << QtTemplateBuilder.templateCache()->misses();
+//!
+QtTICompiledTemplateCache *QtTemplateInterpreter::templateCache()
+{
+    return &_templateCache;
+}
+
+//!
+//! \brief Render the compiled template or the program (if the compiled template is NULL) for each render context in parallel
+//! \param compiledTemplate Compiled template
+//! \param program Compiled template program
+//! \param contexts Render contexts
+//! \param pool Thread pool (if NULL, the global thread pool is used)
+//! \return Results in the order of contexts
+//!
+QVector<std::tuple<bool, QString, QString>> QtTemplateInterpreter::renderBatch(const QtTICompiledTemplate *compiledTemplate,
+                                                                               const QtTIProgram *program,
+                                                                               QVector<QtTIRenderContext> &contexts,
+                                                                               QThreadPool *pool) const
+{
+    QVector<QtTIRenderBatchTask::Result> results(contexts.size());
+    if (contexts.isEmpty())
+        return results;
+    if (!pool)
+        pool = QThreadPool::globalInstance();
+
+    // detach the arrays before sharing them between threads
+    QtTIRenderContext *contextsData = contexts.data();
+    QtTIRenderBatchTask::Result *resultsData = results.data();
+
+    QAtomicInt nextIndex(0);
+    QSemaphore done;
+    const int count = contexts.size();
+    auto createTask = [&]() -> QtTIRenderBatchTask* {
+        if (compiledTemplate)
+            return new QtTIRenderBatchTask(_parser, compiledTemplate, contextsData, resultsData, count, &nextIndex, &done);
+        return new QtTIRenderBatchTask(_parser, program, contextsData, resultsData, count, &nextIndex, &done);
+    };
+
+    const int workerCount = qMin(qMax(pool->maxThreadCount(), 1), count) - 1;
+    std::vector<std::unique_ptr<QtTIRenderBatchTask>> workers;
+    for (int i = 0; i < workerCount; ++i) {
+        workers.emplace_back(createTask());
+        pool->start(workers.back().get());
+    }
+
+    std::unique_ptr<QtTIRenderBatchTask> task(createTask());
+    task->run();
+
+    // workers not yet started are not needed anymore
+    int startedCount = workerCount + 1;
+    for (const std::unique_ptr<QtTIRenderBatchTask> &worker : workers) {
+        if (pool->tryTake(worker.get()))
+            startedCount--;
+    }
+    done.acquire(startedCount);
+    return results;
+}
+
+//!
+//! \brief Convert the batch results to the list of results
+//! \param results Batch results
+//! \return
+//!
+//! NOTE: This method only displays a critical message to the console in case of errors (the result of the failed render is empty).
 //!
-void QtTemplateInterpreter::clear(QtTIAbstractParserBlock *block)
+QStringList QtTemplateInterpreter::batchResultList(const QVector<std::tuple<bool, QString, QString>> &results)
 {
-    _parser->parserArgs()->clearTmpParams();
-    if (block)
-        delete block;
+    QStringList resultList;
+    resultList.reserve(results.size());
+    for (int i = 0; i < results.size(); ++i) {
+        bool isOk = false;
+        QString result, error;
+        std::tie(isOk, result, error) = results[i];
+        if (!isOk)
+            qCritical() << qPrintable(QString("[QtTemplateInterpreter][renderBatchRes] Context %1: %2").arg(i).arg(error));
+        resultList.append(result);
+    }
+    return resultList;
 }
@@ -5,9 +5,15 @@
 #include <QString>
 #include <QHash>
 #include <QMultiHash>
+#include <QIODevice>
+#include <QVector>
+#include <QStringList>
+#include <QThreadPool>
+#include <memory>
 
 #include "QtTemplateInterpreterVersion.h"
 #include "QtTIParser/QtTIParser.h"
+#include "QtTIParser/CompiledTemplate/QtTICompiledTemplateCache.h"
 
 class QtTemplateInterpreter
 {
@@ -21,19 +27,96 @@ public:
     void appendHelpParam(const QString &paramName, const QVariant &value);
     void removeHelpParam(const QString &paramName);
 
+    void freezeHelpParams(const QStringList &paramNames);
+    void unfreezeHelpParams(const QStringList &paramNames);
+    QStringList frozenHelpParams() const;
+
     void clearFunctions();
     void clearParams();
 
+    std::tuple<bool/*isOk*/,std::shared_ptr<const QtTICompiledTemplate>/*result*/,QString/*error*/> compile(QString data);
+    std::shared_ptr<const QtTICompiledTemplate> compileRes(QString data);
+
+    std::tuple<bool/*isOk*/,QString/*result*/,QString/*error*/> render(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate) const;
+    std::tuple<bool/*isOk*/,QString/*error*/> render(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate,
+                                                     QIODevice *device,
+                                                     const int flushThreshold = QTTI_RENDER_WRITER_DEFAULT_FLUSH_THRESHOLD) const;
+    std::tuple<bool/*isOk*/,QString/*error*/> render(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate,
+                                                     const QtTIRenderWriter::Sink &sink,
+                                                     const int flushThreshold = QTTI_RENDER_WRITER_DEFAULT_FLUSH_THRESHOLD) const;
+    QString renderRes(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate) const;
+
+    QtTIRenderContext createRenderContext() const;
+    std::tuple<bool/*isOk*/,QString/*result*/,QString/*error*/> render(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate,
+                                                                       QtTIRenderContext &context) const;
+    std::tuple<bool/*isOk*/,QString/*error*/> render(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate,
+                                                     QtTIRenderContext &context,
+                                                     QIODevice *device,
+                                                     const int flushThreshold = QTTI_RENDER_WRITER_DEFAULT_FLUSH_THRESHOLD) const;
+    std::tuple<bool/*isOk*/,QString/*error*/> render(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate,
+                                                     QtTIRenderContext &context,
+                                                     const QtTIRenderWriter::Sink &sink,
+                                                     const int flushThreshold = QTTI_RENDER_WRITER_DEFAULT_FLUSH_THRESHOLD) const;
+    QString renderRes(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate,
+                      QtTIRenderContext &context) const;
+
+    std::tuple<bool/*isOk*/,std::shared_ptr<const QtTIProgram>/*result*/,QString/*error*/> compileProgram(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate) const;
+    std::tuple<bool/*isOk*/,std::shared_ptr<const QtTIProgram>/*result*/,QString/*error*/> specialize(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate) const;
+    std::tuple<bool/*isOk*/,QString/*result*/,QString/*error*/> render(const std::shared_ptr<const QtTIProgram> &program) const;
+    std::tuple<bool/*isOk*/,QString/*error*/> render(const std::shared_ptr<const QtTIProgram> &program,
+                                                     QIODevice *device,
+                                                     const int flushThreshold = QTTI_RENDER_WRITER_DEFAULT_FLUSH_THRESHOLD) const;
+    std::tuple<bool/*isOk*/,QString/*error*/> render(const std::shared_ptr<const QtTIProgram> &program,
+                                                     const QtTIRenderWriter::Sink &sink,
+                                                     const int flushThreshold = QTTI_RENDER_WRITER_DEFAULT_FLUSH_THRESHOLD) const;
+    std::tuple<bool/*isOk*/,QString/*result*/,QString/*error*/> render(const std::shared_ptr<const QtTIProgram> &program,
+                                                                       QtTIRenderContext &context) const;
+    std::tuple<bool/*isOk*/,QString/*error*/> render(const std::shared_ptr<const QtTIProgram> &program,
+                                                     QtTIRenderContext &context,
+                                                     QIODevice *device,
+                                                     const int flushThreshold = QTTI_RENDER_WRITER_DEFAULT_FLUSH_THRESHOLD) const;
+    std::tuple<bool/*isOk*/,QString/*error*/> render(const std::shared_ptr<const QtTIProgram> &program,
+                                                     QtTIRenderContext &context,
+                                                     const QtTIRenderWriter::Sink &sink,
+                                                     const int flushThreshold = QTTI_RENDER_WRITER_DEFAULT_FLUSH_THRESHOLD) const;
+    QString renderRes(const std::shared_ptr<const QtTIProgram> &program) const;
+
+    QVector<std::tuple<bool/*isOk*/,QString/*result*/,QString/*error*/>> renderBatch(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate,
+                                                                                     QVector<QtTIRenderContext> &contexts,
+                                                                                     QThreadPool *pool = nullptr) const;
+    QStringList renderBatchRes(const std::shared_ptr<const QtTICompiledTemplate> &compiledTemplate,
+                               QVector<QtTIRenderContext> &contexts,
+                               QThreadPool *pool = nullptr) const;
+    QVector<std::tuple<bool/*isOk*/,QString/*result*/,QString/*error*/>> renderBatch(const std::shared_ptr<const QtTIProgram> &program,
+                                                                                     QVector<QtTIRenderContext> &contexts,
+                                                                                     QThreadPool *pool = nullptr) const;
+    QStringList renderBatchRes(const std::shared_ptr<const QtTIProgram> &program,
+                               QVector<QtTIRenderContext> &contexts,
+                               QThreadPool *pool = nullptr) const;
+
     std::tuple<bool/*isOk*/,QString/*result*/,QString/*error*/> interpret(QString data);
     QString interpretRes(QString data);
 
+    std::tuple<bool/*isOk*/,std::shared_ptr<const QtTICompiledTemplate>/*result*/,QString/*error*/> compileFromFile(const QString &path);
+
     std::tuple<bool/*isOk*/,QString/*result*/,QString/*error*/> interpretFromFile(const QString &path);
+    std::tuple<bool/*isOk*/,QString/*error*/> interpretFromFile(const QString &path,
+                                                                QIODevice *device,
+                                                                const int flushThreshold = QTTI_RENDER_WRITER_DEFAULT_FLUSH_THRESHOLD);
     QString interpretResFromFile(const QString &path);
 
+    QtTICompiledTemplateCache *templateCache();
+
 private:
-    QtTIParser *_parser {nullptr};                      //!< data parser
+    QVector<std::tuple<bool/*isOk*/,QString/*result*/,QString/*error*/>> renderBatch(const QtTICompiledTemplate *compiledTemplate,
+                                                                                     const QtTIProgram *program,
+                                                                                     QVector<QtTIRenderContext> &contexts,
+                                                                                     QThreadPool *pool) const;
+    static QStringList batchResultList(const QVector<std::tuple<bool/*isOk*/,QString/*result*/,QString/*error*/>> &results);
 
-    void clear(QtTIAbstractParserBlock *block);
+    QtTIParser *_parser {nullptr};                      //!< data parser
+    QStringList _frozenParams;                          //!< frozen global parameters (see specialize)
+    QtTICompiledTemplateCache _templateCache;           //!< compiled templates from files
 };
 
 #endif // QTTEMPLATEINTERPRETER_H
@@ -22,11 +22,31 @@ HEADERS += \
     $$PWD/QtTIParser/ControlBlockFabric/ControlBlocks/QtTIControlBlockSet.h \
     $$PWD/QtTIParser/ControlBlockFabric/ControlBlocks/QtTIControlBlockUnset.h \
     $$PWD/QtTIParser/ControlBlockFabric/QtTIControlBlockFabric.h \
-    $$PWD/QtTIParser/BracketsExpr/QtTIBracketsNode.h \
-    $$PWD/QtTIParser/BracketsExpr/QtTIParserBracketsExpr.h \
+    $$PWD/QtTIParser/CompiledTemplate/QtTICompiledNode.h \
+    $$PWD/QtTIParser/CompiledTemplate/QtTICompiledTemplate.h \
+    $$PWD/QtTIParser/CompiledTemplate/QtTICompiledTemplateCache.h \
+    $$PWD/QtTIParser/CompiledTemplate/QtTIRenderWriter.h \
+    $$PWD/QtTIParser/CompiledTemplate/QtTIRenderBatchTask.h \
+    $$PWD/QtTIParser/Expression/QtTIExprToken.h \
+    $$PWD/QtTIParser/Expression/QtTIExprLexer.h \
+    $$PWD/QtTIParser/Expression/QtTIExprNode.h \
+    $$PWD/QtTIParser/Expression/QtTIExprParser.h \
+    $$PWD/QtTIParser/Expression/QtTIExpression.h \
+    $$PWD/QtTIParser/Expression/QtTIExprFolder.h \
+    $$PWD/QtTIParser/Expression/QtTIValue.h \
+    $$PWD/QtTIParser/TemplateLexer/QtTITemplateToken.h \
+    $$PWD/QtTIParser/TemplateLexer/QtTITemplateLexer.h \
+    $$PWD/QtTIParser/Scope/QtTIScope.h \
+    $$PWD/QtTIParser/Scope/QtTIParamPath.h \
+    $$PWD/QtTIParser/Scope/QtTIPropertyCache.h \
+    $$PWD/QtTIParser/Scope/QtTIMethodCache.h \
+    $$PWD/QtTIParser/Scope/QtTIFunctionCache.h \
+    $$PWD/QtTIParser/Program/QtTIProgram.h \
+    $$PWD/QtTIParser/Program/QtTIProgramCompiler.h \
+    $$PWD/QtTIParser/Program/QtTIProgramRunner.h \
     $$PWD/QtTIParser/Logic/QtTIParserLogic.h \
-    $$PWD/QtTIParser/Math/QtTIMathAction.h \
     $$PWD/QtTIParser/Math/QtTIParserMath.h \
+    $$PWD/QtTIParser/RegExpRegistry/QtTIRegExpRegistry.h \
     $$PWD/QtTIParser/NullCoalescingOperator/QtTIParserNullCoalescingOperator.h \
     $$PWD/QtTIParser/TernaryOperator/QtTIParserTernaryOperator.h \
     $$PWD/QtTIParser/HelperClasses/RegExp.h \
@@ -34,6 +54,7 @@ HEADERS += \
     $$PWD/QtTIParser/QtTIParserArgs.h \
     $$PWD/QtTIParser/QtTIParserFunc.h \
     $$PWD/QtTIParser/QtTIParserBlock.h \
+    $$PWD/QtTIParser/QtTIRenderContext.h \
     $$PWD/QtTemplateInterpreter.h \
     $$PWD/QtTemplateInterpreterVersion.h
 
@@ -43,12 +64,31 @@ SOURCES += \
     $$PWD/QtTIParser/ControlBlockFabric/ControlBlocks/QtTIControlBlockSet.cpp \
     $$PWD/QtTIParser/ControlBlockFabric/ControlBlocks/QtTIControlBlockUnset.cpp \
     $$PWD/QtTIParser/ControlBlockFabric/QtTIControlBlockFabric.cpp \
+    $$PWD/QtTIParser/CompiledTemplate/QtTICompiledTemplateCache.cpp \
+    $$PWD/QtTIParser/CompiledTemplate/QtTIRenderWriter.cpp \
+    $$PWD/QtTIParser/CompiledTemplate/QtTIRenderBatchTask.cpp \
+    $$PWD/QtTIParser/Expression/QtTIExprLexer.cpp \
+    $$PWD/QtTIParser/Expression/QtTIExprNode.cpp \
+    $$PWD/QtTIParser/Expression/QtTIExprParser.cpp \
+    $$PWD/QtTIParser/Expression/QtTIExpression.cpp \
+    $$PWD/QtTIParser/Expression/QtTIExprFolder.cpp \
+    $$PWD/QtTIParser/Expression/QtTIValue.cpp \
+    $$PWD/QtTIParser/TemplateLexer/QtTITemplateLexer.cpp \
+    $$PWD/QtTIParser/Scope/QtTIScope.cpp \
+    $$PWD/QtTIParser/Scope/QtTIParamPath.cpp \
+    $$PWD/QtTIParser/Scope/QtTIPropertyCache.cpp \
+    $$PWD/QtTIParser/Scope/QtTIMethodCache.cpp \
+    $$PWD/QtTIParser/Scope/QtTIFunctionCache.cpp \
+    $$PWD/QtTIParser/Program/QtTIProgram.cpp \
+    $$PWD/QtTIParser/Program/QtTIProgramCompiler.cpp \
+    $$PWD/QtTIParser/Program/QtTIProgramRunner.cpp \
     $$PWD/QtTIParser/Logic/QtTIParserLogic.cpp \
     $$PWD/QtTIParser/NullCoalescingOperator/QtTIParserNullCoalescingOperator.cpp \
     $$PWD/QtTIParser/TernaryOperator/QtTIParserTernaryOperator.cpp \
     $$PWD/QtTIParser/Math/QtTIParserMath.cpp \
-    $$PWD/QtTIParser/BracketsExpr/QtTIParserBracketsExpr.cpp \
+    $$PWD/QtTIParser/RegExpRegistry/QtTIRegExpRegistry.cpp \
     $$PWD/QtTIParser/QtTIParser.cpp \
     $$PWD/QtTIParser/QtTIParserArgs.cpp \
     $$PWD/QtTIParser/QtTIParserFunc.cpp \
+    $$PWD/QtTIParser/QtTIRenderContext.cpp \
     $$PWD/QtTemplateInterpreter.cpp